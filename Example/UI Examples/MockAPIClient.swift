@@ -38,8 +38,9 @@ extension STPAddCardViewController {
 
 class MockAPIClient: STPAPIClient {
 
-    override func createToken(withCard card: STPCardParams, completion: STPTokenCompletionBlock? = nil) {
-        guard let completion = completion else { return }
+    override func createToken(withCard card: STPCardParams, completion: STPTokenCompletionBlock? = nil) -> STPAPIOperation {
+        let operation = STPAPIOperation()
+        guard let completion = completion else { return operation }
 
         // Generate a mock card model using the given card params
         var cardJSON: [String: Any] = [:]
@@ -71,5 +72,6 @@ class MockAPIClient: STPAPIClient {
         DispatchQueue.main.asyncAfter(deadline: .now() + 0.6) {
             completion(token, nil)
         }
+        return operation
     }
 }
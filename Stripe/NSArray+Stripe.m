@@ -20,28 +20,36 @@
 }
 
 - (NSArray *)stp_arrayByRemovingNulls {
-    NSMutableArray *result = [[NSMutableArray alloc] init];
+    // Only copied if something changes, see stp_dictionaryByRemovingNulls
+    NSMutableArray *result = nil;
 
-    for (id obj in self) {
+    for (NSUInteger i = 0; i < self.count; i++) {
+        id obj = self[i];
+        id value = obj;
         if ([obj isKindOfClass:[NSArray class]]) {
             // Save array after removing any null values
-            [result addObject:[(NSArray *)obj stp_arrayByRemovingNulls]];
+            value = [(NSArray *)obj stp_arrayByRemovingNulls];
         }
         else if ([obj isKindOfClass:[NSDictionary class]]) {
             // Save dictionary after removing any null values
-            [result addObject:[(NSDictionary *)obj stp_dictionaryByRemovingNulls]];
+            value = [(NSDictionary *)obj stp_dictionaryByRemovingNulls];
         }
         else if ([obj isKindOfClass:[NSNull class]]) {
             // Skip null value
+            value = nil;
         }
-        else {
-            // Save other value
-            [result addObject:obj];
+
+        if (!result && value != obj) {
+            result = [[self subarrayWithRange:NSMakeRange(0, i)] mutableCopy];
+        }
+        if (result && value) {
+            [result addObject:value];
         }
     }
 
-    // Make immutable copy
-    return [result copy];
+    // Make immutable copy. For an array that's already immutable, this
+    // returns the same array.
+    return result ? [result copy] : [self copy];
 }
 
 @end
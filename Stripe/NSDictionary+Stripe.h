@@ -12,8 +12,19 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface NSDictionary (Stripe)
 
+/**
+ Returns a dictionary without any `NSNull` values, at any depth. Values of
+ fields that only have a few possible values, like `currency` or `status`, are
+ replaced with shared instances.
+ */
 - (NSDictionary *)stp_dictionaryByRemovingNulls;
 
+/**
+ Turns the sharing of values described above on or off. It's on by default,
+ and only turned off in tests, to measure what it saves.
+ */
++ (void)stp_setInterningEnabled:(BOOL)enabled;
+
 - (NSDictionary<NSString *, NSString *> *)stp_dictionaryByRemovingNonStrings;
 
 // Getters
@@ -30,6 +41,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (nullable NSNumber *)stp_numberForKey:(NSString *)key;
 
+/**
+ Like `stp_dictionaryByRemovingNulls`, returns shared instances for fields
+ that only have a few possible values.
+ */
 - (nullable NSString *)stp_stringForKey:(NSString *)key;
 
 - (nullable NSURL *)stp_urlForKey:(NSString *)key;
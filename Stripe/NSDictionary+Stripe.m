@@ -12,31 +12,112 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+// Unexpected values are left alone once the table is this big, so that it
+// can't grow without bound
+static const NSUInteger InternTableCountLimit = 1024;
+
+static BOOL InterningEnabled = YES;
+
+/**
+ Fields whose values come from a small set, e.g. currency codes and statuses.
+ Decoding a list of cards or sources would otherwise keep a separate copy of
+ the same few strings for every object.
+ */
+static BOOL STPShouldInternValueForKey(id key) {
+    if (!InterningEnabled) {
+        return NO;
+    }
+    static NSSet<NSString *> *internedKeys;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        internedKeys = [NSSet setWithArray:@[
+                                             @"address_country",
+                                             @"address_line1_check",
+                                             @"address_zip_check",
+                                             @"brand",
+                                             @"country",
+                                             @"currency",
+                                             @"cvc_check",
+                                             @"flow",
+                                             @"funding",
+                                             @"object",
+                                             @"status",
+                                             @"three_d_secure",
+                                             @"tokenization_method",
+                                             @"type",
+                                             @"usage",
+                                             ]];
+    });
+    return [key isKindOfClass:[NSString class]] && [internedKeys containsObject:key];
+}
+
+/**
+ Returns the process-wide instance of `string`, so that equal values share
+ storage and usually compare equal by pointer.
+ */
+static NSString *STPInternedString(NSString *string) {
+    static NSMutableSet<NSString *> *table;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        table = [NSMutableSet set];
+    });
+
+    @synchronized (table) {
+        NSString *interned = [table member:string];
+        if (!interned) {
+            if (table.count >= InternTableCountLimit) {
+                return string;
+            }
+            interned = [string copy];
+            [table addObject:interned];
+        }
+        return interned;
+    }
+}
+
 @implementation NSDictionary (Stripe)
 
++ (void)stp_setInterningEnabled:(BOOL)enabled {
+    InterningEnabled = enabled;
+}
+
 - (NSDictionary *)stp_dictionaryByRemovingNulls {
-    NSMutableDictionary *result = [[NSMutableDictionary alloc] init];
+    // Only copied if something changes, so that nested models decoded from
+    // parts of this dictionary share them instead of holding their own copies.
+    // Once a dictionary's values have been interned, decoding it again doesn't
+    // change it.
+    __block NSMutableDictionary *result = nil;
 
     [self enumerateKeysAndObjectsUsingBlock:^(id key, id obj, __unused BOOL *stop) {
+        id value = obj;
         if ([obj isKindOfClass:[NSArray class]]) {
             // Save array after removing any null values
-            result[key] = [(NSArray *)obj stp_arrayByRemovingNulls];
+            value = [(NSArray *)obj stp_arrayByRemovingNulls];
         }
         else if ([obj isKindOfClass:[NSDictionary class]]) {
             // Save dictionary after removing any null values
-            result[key] = [(NSDictionary *)obj stp_dictionaryByRemovingNulls];
+            value = [(NSDictionary *)obj stp_dictionaryByRemovingNulls];
         }
         else if ([obj isKindOfClass:[NSNull class]]) {
             // Skip null value
+            value = nil;
         }
-        else {
-            // Save other value
-            result[key] = obj;
+        else if ([obj isKindOfClass:[NSString class]] && STPShouldInternValueForKey(key)) {
+            // Share the value with every other object that has it
+            value = STPInternedString(obj);
+        }
+
+        if (value != obj) {
+            if (!result) {
+                result = [self mutableCopy];
+            }
+            result[key] = value;
         }
     }];
 
-    // Make immutable copy
-    return [result copy];
+    // Make immutable copy. For a dictionary that's already immutable, this
+    // returns the same dictionary.
+    return result ? [result copy] : [self copy];
 }
 
 - (NSDictionary<NSString *, NSString *> *)stp_dictionaryByRemovingNonStrings {
@@ -121,7 +202,7 @@ NS_ASSUME_NONNULL_BEGIN
 - (nullable NSString *)stp_stringForKey:(NSString *)key {
     id value = self[key];
     if (value && [value isKindOfClass:[NSString class]]) {
-        return value;
+        return STPShouldInternValueForKey(key) ? STPInternedString(value) : value;
     }
     return nil;
 }
@@ -21,8 +21,8 @@
  @param payment     The user's encrypted payment information as returned from a PKPaymentAuthorizationViewController. Cannot be nil.
  @param completion  The callback to run with the returned Stripe token (and any errors that may have occurred).
  */
-- (void)createTokenWithPayment:(nonnull PKPayment *)payment
-                    completion:(nonnull STPTokenCompletionBlock)completion;
+- (nonnull STPAPIOperation *)createTokenWithPayment:(nonnull PKPayment *)payment
+                                         completion:(nonnull STPTokenCompletionBlock)completion;
 
 /**
  Converts a PKPayment object into a Stripe source using the Stripe API.
@@ -30,8 +30,8 @@
  @param payment     The user's encrypted payment information as returned from a PKPaymentAuthorizationViewController. Cannot be nil.
  @param completion  The callback to run with the returned Stripe source (and any errors that may have occurred).
  */
-- (void)createSourceWithPayment:(nonnull PKPayment *)payment
-                     completion:(nonnull STPSourceCompletionBlock)completion;
+- (nonnull STPAPIOperation *)createSourceWithPayment:(nonnull PKPayment *)payment
+                                          completion:(nonnull STPSourceCompletionBlock)completion;
 
 @end
 
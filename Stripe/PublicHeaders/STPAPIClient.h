@@ -10,6 +10,7 @@
 #import <PassKit/PassKit.h>
 
 #import "FauxPasAnnotations.h"
+#import "STPAPIOperation.h"
 #import "STPBlocks.h"
 #import "STPFile.h"
 
@@ -22,6 +23,7 @@ static NSString *const STPSDKVersion = @"14.0.0";
 
 @class STPBankAccount, STPBankAccountParams, STPCard, STPCardParams, STPConnectAccountParams;
 @class STPPaymentConfiguration, STPPaymentIntentParams, STPSourceParams, STPToken;
+@protocol STPRequestMetricsObserver;
 
 /**
  A top-level class that imports the rest of the Stripe SDK.
@@ -94,12 +96,42 @@ static NSString *const STPSDKVersion = @"14.0.0";
  */
 @property (nonatomic, copy, nullable) NSString *stripeAccount;
 
+/**
+ An object to notify with the timings of every API request this client makes,
+ such as an `STPRequestMetricsAggregator`. Requests made on behalf of an
+ `STPCustomerContext` are reported to the shared client's observer.
+
+ The observer is not retained, and is called on the main queue.
+ */
+@property (nonatomic, weak, nullable) id<STPRequestMetricsObserver> metricsObserver;
+
+/**
+ The maximum number of times a request is retried after a connectivity
+ failure, a rate limit (HTTP 429) or a server error (HTTP 5xx). Retries wait
+ with exponential back-off and jitter. POST requests carry an
+ `Idempotency-Key` header, so a retried request never creates a second object.
+ Set to 0 to turn retries off. Defaults to 2. Requests made on behalf of an
+ `STPCustomerContext` use the shared client's retry settings.
+ */
+@property (nonatomic) NSUInteger maxRetryCount;
+
+/**
+ Retries are only attempted while less than this many seconds have passed
+ since a request was first sent, including the back-off before the retry.
+ Defaults to 10 seconds.
+ */
+@property (nonatomic) NSTimeInterval retryTimeBudget;
+
 @end
 
 #pragma mark Bank Accounts
 
 /**
  STPAPIClient extensions to create Stripe tokens from bank accounts.
+
+ Each request method below returns an `STPAPIOperation` that can be used to
+ cancel the request or change its priority. You can ignore it if you don't
+ need to do either.
  */
 @interface STPAPIClient (BankAccounts)
 
@@ -109,7 +141,7 @@ static NSString *const STPSDKVersion = @"14.0.0";
  @param bankAccount The user's bank account details. Cannot be nil. @see https://stripe.com/docs/api#create_bank_account_token
  @param completion  The callback to run with the returned Stripe token (and any errors that may have occurred).
  */
-- (void)createTokenWithBankAccount:(STPBankAccountParams *)bankAccount completion:(__nullable STPTokenCompletionBlock)completion;
+- (STPAPIOperation *)createTokenWithBankAccount:(STPBankAccountParams *)bankAccount completion:(__nullable STPTokenCompletionBlock)completion;
 
 @end
 
@@ -126,7 +158,7 @@ static NSString *const STPSDKVersion = @"14.0.0";
  @param pii The user's personal identification number. Cannot be nil. @see https://stripe.com/docs/api#create_pii_token
  @param completion  The callback to run with the returned Stripe token (and any errors that may have occurred).
  */
-- (void)createTokenWithPersonalIDNumber:(NSString *)pii completion:(__nullable STPTokenCompletionBlock)completion;
+- (STPAPIOperation *)createTokenWithPersonalIDNumber:(NSString *)pii completion:(__nullable STPTokenCompletionBlock)completion;
 
 @end
 
@@ -146,7 +178,7 @@ static NSString *const STPSDKVersion = @"14.0.0";
  @param account The Connect Account parameters. Cannot be nil.
  @param completion The callback to run with the returned Stripe token (and any errors that may have occurred).
  */
-- (void)createTokenWithConnectAccount:(STPConnectAccountParams *)account completion:(__nullable STPTokenCompletionBlock)completion;
+- (STPAPIOperation *)createTokenWithConnectAccount:(STPConnectAccountParams *)account completion:(__nullable STPTokenCompletionBlock)completion;
 
 @end
 
@@ -173,9 +205,9 @@ static NSString *const STPSDKVersion = @"14.0.0";
 
  @see https://stripe.com/docs/file-upload
  */
-- (void)uploadImage:(UIImage *)image
-            purpose:(STPFilePurpose)purpose
-         completion:(nullable STPFileCompletionBlock)completion;
+- (STPAPIOperation *)uploadImage:(UIImage *)image
+                         purpose:(STPFilePurpose)purpose
+                      completion:(nullable STPFileCompletionBlock)completion;
 
 @end
 
@@ -192,7 +224,7 @@ static NSString *const STPSDKVersion = @"14.0.0";
  @param card        The user's card details. Cannot be nil. @see https://stripe.com/docs/api#create_card_token
  @param completion  The callback to run with the returned Stripe token (and any errors that may have occurred).
  */
-- (void)createTokenWithCard:(STPCardParams *)card completion:(nullable STPTokenCompletionBlock)completion;
+- (STPAPIOperation *)createTokenWithCard:(STPCardParams *)card completion:(nullable STPTokenCompletionBlock)completion;
 
 @end
 
@@ -283,7 +315,7 @@ static NSString *const STPSDKVersion = @"14.0.0";
  @param params      The details of the source to create. Cannot be nil. @see https://stripe.com/docs/api#create_source
  @param completion  The callback to run with the returned Source object, or an error.
  */
-- (void)createSourceWithParams:(STPSourceParams *)params completion:(STPSourceCompletionBlock)completion;
+- (STPAPIOperation *)createSourceWithParams:(STPSourceParams *)params completion:(STPSourceCompletionBlock)completion;
 
 /**
  Retrieves the Source object with the given ID. @see https://stripe.com/docs/api#retrieve_source
@@ -292,7 +324,7 @@ static NSString *const STPSDKVersion = @"14.0.0";
  @param secret      The client secret of the source. Cannot be nil.
  @param completion  The callback to run with the returned Source object, or an error.
  */
-- (void)retrieveSourceWithId:(NSString *)identifier clientSecret:(NSString *)secret completion:(STPSourceCompletionBlock)completion;
+- (STPAPIOperation *)retrieveSourceWithId:(NSString *)identifier clientSecret:(NSString *)secret completion:(STPSourceCompletionBlock)completion;
 
 /**
  Starts polling the Source object with the given ID. For payment methods that require
@@ -323,6 +355,62 @@ static NSString *const STPSDKVersion = @"14.0.0";
 
 @end
 
+#pragma mark Batches
+
+/**
+ STPAPIClient extensions to create many tokens or sources at once, e.g. when
+ importing saved payment details.
+
+ Batches run at `STPAPIOperationPriorityLow`, so other requests made by the
+ SDK go first. Items that are rate limited by the API are put back in the
+ queue, and the batch backs off and lowers its concurrency before continuing.
+ */
+@interface STPAPIClient (Batches)
+
+/**
+ Converts an array of STPCardParams objects into Stripe tokens.
+
+ @param cards           The cards to tokenize. @see https://stripe.com/docs/api#create_card_token
+ @param maxConcurrency  The maximum number of cards to tokenize at once. The SDK makes at most 4 requests at a time, so higher values only help to keep the SDK's queue full.
+ @param progress        The callback to run each time a card has been tokenized or has failed.
+ @param completion      The callback to run with the results, in the same order as `cards`. Each result holds an `STPToken` or an error.
+ @return An operation that can be used to cancel the cards that haven't been tokenized yet.
+ */
+- (STPAPIOperation *)createTokensWithCards:(NSArray<STPCardParams *> *)cards
+                            maxConcurrency:(NSUInteger)maxConcurrency
+                                  progress:(nullable STPBatchProgressBlock)progress
+                                completion:(STPBatchCompletionBlock)completion;
+
+/**
+ Converts an array of STPBankAccountParams objects into Stripe tokens.
+
+ @param bankAccounts    The bank accounts to tokenize. @see https://stripe.com/docs/api#create_bank_account_token
+ @param maxConcurrency  The maximum number of bank accounts to tokenize at once.
+ @param progress        The callback to run each time a bank account has been tokenized or has failed.
+ @param completion      The callback to run with the results, in the same order as `bankAccounts`. Each result holds an `STPToken` or an error.
+ @return An operation that can be used to cancel the bank accounts that haven't been tokenized yet.
+ */
+- (STPAPIOperation *)createTokensWithBankAccounts:(NSArray<STPBankAccountParams *> *)bankAccounts
+                                   maxConcurrency:(NSUInteger)maxConcurrency
+                                         progress:(nullable STPBatchProgressBlock)progress
+                                       completion:(STPBatchCompletionBlock)completion;
+
+/**
+ Creates a Source object for each of the provided STPSourceParams.
+
+ @param params          The details of the sources to create. @see https://stripe.com/docs/api#create_source
+ @param maxConcurrency  The maximum number of sources to create at once.
+ @param progress        The callback to run each time a source has been created or has failed.
+ @param completion      The callback to run with the results, in the same order as `params`. Each result holds an `STPSource` or an error.
+ @return An operation that can be used to cancel the sources that haven't been created yet.
+ */
+- (STPAPIOperation *)createSourcesWithParams:(NSArray<STPSourceParams *> *)params
+                              maxConcurrency:(NSUInteger)maxConcurrency
+                                    progress:(nullable STPBatchProgressBlock)progress
+                                  completion:(STPBatchCompletionBlock)completion;
+
+@end
+
 #pragma mark Payment Intents
 
 /**
@@ -336,8 +424,8 @@ static NSString *const STPSDKVersion = @"14.0.0";
  @param secret      The client secret of the payment intent to be retrieved. Cannot be nil.
  @param completion  The callback to run with the returned PaymentIntent object, or an error.
  */
-- (void)retrievePaymentIntentWithClientSecret:(NSString *)secret
-                                   completion:(STPPaymentIntentCompletionBlock)completion;
+- (STPAPIOperation *)retrievePaymentIntentWithClientSecret:(NSString *)secret
+                                                completion:(STPPaymentIntentCompletionBlock)completion;
 
 /**
  Confirms the PaymentIntent object with the provided params object.
@@ -346,11 +434,47 @@ static NSString *const STPSDKVersion = @"14.0.0";
 
  @see https://stripe.com/docs/api#confirm_payment_intent
 
+ Confirmation is performed with `STPAPIOperationPriorityHigh`, ahead of any
+ other requests the SDK is waiting to make.
+
  @param paymentIntentParams  The `STPPaymentIntentParams` to pass to `/confirm`
  @param completion           The callback to run with the returned PaymentIntent object, or an error.
  */
-- (void)confirmPaymentIntentWithParams:(STPPaymentIntentParams *)paymentIntentParams
-                            completion:(STPPaymentIntentCompletionBlock)completion;
+- (STPAPIOperation *)confirmPaymentIntentWithParams:(STPPaymentIntentParams *)paymentIntentParams
+                                         completion:(STPPaymentIntentCompletionBlock)completion;
+
+/**
+ Starts polling the PaymentIntent with the given secret. Call this when the
+ customer returns from the redirect started by an `STPRedirectContext`, to find
+ out whether the payment went through. The first request is made right away.
+ Polling stops and the callback is called once the PaymentIntent's status is
+ no longer `STPPaymentIntentStatusRequiresSourceAction` or
+ `STPPaymentIntentStatusProcessing`, or when the given timeout is reached. If
+ polling stops due to an error, the callback is called with the latest
+ retrieved PaymentIntent and the error.
+
+ Polling backs off when the API is having trouble, retries after connectivity
+ errors, and pauses while your app is in the background, in the same way as
+ `startPollingSourceWithId:clientSecret:timeout:completion:`. Starting to poll
+ a PaymentIntent that's already being polled replaces the earlier poll, whose
+ completion block won't be called.
+
+ @param secret      The client secret of the PaymentIntent. Cannot be nil.
+ @param timeout     The timeout for the polling operation, in seconds. Timeouts are capped at 5 minutes.
+ @param completion  The callback to run with the returned PaymentIntent object, or an error.
+ */
+- (void)startPollingPaymentIntentWithClientSecret:(NSString *)secret
+                                          timeout:(NSTimeInterval)timeout
+                                       completion:(STPPaymentIntentCompletionBlock)completion NS_EXTENSION_UNAVAILABLE("PaymentIntent polling is not available in extensions");
+
+/**
+ Stops polling the PaymentIntent with the given secret. The completion block
+ passed to `startPollingPaymentIntentWithClientSecret:timeout:completion:`
+ won't be called.
+
+ @param secret      The client secret of the PaymentIntent. Cannot be nil.
+ */
+- (void)stopPollingPaymentIntentWithClientSecret:(NSString *)secret NS_EXTENSION_UNAVAILABLE("PaymentIntent polling is not available in extensions");
 
 @end
 
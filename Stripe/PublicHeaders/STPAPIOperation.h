@@ -0,0 +1,82 @@
+//
+//  STPAPIOperation.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ How urgently an `STPAPIOperation` should be performed relative to other
+ requests made by the SDK.
+ */
+typedef NS_ENUM(NSInteger, STPAPIOperationPriority) {
+    /**
+     Background work whose result is not immediately needed, such as
+     refreshing a customer's saved payment methods.
+     */
+    STPAPIOperationPriorityLow,
+
+    /**
+     The priority of most requests.
+     */
+    STPAPIOperationPriorityDefault,
+
+    /**
+     Work the user is actively waiting on, such as confirming a payment.
+     */
+    STPAPIOperationPriorityHigh,
+};
+
+/**
+ A handle to a request made by `STPAPIClient`.
+
+ The SDK limits how many requests it has in flight at once (4, shared by all
+ `STPAPIClient`s; file uploads don't count towards it). Requests that are
+ waiting for a free slot are started in priority order, and the priority of a
+ running request is passed on to its `NSURLSessionTask`. A request that is
+ waiting to be retried gives up its slot and waits for another one.
+
+ Cancelling an operation calls its completion block with an error in
+ `NSURLErrorDomain` with code `NSURLErrorCancelled`, unless the operation has
+ already finished.
+ */
+@interface STPAPIOperation : NSObject
+
+/**
+ Creates an operation that is not attached to any request; cancelling it only
+ marks it cancelled. This is useful when overriding `STPAPIClient` methods,
+ e.g. to return canned responses in tests. Otherwise, you should only use
+ operations returned from `STPAPIClient` methods.
+ */
+- (instancetype)init;
+
+/**
+ The priority of the operation. Each `STPAPIClient` method picks a sensible
+ default; changing it affects an operation that is waiting to start as well
+ as one that is already running.
+ */
+@property (nonatomic) STPAPIOperationPriority priority;
+
+/**
+ Whether `cancel` has been called on the operation.
+ */
+@property (nonatomic, readonly, getter=isCancelled) BOOL cancelled;
+
+/**
+ Whether the operation's completion block has been called.
+ */
+@property (nonatomic, readonly, getter=isFinished) BOOL finished;
+
+/**
+ Cancels the operation. Does nothing if the operation has already finished.
+ */
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
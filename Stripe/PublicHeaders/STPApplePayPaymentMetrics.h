@@ -0,0 +1,67 @@
+//
+//  STPApplePayPaymentMetrics.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Timings collected while an `STPPaymentContext` completes an Apple Pay payment,
+ from the Apple Pay source (or token) being created to the sheet being told
+ whether the payment succeeded.
+
+ All durations are in seconds.
+
+ @see STPPaymentContextDelegate
+ */
+@interface STPApplePayPaymentMetrics : NSObject
+
+/**
+ You cannot directly instantiate an `STPApplePayPaymentMetrics`. You should only
+ use one that has been passed to an `STPPaymentContextDelegate`.
+ */
+- (instancetype)init __attribute__((unavailable("You cannot directly instantiate an STPApplePayPaymentMetrics. You should only use one that has been passed to an STPPaymentContextDelegate.")));
+
+/**
+ Whether the source was attached to the customer while your delegate was
+ creating the charge. @see STPPaymentContext.pipelinesApplePayAttachment
+ */
+@property (nonatomic, readonly, getter=isPipelined) BOOL pipelined;
+
+/**
+ Time spent attaching the source to the customer, including fetching an
+ ephemeral key if the current one had expired.
+ */
+@property (nonatomic, readonly) NSTimeInterval attachDuration;
+
+/**
+ Time from calling `paymentContext:didCreatePaymentResult:completion:` to
+ your delegate calling its completion block.
+ */
+@property (nonatomic, readonly) NSTimeInterval paymentResultDuration;
+
+/**
+ Time from the source being created to the sheet being told the outcome.
+ */
+@property (nonatomic, readonly) NSTimeInterval duration;
+
+/**
+ How much sooner the sheet was told the outcome than if the attach and your
+ delegate had run one after the other. Always 0 if the payment wasn't
+ pipelined.
+ */
+@property (nonatomic, readonly) NSTimeInterval timeSaved;
+
+/**
+ The error attaching the source to the customer failed with, if any.
+ */
+@property (nonatomic, nullable, readonly) NSError *attachError;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,156 @@
+//
+//  STPBackgroundUploadSession.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+#import "STPBlocks.h"
+#import "STPFile.h"
+
+@class STPAPIClient;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The states of an `STPBackgroundUpload`.
+ */
+typedef NS_ENUM(NSInteger, STPBackgroundUploadState) {
+    /**
+     The image is being encoded, or the upload is in progress or waiting for
+     the system to run it.
+     */
+    STPBackgroundUploadStateUploading,
+
+    /**
+     The file was uploaded. Its `file` is set.
+     */
+    STPBackgroundUploadStateCompleted,
+
+    /**
+     The upload failed. Its `error` is set.
+     */
+    STPBackgroundUploadStateFailed,
+};
+
+/**
+ A file upload run by an `STPBackgroundUploadSession`.
+ */
+@interface STPBackgroundUpload : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Identifies the upload across launches of your app. Save it if you want to
+ reattach a completion block to the upload after your app is relaunched.
+ */
+@property (nonatomic, copy, readonly) NSString *identifier;
+
+/**
+ The upload's current state.
+ */
+@property (nonatomic, readonly) STPBackgroundUploadState state;
+
+/**
+ The number of bytes of the request body sent so far, and the total.
+ */
+@property (nonatomic, readonly) int64_t countOfBytesSent;
+@property (nonatomic, readonly) int64_t countOfBytesExpectedToSend;
+
+/**
+ The uploaded file, once the upload has completed.
+ */
+@property (nonatomic, strong, nullable, readonly) STPFile *file;
+
+/**
+ Why the upload failed, if it did.
+ */
+@property (nonatomic, strong, nullable, readonly) NSError *error;
+
+@end
+
+/**
+ Uploads files on a background URL session, so that uploads keep going while
+ your app is suspended, and finish even if it's terminated by the system.
+
+ Images are encoded off the main thread, and the request body is written to
+ disk before the upload starts. When your app is relaunched, the uploads that
+ were in progress (or finished while it wasn't running) show up in `uploads`,
+ and you can attach completion blocks to them with
+ `addCompletion:forUploadWithIdentifier:`.
+
+ For uploads to finish while your app isn't running, call
+ `handleEventsForBackgroundURLSession:completionHandler:` from your app
+ delegate's `application:handleEventsForBackgroundURLSession:completionHandler:`.
+
+ All of this class's methods must be called on the main queue, and all of its
+ callbacks are made there.
+ */
+@interface STPBackgroundUploadSession : NSObject
+
+/**
+ The shared upload session. There can only be one per app, since the system
+ identifies a background session by name.
+ */
++ (instancetype)sharedSession;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ The API client used to build upload requests. Defaults to
+ `[STPAPIClient sharedClient]`.
+ */
+@property (nonatomic, strong) STPAPIClient *apiClient;
+
+/**
+ Uploads in progress, and finished uploads whose results haven't been passed
+ to a completion block yet.
+ */
+@property (nonatomic, copy, readonly) NSArray<STPBackgroundUpload *> *uploads;
+
+/**
+ Uploads an image in the background.
+
+ @param image       The image to be uploaded. The maximum allowed file size is 4MB for identity documents and 8MB for all other file types. Large images are scaled down to fit.
+ @param purpose     The purpose of this file. This can be either an identifing document or an evidence dispute.
+ @param completion  The callback to run with the uploaded file (and any errors that may have occurred). Not called if your app is terminated before the upload finishes; use `addCompletion:forUploadWithIdentifier:` after relaunching instead.
+ @return The upload. It's also added to `uploads`.
+
+ @see https://stripe.com/docs/file-upload
+ */
+- (STPBackgroundUpload *)uploadImage:(UIImage *)image
+                             purpose:(STPFilePurpose)purpose
+                          completion:(nullable STPFileCompletionBlock)completion;
+
+/**
+ Adds a completion block to an upload. If the upload has already finished,
+ `completion` is called right away. If there's no upload with this
+ identifier, e.g. because its result was already passed to a completion block,
+ `completion` is called with an error.
+ */
+- (void)addCompletion:(STPFileCompletionBlock)completion
+forUploadWithIdentifier:(NSString *)identifier;
+
+/**
+ Cancels an upload. Its completion blocks are called with an
+ `NSURLErrorCancelled` error.
+ */
+- (void)cancelUploadWithIdentifier:(NSString *)identifier;
+
+/**
+ Call this from your app delegate's
+ `application:handleEventsForBackgroundURLSession:completionHandler:`.
+
+ @return YES if `identifier` is this session's, in which case `completionHandler`
+ will be called once its events have been handled; NO if it belongs to someone
+ else and you should handle it yourself.
+ */
+- (BOOL)handleEventsForBackgroundURLSession:(NSString *)identifier
+                          completionHandler:(void (^)(void))completionHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
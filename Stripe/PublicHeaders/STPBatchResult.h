@@ -0,0 +1,85 @@
+//
+//  STPBatchResult.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The outcome of one item of a batch request, such as
+ `-[STPAPIClient createTokensWithCards:maxConcurrency:progress:completion:]`.
+ Exactly one of `object` and `error` is set.
+ */
+@interface STPBatchItemResult<ObjectType> : NSObject
+
+/**
+ You cannot directly instantiate an `STPBatchItemResult`. You should only use
+ one that has been passed to an `STPBatchCompletionBlock`.
+ */
+- (instancetype)init __attribute__((unavailable("You cannot directly instantiate an STPBatchItemResult. You should only use one that has been passed to an STPBatchCompletionBlock.")));
+
+/**
+ The object created for the item, e.g. an `STPToken`, or nil if the item
+ failed.
+ */
+@property (nonatomic, nullable, readonly) ObjectType object;
+
+/**
+ The error the item failed with, or nil if it succeeded. Items that were not
+ started because the batch was cancelled fail with an error in
+ `NSURLErrorDomain` with code `NSURLErrorCancelled`.
+ */
+@property (nonatomic, nullable, readonly) NSError *error;
+
+@end
+
+/**
+ Aggregate figures for a completed batch request.
+ */
+@interface STPBatchMetrics : NSObject
+
+/**
+ You cannot directly instantiate an `STPBatchMetrics`. You should only use
+ one that has been passed to an `STPBatchCompletionBlock`.
+ */
+- (instancetype)init __attribute__((unavailable("You cannot directly instantiate an STPBatchMetrics. You should only use one that has been passed to an STPBatchCompletionBlock.")));
+
+/**
+ The number of items in the batch.
+ */
+@property (nonatomic, readonly) NSUInteger itemCount;
+
+/**
+ The number of items that failed.
+ */
+@property (nonatomic, readonly) NSUInteger failureCount;
+
+/**
+ The number of times an item was rate limited by the API (HTTP 429) and
+ requeued after backing off.
+ */
+@property (nonatomic, readonly) NSUInteger rateLimitedCount;
+
+/**
+ The highest number of items that were in flight at once.
+ */
+@property (nonatomic, readonly) NSUInteger peakConcurrency;
+
+/**
+ Time from the batch starting to its last item completing, in seconds.
+ */
+@property (nonatomic, readonly) NSTimeInterval duration;
+
+/**
+ Completed items per second.
+ */
+@property (nonatomic, readonly) double throughput;
+
+@end
+
+NS_ASSUME_NONNULL_END
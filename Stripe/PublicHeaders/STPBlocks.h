@@ -15,6 +15,8 @@
 @class STPCustomer;
 @protocol STPSourceProtocol;
 @class STPPaymentIntent;
+@class STPBatchItemResult;
+@class STPBatchMetrics;
 
 /**
  These values control the labels used in the shipping info collection form.
@@ -141,3 +143,27 @@ typedef void (^STPFileCompletionBlock)(STPFile * __nullable file, NSError * __nu
  @param error        The error returned from the response, or nil if none occurs.
  */
 typedef void (^STPCustomerCompletionBlock)(STPCustomer * __nullable customer, NSError * __nullable error);
+
+/**
+ A callback to be run with a page of a customer's payment sources.
+
+ @param sources      The sources on the page, or nil if an error occurred. @see STPSourceProtocol
+ @param error        The error returned from the response, or nil if none occurs.
+ */
+typedef void (^STPSourcesPageCompletionBlock)(NSArray<id<STPSourceProtocol>> * __nullable sources, NSError * __nullable error);
+
+/**
+ A callback to be run as the items of a batch request complete.
+
+ @param completedCount  How many items have completed, successfully or not.
+ @param totalCount      How many items are in the batch.
+ */
+typedef void (^STPBatchProgressBlock)(NSUInteger completedCount, NSUInteger totalCount);
+
+/**
+ A callback to be run when every item of a batch request has completed.
+
+ @param results  One result per item, in the order the items were given. @see STPBatchItemResult
+ @param metrics  Aggregate timings for the batch. @see STPBatchMetrics
+ */
+typedef void (^STPBatchCompletionBlock)(NSArray<STPBatchItemResult *> * __nonnull results, STPBatchMetrics * __nonnull metrics);
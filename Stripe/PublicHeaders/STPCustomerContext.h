@@ -9,6 +9,7 @@
 #import <Foundation/Foundation.h>
 
 #import "STPBackendAPIAdapter.h"
+#import "STPCustomerSourcesIterator.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -59,6 +60,16 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, assign) BOOL includeApplePaySources;
 
+/**
+ The customer object's `sources` only has the customer's newest sources, up to
+ one page of them. Use an iterator to load all of them a page at a time,
+ starting with the newest.
+
+ @param pageSize  The most sources to load at once, between 1 and 100.
+ @return a new iterator, which hasn't loaded anything yet.
+ */
+- (STPCustomerSourcesIterator *)sourcesIteratorWithPageSize:(NSUInteger)pageSize;
+
 @end
 
 NS_ASSUME_NONNULL_END
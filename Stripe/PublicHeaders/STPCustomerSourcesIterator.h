@@ -0,0 +1,63 @@
+//
+//  STPCustomerSourcesIterator.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "STPBlocks.h"
+#import "STPSourceProtocol.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Loads a customer's payment sources a page at a time, so that customers with
+ many saved sources don't have to wait for all of them. Create one with
+ `-[STPCustomerContext sourcesIteratorWithPageSize:]`.
+
+ Like its customer context, the iterator leaves out Apple Pay sources unless
+ `includeApplePaySources` is set. All of its methods must be called on the
+ main queue, and its callbacks are made there.
+ */
+@interface STPCustomerSourcesIterator : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ The most sources that are requested at once.
+ */
+@property (nonatomic, readonly) NSUInteger pageSize;
+
+/**
+ All of the sources loaded so far, newest first.
+ */
+@property (nonatomic, copy, readonly) NSArray<id<STPSourceProtocol>> *sources;
+
+/**
+ Whether there may be more sources to load. This is YES until a page comes
+ back that the API says is the last one.
+ */
+@property (nonatomic, readonly) BOOL hasMore;
+
+/**
+ Whether a page is being loaded.
+ */
+@property (nonatomic, readonly, getter=isLoading) BOOL loading;
+
+/**
+ Loads the next page of sources, and adds them to `sources`.
+
+ If a page is already being loaded, `completion` is called with that page
+ rather than starting another one. If there are no more sources, `completion`
+ is called with an empty array.
+
+ @param completion  The callback to run with the sources on the page, or with an error. Another call will retry the same page.
+ */
+- (void)loadNextPage:(nullable STPSourcesPageCompletionBlock)completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
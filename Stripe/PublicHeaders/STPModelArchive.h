@@ -0,0 +1,78 @@
+//
+//  STPModelArchive.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "STPAPIResponseDecodable.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A compact binary archive of API models, for caching them on disk.
+
+ Loading a model from an archive skips parsing JSON: each model's response
+ fields are stored in a length-prefixed binary layout, and are only read when
+ that model is asked for. An archive can be memory-mapped, so loading one model
+ from a large archive doesn't read the rest of the file. Each distinct string,
+ such as a field name, is stored and created once per archive and shared by
+ the models loaded from it.
+
+ The supported models are `STPCard`, `STPCustomer`, `STPEphemeralKey`,
+ `STPOrder`, `STPPaymentIntent`, `STPProduct`, `STPSku` and `STPSource`. Archives are
+ tied to the SDK's API version; archives written by an SDK using a different
+ one fail to load, and should be replaced by fetching the models again.
+ */
+@interface STPModelArchive : NSObject
+
+/**
+ Archives models.
+
+ @param objects  The models to archive. Models of unsupported classes are left out.
+ @return The archive's data, e.g. to write to a file.
+ */
++ (NSData *)archivedDataWithObjects:(NSArray<id<STPAPIResponseDecodable>> *)objects;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Opens an archive. Only its header is read; models are decoded by
+ `objectAtIndex:`.
+
+ @param data   Data returned by `archivedDataWithObjects:`.
+ @param error  Set if the data isn't an archive, or was written for a different API version.
+ */
+- (nullable instancetype)initWithData:(NSData *)data error:(NSError **)error;
+
+/**
+ Memory-maps an archive file, and opens it.
+
+ @param url    The URL of a file containing data returned by `archivedDataWithObjects:`.
+ @param error  Set if the file can't be read, isn't an archive, or was written for a different API version.
+ */
+- (nullable instancetype)initWithContentsOfURL:(NSURL *)url error:(NSError **)error;
+
+/**
+ The number of models in the archive.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ Decodes one model from the archive, without reading the others.
+
+ @return The model, or nil if its part of the archive is corrupt.
+ */
+- (nullable id<STPAPIResponseDecodable>)objectAtIndex:(NSUInteger)index;
+
+/**
+ Decodes every model in the archive, leaving out any that are corrupt.
+ */
+- (NSArray<id<STPAPIResponseDecodable>> *)allObjects;
+
+@end
+
+NS_ASSUME_NONNULL_END
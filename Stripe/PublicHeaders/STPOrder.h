@@ -8,6 +8,8 @@
 
 #import <Foundation/Foundation.h>
 
+#import "STPAPIResponseDecodable.h"
+
 /**
  *  The various order status.
  */
@@ -22,7 +24,7 @@ typedef NS_ENUM(NSInteger, STPOrderStatus) {
 
 @class STPCustomer, STPAddress, STPShippingMethod, STPOrderItem;
 
-@interface STPOrder : NSObject
+@interface STPOrder : NSObject <STPAPIResponseDecodable>
 
 /**
  *  The Stripe ID for the order.
@@ -11,6 +11,7 @@
 #import <PassKit/PassKit.h>
 
 #import "STPAddress.h"
+#import "STPApplePayPaymentMetrics.h"
 #import "STPBlocks.h"
 #import "STPPaymentConfiguration.h"
 #import "STPPaymentMethod.h"
@@ -95,6 +96,24 @@ NS_ASSUME_NONNULL_BEGIN
                      configuration:(STPPaymentConfiguration *)configuration
                              theme:(STPTheme *)theme;
 
+/**
+ Starts loading what a payment context needs ahead of time, so that a context
+ created soon afterwards with the same customer context doesn't have to wait
+ for the network. Call this from a screen that usually leads to checkout,
+ e.g. your cart.
+
+ This fetches an ephemeral key and the customer, and loads the images of the
+ customer's payment methods and the SDK's localized strings. The customer is
+ cached for a minute, and is used by the next payment context created with
+ this customer context; other payment contexts fetch the customer again. The
+ ephemeral key is cached for as long as it's valid.
+
+ @param customerContext The customer context you'll create the payment context with.
+ @param configuration   The configuration you'll create the payment context with.
+ */
++ (void)prefetchWithCustomerContext:(STPCustomerContext *)customerContext
+                      configuration:(STPPaymentConfiguration *)configuration;
+
 /**
  Note: Instead of providing your own backend API adapter, we recommend using
  `STPCustomerContext`, which will manage retrieving and updating a
@@ -267,6 +286,27 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong) UIView *addCardViewControllerFooterView;
 
+/**
+ If true, when the user pays with Apple Pay, the source is attached to the
+ customer while your delegate creates the charge, rather than before
+ `paymentContext:didCreatePaymentResult:completion:` is called. The Apple Pay
+ sheet is told the outcome once both have finished. The ephemeral key is also
+ refreshed when the sheet is presented, so that it doesn't need to be fetched
+ after the user authorizes the payment. The default value is false.
+
+ Only turn this on if your backend can create the charge before the source
+ has been attached to the customer, e.g. by charging the source directly.
+ The outcome of the payment is the outcome of your charge: if the charge
+ succeeds but the attach fails, the payment still succeeds, and the attach
+ error is reported in `paymentContext:didCollectApplePayMetrics:`.
+
+ This only applies to sources. If `configuration.createCardSources` is false,
+ Apple Pay creates a token, and the card in your payment result can't be
+ charged with the customer until the token has been attached, so the token is
+ still attached first.
+ */
+@property (nonatomic, assign) BOOL pipelinesApplePayAttachment;
+
 
 
 /**
@@ -409,6 +449,17 @@ didCreatePaymentResult:(STPPaymentResult *)paymentResult
 didUpdateShippingAddress:(STPAddress *)address
             completion:(STPShippingMethodsCompletionBlock)completion;
 
+/**
+ Called after an Apple Pay payment has completed, with timings for attaching
+ the source to the customer and for your charge. Use it to measure how much
+ `pipelinesApplePayAttachment` saves your users.
+
+ @param paymentContext  The context that completed the payment
+ @param metrics         The timings collected for the payment
+ */
+- (void)paymentContext:(STPPaymentContext *)paymentContext
+didCollectApplePayMetrics:(STPApplePayPaymentMetrics *)metrics;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -8,9 +8,11 @@
 
 #import <Foundation/Foundation.h>
 
+#import "STPAPIResponseDecodable.h"
+
 @class STPSku, STPPackage;
 
-@interface STPProduct : NSObject
+@interface STPProduct : NSObject <STPAPIResponseDecodable>
 
 
 /**
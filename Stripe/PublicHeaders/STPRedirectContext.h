@@ -9,6 +9,8 @@
 #import <Foundation/Foundation.h>
 #import "STPBlocks.h"
 
+@class STPAPIClient;
+
 NS_ASSUME_NONNULL_BEGIN
 
 /**
@@ -141,6 +143,30 @@ NS_EXTENSION_UNAVAILABLE("STPRedirectContext is not available in extensions")
 - (nullable instancetype)initWithPaymentIntent:(STPPaymentIntent *)paymentIntent
                                     completion:(STPRedirectContextPaymentIntentCompletionBlock)completion;
 
+/**
+ Initializer for context from an `STPPaymentIntent`, which polls the
+ PaymentIntent once the customer returns from the redirect.
+
+ This behaves like `initWithPaymentIntent:completion:`, except that when the
+ redirect completes, the context calls
+ `-[STPAPIClient startPollingPaymentIntentWithClientSecret:timeout:completion:]`
+ on `apiClient`, and `completion` is called with the PaymentIntent polling
+ ends with. If the redirect fails, `completion` is called with the error and
+ no polling takes place.
+
+ @param paymentIntent The STPPaymentIntent that needs a redirect.
+ @param apiClient The client to poll the PaymentIntent with.
+ @param timeout The timeout for polling, in seconds. Timeouts are capped at 5 minutes.
+ @param completion A block to fire with the PaymentIntent once polling stops,
+ or with an error.
+ @return nil if the provided PaymentIntent does not need a redirect. Otherwise
+ a new context object.
+ */
+- (nullable instancetype)initWithPaymentIntent:(STPPaymentIntent *)paymentIntent
+                                     apiClient:(STPAPIClient *)apiClient
+                                pollingTimeout:(NSTimeInterval)timeout
+                                    completion:(STPPaymentIntentCompletionBlock)completion;
+
 /**
  Use `initWithSource:completion:`
  */
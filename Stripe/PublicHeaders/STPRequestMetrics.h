@@ -0,0 +1,145 @@
+//
+//  STPRequestMetrics.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class STPAPIClient;
+
+/**
+ Timings collected for a single request made by `STPAPIClient`.
+
+ Network timings come from `NSURLSessionTaskMetrics` and are only available on
+ iOS 10 and later; on earlier versions they are 0. For a retried request they
+ describe the final attempt. A network phase that did not
+ happen (e.g. DNS lookup on a reused connection) is also reported as 0.
+
+ All durations are in seconds.
+ */
+@interface STPRequestMetrics : NSObject
+
+/**
+ You cannot directly instantiate an `STPRequestMetrics`. You should only use
+ one that has been passed to an `STPRequestMetricsObserver`.
+ */
+- (instancetype)init __attribute__((unavailable("You cannot directly instantiate an STPRequestMetrics. You should only use one that has been passed to an STPRequestMetricsObserver.")));
+
+/**
+ The API endpoint that was requested, with object identifiers replaced by
+ `:id`, e.g. `customers/:id/sources`.
+ */
+@property (nonatomic, readonly) NSString *endpoint;
+
+/**
+ The HTTP method of the request.
+ */
+@property (nonatomic, readonly) NSString *HTTPMethod;
+
+/**
+ The HTTP status code of the response, or 0 if no response was received.
+ */
+@property (nonatomic, readonly) NSInteger statusCode;
+
+/**
+ The error the request completed with, if any.
+ */
+@property (nonatomic, nullable, readonly) NSError *error;
+
+/**
+ How many times the request was retried before it completed.
+ @see STPAPIClient.maxRetryCount
+ */
+@property (nonatomic, readonly) NSUInteger retryCount;
+
+/**
+ Time from the request being built to its final attempt being sent,
+ i.e. time lost to failed attempts and back-off. 0 if the request was not
+ retried.
+ */
+@property (nonatomic, readonly) NSTimeInterval retryDuration;
+
+/**
+ Time spent resolving the API host name.
+ */
+@property (nonatomic, readonly) NSTimeInterval domainLookupDuration;
+
+/**
+ Time spent establishing the TCP connection, including the TLS handshake.
+ */
+@property (nonatomic, readonly) NSTimeInterval connectDuration;
+
+/**
+ Time spent on the TLS handshake.
+ */
+@property (nonatomic, readonly) NSTimeInterval secureConnectionDuration;
+
+/**
+ Time spent writing the request headers and body.
+ */
+@property (nonatomic, readonly) NSTimeInterval requestDuration;
+
+/**
+ Time from the start of the request to the first byte of the response.
+ */
+@property (nonatomic, readonly) NSTimeInterval timeToFirstByte;
+
+/**
+ Time spent receiving the response body.
+ */
+@property (nonatomic, readonly) NSTimeInterval transferDuration;
+
+/**
+ Time spent form-encoding the request parameters.
+ */
+@property (nonatomic, readonly) NSTimeInterval formEncodeDuration;
+
+/**
+ Time spent parsing the response JSON.
+ */
+@property (nonatomic, readonly) NSTimeInterval JSONParseDuration;
+
+/**
+ Time spent decoding the response into an SDK model object.
+ */
+@property (nonatomic, readonly) NSTimeInterval modelDecodeDuration;
+
+/**
+ Time between the response being ready and the completion block starting on
+ the main thread.
+ */
+@property (nonatomic, readonly) NSTimeInterval mainThreadDispatchDelay;
+
+/**
+ Time from building the request to the completion block starting on the main
+ thread.
+ */
+@property (nonatomic, readonly) NSTimeInterval totalDuration;
+
+@end
+
+/**
+ An object that is notified with the metrics of every request made by an
+ `STPAPIClient`.
+
+ @see STPAPIClient.metricsObserver
+ @see STPRequestMetricsAggregator
+ */
+@protocol STPRequestMetricsObserver <NSObject>
+
+/**
+ Called on the main queue after the completion block of a request has run.
+
+ @param apiClient The client that made the request.
+ @param metrics   The metrics collected for the request.
+ */
+- (void)apiClient:(STPAPIClient *)apiClient didCollectRequestMetrics:(STPRequestMetrics *)metrics;
+
+@end
+
+NS_ASSUME_NONNULL_END
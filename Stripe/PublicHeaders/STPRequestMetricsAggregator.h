@@ -0,0 +1,104 @@
+//
+//  STPRequestMetricsAggregator.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "STPRequestMetrics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A latency histogram over the requests recently made to one endpoint.
+ */
+@interface STPRequestMetricsHistogram : NSObject
+
+/**
+ You cannot directly instantiate an `STPRequestMetricsHistogram`. Use
+ `-[STPRequestMetricsAggregator histogramForEndpoint:]`.
+ */
+- (instancetype)init __attribute__((unavailable("Use -[STPRequestMetricsAggregator histogramForEndpoint:] instead.")));
+
+/**
+ The inclusive upper bound of each bucket, in seconds. The last bucket has an
+ upper bound of `DBL_MAX` and counts everything slower than the one before it.
+ */
+@property (nonatomic, readonly) NSArray<NSNumber *> *bucketUpperBounds;
+
+/**
+ The number of requests in each bucket.
+ */
+@property (nonatomic, readonly) NSArray<NSNumber *> *bucketCounts;
+
+/**
+ The number of requests in the histogram.
+ */
+@property (nonatomic, readonly) NSUInteger sampleCount;
+
+/**
+ The upper bound of the bucket containing the given percentile.
+
+ @param percentile A value between 0 and 1, e.g. 0.99 for p99.
+ @return The bucket upper bound in seconds, or 0 if there are no samples.
+ */
+- (NSTimeInterval)approximateDurationAtPercentile:(double)percentile;
+
+@end
+
+/**
+ An `STPRequestMetricsObserver` that keeps the metrics of the most recent
+ requests to each endpoint and builds total-duration histograms from them.
+
+ Set an aggregator as an `STPAPIClient`'s `metricsObserver`, keeping a strong
+ reference to it yourself. It is safe to read from any thread.
+ */
+@interface STPRequestMetricsAggregator : NSObject <STPRequestMetricsObserver>
+
+/**
+ Creates an aggregator that keeps the 100 most recent requests per endpoint.
+ */
+- (instancetype)init;
+
+/**
+ Creates an aggregator that keeps the `windowSize` most recent requests per
+ endpoint.
+ */
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize NS_DESIGNATED_INITIALIZER;
+
+/**
+ The number of recent requests kept per endpoint.
+ */
+@property (nonatomic, readonly) NSUInteger windowSize;
+
+/**
+ Every endpoint a request has been observed for, sorted alphabetically.
+ */
+@property (nonatomic, readonly) NSArray<NSString *> *endpoints;
+
+/**
+ The metrics of the most recent requests to an endpoint, oldest first.
+
+ @param endpoint A normalized endpoint, as reported by `STPRequestMetrics.endpoint`.
+ */
+- (NSArray<STPRequestMetrics *> *)recentMetricsForEndpoint:(NSString *)endpoint;
+
+/**
+ A histogram of the total duration of the most recent requests to an endpoint.
+
+ @param endpoint A normalized endpoint, as reported by `STPRequestMetrics.endpoint`.
+ @return The histogram, or nil if no request to the endpoint has been observed.
+ */
+- (nullable STPRequestMetricsHistogram *)histogramForEndpoint:(NSString *)endpoint;
+
+/**
+ Discards all observed metrics.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
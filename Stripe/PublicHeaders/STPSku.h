@@ -8,10 +8,12 @@
 
 #import <Foundation/Foundation.h>
 
+#import "STPAPIResponseDecodable.h"
+
 @class STPPackage, STPInventory, STPSku;
 @class STPProduct;
 
-@interface STPSku : NSObject
+@interface STPSku : NSObject <STPAPIResponseDecodable>
 
 /**
  *  The Stripe ID for the SKU.
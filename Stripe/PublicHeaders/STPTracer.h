@@ -0,0 +1,108 @@
+//
+//  STPTracer.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "STPAPIClient.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ An object that receives timing spans from inside the SDK, such as an
+ `STPTraceRecorder`.
+
+ Spans cover building requests, form encoding, the network round trip, JSON
+ parsing, model decoding, the wait for the main thread before a completion
+ block runs, image compression, source poll cycles, ephemeral key refreshes
+ and customer retrieval.
+ */
+@protocol STPTracer <NSObject>
+
+/**
+ Called when a span ends, on the thread that ended it. This can be any
+ thread, and several threads can call it at once.
+
+ @param name       What was measured, e.g. `json_parse`.
+ @param category   The part of the SDK the span belongs to, e.g. `api`.
+ @param startTime  When the span started, in seconds since the device booted, like `-[NSProcessInfo systemUptime]`.
+ @param endTime    When the span ended, on the same clock as `startTime`.
+ */
+- (void)recordSpanWithName:(NSString *)name
+                  category:(NSString *)category
+                 startTime:(NSTimeInterval)startTime
+                   endTime:(NSTimeInterval)endTime;
+
+@end
+
+/**
+ Records spans in memory, and writes them out as Chrome `trace_event` JSON,
+ which can be opened in `chrome://tracing` or https://ui.perfetto.dev.
+
+ Each span is shown on the track of the thread that ended it. Spans that
+ wait on something else, like `network`, end on a different thread than
+ they started on.
+ */
+@interface STPTraceRecorder : NSObject <STPTracer>
+
+/**
+ Creates a recorder that keeps up to 100,000 spans.
+ */
+- (instancetype)init;
+
+/**
+ Creates a recorder that keeps up to `maxSpanCount` spans. Spans ended after
+ that are dropped, so that a recorder left running doesn't grow forever.
+ */
+- (instancetype)initWithMaxSpanCount:(NSUInteger)maxSpanCount NS_DESIGNATED_INITIALIZER;
+
+/**
+ The number of spans recorded so far.
+ */
+@property (nonatomic, readonly) NSUInteger spanCount;
+
+/**
+ The recorded spans, as a Chrome trace in the JSON object format.
+ */
+- (NSData *)traceData;
+
+/**
+ Writes `traceData` to a file.
+
+ @return NO if the file couldn't be written, in which case `error` is set.
+ */
+- (BOOL)writeTraceToURL:(NSURL *)url error:(NSError **)error;
+
+/**
+ Discards the recorded spans.
+ */
+- (void)reset;
+
+@end
+
+/**
+ Stripe extensions for tracing.
+ */
+@interface Stripe (Tracing)
+
+/**
+ The tracer that receives the SDK's spans. It's retained, and shared by every
+ `STPAPIClient`.
+
+ Defaults to nil, which turns tracing off. While it's nil, no timestamps are
+ taken, and instrumentation costs a single check.
+ */
++ (nullable id<STPTracer>)tracer;
+
+/**
+ Sets the tracer. Spans that started while tracing was off aren't reported.
+ */
++ (void)setTracer:(nullable id<STPTracer>)tracer;
+
+@end
+
+NS_ASSUME_NONNULL_END
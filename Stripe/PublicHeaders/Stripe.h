@@ -12,11 +12,15 @@
 #import "STPAddress+Vero.h"
 #import "STPAPIClient+ApplePay.h"
 #import "STPAPIClient.h"
+#import "STPAPIOperation.h"
 #import "STPAPIResponseDecodable.h"
+#import "STPApplePayPaymentMetrics.h"
 #import "STPApplePayPaymentMethod.h"
+#import "STPBackgroundUploadSession.h"
 #import "STPBackendAPIAdapter.h"
 #import "STPBankAccount.h"
 #import "STPBankAccountParams.h"
+#import "STPBatchResult.h"
 #import "STPBlocks.h"
 #import "STPCard.h"
 #import "STPCardBrand.h"
@@ -36,11 +40,13 @@
 #import "STPCoreViewController.h"
 #import "STPCustomer.h"
 #import "STPCustomerContext.h"
+#import "STPCustomerSourcesIterator.h"
 #import "STPEphemeralKeyProvider.h"
 #import "STPFile.h"
 #import "STPFormEncodable.h"
 #import "STPImageLibrary.h"
 #import "STPLegalEntityParams.h"
+#import "STPModelArchive.h"
 #import "STPPaymentActivityIndicatorView.h"
 #import "STPPaymentCardTextField.h"
 #import "STPPaymentConfiguration.h"
@@ -54,6 +60,8 @@
 #import "STPPaymentMethodsViewController.h"
 #import "STPPaymentResult.h"
 #import "STPRedirectContext.h"
+#import "STPRequestMetrics.h"
+#import "STPRequestMetricsAggregator.h"
 #import "STPShippingAddressViewController.h"
 #import "STPSource.h"
 #import "STPSourceCardDetails.h"
@@ -67,6 +75,7 @@
 #import "STPSourceVerification.h"
 #import "STPTheme.h"
 #import "STPToken.h"
+#import "STPTracer.h"
 #import "STPUserInformation.h"
 #import "StripeError.h"
 #import "UINavigationBar+Stripe_Theme.h"
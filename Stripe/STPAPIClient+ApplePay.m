@@ -10,6 +10,7 @@
 #import "NSError+Stripe.h"
 #import "PKPayment+Stripe.h"
 #import "STPAPIClient+Private.h"
+#import "STPAPIOperation+Private.h"
 #import "STPAnalyticsClient.h"
 #import "STPSourceParams.h"
 #import "STPTelemetryClient.h"
@@ -17,29 +18,37 @@
 
 @implementation STPAPIClient (ApplePay)
 
-- (void)createTokenWithPayment:(PKPayment *)payment completion:(STPTokenCompletionBlock)completion {
+- (STPAPIOperation *)createTokenWithPayment:(PKPayment *)payment completion:(STPTokenCompletionBlock)completion {
     NSMutableDictionary *params = [[[self class] parametersForPayment:payment] mutableCopy];
     [[STPTelemetryClient sharedInstance] addTelemetryFieldsToParams:params];
-    [self createTokenWithParameters:params
-                         completion:completion];
+    STPAPIOperation *operation = [self createTokenWithParameters:params
+                                                      completion:completion];
     [[STPTelemetryClient sharedInstance] sendTelemetryData];
+    return operation;
 }
 
-- (void)createSourceWithPayment:(PKPayment *)payment completion:(STPSourceCompletionBlock)completion {
+- (STPAPIOperation *)createSourceWithPayment:(PKPayment *)payment completion:(STPSourceCompletionBlock)completion {
     NSCAssert(payment != nil, @"'payment' is required to create an apple pay source");
     NSCAssert(completion != nil, @"'completion' is required to use the source that is created");
-    [self createTokenWithPayment:payment completion:^(STPToken * _Nullable token, NSError * _Nullable error) {
+    // One handle for both requests: cancelling it cancels whichever is current
+    STPAPIOperation *operation = [[STPAPIOperation alloc] initGroupWithPriority:STPAPIOperationPriorityDefault];
+    operation.currentOperation = [self createTokenWithPayment:payment completion:^(STPToken * _Nullable token, NSError * _Nullable error) {
         if (token.tokenId == nil
             || error != nil) {
+            [operation markFinished];
             completion(nil, error ?: [NSError stp_genericConnectionError]);
         }
         else {
             STPSourceParams *params = [STPSourceParams new];
             params.type = STPSourceTypeCard;
             params.token = token.tokenId;
-            [self createSourceWithParams:params completion:completion];
+            operation.currentOperation = [self createSourceWithParams:params completion:^(STPSource * _Nullable source, NSError * _Nullable sourceError) {
+                [operation markFinished];
+                completion(source, sourceError);
+            }];
         }
     }];
+    return operation;
 }
 
 + (NSDictionary *)addressParamsFromPKContact:(PKContact *)billingContact {
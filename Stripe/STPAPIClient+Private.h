@@ -10,6 +10,7 @@
 
 #import "STPAPIClient.h"
 #import "STPAPIRequest.h"
+#import "STPCustomerSourcesPage.h"
 
 @class STPEphemeralKey;
 
@@ -19,15 +20,33 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (NSString *)apiVersion;
 
-- (void)createTokenWithParameters:(NSDictionary *)parameters
-                       completion:(STPTokenCompletionBlock)completion;
+- (STPAPIOperation *)createTokenWithParameters:(NSDictionary *)parameters
+                                    completion:(STPTokenCompletionBlock)completion;
 
 
 @property (nonatomic, strong, readwrite) NSURL *apiURL;
 @property (nonatomic, strong, readonly) NSURLSession *urlSession;
 
+/**
+ A request for `url` with the headers every API request is sent with. The
+ headers are only rebuilt after `publishableKey` or `stripeAccount` change.
+ */
 - (NSMutableURLRequest *)configuredRequestForURL:(NSURL *)url;
 
+/**
+ The URL of an API endpoint, e.g. `tokens`, relative to `apiURL`. The URLs of
+ resources are cached, and the rest of a path that holds object IDs, e.g.
+ `cus_123/sources` in `customers/cus_123/sources`, is appended to them.
+ */
+- (NSURL *)URLForEndpoint:(NSString *)endpoint;
+
+/**
+ A request to upload `image` to the files API, with the image encoded as JPEG
+ in a multipart body.
+ */
+- (NSMutableURLRequest *)fileUploadRequestForImage:(UIImage *)image
+                                          purpose:(STPFilePurpose)purpose;
+
 + (NSURLSessionConfiguration *)sharedUrlSessionConfiguration;
 
 @end
@@ -38,44 +57,62 @@ NS_ASSUME_NONNULL_BEGIN
                                   clientSecret:(NSString *)secret
                             responseCompletion:(void (^)(STPSource * _Nullable, NSHTTPURLResponse * _Nullable, NSError * _Nullable))completion;
 
+- (NSURLSessionDataTask *)retrievePaymentIntentWithClientSecret:(NSString *)secret
+                                             responseCompletion:(void (^)(STPPaymentIntent * _Nullable, NSHTTPURLResponse * _Nullable, NSError * _Nullable))completion;
+
 @end
 
 @interface STPAPIClient (Customers)
 
 /**
- Retrieve a customer
+ Retrieve a customer. This is a low priority request, since customers are
+ refreshed in the background.
 
  @see https://stripe.com/docs/api#retrieve_customer
  */
-+ (void)retrieveCustomerUsingKey:(STPEphemeralKey *)ephemeralKey
-                      completion:(STPCustomerCompletionBlock)completion;
++ (STPAPIOperation *)retrieveCustomerUsingKey:(STPEphemeralKey *)ephemeralKey
+                                   completion:(STPCustomerCompletionBlock)completion;
+
+/**
+ List a page of a customer's sources, newest first. Like `retrieveCustomerUsingKey:`,
+ this is a low priority request.
+
+ @param limit          How many sources to return, between 1 and 100.
+ @param startingAfter  The ID of the last source on the previous page, or nil for the first page.
+
+ @see https://stripe.com/docs/api#list_cards
+ */
++ (STPAPIOperation *)listSourcesForCustomerUsingKey:(STPEphemeralKey *)ephemeralKey
+                                              limit:(NSUInteger)limit
+                                      startingAfter:(nullable NSString *)startingAfter
+                                         completion:(STPCustomerSourcesPageCompletionBlock)completion;
 
 /**
  Add a source to a customer
 
  @see https://stripe.com/docs/api#create_card
  */
-+ (void)addSource:(NSString *)sourceID
-toCustomerUsingKey:(STPEphemeralKey *)ephemeralKey
-       completion:(STPSourceProtocolCompletionBlock)completion;
++ (STPAPIOperation *)addSource:(NSString *)sourceID
+             toCustomerUsingKey:(STPEphemeralKey *)ephemeralKey
+                     completion:(STPSourceProtocolCompletionBlock)completion;
 
 /**
  Update a customer with parameters
 
  @see https://stripe.com/docs/api#update_customer
  */
-+ (void)updateCustomerWithParameters:(NSDictionary *)parameters
-                            usingKey:(STPEphemeralKey *)ephemeralKey
-                          completion:(STPCustomerCompletionBlock)completion;
++ (STPAPIOperation *)updateCustomerWithParameters:(NSDictionary *)parameters
+                                         usingKey:(STPEphemeralKey *)ephemeralKey
+                                       completion:(STPCustomerCompletionBlock)completion;
 
 /**
  Delete a source from a customer
 
  @see https://stripe.com/docs/api#delete_card
  */
-+ (void)deleteSource:(NSString *)sourceID
-fromCustomerUsingKey:(STPEphemeralKey *)ephemeralKey
-          completion:(STPErrorBlock)completion;
++ (STPAPIOperation *)deleteSource:(NSString *)sourceID
+              fromCustomerUsingKey:(STPEphemeralKey *)ephemeralKey
+                        completion:(STPErrorBlock)completion;
 
 @end
 
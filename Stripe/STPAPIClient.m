@@ -17,24 +17,32 @@
 #import "NSError+Stripe.h"
 #import "NSMutableURLRequest+Stripe.h"
 #import "STPAnalyticsClient.h"
+#import "STPAPIOperation+Private.h"
 #import "STPAPIRequest.h"
 #import "STPBankAccount.h"
+#import "STPBatchRequestRunner.h"
 #import "STPCard.h"
+#import "STPCustomerSourcesPage.h"
 #import "STPDispatchFunctions.h"
 #import "STPEphemeralKey.h"
 #import "STPFormEncoder.h"
 #import "STPGenericStripeObject.h"
+#import "STPLocalizationUtils.h"
 #import "STPMultipartFormDataEncoder.h"
 #import "STPMultipartFormDataPart.h"
 #import "STPPaymentConfiguration.h"
 #import "STPPaymentIntent+Private.h"
 #import "STPPaymentIntentParams.h"
+#import "STPPaymentIntentPoller.h"
+#import "STPRequestMetrics.h"
 #import "STPSource+Private.h"
 #import "STPSourceParams.h"
 #import "STPSourceParams+Private.h"
 #import "STPSourcePoller.h"
 #import "STPTelemetryClient.h"
 #import "STPToken.h"
+#import "STPURLSessionDelegate.h"
+#import "STPUploadPreprocessingQueue.h"
 #import "UIImage+Stripe.h"
 
 #if __has_include("Fabric.h")
@@ -53,6 +61,10 @@ static NSString * const APIEndpointSources = @"sources";
 static NSString * const APIEndpointCustomers = @"customers";
 static NSString * const FileUploadURL = @"https://uploads.stripe.com/v1/files";
 static NSString * const APIEndpointPaymentIntents = @"payment_intents";
+static const NSUInteger DefaultMaxRetryCount = 2;
+static const NSTimeInterval DefaultRetryTimeBudget = 10;
+// Only resources are cached, e.g. `customers`, and there are far fewer of them
+static const NSUInteger EndpointURLCacheCountLimit = 64;
 
 #pragma mark - Stripe
 
@@ -60,6 +72,8 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
 
 + (void)setDefaultPublishableKey:(NSString *)publishableKey {
     [STPPaymentConfiguration sharedConfiguration].publishableKey = publishableKey;
+    // Apps set this at launch, well before they show any of our UI
+    [STPLocalizationUtils prewarmLocalizedStrings];
 }
 
 + (NSString *)defaultPublishableKey {
@@ -101,9 +115,11 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
 @interface STPAPIClient()
 #endif
 
-@property (nonatomic, strong, readwrite) NSMutableDictionary<NSString *,NSObject *> *sourcePollers;
-@property (nonatomic, strong, readwrite) dispatch_queue_t sourcePollersQueue;
+@property (nonatomic, strong, readwrite) NSMutableDictionary<NSString *,NSObject *> *pollers;
+@property (nonatomic, strong, readwrite) dispatch_queue_t pollersQueue;
 @property (nonatomic, strong, readwrite) NSString *apiKey;
+@property (nonatomic, copy, nullable) NSDictionary<NSString *, NSString *> *cachedDefaultHeaders;
+@property (nonatomic, strong, readwrite) NSCache<NSString *, NSURL *> *endpointURLCache;
 
 // See STPAPIClient+Private.h
 
@@ -151,13 +167,24 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
         _apiURL = [NSURL URLWithString:APIBaseURL];
         _configuration = configuration;
         _stripeAccount = configuration.stripeAccount;
-        _sourcePollers = [NSMutableDictionary dictionary];
-        _sourcePollersQueue = dispatch_queue_create("com.stripe.sourcepollers", DISPATCH_QUEUE_SERIAL);
-        _urlSession = [NSURLSession sessionWithConfiguration:[self.class sharedUrlSessionConfiguration]];
+        _pollers = [NSMutableDictionary dictionary];
+        _pollersQueue = dispatch_queue_create("com.stripe.pollers", DISPATCH_QUEUE_SERIAL);
+        _endpointURLCache = [NSCache new];
+        _endpointURLCache.countLimit = EndpointURLCacheCountLimit;
+        _maxRetryCount = DefaultMaxRetryCount;
+        _retryTimeBudget = DefaultRetryTimeBudget;
+        _urlSession = [NSURLSession sessionWithConfiguration:[self.class sharedUrlSessionConfiguration]
+                                                    delegate:[STPURLSessionDelegate new]
+                                               delegateQueue:nil];
     }
     return self;
 }
 
+- (void)dealloc {
+    // The session retains its delegate until it is invalidated
+    [_urlSession finishTasksAndInvalidate];
+}
+
 + (NSURLSessionConfiguration *)sharedUrlSessionConfiguration {
     static NSURLSessionConfiguration  *STPSharedURLSessionConfiguration;
     static dispatch_once_t configToken;
@@ -169,19 +196,58 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
 
 - (NSMutableURLRequest *)configuredRequestForURL:(NSURL *)url {
     NSMutableURLRequest *request = [[NSMutableURLRequest alloc] initWithURL:url];
-    [[self defaultHeaders] enumerateKeysAndObjectsUsingBlock:^(NSString *  _Nonnull key, NSString *  _Nonnull obj, __unused BOOL * _Nonnull stop) {
-        [request setValue:obj forHTTPHeaderField:key];
-    }];
+    request.allHTTPHeaderFields = [self defaultHeaders];
     return request;
 }
 
+- (NSURL *)URLForEndpoint:(NSString *)endpoint {
+    // Paths below a resource, e.g. `customers/cus_123/sources`, hold object
+    // IDs, so caching them would push the resources themselves out
+    NSRange separatorRange = [endpoint rangeOfString:@"/"];
+    if (separatorRange.location != NSNotFound) {
+        NSURL *resourceURL = [self URLForEndpoint:[endpoint substringToIndex:separatorRange.location]];
+        return [resourceURL URLByAppendingPathComponent:[endpoint substringFromIndex:NSMaxRange(separatorRange)]];
+    }
+    NSURL *url = [self.endpointURLCache objectForKey:endpoint];
+    if (!url) {
+        url = [self.apiURL URLByAppendingPathComponent:endpoint];
+        [self.endpointURLCache setObject:url forKey:endpoint];
+    }
+    return url;
+}
+
 - (NSDictionary<NSString *, NSString *> *)defaultHeaders {
-    NSMutableDictionary *additionalHeaders = [NSMutableDictionary new];
-    additionalHeaders[@"X-Stripe-User-Agent"] = [self.class stripeUserAgentDetails];
-    additionalHeaders[@"Stripe-Version"] = APIVersion;
-    additionalHeaders[@"Authorization"] = [@"Bearer " stringByAppendingString:self.apiKey ?: @""];
-    additionalHeaders[@"Stripe-Account"] = self.stripeAccount;
-    return [additionalHeaders copy];
+    // Built once, and again only after apiKey or stripeAccount change
+    @synchronized (self) {
+        if (!self.cachedDefaultHeaders) {
+            NSMutableDictionary *additionalHeaders = [NSMutableDictionary new];
+            additionalHeaders[@"X-Stripe-User-Agent"] = [self.class stripeUserAgentDetails];
+            additionalHeaders[@"Stripe-Version"] = APIVersion;
+            additionalHeaders[@"Authorization"] = [@"Bearer " stringByAppendingString:self.apiKey ?: @""];
+            additionalHeaders[@"Stripe-Account"] = self.stripeAccount;
+            self.cachedDefaultHeaders = additionalHeaders;
+        }
+        return self.cachedDefaultHeaders;
+    }
+}
+
+- (void)setApiKey:(NSString *)apiKey {
+    @synchronized (self) {
+        _apiKey = apiKey;
+        self.cachedDefaultHeaders = nil;
+    }
+}
+
+- (void)setStripeAccount:(NSString *)stripeAccount {
+    @synchronized (self) {
+        _stripeAccount = [stripeAccount copy];
+        self.cachedDefaultHeaders = nil;
+    }
+}
+
+- (void)setApiURL:(NSURL *)apiURL {
+    _apiURL = apiURL;
+    [self.endpointURLCache removeAllObjects];
 }
 
 - (void)setPublishableKey:(NSString *)publishableKey {
@@ -193,20 +259,22 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
     return self.configuration.publishableKey;
 }
 
-- (void)createTokenWithParameters:(NSDictionary *)parameters
-                       completion:(STPTokenCompletionBlock)completion {
+- (STPAPIOperation *)createTokenWithParameters:(NSDictionary *)parameters
+                                    completion:(STPTokenCompletionBlock)completion {
     NSCAssert(parameters != nil, @"'parameters' is required to create a token");
     NSCAssert(completion != nil, @"'completion' is required to use the token that is created");
     NSString *tokenType = [STPAnalyticsClient tokenTypeFromParameters:parameters];
     [[STPAnalyticsClient sharedClient] logTokenCreationAttemptWithConfiguration:self.configuration
                                                                       tokenType:tokenType];
-    [STPAPIRequest<STPToken *> postWithAPIClient:self
-                                        endpoint:APIEndpointToken
-                                      parameters:parameters
-                                    deserializer:[STPToken new]
-                                      completion:^(STPToken *object, __unused NSHTTPURLResponse *response, NSError *error) {
-                                          completion(object, error);
-                                      }];
+    return [STPAPIRequest<STPToken *> enqueueWithPriority:STPAPIOperationPriorityDefault request:^NSURLSessionTask *(STPAPIResponseBlock requestCompletion) {
+        return [STPAPIRequest<STPToken *> postWithAPIClient:self
+                                                   endpoint:APIEndpointToken
+                                                 parameters:parameters
+                                               deserializer:[STPToken new]
+                                                 completion:requestCompletion];
+    } completion:^(STPToken *object, __unused NSHTTPURLResponse *response, NSError *error) {
+        completion(object, error);
+    }];
 }
 
 #pragma mark Helpers
@@ -232,30 +300,42 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
 #pragma clang diagnostic pop
 
 + (NSString *)stripeUserAgentDetails {
-    NSMutableDictionary *details = [@{
-        @"lang": @"objective-c",
-        @"bindings_version": STPSDKVersion,
-    } mutableCopy];
-    NSString *version = [UIDevice currentDevice].systemVersion;
-    if (version) {
-        details[@"os_version"] = version;
-    }
-    struct utsname systemInfo;
-    uname(&systemInfo);
-    NSString *deviceType = @(systemInfo.machine);
-    if (deviceType) {
-        details[@"type"] = deviceType;
-    }
-    NSString *model = [UIDevice currentDevice].localizedModel;
-    if (model) {
-        details[@"model"] = model;
-    }
+    static NSString *cachedDetails;
+    @synchronized (self) {
+        if (cachedDetails) {
+            return cachedDetails;
+        }
+        NSMutableDictionary *details = [@{
+            @"lang": @"objective-c",
+            @"bindings_version": STPSDKVersion,
+        } mutableCopy];
+        NSString *version = [UIDevice currentDevice].systemVersion;
+        if (version) {
+            details[@"os_version"] = version;
+        }
+        struct utsname systemInfo;
+        uname(&systemInfo);
+        NSString *deviceType = @(systemInfo.machine);
+        if (deviceType) {
+            details[@"type"] = deviceType;
+        }
+        NSString *model = [UIDevice currentDevice].localizedModel;
+        if (model) {
+            details[@"model"] = model;
+        }
 
-    NSString *vendorIdentifier = [UIDevice currentDevice].identifierForVendor.UUIDString;
-    if (vendorIdentifier) {
-        details[@"vendor_identifier"] = vendorIdentifier;
+        NSString *vendorIdentifier = [UIDevice currentDevice].identifierForVendor.UUIDString;
+        if (vendorIdentifier) {
+            details[@"vendor_identifier"] = vendorIdentifier;
+        }
+        NSString *detailsString = [[NSString alloc] initWithData:[NSJSONSerialization dataWithJSONObject:[details copy] options:(NSJSONWritingOptions)kNilOptions error:NULL] encoding:NSUTF8StringEncoding];
+        // None of this changes while the app is running, except that the
+        // vendor identifier isn't available until the device is first unlocked
+        if (vendorIdentifier) {
+            cachedDetails = detailsString;
+        }
+        return detailsString;
     }
-    return [[NSString alloc] initWithData:[NSJSONSerialization dataWithJSONObject:[details copy] options:(NSJSONWritingOptions)kNilOptions error:NULL] encoding:NSUTF8StringEncoding];
 }
 
 #pragma mark Fabric
@@ -295,12 +375,13 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
 
 @implementation STPAPIClient (BankAccounts)
 
-- (void)createTokenWithBankAccount:(STPBankAccountParams *)bankAccount
-                        completion:(STPTokenCompletionBlock)completion {
+- (STPAPIOperation *)createTokenWithBankAccount:(STPBankAccountParams *)bankAccount
+                                     completion:(STPTokenCompletionBlock)completion {
     NSMutableDictionary *params = [[STPFormEncoder dictionaryForObject:bankAccount] mutableCopy];
     [[STPTelemetryClient sharedInstance] addTelemetryFieldsToParams:params];
-    [self createTokenWithParameters:params completion:completion];
+    STPAPIOperation *operation = [self createTokenWithParameters:params completion:completion];
     [[STPTelemetryClient sharedInstance] sendTelemetryData];
+    return operation;
 }
 
 @end
@@ -309,11 +390,12 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
 
 @implementation STPAPIClient (PII)
 
-- (void)createTokenWithPersonalIDNumber:(NSString *)pii completion:(__nullable STPTokenCompletionBlock)completion {
+- (STPAPIOperation *)createTokenWithPersonalIDNumber:(NSString *)pii completion:(__nullable STPTokenCompletionBlock)completion {
     NSMutableDictionary *params = [@{@"pii": @{ @"personal_id_number": pii }} mutableCopy];
     [[STPTelemetryClient sharedInstance] addTelemetryFieldsToParams:params];
-    [self createTokenWithParameters:params completion:completion];
+    STPAPIOperation *operation = [self createTokenWithParameters:params completion:completion];
     [[STPTelemetryClient sharedInstance] sendTelemetryData];
+    return operation;
 }
 
 @end
@@ -322,11 +404,12 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
 
 @implementation STPAPIClient (ConnectAccounts)
 
-- (void)createTokenWithConnectAccount:(STPConnectAccountParams *)account completion:(__nullable STPTokenCompletionBlock)completion {
+- (STPAPIOperation *)createTokenWithConnectAccount:(STPConnectAccountParams *)account completion:(__nullable STPTokenCompletionBlock)completion {
     NSMutableDictionary *params = [[STPFormEncoder dictionaryForObject:account] mutableCopy];
     [[STPTelemetryClient sharedInstance] addTelemetryFieldsToParams:params];
-    [self createTokenWithParameters:params completion:completion];
+    STPAPIOperation *operation = [self createTokenWithParameters:params completion:completion];
     [[STPTelemetryClient sharedInstance] sendTelemetryData];
+    return operation;
 }
 
 @end
@@ -353,10 +436,8 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
     return [image stp_jpegDataWithMaxFileSize:maxBytes];
 }
 
-- (void)uploadImage:(UIImage *)image
-            purpose:(STPFilePurpose)purpose
-         completion:(nullable STPFileCompletionBlock)completion {
-
+- (NSMutableURLRequest *)fileUploadRequestForImage:(UIImage *)image
+                                          purpose:(STPFilePurpose)purpose {
     STPMultipartFormDataPart *purposePart = [[STPMultipartFormDataPart alloc] init];
     purposePart.name = @"purpose";
     purposePart.data = [[STPFile stringFromPurpose:purpose] dataUsingEncoding:NSUTF8StringEncoding];
@@ -375,28 +456,62 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
     NSMutableURLRequest *request = [self configuredRequestForURL:[NSURL URLWithString:FileUploadURL]];
     [request setHTTPMethod:@"POST"];
     [request stp_setMultipartFormData:data boundary:boundary];
+    return request;
+}
 
-    [[_urlSession dataTaskWithRequest:request completionHandler:^(NSData * _Nullable body, NSURLResponse * _Nullable response, NSError * _Nullable error) {
-        NSDictionary *jsonDictionary = body ? [NSJSONSerialization JSONObjectWithData:body options:(NSJSONReadingOptions)kNilOptions error:NULL] : nil;
-        STPFile *file = [STPFile decodedObjectFromAPIResponse:jsonDictionary];
+- (STPAPIOperation *)uploadImage:(UIImage *)image
+                         purpose:(STPFilePurpose)purpose
+                      completion:(nullable STPFileCompletionBlock)completion {
 
-        NSError *returnedError = [NSError stp_errorFromStripeResponse:jsonDictionary] ?: error;
-        if ((!file || ![response isKindOfClass:[NSHTTPURLResponse class]]) && !returnedError) {
-            returnedError = [NSError stp_genericFailedToParseResponseError];
-        }
-
-        if (!completion) {
+    // One handle for encoding the image and uploading it
+    STPAPIOperation *operation = [[STPAPIOperation alloc] initGroupWithPriority:STPAPIOperationPriorityDefault];
+    operation.currentOperation = [[STPUploadPreprocessingQueue sharedQueue] addJobWithCost:[STPUploadPreprocessingQueue estimatedCostOfEncodingImage:image] block:^id{
+        return [self fileUploadRequestForImage:image purpose:purpose];
+    } completion:^(NSMutableURLRequest *request, NSError *error) {
+        if (error) {
+            [operation markFinished];
+            if (completion) {
+                completion(nil, error);
+            }
             return;
         }
+        operation.currentOperation = [self uploadFileWithRequest:request completion:^(STPFile *file, NSError *uploadError) {
+            [operation markFinished];
+            if (completion) {
+                completion(file, uploadError);
+            }
+        }];
+    }];
+    return operation;
+}
 
-        stpDispatchToMainThreadIfNecessary(^{
-            if (returnedError) {
-                completion(nil, returnedError);
-            } else {
-                completion(file, nil);
+- (STPAPIOperation *)uploadFileWithRequest:(NSURLRequest *)request
+                                completion:(STPFileCompletionBlock)completion {
+    // Not queued: an upload would hold one of the queue's few slots for as
+    // long as the transfer takes
+    return [STPAPIRequest<STPFile *> startWithPriority:STPAPIOperationPriorityDefault request:^NSURLSessionTask *(STPAPIResponseBlock requestCompletion) {
+        NSURLSessionDataTask *task = [self->_urlSession dataTaskWithRequest:request completionHandler:^(NSData * _Nullable body, NSURLResponse * _Nullable response, NSError * _Nullable error) {
+            NSDictionary *jsonDictionary = body ? [NSJSONSerialization JSONObjectWithData:body options:(NSJSONReadingOptions)kNilOptions error:NULL] : nil;
+            STPFile *file = [STPFile decodedObjectFromAPIResponse:jsonDictionary];
+
+            NSError *returnedError = [NSError stp_errorFromStripeResponse:jsonDictionary] ?: error;
+            if ((!file || ![response isKindOfClass:[NSHTTPURLResponse class]]) && !returnedError) {
+                returnedError = [NSError stp_genericFailedToParseResponseError];
             }
-        });
-    }] resume];
+
+            stpDispatchToMainThreadIfNecessary(^{
+                if (returnedError) {
+                    requestCompletion(nil, nil, returnedError);
+                } else {
+                    requestCompletion(file, (NSHTTPURLResponse *)response, nil);
+                }
+            });
+        }];
+        [task resume];
+        return task;
+    } completion:^(STPFile *file, __unused NSHTTPURLResponse *response, NSError *error) {
+        completion(file, error);
+    }];
 }
 
 @end
@@ -405,11 +520,12 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
 
 @implementation STPAPIClient (CreditCards)
 
-- (void)createTokenWithCard:(STPCardParams *)cardParams completion:(STPTokenCompletionBlock)completion {
+- (STPAPIOperation *)createTokenWithCard:(STPCardParams *)cardParams completion:(STPTokenCompletionBlock)completion {
     NSMutableDictionary *params = [[STPFormEncoder dictionaryForObject:cardParams] mutableCopy];
     [[STPTelemetryClient sharedInstance] addTelemetryFieldsToParams:params];
-    [self createTokenWithParameters:params completion:completion];
+    STPAPIOperation *operation = [self createTokenWithParameters:params completion:completion];
     [[STPTelemetryClient sharedInstance] sendTelemetryData];
+    return operation;
 }
 
 @end
@@ -465,7 +581,7 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
 
 @implementation STPAPIClient (Sources)
 
-- (void)createSourceWithParams:(STPSourceParams *)sourceParams completion:(STPSourceCompletionBlock)completion {
+- (STPAPIOperation *)createSourceWithParams:(STPSourceParams *)sourceParams completion:(STPSourceCompletionBlock)completion {
     NSCAssert(sourceParams != nil, @"'params' is required to create a source");
     NSCAssert(completion != nil, @"'completion' is required to use the source that is created");
     NSString *sourceType = [STPSource stringFromType:sourceParams.type];
@@ -474,21 +590,26 @@ static NSString * const APIEndpointPaymentIntents = @"payment_intents";
     sourceParams.redirectMerchantName = self.configuration.companyName ?: [NSBundle stp_applicationName];
     NSMutableDictionary *params = [[STPFormEncoder dictionaryForObject:sourceParams] mutableCopy];
     [[STPTelemetryClient sharedInstance] addTelemetryFieldsToParams:params];
-    [STPAPIRequest<STPSource *> postWithAPIClient:self
-                                         endpoint:APIEndpointSources
-                                       parameters:params
-                                     deserializer:[STPSource new]
-                                       completion:^(STPSource *object, __unused NSHTTPURLResponse *response, NSError *error) {
-                                           completion(object, error);
-                                       }];
+    STPAPIOperation *operation = [STPAPIRequest<STPSource *> enqueueWithPriority:STPAPIOperationPriorityDefault request:^NSURLSessionTask *(STPAPIResponseBlock requestCompletion) {
+        return [STPAPIRequest<STPSource *> postWithAPIClient:self
+                                                    endpoint:APIEndpointSources
+                                                  parameters:params
+                                                deserializer:[STPSource new]
+                                                  completion:requestCompletion];
+    } completion:^(STPSource *object, __unused NSHTTPURLResponse *response, NSError *error) {
+        completion(object, error);
+    }];
     [[STPTelemetryClient sharedInstance] sendTelemetryData];
+    return operation;
 }
 
-- (void)retrieveSourceWithId:(NSString *)identifier clientSecret:(NSString *)secret completion:(STPSourceCompletionBlock)completion {
+- (STPAPIOperation *)retrieveSourceWithId:(NSString *)identifier clientSecret:(NSString *)secret completion:(STPSourceCompletionBlock)completion {
     NSCAssert(identifier != nil, @"'identifier' is required to retrieve a source");
     NSCAssert(secret != nil, @"'secret' is required to retrieve a source");
     NSCAssert(completion != nil, @"'completion' is required to use the source that is retrieved");
-    [self retrieveSourceWithId:identifier clientSecret:secret responseCompletion:^(STPSource * object, __unused NSHTTPURLResponse *response, NSError *error) {
+    return [STPAPIRequest<STPSource *> enqueueWithPriority:STPAPIOperationPriorityDefault request:^NSURLSessionTask *(STPAPIResponseBlock requestCompletion) {
+        return [self retrieveSourceWithId:identifier clientSecret:secret responseCompletion:requestCompletion];
+    } completion:^(STPSource *object, __unused NSHTTPURLResponse *response, NSError *error) {
         completion(object, error);
     }];
 }
@@ -512,23 +633,82 @@ responseCompletion:(void (^)(STPSource * _Nullable, NSHTTPURLResponse * _Nullabl
                                                                 sourceID:identifier
                                                                  timeout:timeout
                                                               completion:completion];
-    dispatch_async(self.sourcePollersQueue, ^{
-        self.sourcePollers[identifier] = poller;
+    dispatch_async(self.pollersQueue, ^{
+        self.pollers[identifier] = poller;
     });
 }
 
 - (void)stopPollingSourceWithId:(NSString *)identifier {
-    dispatch_async(self.sourcePollersQueue, ^{
-        STPSourcePoller *poller = (STPSourcePoller *)self.sourcePollers[identifier];
+    dispatch_async(self.pollersQueue, ^{
+        STPSourcePoller *poller = (STPSourcePoller *)self.pollers[identifier];
         if (poller) {
             [poller stopPolling];
-            self.sourcePollers[identifier] = nil;
+            self.pollers[identifier] = nil;
         }
     });
 }
 
 @end
 
+#pragma mark - Batches
+
+@implementation STPAPIClient (Batches)
+
+- (STPAPIOperation *)createTokensWithCards:(NSArray<STPCardParams *> *)cards
+                            maxConcurrency:(NSUInteger)maxConcurrency
+                                  progress:(STPBatchProgressBlock)progress
+                                completion:(STPBatchCompletionBlock)completion {
+    NSCAssert(completion != nil, @"'completion' is required to use the tokens that are created");
+    NSArray<STPCardParams *> *items = [cards copy];
+    return [self runBatchWithItemCount:items.count maxConcurrency:maxConcurrency request:^STPAPIOperation *(NSUInteger index, STPBatchItemCompletionBlock itemCompletion) {
+        return [self createTokenWithCard:items[index] completion:^(STPToken *token, NSError *error) {
+            itemCompletion(token, error);
+        }];
+    } progress:progress completion:completion];
+}
+
+- (STPAPIOperation *)createTokensWithBankAccounts:(NSArray<STPBankAccountParams *> *)bankAccounts
+                                   maxConcurrency:(NSUInteger)maxConcurrency
+                                         progress:(STPBatchProgressBlock)progress
+                                       completion:(STPBatchCompletionBlock)completion {
+    NSCAssert(completion != nil, @"'completion' is required to use the tokens that are created");
+    NSArray<STPBankAccountParams *> *items = [bankAccounts copy];
+    return [self runBatchWithItemCount:items.count maxConcurrency:maxConcurrency request:^STPAPIOperation *(NSUInteger index, STPBatchItemCompletionBlock itemCompletion) {
+        return [self createTokenWithBankAccount:items[index] completion:^(STPToken *token, NSError *error) {
+            itemCompletion(token, error);
+        }];
+    } progress:progress completion:completion];
+}
+
+- (STPAPIOperation *)createSourcesWithParams:(NSArray<STPSourceParams *> *)params
+                              maxConcurrency:(NSUInteger)maxConcurrency
+                                    progress:(STPBatchProgressBlock)progress
+                                  completion:(STPBatchCompletionBlock)completion {
+    NSCAssert(completion != nil, @"'completion' is required to use the sources that are created");
+    NSArray<STPSourceParams *> *items = [params copy];
+    return [self runBatchWithItemCount:items.count maxConcurrency:maxConcurrency request:^STPAPIOperation *(NSUInteger index, STPBatchItemCompletionBlock itemCompletion) {
+        return [self createSourceWithParams:items[index] completion:^(STPSource *source, NSError *error) {
+            itemCompletion(source, error);
+        }];
+    } progress:progress completion:completion];
+}
+
+- (STPAPIOperation *)runBatchWithItemCount:(NSUInteger)itemCount
+                            maxConcurrency:(NSUInteger)maxConcurrency
+                                   request:(STPBatchRequestBlock)request
+                                  progress:(STPBatchProgressBlock)progress
+                                completion:(STPBatchCompletionBlock)completion {
+    STPBatchRequestRunner *runner = [[STPBatchRequestRunner alloc] initWithItemCount:itemCount
+                                                                      maxConcurrency:maxConcurrency
+                                                                             request:request
+                                                                            progress:progress
+                                                                          completion:completion];
+    [runner start];
+    return runner.operation;
+}
+
+@end
+
 #pragma mark - Customers
 
 @implementation STPAPIClient (Customers)
@@ -536,59 +716,93 @@ responseCompletion:(void (^)(STPSource * _Nullable, NSHTTPURLResponse * _Nullabl
 + (STPAPIClient *)apiClientWithEphemeralKey:(STPEphemeralKey *)key {
     STPAPIClient *client = [[self alloc] init];
     client.apiKey = key.secret;
+    STPAPIClient *sharedClient = [self sharedClient];
+    client.metricsObserver = sharedClient.metricsObserver;
+    client.maxRetryCount = sharedClient.maxRetryCount;
+    client.retryTimeBudget = sharedClient.retryTimeBudget;
     return client;
 }
 
-+ (void)retrieveCustomerUsingKey:(STPEphemeralKey *)ephemeralKey completion:(STPCustomerCompletionBlock)completion {
++ (STPAPIOperation *)retrieveCustomerUsingKey:(STPEphemeralKey *)ephemeralKey completion:(STPCustomerCompletionBlock)completion {
     STPAPIClient *client = [self apiClientWithEphemeralKey:ephemeralKey];
     NSString *endpoint = [NSString stringWithFormat:@"%@/%@", APIEndpointCustomers, ephemeralKey.customerID];
-    [STPAPIRequest<STPCustomer *> getWithAPIClient:client
-                                          endpoint:endpoint
-                                        parameters:nil
-                                      deserializer:[STPCustomer new]
-                                        completion:^(STPCustomer *object, __unused NSHTTPURLResponse *response, NSError *error) {
-                                            completion(object, error);
-                                        }];
-}
-
-+ (void)updateCustomerWithParameters:(NSDictionary *)parameters
-                            usingKey:(STPEphemeralKey *)ephemeralKey
-                          completion:(STPCustomerCompletionBlock)completion {
+    // Customer refreshes happen in the background, so let payment requests go first
+    return [STPAPIRequest<STPCustomer *> enqueueWithPriority:STPAPIOperationPriorityLow request:^NSURLSessionTask *(STPAPIResponseBlock requestCompletion) {
+        return [STPAPIRequest<STPCustomer *> getWithAPIClient:client
+                                                     endpoint:endpoint
+                                                   parameters:nil
+                                                 deserializer:[STPCustomer new]
+                                                   completion:requestCompletion];
+    } completion:^(STPCustomer *object, __unused NSHTTPURLResponse *response, NSError *error) {
+        completion(object, error);
+    }];
+}
+
++ (STPAPIOperation *)listSourcesForCustomerUsingKey:(STPEphemeralKey *)ephemeralKey
+                                              limit:(NSUInteger)limit
+                                      startingAfter:(NSString *)startingAfter
+                                         completion:(STPCustomerSourcesPageCompletionBlock)completion {
+    STPAPIClient *client = [self apiClientWithEphemeralKey:ephemeralKey];
+    NSString *endpoint = [NSString stringWithFormat:@"%@/%@/%@", APIEndpointCustomers, ephemeralKey.customerID, APIEndpointSources];
+    NSMutableDictionary *parameters = [NSMutableDictionary dictionary];
+    parameters[@"limit"] = @(limit);
+    parameters[@"starting_after"] = startingAfter;
+    // Later pages are loaded while the first one is shown, so let payment requests go first
+    return [STPAPIRequest<STPCustomerSourcesPage *> enqueueWithPriority:STPAPIOperationPriorityLow request:^NSURLSessionTask *(STPAPIResponseBlock requestCompletion) {
+        return [STPAPIRequest<STPCustomerSourcesPage *> getWithAPIClient:client
+                                                                endpoint:endpoint
+                                                              parameters:[parameters copy]
+                                                            deserializer:[STPCustomerSourcesPage new]
+                                                              completion:requestCompletion];
+    } completion:^(STPCustomerSourcesPage *object, __unused NSHTTPURLResponse *response, NSError *error) {
+        completion(object, error);
+    }];
+}
+
++ (STPAPIOperation *)updateCustomerWithParameters:(NSDictionary *)parameters
+                                         usingKey:(STPEphemeralKey *)ephemeralKey
+                                       completion:(STPCustomerCompletionBlock)completion {
     STPAPIClient *client = [self apiClientWithEphemeralKey:ephemeralKey];
     NSString *endpoint = [NSString stringWithFormat:@"%@/%@", APIEndpointCustomers, ephemeralKey.customerID];
-    [STPAPIRequest<STPCustomer *> postWithAPIClient:client
-                                           endpoint:endpoint
-                                         parameters:parameters
-                                       deserializer:[STPCustomer new]
-                                         completion:^(STPCustomer *object, __unused NSHTTPURLResponse *response, NSError *error) {
-                                             completion(object, error);
-                                         }];
-}
-
-+ (void)addSource:(NSString *)sourceID
-toCustomerUsingKey:(STPEphemeralKey *)ephemeralKey
-       completion:(STPSourceProtocolCompletionBlock)completion {
+    return [STPAPIRequest<STPCustomer *> enqueueWithPriority:STPAPIOperationPriorityDefault request:^NSURLSessionTask *(STPAPIResponseBlock requestCompletion) {
+        return [STPAPIRequest<STPCustomer *> postWithAPIClient:client
+                                                      endpoint:endpoint
+                                                    parameters:parameters
+                                                  deserializer:[STPCustomer new]
+                                                    completion:requestCompletion];
+    } completion:^(STPCustomer *object, __unused NSHTTPURLResponse *response, NSError *error) {
+        completion(object, error);
+    }];
+}
+
++ (STPAPIOperation *)addSource:(NSString *)sourceID
+             toCustomerUsingKey:(STPEphemeralKey *)ephemeralKey
+                     completion:(STPSourceProtocolCompletionBlock)completion {
     STPAPIClient *client = [self apiClientWithEphemeralKey:ephemeralKey];
     NSString *endpoint = [NSString stringWithFormat:@"%@/%@/%@", APIEndpointCustomers, ephemeralKey.customerID, APIEndpointSources];
-    [STPAPIRequest<STPSourceProtocol> postWithAPIClient:client
-                                               endpoint:endpoint
-                                             parameters:@{@"source": sourceID}
-                                          deserializers:@[[STPCard new], [STPSource new]]
-                                             completion:^(id object, __unused NSHTTPURLResponse *response, NSError *error) {
-                                                 completion(object, error);
-                                             }];
+    return [STPAPIRequest<STPSourceProtocol> enqueueWithPriority:STPAPIOperationPriorityDefault request:^NSURLSessionTask *(STPAPIResponseBlock requestCompletion) {
+        return [STPAPIRequest<STPSourceProtocol> postWithAPIClient:client
+                                                          endpoint:endpoint
+                                                        parameters:@{@"source": sourceID}
+                                                     deserializers:@[[STPCard new], [STPSource new]]
+                                                        completion:requestCompletion];
+    } completion:^(id object, __unused NSHTTPURLResponse *response, NSError *error) {
+        completion(object, error);
+    }];
 }
 
-+ (void)deleteSource:(NSString *)sourceID fromCustomerUsingKey:(STPEphemeralKey *)ephemeralKey completion:(STPErrorBlock)completion {
++ (STPAPIOperation *)deleteSource:(NSString *)sourceID fromCustomerUsingKey:(STPEphemeralKey *)ephemeralKey completion:(STPErrorBlock)completion {
     STPAPIClient *client = [self apiClientWithEphemeralKey:ephemeralKey];
     NSString *endpoint = [NSString stringWithFormat:@"%@/%@/%@/%@", APIEndpointCustomers, ephemeralKey.customerID, APIEndpointSources, sourceID];
-    [STPAPIRequest<STPSourceProtocol> deleteWithAPIClient:client
-                                                 endpoint:endpoint
-                                               parameters:nil
-                                            deserializers:@[[STPGenericStripeObject new]]
-                                               completion:^(__unused STPGenericStripeObject *object, __unused NSHTTPURLResponse *response, NSError *error) {
-                                                   completion(error);
-                                               }];
+    return [STPAPIRequest<STPSourceProtocol> enqueueWithPriority:STPAPIOperationPriorityDefault request:^NSURLSessionTask *(STPAPIResponseBlock requestCompletion) {
+        return [STPAPIRequest<STPSourceProtocol> deleteWithAPIClient:client
+                                                            endpoint:endpoint
+                                                          parameters:nil
+                                                       deserializers:@[[STPGenericStripeObject new]]
+                                                          completion:requestCompletion];
+    } completion:^(__unused STPGenericStripeObject *object, __unused NSHTTPURLResponse *response, NSError *error) {
+        completion(error);
+    }];
 }
 
 @end
@@ -597,25 +811,75 @@ toCustomerUsingKey:(STPEphemeralKey *)ephemeralKey
 
 @implementation STPAPIClient (PaymentIntents)
 
-- (void)retrievePaymentIntentWithClientSecret:(NSString *)secret
-                                   completion:(STPPaymentIntentCompletionBlock)completion {
+- (STPAPIOperation *)retrievePaymentIntentWithClientSecret:(NSString *)secret
+                                                completion:(STPPaymentIntentCompletionBlock)completion {
     NSCAssert(secret != nil, @"'secret' is required to retrieve a PaymentIntent");
     NSCAssert(completion != nil, @"'completion' is required to use the PaymentIntent that is retrieved");
-    NSString *identifier = [STPPaymentIntent idFromClientSecret:secret];
+    return [STPAPIRequest<STPPaymentIntent *> enqueueWithPriority:STPAPIOperationPriorityDefault request:^NSURLSessionTask *(STPAPIResponseBlock requestCompletion) {
+        return [self retrievePaymentIntentWithClientSecret:secret responseCompletion:requestCompletion];
+    } completion:^(STPPaymentIntent *paymentIntent, __unused NSHTTPURLResponse *response, NSError *error) {
+        completion(paymentIntent, error);
+    }];
+}
 
+- (NSURLSessionDataTask *)retrievePaymentIntentWithClientSecret:(NSString *)secret
+                                             responseCompletion:(void (^)(STPPaymentIntent * _Nullable, NSHTTPURLResponse * _Nullable, NSError * _Nullable))completion {
+    NSString *identifier = [STPPaymentIntent idFromClientSecret:secret];
     NSString *endpoint = [NSString stringWithFormat:@"%@/%@", APIEndpointPaymentIntents, identifier];
+    return [STPAPIRequest<STPPaymentIntent *> getWithAPIClient:self
+                                                      endpoint:endpoint
+                                                    parameters:@{ @"client_secret": secret }
+                                                  deserializer:[STPPaymentIntent new]
+                                                    completion:completion];
+}
 
-    [STPAPIRequest<STPPaymentIntent *> getWithAPIClient:self
-                                               endpoint:endpoint
-                                             parameters:@{ @"client_secret": secret }
-                                           deserializer:[STPPaymentIntent new]
-                                             completion:^(STPPaymentIntent *paymentIntent, __unused NSHTTPURLResponse *response, NSError *error) {
-                                                 completion(paymentIntent, error);
-                                             }];
+- (void)startPollingPaymentIntentWithClientSecret:(NSString *)secret
+                                          timeout:(NSTimeInterval)timeout
+                                       completion:(STPPaymentIntentCompletionBlock)completion {
+    NSCAssert(secret != nil, @"'secret' is required to poll a PaymentIntent");
+    NSCAssert(completion != nil, @"'completion' is required to use the PaymentIntent that is retrieved");
+    NSString *identifier = [STPPaymentIntent idFromClientSecret:secret];
+    if (!identifier) {
+        completion(nil, [NSError stp_genericFailedToParseResponseError]);
+        return;
+    }
+    [self stopPollingPaymentIntentWithClientSecret:secret];
+    __block __weak STPPaymentIntentPoller *weakPoller = nil;
+    STPPaymentIntentPoller *poller = [[STPPaymentIntentPoller alloc] initWithAPIClient:self
+                                                                          clientSecret:secret
+                                                                               timeout:timeout
+                                                                            completion:^(STPPaymentIntent *paymentIntent, NSError *error) {
+                                                                                STPPaymentIntentPoller *finishedPoller = weakPoller;
+                                                                                dispatch_async(self.pollersQueue, ^{
+                                                                                    // Unless it's already been replaced by a new poll
+                                                                                    if (self.pollers[identifier] == finishedPoller) {
+                                                                                        [self.pollers removeObjectForKey:identifier];
+                                                                                    }
+                                                                                });
+                                                                                completion(paymentIntent, error);
+                                                                            }];
+    weakPoller = poller;
+    dispatch_async(self.pollersQueue, ^{
+        self.pollers[identifier] = poller;
+    });
+}
+
+- (void)stopPollingPaymentIntentWithClientSecret:(NSString *)secret {
+    NSString *identifier = [STPPaymentIntent idFromClientSecret:secret];
+    if (!identifier) {
+        return;
+    }
+    dispatch_async(self.pollersQueue, ^{
+        STPPaymentIntentPoller *poller = (STPPaymentIntentPoller *)self.pollers[identifier];
+        if (poller) {
+            [poller stopPolling];
+            self.pollers[identifier] = nil;
+        }
+    });
 }
 
-- (void)confirmPaymentIntentWithParams:(STPPaymentIntentParams *)paymentIntentParams
-                            completion:(STPPaymentIntentCompletionBlock)completion {
+- (STPAPIOperation *)confirmPaymentIntentWithParams:(STPPaymentIntentParams *)paymentIntentParams
+                                         completion:(STPPaymentIntentCompletionBlock)completion {
     NSCAssert(paymentIntentParams.clientSecret != nil, @"'clientSecret' is required to confirm a PaymentIntent");
     NSString *identifier = paymentIntentParams.stripeId;
     NSString *sourceType = [STPSource stringFromType:paymentIntentParams.sourceParams.type];
@@ -631,13 +895,16 @@ toCustomerUsingKey:(STPEphemeralKey *)ephemeralKey
         params[@"source_data"] = [sourceParamsDict copy];
     }
 
-    [STPAPIRequest<STPPaymentIntent *> postWithAPIClient:self
-                                                endpoint:endpoint
-                                              parameters:[params copy]
-                                            deserializer:[STPPaymentIntent new]
-                                              completion:^(STPPaymentIntent *paymentIntent, __unused NSHTTPURLResponse *response, NSError *error) {
-                                                  completion(paymentIntent, error);
-                                              }];
+    // The customer is waiting on this, so it goes ahead of any queued requests
+    return [STPAPIRequest<STPPaymentIntent *> enqueueWithPriority:STPAPIOperationPriorityHigh request:^NSURLSessionTask *(STPAPIResponseBlock requestCompletion) {
+        return [STPAPIRequest<STPPaymentIntent *> postWithAPIClient:self
+                                                           endpoint:endpoint
+                                                         parameters:[params copy]
+                                                       deserializer:[STPPaymentIntent new]
+                                                         completion:requestCompletion];
+    } completion:^(STPPaymentIntent *paymentIntent, __unused NSHTTPURLResponse *response, NSError *error) {
+        completion(paymentIntent, error);
+    }];
 }
 
 @end
@@ -0,0 +1,146 @@
+//
+//  STPAPIOperation+Private.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPAPIOperation.h"
+
+@class STPAPIOperationQueue;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Starts the operation's network task and returns it. The operation must be
+ marked finished (via `markFinished`) when the task's completion has run.
+ */
+typedef NSURLSessionTask * _Nullable (^STPAPIOperationStartBlock)(void);
+
+/**
+ Called on the main queue when an operation is cancelled before it started,
+ with the error to report to the caller.
+ */
+typedef void (^STPAPIOperationCancelBlock)(NSError *error);
+
+@interface STPAPIOperation ()
+
+/**
+ Creates an operation that performs a single request once the shared
+ `STPAPIOperationQueue` has room for it. The operation is not enqueued until
+ `enqueue` is called.
+ */
+- (instancetype)initWithPriority:(STPAPIOperationPriority)priority
+                      startBlock:(STPAPIOperationStartBlock)startBlock
+                     cancelBlock:(STPAPIOperationCancelBlock)cancelBlock;
+
+/**
+ Creates an operation that stands for a sequence or batch of requests. It is
+ never enqueued itself; instead, the operations it is waiting on are added as
+ children, and cancelling or reprioritizing the group is forwarded to them.
+ */
+- (instancetype)initGroupWithPriority:(STPAPIOperationPriority)priority;
+
+/**
+ The step a group operation performing a sequence of requests is currently
+ on. Setting it replaces all of the group's children.
+ */
+@property (nonatomic, strong, nullable) STPAPIOperation *currentOperation;
+
+/**
+ Adds a child to a group operation performing several requests at once.
+ The child takes on the group's priority, and is cancelled right away if the
+ group has been cancelled.
+ */
+- (void)addChildOperation:(STPAPIOperation *)operation;
+
+- (void)removeChildOperation:(STPAPIOperation *)operation;
+
+/**
+ Called on the main queue when a group operation is cancelled, after its
+ children have been cancelled.
+ */
+@property (nonatomic, copy, nullable) dispatch_block_t cancellationHandler;
+
+/**
+ The task started for the operation, if it has started.
+ */
+@property (nonatomic, strong, nullable, readonly) NSURLSessionTask *task;
+
+/**
+ The queue the operation has been added to.
+ */
+@property (nonatomic, weak, nullable) STPAPIOperationQueue *queue;
+
+/**
+ Adds the operation to the shared queue and returns it.
+ */
+- (instancetype)enqueue;
+
+/**
+ Called by the queue when the operation may start. Starts the task, or
+ finishes the operation straight away if it was cancelled in the meantime.
+ */
+- (void)start;
+
+/**
+ Marks the operation as finished and frees its slot in the queue. Safe to
+ call more than once.
+ */
+- (void)markFinished;
+
+/**
+ The operation whose start block is running on the current thread, if any.
+ Lets code that creates tasks on an operation's behalf (e.g. to retry a
+ request) find the operation without it being passed down explicitly.
+ */
++ (nullable STPAPIOperation *)startingOperation;
+
+/**
+ Calls `block`. Operations created while it runs don't retry their requests,
+ whatever their client's `maxRetryCount`. Lets code that retries on its own
+ terms (e.g. the batch runner) avoid stacking request retries on top.
+ */
++ (void)performWithoutRetries:(dispatch_block_t)block;
+
+/**
+ Whether the operation was created inside `performWithoutRetries:`.
+ */
+@property (nonatomic, assign, readonly) BOOL retriesDisabled;
+
+/**
+ Replaces the operation's task, e.g. with a retry of the original request.
+ The new task takes on the operation's priority, and is cancelled right away
+ if the operation has been cancelled.
+ */
+- (void)replaceTask:(NSURLSessionTask *)task;
+
+/**
+ Frees the operation's slot in the queue while it waits to retry its request,
+ so that other operations can run in the meantime. Must be followed by
+ `requeueWithStartBlock:`.
+ */
+- (void)yieldSlot;
+
+/**
+ Adds an operation that yielded its slot back to its queue; `startBlock` is
+ called in place of the original one once there is room. An operation that
+ isn't on a queue is started right away. If the operation was cancelled in
+ the meantime, its cancellation is reported instead.
+ */
+- (void)requeueWithStartBlock:(STPAPIOperationStartBlock)startBlock;
+
+/**
+ The error reported for cancelled operations.
+ */
++ (NSError *)cancelledError;
+
+/**
+ The `NSURLSessionTask.priority` an operation priority maps to.
+ */
++ (float)taskPriorityForPriority:(STPAPIOperationPriority)priority;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,285 @@
+//
+//  STPAPIOperation.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPAPIOperation.h"
+#import "STPAPIOperation+Private.h"
+
+#import "STPAPIOperationQueue.h"
+#import "STPDispatchFunctions.h"
+
+static NSString * const StartingOperationKey = @"com.stripe.STPAPIOperation.startingOperation";
+static NSString * const RetriesDisabledKey = @"com.stripe.STPAPIOperation.retriesDisabled";
+
+@interface STPAPIOperation ()
+
+@property (nonatomic, assign, readwrite, getter=isCancelled) BOOL cancelled;
+@property (nonatomic, assign, readwrite, getter=isFinished) BOOL finished;
+@property (nonatomic, strong, nullable, readwrite) NSURLSessionTask *task;
+@property (nonatomic, assign) BOOL group;
+@property (nonatomic, assign, readwrite) BOOL retriesDisabled;
+@property (nonatomic, copy, nullable) STPAPIOperationStartBlock startBlock;
+@property (nonatomic, copy, nullable) STPAPIOperationCancelBlock cancelBlock;
+@property (nonatomic, strong) NSMutableArray<STPAPIOperation *> *childOperations;
+
+@end
+
+@implementation STPAPIOperation
+
+@synthesize priority = _priority;
+@synthesize cancellationHandler = _cancellationHandler;
+
+- (instancetype)initWithPriority:(STPAPIOperationPriority)priority
+                      startBlock:(STPAPIOperationStartBlock)startBlock
+                     cancelBlock:(STPAPIOperationCancelBlock)cancelBlock {
+    self = [super init];
+    if (self) {
+        _priority = priority;
+        _startBlock = [startBlock copy];
+        _cancelBlock = [cancelBlock copy];
+        _retriesDisabled = [[NSThread currentThread].threadDictionary[RetriesDisabledKey] boolValue];
+    }
+    return self;
+}
+
+- (instancetype)init {
+    return [self initGroupWithPriority:STPAPIOperationPriorityDefault];
+}
+
+- (instancetype)initGroupWithPriority:(STPAPIOperationPriority)priority {
+    self = [super init];
+    if (self) {
+        _priority = priority;
+        _group = YES;
+        _childOperations = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (instancetype)enqueue {
+    [[STPAPIOperationQueue sharedQueue] addOperation:self];
+    return self;
+}
+
+#pragma mark - Priority
+
+- (STPAPIOperationPriority)priority {
+    @synchronized(self) {
+        return _priority;
+    }
+}
+
+- (void)setPriority:(STPAPIOperationPriority)priority {
+    NSArray<STPAPIOperation *> *childOperations;
+    NSURLSessionTask *task;
+    @synchronized(self) {
+        _priority = priority;
+        childOperations = [self.childOperations copy];
+        task = self.task;
+    }
+    for (STPAPIOperation *childOperation in childOperations) {
+        childOperation.priority = priority;
+    }
+    task.priority = [[self class] taskPriorityForPriority:priority];
+}
+
++ (float)taskPriorityForPriority:(STPAPIOperationPriority)priority {
+    switch (priority) {
+        case STPAPIOperationPriorityLow:
+            return NSURLSessionTaskPriorityLow;
+        case STPAPIOperationPriorityDefault:
+            return NSURLSessionTaskPriorityDefault;
+        case STPAPIOperationPriorityHigh:
+            return NSURLSessionTaskPriorityHigh;
+    }
+    return NSURLSessionTaskPriorityDefault;
+}
+
+#pragma mark - Groups
+
+- (STPAPIOperation *)currentOperation {
+    @synchronized(self) {
+        return self.childOperations.lastObject;
+    }
+}
+
+- (void)setCurrentOperation:(STPAPIOperation *)currentOperation {
+    @synchronized(self) {
+        [self.childOperations removeAllObjects];
+    }
+    if (currentOperation) {
+        [self addChildOperation:currentOperation];
+    }
+}
+
+- (void)addChildOperation:(STPAPIOperation *)operation {
+    BOOL cancelled;
+    STPAPIOperationPriority priority;
+    @synchronized(self) {
+        [self.childOperations addObject:operation];
+        cancelled = self.cancelled;
+        priority = _priority;
+    }
+    operation.priority = priority;
+    if (cancelled) {
+        [operation cancel];
+    }
+}
+
+- (void)removeChildOperation:(STPAPIOperation *)operation {
+    @synchronized(self) {
+        [self.childOperations removeObjectIdenticalTo:operation];
+    }
+}
+
+- (dispatch_block_t)cancellationHandler {
+    @synchronized(self) {
+        return _cancellationHandler;
+    }
+}
+
+- (void)setCancellationHandler:(dispatch_block_t)cancellationHandler {
+    @synchronized(self) {
+        _cancellationHandler = [cancellationHandler copy];
+    }
+}
+
+#pragma mark - Lifecycle
+
+- (void)start {
+    STPAPIOperationStartBlock startBlock;
+    BOOL cancelled;
+    @synchronized(self) {
+        startBlock = self.startBlock;
+        cancelled = self.cancelled;
+    }
+    if (cancelled) {
+        [self reportCancellation];
+        return;
+    }
+
+    NSMutableDictionary *threadDictionary = [NSThread currentThread].threadDictionary;
+    threadDictionary[StartingOperationKey] = self;
+    NSURLSessionTask *task = startBlock ? startBlock() : nil;
+    [threadDictionary removeObjectForKey:StartingOperationKey];
+    [self replaceTask:task];
+}
+
++ (STPAPIOperation *)startingOperation {
+    return [NSThread currentThread].threadDictionary[StartingOperationKey];
+}
+
++ (void)performWithoutRetries:(dispatch_block_t)block {
+    NSMutableDictionary *threadDictionary = [NSThread currentThread].threadDictionary;
+    id previousValue = threadDictionary[RetriesDisabledKey];
+    threadDictionary[RetriesDisabledKey] = @YES;
+    block();
+    threadDictionary[RetriesDisabledKey] = previousValue;
+}
+
+- (void)replaceTask:(NSURLSessionTask *)task {
+    BOOL cancelled;
+    task.priority = [[self class] taskPriorityForPriority:self.priority];
+    @synchronized(self) {
+        self.task = task;
+        cancelled = self.cancelled;
+    }
+    if (cancelled) {
+        // -cancel ran while the task was being created
+        [task cancel];
+    }
+}
+
+- (void)yieldSlot {
+    @synchronized(self) {
+        // The finished task can't be cancelled; -cancel falls back on -start
+        self.task = nil;
+    }
+    [self.queue operationDidFinish:self];
+}
+
+- (void)requeueWithStartBlock:(STPAPIOperationStartBlock)startBlock {
+    @synchronized(self) {
+        if (self.finished) {
+            return;
+        }
+        self.startBlock = startBlock;
+    }
+    if (self.queue) {
+        [self.queue addOperation:self];
+    }
+    else {
+        [self start];
+    }
+}
+
+- (void)cancel {
+    NSArray<STPAPIOperation *> *childOperations;
+    dispatch_block_t cancellationHandler;
+    NSURLSessionTask *task;
+    @synchronized(self) {
+        if (self.cancelled || self.finished) {
+            return;
+        }
+        self.cancelled = YES;
+        childOperations = [self.childOperations copy];
+        cancellationHandler = _cancellationHandler;
+        task = self.task;
+    }
+
+    if (self.group) {
+        for (STPAPIOperation *childOperation in childOperations) {
+            [childOperation cancel];
+        }
+        if (cancellationHandler) {
+            stpDispatchToMainThreadIfNecessary(cancellationHandler);
+        }
+    }
+    else if (task) {
+        // The task's completion reports NSURLErrorCancelled and finishes us
+        [task cancel];
+    }
+    else if (!self.queue || [self.queue removePendingOperation:self]) {
+        [self reportCancellation];
+    }
+    // Otherwise the queue is about to call -start (or the operation is
+    // waiting to retry and will be requeued), which reports it
+}
+
+- (void)markFinished {
+    @synchronized(self) {
+        if (self.finished) {
+            return;
+        }
+        self.finished = YES;
+        self.startBlock = nil;
+        self.cancelBlock = nil;
+        self.task = nil;
+        [self.childOperations removeAllObjects];
+        _cancellationHandler = nil;
+    }
+    [self.queue operationDidFinish:self];
+}
+
+- (void)reportCancellation {
+    STPAPIOperationCancelBlock cancelBlock;
+    @synchronized(self) {
+        cancelBlock = self.cancelBlock;
+    }
+    [self markFinished];
+    if (cancelBlock) {
+        stpDispatchToMainThreadIfNecessary(^{
+            cancelBlock([[self class] cancelledError]);
+        });
+    }
+}
+
++ (NSError *)cancelledError {
+    return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+}
+
+@end
@@ -0,0 +1,68 @@
+//
+//  STPAPIOperationQueue.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class STPAPIOperation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Limits how many `STPAPIOperation`s are running at once and starts waiting
+ operations highest priority first (and in the order they were added within
+ a priority).
+
+ A single queue is shared by every `STPAPIClient`, including the short-lived
+ clients used for customer requests, so that a payment confirmation is never
+ stuck behind a backlog of background work. This also means its limit caps
+ everything the SDK does at once: a batch's `maxConcurrency`, for example, can
+ only keep this queue full. Long transfers such as file uploads don't go
+ through the queue, and a request waiting to be retried gives up its slot.
+ */
+@interface STPAPIOperationQueue : NSObject
+
+/**
+ The queue used for all requests made by the SDK.
+ */
++ (instancetype)sharedQueue;
+
+- (instancetype)init;
+
+- (instancetype)initWithMaxConcurrentOperationCount:(NSUInteger)maxConcurrentOperationCount NS_DESIGNATED_INITIALIZER;
+
+/**
+ How many operations may be running at once. Defaults to 4 (see
+ `DefaultMaxConcurrentOperationCount`). Raising it starts waiting operations
+ right away; lowering it lets running operations finish.
+ */
+@property (nonatomic) NSUInteger maxConcurrentOperationCount;
+
+@property (nonatomic, readonly) NSUInteger pendingOperationCount;
+@property (nonatomic, readonly) NSUInteger runningOperationCount;
+
+/**
+ Adds an operation to the queue, starting it right away if there is room.
+ */
+- (void)addOperation:(STPAPIOperation *)operation;
+
+/**
+ Removes an operation that has not started yet.
+
+ @return YES if the operation was waiting and has been removed, NO if it had
+ already been started (or was never added).
+ */
+- (BOOL)removePendingOperation:(STPAPIOperation *)operation;
+
+/**
+ Called by a running operation when it has finished, to free its slot.
+ */
+- (void)operationDidFinish:(STPAPIOperation *)operation;
+
+@end
+
+NS_ASSUME_NONNULL_END
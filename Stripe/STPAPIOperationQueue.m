@@ -0,0 +1,142 @@
+//
+//  STPAPIOperationQueue.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPAPIOperationQueue.h"
+
+#import "STPAPIOperation+Private.h"
+
+/**
+ Matches `NSURLSessionConfiguration.HTTPMaximumConnectionsPerHost` on iOS, so
+ requests wait here (where priority is respected) rather than inside
+ NSURLSession.
+ */
+static const NSUInteger DefaultMaxConcurrentOperationCount = 4;
+
+@interface STPAPIOperationQueue ()
+
+@property (nonatomic, strong) NSMutableArray<STPAPIOperation *> *pendingOperations;
+@property (nonatomic, strong) NSMutableArray<STPAPIOperation *> *runningOperations;
+
+@end
+
+@implementation STPAPIOperationQueue
+
++ (instancetype)sharedQueue {
+    static STPAPIOperationQueue *sharedQueue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedQueue = [self new];
+    });
+    return sharedQueue;
+}
+
+- (instancetype)init {
+    return [self initWithMaxConcurrentOperationCount:DefaultMaxConcurrentOperationCount];
+}
+
+- (instancetype)initWithMaxConcurrentOperationCount:(NSUInteger)maxConcurrentOperationCount {
+    self = [super init];
+    if (self) {
+        _maxConcurrentOperationCount = MAX(maxConcurrentOperationCount, (NSUInteger)1);
+        _pendingOperations = [NSMutableArray array];
+        _runningOperations = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (NSUInteger)maxConcurrentOperationCount {
+    @synchronized(self) {
+        return _maxConcurrentOperationCount;
+    }
+}
+
+- (void)setMaxConcurrentOperationCount:(NSUInteger)maxConcurrentOperationCount {
+    @synchronized(self) {
+        _maxConcurrentOperationCount = MAX(maxConcurrentOperationCount, (NSUInteger)1);
+    }
+    [self startOperationsIfPossible];
+}
+
+- (NSUInteger)pendingOperationCount {
+    @synchronized(self) {
+        return self.pendingOperations.count;
+    }
+}
+
+- (NSUInteger)runningOperationCount {
+    @synchronized(self) {
+        return self.runningOperations.count;
+    }
+}
+
+- (void)addOperation:(STPAPIOperation *)operation {
+    operation.queue = self;
+    @synchronized(self) {
+        [self.pendingOperations addObject:operation];
+    }
+    [self startOperationsIfPossible];
+}
+
+- (BOOL)removePendingOperation:(STPAPIOperation *)operation {
+    @synchronized(self) {
+        NSUInteger index = [self.pendingOperations indexOfObjectIdenticalTo:operation];
+        if (index == NSNotFound) {
+            return NO;
+        }
+        [self.pendingOperations removeObjectAtIndex:index];
+        return YES;
+    }
+}
+
+- (void)operationDidFinish:(STPAPIOperation *)operation {
+    @synchronized(self) {
+        [self.runningOperations removeObjectIdenticalTo:operation];
+    }
+    [self startOperationsIfPossible];
+}
+
+#pragma mark - Helpers
+
+- (void)startOperationsIfPossible {
+    NSMutableArray<STPAPIOperation *> *operationsToStart = [NSMutableArray array];
+    @synchronized(self) {
+        while (self.runningOperations.count < _maxConcurrentOperationCount) {
+            STPAPIOperation *operation = [self dequeueHighestPriorityOperation];
+            if (!operation) {
+                break;
+            }
+            [self.runningOperations addObject:operation];
+            [operationsToStart addObject:operation];
+        }
+    }
+    // Start outside the lock: starting creates a task, and a cancelled
+    // operation finishes (and re-enters the queue) immediately.
+    for (STPAPIOperation *operation in operationsToStart) {
+        [operation start];
+    }
+}
+
+- (STPAPIOperation *)dequeueHighestPriorityOperation {
+    NSUInteger bestIndex = NSNotFound;
+    STPAPIOperationPriority bestPriority = STPAPIOperationPriorityLow;
+    for (NSUInteger i = 0; i < self.pendingOperations.count; i++) {
+        STPAPIOperationPriority priority = self.pendingOperations[i].priority;
+        if (bestIndex == NSNotFound || priority > bestPriority) {
+            bestIndex = i;
+            bestPriority = priority;
+        }
+    }
+    if (bestIndex == NSNotFound) {
+        return nil;
+    }
+    STPAPIOperation *operation = self.pendingOperations[bestIndex];
+    [self.pendingOperations removeObjectAtIndex:bestIndex];
+    return operation;
+}
+
+@end
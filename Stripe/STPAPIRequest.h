@@ -7,6 +7,7 @@
 //
 
 #import <Foundation/Foundation.h>
+#import "STPAPIOperation.h"
 #import "STPAPIResponseDecodable.h"
 
 @class STPAPIClient;
@@ -45,4 +46,25 @@ typedef void(^STPAPIResponseBlock)(ResponseType object, NSHTTPURLResponse *respo
                                 deserializers:(NSArray<ResponseType> *)deserializer
                                    completion:(STPAPIResponseBlock)completion;
 
+/**
+ Adds an operation to the shared `STPAPIOperationQueue` that calls `request`
+ once there is room for it. `request` should start a task with one of the
+ methods above, passing along the completion it is given.
+
+ If the operation is cancelled before it starts, `completion` is called with
+ a cancellation error and `request` is never called.
+ */
++ (STPAPIOperation *)enqueueWithPriority:(STPAPIOperationPriority)priority
+                                 request:(NSURLSessionTask *(^)(STPAPIResponseBlock completion))request
+                              completion:(STPAPIResponseBlock)completion;
+
+/**
+ Like `enqueueWithPriority:request:completion:`, but calls `request` right
+ away instead of waiting for a slot in the queue. For long transfers such as
+ file uploads, which would otherwise keep a slot for their whole duration.
+ */
++ (STPAPIOperation *)startWithPriority:(STPAPIOperationPriority)priority
+                               request:(NSURLSessionTask *(^)(STPAPIResponseBlock completion))request
+                            completion:(STPAPIResponseBlock)completion;
+
 @end
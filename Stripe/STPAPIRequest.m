@@ -8,12 +8,17 @@
 
 #import "STPAPIRequest.h"
 
+#import <math.h>
+
 #import "NSError+Stripe.h"
 #import "NSMutableURLRequest+Stripe.h"
 #import "STPAPIClient.h"
 #import "STPAPIClient+Private.h"
+#import "STPAPIOperation+Private.h"
 #import "STPDispatchFunctions.h"
 #import "STPInternalAPIResponseDecodable.h"
+#import "STPRequestMetricsCollector.h"
+#import "STPTrace.h"
 
 @implementation STPAPIRequest
 
@@ -23,6 +28,27 @@ static NSString * const HTTPMethodDELETE = @"DELETE";
 
 static NSString * const JSONKeyObject = @"object";
 
+static NSString * const HTTPHeaderIdempotencyKey = @"Idempotency-Key";
+static NSString * const HTTPHeaderRetryAfter = @"Retry-After";
+
+static const NSTimeInterval RetryBaseDelay = 0.5;
+static const NSTimeInterval RetryMaxDelay = 4;
+
+/**
+ What a request needs to know to decide whether to send another attempt.
+ */
+@interface STPAPIRequestRetryState : NSObject
+
+@property (nonatomic) NSUInteger attempt;
+@property (nonatomic) NSUInteger maxRetryCount;
+@property (nonatomic) NSTimeInterval deadline;
+@property (nonatomic, weak) STPAPIOperation *operation;
+
+@end
+
+@implementation STPAPIRequestRetryState
+@end
+
 #pragma mark - POST
 
 + (NSURLSessionDataTask *)postWithAPIClient:(STPAPIClient *)apiClient
@@ -38,21 +64,30 @@ static NSString * const JSONKeyObject = @"object";
                                  parameters:(NSDictionary *)parameters
                               deserializers:(NSArray<id<STPAPIResponseDecodable>>*)deserializers
                                  completion:(STPAPIResponseBlock)completion {
+    NSTimeInterval buildStartTime = stpTraceBegin();
+
     // Build url
-    NSURL *url = [apiClient.apiURL URLByAppendingPathComponent:endpoint];
+    NSURL *url = [apiClient URLForEndpoint:endpoint];
+    STPRequestMetricsCollector *metricsCollector = [STPRequestMetricsCollector collectorWithAPIClient:apiClient endpoint:endpoint HTTPMethod:HTTPMethodPOST];
 
     // Setup request
     NSMutableURLRequest *request = [apiClient configuredRequestForURL:url];
     request.HTTPMethod = HTTPMethodPOST;
+    // Sent unchanged with every retry, so the API performs the request at most once
+    [request setValue:[NSUUID UUID].UUIDString forHTTPHeaderField:HTTPHeaderIdempotencyKey];
+    NSTimeInterval encodeStartTime = [STPRequestMetricsCollector currentTime];
     [request stp_setFormPayload:parameters];
+    [metricsCollector recordFormEncodeDuration:[STPRequestMetricsCollector currentTime] - encodeStartTime];
 
-    // Perform request
-    NSURLSessionDataTask *task = [apiClient.urlSession dataTaskWithRequest:request completionHandler:^(NSData *body, NSURLResponse *response, NSError *error) {
-        [[self class] parseResponse:response body:body error:error deserializers:deserializers completion:completion];
-    }];
-    [task resume];
+    stpTraceEnd(buildStartTime, @"request_build", STPTraceCategoryAPI);
 
-    return task;
+    // Perform request
+    return [self startTaskWithAPIClient:apiClient
+                                request:request
+                          deserializers:deserializers
+                       metricsCollector:metricsCollector
+                             retryState:[self retryStateWithAPIClient:apiClient]
+                             completion:completion];
 }
 
 #pragma mark - GET
@@ -62,21 +97,28 @@ static NSString * const JSONKeyObject = @"object";
                                 parameters:(NSDictionary *)parameters
                               deserializer:(id<STPAPIResponseDecodable>)deserializer
                                 completion:(STPAPIResponseBlock)completion {
+    NSTimeInterval buildStartTime = stpTraceBegin();
+
     // Build url
-    NSURL *url = [apiClient.apiURL URLByAppendingPathComponent:endpoint];
+    NSURL *url = [apiClient URLForEndpoint:endpoint];
+    STPRequestMetricsCollector *metricsCollector = [STPRequestMetricsCollector collectorWithAPIClient:apiClient endpoint:endpoint HTTPMethod:HTTPMethodGET];
 
     // Setup request
     NSMutableURLRequest *request = [apiClient configuredRequestForURL:url];
+    NSTimeInterval encodeStartTime = [STPRequestMetricsCollector currentTime];
     [request stp_addParametersToURL:parameters];
+    [metricsCollector recordFormEncodeDuration:[STPRequestMetricsCollector currentTime] - encodeStartTime];
     request.HTTPMethod = HTTPMethodGET;
 
-    // Perform request
-    NSURLSessionDataTask *task = [apiClient.urlSession dataTaskWithRequest:request completionHandler:^(NSData *body, NSURLResponse *response, NSError *error) {
-        [[self class] parseResponse:response body:body error:error deserializers:@[deserializer] completion:completion];
-    }];
-    [task resume];
+    stpTraceEnd(buildStartTime, @"request_build", STPTraceCategoryAPI);
 
-    return task;
+    // Perform request
+    return [self startTaskWithAPIClient:apiClient
+                                request:request
+                          deserializers:@[deserializer]
+                       metricsCollector:metricsCollector
+                             retryState:[self retryStateWithAPIClient:apiClient]
+                             completion:completion];
 }
 
 #pragma mark - DELETE
@@ -94,29 +136,172 @@ static NSString * const JSONKeyObject = @"object";
                                    parameters:(NSDictionary *)parameters
                                 deserializers:(NSArray<id<STPAPIResponseDecodable>> *)deserializers
                                    completion:(STPAPIResponseBlock)completion {
+    NSTimeInterval buildStartTime = stpTraceBegin();
+
     // Build url
-    NSURL *url = [apiClient.apiURL URLByAppendingPathComponent:endpoint];
+    NSURL *url = [apiClient URLForEndpoint:endpoint];
+    STPRequestMetricsCollector *metricsCollector = [STPRequestMetricsCollector collectorWithAPIClient:apiClient endpoint:endpoint HTTPMethod:HTTPMethodDELETE];
 
     // Setup request
     NSMutableURLRequest *request = [apiClient configuredRequestForURL:url];
+    NSTimeInterval encodeStartTime = [STPRequestMetricsCollector currentTime];
     [request stp_addParametersToURL:parameters];
+    [metricsCollector recordFormEncodeDuration:[STPRequestMetricsCollector currentTime] - encodeStartTime];
     request.HTTPMethod = HTTPMethodDELETE;
 
-    // Perform request
+    stpTraceEnd(buildStartTime, @"request_build", STPTraceCategoryAPI);
+
+    // Perform request. DELETEs aren't retried: if the first attempt went
+    // through, a retry would fail because the object no longer exists.
+    return [self startTaskWithAPIClient:apiClient
+                                request:request
+                          deserializers:deserializers
+                       metricsCollector:metricsCollector
+                             retryState:nil
+                             completion:completion];
+}
+
+#pragma mark - Retries
+
++ (STPAPIRequestRetryState *)retryStateWithAPIClient:(STPAPIClient *)apiClient {
+    STPAPIRequestRetryState *retryState = [STPAPIRequestRetryState new];
+    // Retries replace the operation's task so that cancelling it still works
+    retryState.operation = [STPAPIOperation startingOperation];
+    retryState.maxRetryCount = retryState.operation.retriesDisabled ? 0 : apiClient.maxRetryCount;
+    retryState.deadline = [STPRequestMetricsCollector currentTime] + apiClient.retryTimeBudget;
+    return retryState;
+}
+
++ (NSURLSessionDataTask *)startTaskWithAPIClient:(STPAPIClient *)apiClient
+                                         request:(NSURLRequest *)request
+                                   deserializers:(NSArray<id<STPAPIResponseDecodable>> *)deserializers
+                                metricsCollector:(STPRequestMetricsCollector *)metricsCollector
+                                      retryState:(STPAPIRequestRetryState *)retryState
+                                      completion:(STPAPIResponseBlock)completion {
+    NSTimeInterval networkStartTime = stpTraceBegin();
     NSURLSessionDataTask *task = [apiClient.urlSession dataTaskWithRequest:request completionHandler:^(NSData *body, NSURLResponse *response, NSError *error) {
-        [[self class] parseResponse:response body:body error:error deserializers:deserializers completion:completion];
+        stpTraceEnd(networkStartTime, @"network", STPTraceCategoryAPI);
+        if (retryState.attempt < retryState.maxRetryCount
+            && [[self class] shouldRetryResponse:response error:error]) {
+            NSTimeInterval delay = [[self class] delayBeforeRetryAttempt:retryState.attempt response:response];
+            if ([STPRequestMetricsCollector currentTime] + delay < retryState.deadline) {
+                retryState.attempt++;
+                NSURLSessionTask *(^retry)(void) = ^NSURLSessionTask *{
+                    return [[self class] startTaskWithAPIClient:apiClient
+                                                        request:request
+                                                  deserializers:deserializers
+                                               metricsCollector:metricsCollector
+                                                     retryState:retryState
+                                                     completion:completion];
+                };
+                // Don't hold a slot in the queue while backing off; the retry
+                // waits for a free one like any other request
+                STPAPIOperation *operation = retryState.operation;
+                [operation yieldSlot];
+                dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+                    if (operation) {
+                        [operation requeueWithStartBlock:retry];
+                    }
+                    else {
+                        retry();
+                    }
+                });
+                return;
+            }
+        }
+        [[self class] parseResponse:response body:body error:error deserializers:deserializers metricsCollector:metricsCollector completion:completion];
     }];
+    [metricsCollector observeTask:task];
+    if (retryState.attempt > 0) {
+        [metricsCollector recordRetry];
+        [retryState.operation replaceTask:task];
+    }
     [task resume];
 
     return task;
 }
 
++ (BOOL)shouldRetryResponse:(NSURLResponse *)response error:(NSError *)error {
+    if ([error isKindOfClass:[NSError class]]) {
+        if (![error.domain isEqualToString:NSURLErrorDomain]) {
+            return NO;
+        }
+        switch (error.code) {
+            case NSURLErrorTimedOut:
+            case NSURLErrorCannotFindHost:
+            case NSURLErrorCannotConnectToHost:
+            case NSURLErrorNetworkConnectionLost:
+            case NSURLErrorDNSLookupFailed:
+            case NSURLErrorNotConnectedToInternet:
+                return YES;
+            default:
+                // Including NSURLErrorCancelled
+                return NO;
+        }
+    }
+    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+        NSInteger statusCode = ((NSHTTPURLResponse *)response).statusCode;
+        return statusCode == 429 || (statusCode >= 500 && statusCode <= 599);
+    }
+    return NO;
+}
+
++ (NSTimeInterval)delayBeforeRetryAttempt:(NSUInteger)attempt response:(NSURLResponse *)response {
+    NSTimeInterval backoff = MIN(RetryMaxDelay, RetryBaseDelay * pow(2, attempt));
+    // Keep half of the back-off and randomize the rest, so that clients
+    // which failed together don't all retry together
+    double random = arc4random_uniform(UINT32_MAX) / (double)UINT32_MAX;
+    NSTimeInterval delay = backoff / 2 + random * backoff / 2;
+
+    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+        NSString *retryAfter = ((NSHTTPURLResponse *)response).allHeaderFields[HTTPHeaderRetryAfter];
+        if ([retryAfter isKindOfClass:[NSString class]] && retryAfter.doubleValue > 0) {
+            delay = MAX(delay, retryAfter.doubleValue);
+        }
+    }
+    return delay;
+}
+
+#pragma mark - Operations
+
++ (STPAPIOperation *)enqueueWithPriority:(STPAPIOperationPriority)priority
+                                 request:(NSURLSessionTask *(^)(STPAPIResponseBlock completion))request
+                              completion:(STPAPIResponseBlock)completion {
+    return [[self operationWithPriority:priority request:request completion:completion] enqueue];
+}
+
++ (STPAPIOperation *)startWithPriority:(STPAPIOperationPriority)priority
+                               request:(NSURLSessionTask *(^)(STPAPIResponseBlock completion))request
+                            completion:(STPAPIResponseBlock)completion {
+    STPAPIOperation *operation = [self operationWithPriority:priority request:request completion:completion];
+    [operation start];
+    return operation;
+}
+
++ (STPAPIOperation *)operationWithPriority:(STPAPIOperationPriority)priority
+                                   request:(NSURLSessionTask *(^)(STPAPIResponseBlock completion))request
+                                completion:(STPAPIResponseBlock)completion {
+    // The queue keeps a queued operation alive until it finishes
+    __block __weak STPAPIOperation *weakOperation = nil;
+    STPAPIOperation *operation = [[STPAPIOperation alloc] initWithPriority:priority startBlock:^NSURLSessionTask *{
+        return request(^(id<STPAPIResponseDecodable> object, NSHTTPURLResponse *response, NSError *error) {
+            [weakOperation markFinished];
+            completion(object, response, error);
+        });
+    } cancelBlock:^(NSError *error) {
+        completion(nil, nil, error);
+    }];
+    weakOperation = operation;
+    return operation;
+}
+
 #pragma mark -
 
 + (void)parseResponse:(NSURLResponse *)response
                  body:(NSData *)body
                 error:(NSError *)error
         deserializers:(NSArray<id<STPAPIResponseDecodable>>*)deserializers
+     metricsCollector:(STPRequestMetricsCollector *)metricsCollector
            completion:(STPAPIResponseBlock)completion {
     // Derive HTTP URL response
     NSHTTPURLResponse *httpResponse = nil;
@@ -126,8 +311,13 @@ static NSString * const JSONKeyObject = @"object";
 
     // Wrap completion block with main thread dispatch
     void (^safeCompletion)(id<STPAPIResponseDecodable>, NSError *) = ^(id<STPAPIResponseDecodable> responseObject, NSError *responseError) {
+        [metricsCollector recordResponse:httpResponse error:responseError];
+        NSTimeInterval dispatchStartTime = stpTraceBegin();
         stpDispatchToMainThreadIfNecessary(^{
+            stpTraceEnd(dispatchStartTime, @"main_thread_dispatch", STPTraceCategoryAPI);
+            [metricsCollector recordCompletionStarted];
             completion(responseObject, httpResponse, responseError);
+            [metricsCollector finish];
         });
     };
 
@@ -144,7 +334,11 @@ static NSString * const JSONKeyObject = @"object";
     // Parse JSON response body
     NSDictionary *jsonDictionary = nil;
     if (body) {
+        NSTimeInterval parseStartTime = [STPRequestMetricsCollector currentTime];
+        NSTimeInterval parseTraceStartTime = stpTraceBegin();
         jsonDictionary = [NSJSONSerialization JSONObjectWithData:body options:(NSJSONReadingOptions)kNilOptions error:NULL];
+        stpTraceEnd(parseTraceStartTime, @"json_parse", STPTraceCategoryAPI);
+        [metricsCollector recordJSONParseDuration:[STPRequestMetricsCollector currentTime] - parseStartTime];
     }
 
     // Determine appropriate deserializer
@@ -168,7 +362,11 @@ static NSString * const JSONKeyObject = @"object";
     id<STPAPIResponseDecodable> responseObject = nil;
     if (deserializerClass) {
         // Generate response object
+        NSTimeInterval decodeStartTime = [STPRequestMetricsCollector currentTime];
+        NSTimeInterval decodeTraceStartTime = stpTraceBegin();
         responseObject = [deserializerClass decodedObjectFromAPIResponse:jsonDictionary];
+        stpTraceEnd(decodeTraceStartTime, @"model_decode", STPTraceCategoryAPI);
+        [metricsCollector recordModelDecodeDuration:[STPRequestMetricsCollector currentTime] - decodeStartTime];
     }
 
     if (!responseObject) {
@@ -41,7 +41,7 @@
 
         STPValidatedTextField *textField;
         if (type == STPAddressFieldTypePhone) {
-            // We have very specific US-based phone formatting that's built into STPFormTextField
+            // Phone number formatting is built into STPFormTextField
             STPFormTextField *formTextField = [[STPFormTextField alloc] init];
             formTextField.preservesContentsOnPaste = NO;
             formTextField.selectionEnabled = NO;
@@ -194,9 +194,10 @@
             if (@available(iOS 10.0, *)) {
                 self.textField.textContentType = UITextContentTypeTelephoneNumber;
             }
-            STPFormTextFieldAutoFormattingBehavior behavior = ([self countryCodeIsUnitedStates] ?
+            STPFormTextFieldAutoFormattingBehavior behavior = ([STPPhoneNumberValidator canFormatPhoneNumbersForCountryCode:self.ourCountryCode] ?
                                                                STPFormTextFieldAutoFormattingBehaviorPhoneNumbers :
                                                                STPFormTextFieldAutoFormattingBehaviorNone);
+            ((STPFormTextField *)self.textField).phoneNumberCountryCode = self.ourCountryCode;
             ((STPFormTextField *)self.textField).autoFormattingBehavior = behavior;
             if (!self.lastInList) {
                 self.textField.inputAccessoryView = self.inputAccessoryToolbar;
@@ -395,7 +396,8 @@
                     || validationState == STPCardValidationStateIncomplete);
         }
         case STPAddressFieldTypeEmail:
-            return [STPEmailAddressValidator stringIsValidPartialEmailAddress:self.contents];
+            return ([STPEmailAddressValidator validationStateForEmailAddress:self.contents]
+                    != STPCardValidationStateInvalid);
         case STPAddressFieldTypePhone:
             return [STPPhoneNumberValidator stringIsValidPartialPhoneNumber:self.contents
                                                              forCountryCode:self.ourCountryCode];
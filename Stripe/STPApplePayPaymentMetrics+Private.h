@@ -0,0 +1,24 @@
+//
+//  STPApplePayPaymentMetrics+Private.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPApplePayPaymentMetrics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface STPApplePayPaymentMetrics ()
+
+- (instancetype)initWithPipelined:(BOOL)pipelined NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readwrite) NSTimeInterval attachDuration;
+@property (nonatomic, readwrite) NSTimeInterval paymentResultDuration;
+@property (nonatomic, readwrite) NSTimeInterval duration;
+@property (nonatomic, nullable, readwrite) NSError *attachError;
+
+@end
+
+NS_ASSUME_NONNULL_END
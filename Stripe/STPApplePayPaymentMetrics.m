@@ -0,0 +1,50 @@
+//
+//  STPApplePayPaymentMetrics.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPApplePayPaymentMetrics.h"
+#import "STPApplePayPaymentMetrics+Private.h"
+
+@implementation STPApplePayPaymentMetrics
+
+- (instancetype)initWithPipelined:(BOOL)pipelined {
+    self = [super init];
+    if (self) {
+        _pipelined = pipelined;
+    }
+    return self;
+}
+
+- (NSTimeInterval)timeSaved {
+    if (!self.pipelined) {
+        return 0;
+    }
+    return MAX(self.attachDuration + self.paymentResultDuration - self.duration, 0);
+}
+
+- (NSString *)description {
+    NSArray *props = @[
+                       // Object
+                       [NSString stringWithFormat:@"%@: %p", NSStringFromClass([self class]), self],
+
+                       // Mode
+                       [NSString stringWithFormat:@"pipelined = %@", self.pipelined ? @"YES" : @"NO"],
+
+                       // Timing
+                       [NSString stringWithFormat:@"attachDuration = %.4f", self.attachDuration],
+                       [NSString stringWithFormat:@"paymentResultDuration = %.4f", self.paymentResultDuration],
+                       [NSString stringWithFormat:@"duration = %.4f", self.duration],
+                       [NSString stringWithFormat:@"timeSaved = %.4f", self.timeSaved],
+
+                       // Errors
+                       [NSString stringWithFormat:@"attachError = %@", self.attachError],
+                       ];
+
+    return [NSString stringWithFormat:@"<%@>", [props componentsJoinedByString:@"; "]];
+}
+
+@end
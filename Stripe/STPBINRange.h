@@ -21,6 +21,19 @@ NS_ASSUME_NONNULL_BEGIN
 + (NSArray<STPBINRange *> *)binRangesForBrand:(STPCardBrand)brand;
 + (instancetype)mostSpecificBINRangeForNumber:(NSString *)number;
 
+/**
+ Returns the range with the longest prefix out of `binRanges`, e.g. the result
+ of `binRangesForNumber:`.
+ */
++ (nullable instancetype)mostSpecificBINRangeInRanges:(NSArray<STPBINRange *> *)binRanges;
+
+/**
+ The number of leading digits that decide which ranges match a number. Numbers
+ that share this many leading digits (or are equal, if shorter) match the same
+ ranges.
+ */
++ (NSUInteger)maxPrefixLength;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -132,10 +132,23 @@
 }
 
 + (instancetype)mostSpecificBINRangeForNumber:(NSString *)number {
-    NSArray *validRanges = [[self allRanges] filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(STPBINRange *range, __unused NSDictionary *bindings) {
-        return [range matchesNumber:number];
-    }]];
-    return [[validRanges sortedArrayUsingSelector:@selector(compare:)] lastObject];
+    return [self mostSpecificBINRangeInRanges:[self binRangesForNumber:number]];
+}
+
++ (instancetype)mostSpecificBINRangeInRanges:(NSArray<STPBINRange *> *)binRanges {
+    return [[binRanges sortedArrayUsingSelector:@selector(compare:)] lastObject];
+}
+
++ (NSUInteger)maxPrefixLength {
+    static NSUInteger STPBINRangeMaxPrefixLength;
+
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (STPBINRange *range in [self allRanges]) {
+            STPBINRangeMaxPrefixLength = MAX(STPBINRangeMaxPrefixLength, MAX(range.qRangeLow.length, range.qRangeHigh.length));
+        }
+    });
+    return STPBINRangeMaxPrefixLength;
 }
 
 + (NSArray<STPBINRange *> *)binRangesForBrand:(STPCardBrand)brand {
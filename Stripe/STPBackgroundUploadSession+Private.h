@@ -0,0 +1,32 @@
+//
+//  STPBackgroundUploadSession+Private.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPBackgroundUploadSession.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface STPBackgroundUploadSession ()
+
+/**
+ @param identifier     The name `handleEventsForBackgroundURLSession:completionHandler:` answers to.
+ @param configuration  The configuration of the URL session. Tests pass a default configuration, since background sessions need a host app.
+ @param directoryURL   Where request bodies and unclaimed results are kept.
+ */
+- (instancetype)initWithIdentifier:(NSString *)identifier
+                     configuration:(NSURLSessionConfiguration *)configuration
+                      directoryURL:(NSURL *)directoryURL NS_DESIGNATED_INITIALIZER;
+
+/**
+ Cancels all uploads and releases the URL session, which otherwise keeps the
+ upload session alive.
+ */
+- (void)invalidate;
+
+@end
+
+NS_ASSUME_NONNULL_END
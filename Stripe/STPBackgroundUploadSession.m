@@ -0,0 +1,380 @@
+//
+//  STPBackgroundUploadSession.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPBackgroundUploadSession.h"
+#import "STPBackgroundUploadSession+Private.h"
+
+#import "NSError+Stripe.h"
+#import "STPAPIClient+Private.h"
+#import "STPAPIOperation.h"
+#import "STPUploadPreprocessingQueue.h"
+#import "StripeError.h"
+
+static NSString * const SharedSessionIdentifier = @"com.stripe.background-uploads";
+static NSString * const RequestBodyExtension = @"body";
+static NSString * const ResponseExtension = @"json";
+
+@interface STPBackgroundUpload ()
+
+@property (nonatomic, copy, readwrite) NSString *identifier;
+@property (nonatomic, readwrite) STPBackgroundUploadState state;
+@property (nonatomic, readwrite) int64_t countOfBytesSent;
+@property (nonatomic, readwrite) int64_t countOfBytesExpectedToSend;
+@property (nonatomic, strong, nullable, readwrite) STPFile *file;
+@property (nonatomic, strong, nullable, readwrite) NSError *error;
+
+@property (nonatomic, strong, nullable) STPAPIOperation *preprocessingOperation;
+@property (nonatomic, strong, nullable) NSURLSessionTask *task;
+@property (nonatomic, strong) NSMutableArray<STPFileCompletionBlock> *completions;
+
+@end
+
+@implementation STPBackgroundUpload
+
+- (instancetype)initWithIdentifier:(NSString *)identifier {
+    self = [super init];
+    if (self) {
+        _identifier = [identifier copy];
+        _state = STPBackgroundUploadStateUploading;
+        _completions = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (NSString *)description {
+    NSArray *props = @[
+                       // Object
+                       [NSString stringWithFormat:@"%@: %p", NSStringFromClass([self class]), self],
+
+                       // Identifier
+                       [NSString stringWithFormat:@"identifier = %@", self.identifier],
+
+                       // State
+                       [NSString stringWithFormat:@"state = %ld", (long)self.state],
+                       [NSString stringWithFormat:@"countOfBytesSent = %lld", self.countOfBytesSent],
+                       [NSString stringWithFormat:@"countOfBytesExpectedToSend = %lld", self.countOfBytesExpectedToSend],
+                       ];
+
+    return [NSString stringWithFormat:@"<%@>", [props componentsJoinedByString:@"; "]];
+}
+
+@end
+
+@interface STPBackgroundUploadSession () <NSURLSessionDataDelegate>
+
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) NSURLSession *urlSession;
+@property (nonatomic, strong) NSMutableArray<STPBackgroundUpload *> *mutableUploads;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSMutableData *> *responseDataByTaskIdentifier;
+@property (nonatomic, copy, nullable) void (^backgroundEventsCompletionHandler)(void);
+
+@end
+
+@implementation STPBackgroundUploadSession
+
++ (instancetype)sharedSession {
+    static STPBackgroundUploadSession *sharedSession;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration backgroundSessionConfigurationWithIdentifier:SharedSessionIdentifier];
+        configuration.sessionSendsLaunchEvents = YES;
+        NSURL *applicationSupportURL = [[NSFileManager defaultManager] URLsForDirectory:NSApplicationSupportDirectory inDomains:NSUserDomainMask].firstObject;
+        NSURL *directoryURL = [applicationSupportURL URLByAppendingPathComponent:SharedSessionIdentifier isDirectory:YES];
+        sharedSession = [[self alloc] initWithIdentifier:SharedSessionIdentifier
+                                           configuration:configuration
+                                            directoryURL:directoryURL];
+    });
+    return sharedSession;
+}
+
+- (instancetype)initWithIdentifier:(NSString *)identifier
+                     configuration:(NSURLSessionConfiguration *)configuration
+                      directoryURL:(NSURL *)directoryURL {
+    self = [super init];
+    if (self) {
+        _identifier = [identifier copy];
+        _directoryURL = directoryURL;
+        _apiClient = [STPAPIClient sharedClient];
+        _mutableUploads = [NSMutableArray array];
+        _responseDataByTaskIdentifier = [NSMutableDictionary dictionary];
+        [[NSFileManager defaultManager] createDirectoryAtURL:directoryURL
+                                 withIntermediateDirectories:YES
+                                                  attributes:nil
+                                                       error:nil];
+        [self restoreFinishedUploads];
+        // Recreating a background session delivers the events of tasks that
+        // finished while we weren't running
+        _urlSession = [NSURLSession sessionWithConfiguration:configuration
+                                                    delegate:self
+                                               delegateQueue:[NSOperationQueue mainQueue]];
+        [self restoreRunningUploads];
+    }
+    return self;
+}
+
+- (void)invalidate {
+    [self.urlSession invalidateAndCancel];
+}
+
+- (NSArray<STPBackgroundUpload *> *)uploads {
+    return [self.mutableUploads copy];
+}
+
+#pragma mark - Uploading
+
+- (STPBackgroundUpload *)uploadImage:(UIImage *)image
+                             purpose:(STPFilePurpose)purpose
+                          completion:(STPFileCompletionBlock)completion {
+    STPBackgroundUpload *upload = [[STPBackgroundUpload alloc] initWithIdentifier:[NSUUID UUID].UUIDString];
+    if (completion) {
+        [upload.completions addObject:[completion copy]];
+    }
+    [self.mutableUploads addObject:upload];
+
+    NSURL *bodyURL = [self URLForUploadWithIdentifier:upload.identifier extension:RequestBodyExtension];
+    STPAPIClient *apiClient = self.apiClient;
+    upload.preprocessingOperation = [[STPUploadPreprocessingQueue sharedQueue] addJobWithCost:[STPUploadPreprocessingQueue estimatedCostOfEncodingImage:image] block:^id{
+        NSMutableURLRequest *request = [apiClient fileUploadRequestForImage:image purpose:purpose];
+        NSError *writeError = nil;
+        // Uploads may continue while the device is locked
+        if (![request.HTTPBody writeToURL:bodyURL options:(NSDataWritingAtomic | NSDataWritingFileProtectionCompleteUntilFirstUserAuthentication) error:&writeError]) {
+            return writeError;
+        }
+        return request;
+    } completion:^(id result, NSError *error) {
+        upload.preprocessingOperation = nil;
+        if (error || [result isKindOfClass:[NSError class]]) {
+            [self finishUpload:upload withResponse:nil error:error ?: result];
+            return;
+        }
+
+        NSMutableURLRequest *request = result;
+        upload.countOfBytesExpectedToSend = (int64_t)request.HTTPBody.length;
+        // Background sessions can only upload from a file
+        request.HTTPBody = nil;
+        NSURLSessionUploadTask *task = [self.urlSession uploadTaskWithRequest:request fromFile:bodyURL];
+        task.taskDescription = upload.identifier;
+        upload.task = task;
+        [task resume];
+    }];
+    return upload;
+}
+
+- (void)addCompletion:(STPFileCompletionBlock)completion forUploadWithIdentifier:(NSString *)identifier {
+    STPBackgroundUpload *upload = [self uploadWithIdentifier:identifier];
+    if (!upload) {
+        NSDictionary *userInfo = @{
+                                   NSLocalizedDescriptionKey: [NSError stp_unexpectedErrorMessage],
+                                   STPErrorMessageKey: [NSString stringWithFormat:@"There is no upload with identifier %@. It may have already been passed to a completion block.", identifier],
+                                   };
+        completion(nil, [NSError errorWithDomain:StripeDomain code:STPInvalidRequestError userInfo:userInfo]);
+        return;
+    }
+    [upload.completions addObject:[completion copy]];
+    if (upload.state != STPBackgroundUploadStateUploading) {
+        [self deliverResultOfUpload:upload];
+    }
+}
+
+- (void)cancelUploadWithIdentifier:(NSString *)identifier {
+    STPBackgroundUpload *upload = [self uploadWithIdentifier:identifier];
+    // Either reports the cancellation back to us
+    [upload.preprocessingOperation cancel];
+    [upload.task cancel];
+}
+
+- (BOOL)handleEventsForBackgroundURLSession:(NSString *)identifier completionHandler:(void (^)(void))completionHandler {
+    if (![identifier isEqualToString:self.identifier]) {
+        return NO;
+    }
+    self.backgroundEventsCompletionHandler = completionHandler;
+    return YES;
+}
+
+#pragma mark - Results
+
+- (void)finishUpload:(STPBackgroundUpload *)upload
+        withResponse:(nullable NSDictionary *)response
+               error:(nullable NSError *)error {
+    STPFile *file = [STPFile decodedObjectFromAPIResponse:response];
+    NSError *returnedError = [NSError stp_errorFromStripeResponse:response] ?: error;
+    if (!file && !returnedError) {
+        returnedError = [NSError stp_genericFailedToParseResponseError];
+    }
+
+    [[NSFileManager defaultManager] removeItemAtURL:[self URLForUploadWithIdentifier:upload.identifier extension:RequestBodyExtension] error:nil];
+    upload.task = nil;
+    if (returnedError) {
+        upload.state = STPBackgroundUploadStateFailed;
+        upload.error = returnedError;
+    }
+    else {
+        upload.state = STPBackgroundUploadStateCompleted;
+        upload.file = file;
+    }
+
+    if (upload.completions.count > 0) {
+        [self deliverResultOfUpload:upload];
+    }
+    else if (file) {
+        // Nobody is waiting yet, e.g. because we were launched in the
+        // background, so keep the file around for a later launch. Failures
+        // are only kept in memory; the app can upload again.
+        NSData *data = [NSJSONSerialization dataWithJSONObject:response options:(NSJSONWritingOptions)kNilOptions error:nil];
+        [data writeToURL:[self URLForUploadWithIdentifier:upload.identifier extension:ResponseExtension]
+                 options:(NSDataWritingAtomic | NSDataWritingFileProtectionCompleteUntilFirstUserAuthentication)
+                   error:nil];
+    }
+}
+
+- (void)deliverResultOfUpload:(STPBackgroundUpload *)upload {
+    NSArray<STPFileCompletionBlock> *completions = [upload.completions copy];
+    [upload.completions removeAllObjects];
+    [self.mutableUploads removeObject:upload];
+    [[NSFileManager defaultManager] removeItemAtURL:[self URLForUploadWithIdentifier:upload.identifier extension:ResponseExtension] error:nil];
+    for (STPFileCompletionBlock completion in completions) {
+        completion(upload.file, upload.error);
+    }
+}
+
+#pragma mark - Restoring
+
+- (void)restoreFinishedUploads {
+    NSArray<NSURL *> *fileURLs = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:self.directoryURL
+                                                               includingPropertiesForKeys:nil
+                                                                                  options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                                    error:nil];
+    for (NSURL *fileURL in fileURLs) {
+        if (![fileURL.pathExtension isEqualToString:ResponseExtension]) {
+            continue;
+        }
+        NSData *data = [NSData dataWithContentsOfURL:fileURL];
+        NSDictionary *response = data ? [NSJSONSerialization JSONObjectWithData:data options:(NSJSONReadingOptions)kNilOptions error:nil] : nil;
+        STPFile *file = [STPFile decodedObjectFromAPIResponse:response];
+        if (!file) {
+            [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+            continue;
+        }
+        STPBackgroundUpload *upload = [[STPBackgroundUpload alloc] initWithIdentifier:fileURL.URLByDeletingPathExtension.lastPathComponent];
+        upload.state = STPBackgroundUploadStateCompleted;
+        upload.file = file;
+        [self.mutableUploads addObject:upload];
+    }
+}
+
+- (void)restoreRunningUploads {
+    [self.urlSession getTasksWithCompletionHandler:^(__unused NSArray<NSURLSessionDataTask *> *dataTasks, NSArray<NSURLSessionUploadTask *> *uploadTasks, __unused NSArray<NSURLSessionDownloadTask *> *downloadTasks) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            for (NSURLSessionUploadTask *task in uploadTasks) {
+                if (task.state != NSURLSessionTaskStateCompleted) {
+                    [self uploadForTask:task];
+                }
+            }
+            [self removeOrphanedRequestBodies];
+        });
+    }];
+}
+
+- (void)removeOrphanedRequestBodies {
+    NSArray<NSURL *> *fileURLs = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:self.directoryURL
+                                                               includingPropertiesForKeys:nil
+                                                                                  options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                                    error:nil];
+    for (NSURL *fileURL in fileURLs) {
+        if ([fileURL.pathExtension isEqualToString:RequestBodyExtension]
+            && ![self uploadWithIdentifier:fileURL.URLByDeletingPathExtension.lastPathComponent]) {
+            [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+        }
+    }
+}
+
+#pragma mark - Helpers
+
+- (nullable STPBackgroundUpload *)uploadWithIdentifier:(NSString *)identifier {
+    for (STPBackgroundUpload *upload in self.mutableUploads) {
+        if ([upload.identifier isEqualToString:identifier]) {
+            return upload;
+        }
+    }
+    return nil;
+}
+
+/**
+ The upload a task belongs to. Tasks from an earlier launch get a new upload
+ object with the same identifier.
+ */
+- (nullable STPBackgroundUpload *)uploadForTask:(NSURLSessionTask *)task {
+    NSString *identifier = task.taskDescription;
+    if (!identifier) {
+        return nil;
+    }
+    STPBackgroundUpload *upload = [self uploadWithIdentifier:identifier];
+    if (!upload) {
+        upload = [[STPBackgroundUpload alloc] initWithIdentifier:identifier];
+        [self.mutableUploads addObject:upload];
+    }
+    if (!upload.task && upload.state == STPBackgroundUploadStateUploading) {
+        upload.task = task;
+        upload.countOfBytesSent = task.countOfBytesSent;
+        upload.countOfBytesExpectedToSend = task.countOfBytesExpectedToSend;
+    }
+    return upload;
+}
+
+- (NSURL *)URLForUploadWithIdentifier:(NSString *)identifier extension:(NSString *)extension {
+    return [[self.directoryURL URLByAppendingPathComponent:identifier] URLByAppendingPathExtension:extension];
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)URLSession:(__unused NSURLSession *)session
+              task:(NSURLSessionTask *)task
+   didSendBodyData:(__unused int64_t)bytesSent
+    totalBytesSent:(int64_t)totalBytesSent
+totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend {
+    STPBackgroundUpload *upload = [self uploadForTask:task];
+    upload.countOfBytesSent = totalBytesSent;
+    upload.countOfBytesExpectedToSend = totalBytesExpectedToSend;
+}
+
+- (void)URLSession:(__unused NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
+    NSNumber *taskIdentifier = @(dataTask.taskIdentifier);
+    NSMutableData *responseData = self.responseDataByTaskIdentifier[taskIdentifier];
+    if (!responseData) {
+        responseData = [NSMutableData data];
+        self.responseDataByTaskIdentifier[taskIdentifier] = responseData;
+    }
+    [responseData appendData:data];
+}
+
+- (void)URLSession:(__unused NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error {
+    NSNumber *taskIdentifier = @(task.taskIdentifier);
+    NSData *responseData = self.responseDataByTaskIdentifier[taskIdentifier];
+    [self.responseDataByTaskIdentifier removeObjectForKey:taskIdentifier];
+
+    STPBackgroundUpload *upload = [self uploadForTask:task];
+    if (!upload || upload.state != STPBackgroundUploadStateUploading) {
+        return;
+    }
+    NSDictionary *response = responseData ? [NSJSONSerialization JSONObjectWithData:responseData options:(NSJSONReadingOptions)kNilOptions error:nil] : nil;
+    if (![response isKindOfClass:[NSDictionary class]]) {
+        response = nil;
+    }
+    [self finishUpload:upload withResponse:response error:error];
+}
+
+- (void)URLSessionDidFinishEventsForBackgroundURLSession:(__unused NSURLSession *)session {
+    void (^completionHandler)(void) = self.backgroundEventsCompletionHandler;
+    self.backgroundEventsCompletionHandler = nil;
+    if (completionHandler) {
+        completionHandler();
+    }
+}
+
+@end
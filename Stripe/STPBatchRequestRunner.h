@@ -0,0 +1,66 @@
+//
+//  STPBatchRequestRunner.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "STPBlocks.h"
+
+@class STPAPIOperation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef void (^STPBatchItemCompletionBlock)(id _Nullable object, NSError * _Nullable error);
+
+/**
+ Starts the request for the item at `index` and returns its operation.
+ `completion` must be called on the main queue.
+ */
+typedef STPAPIOperation * _Nonnull (^STPBatchRequestBlock)(NSUInteger index, STPBatchItemCompletionBlock completion);
+
+/**
+ Performs one request per item of a batch with at most `maxConcurrency` in
+ flight, and reports the results in item order.
+
+ Item requests aren't retried by `STPAPIRequest`. Instead, items that are
+ rate limited (HTTP 429) are put back at the front of the queue. The runner
+ then stops starting items for a while, backing off exponentially, and halves
+ its concurrency; each success raises the concurrency by one again, up to
+ `maxConcurrency`.
+
+ All state is kept on the main queue.
+ */
+@interface STPBatchRequestRunner : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithItemCount:(NSUInteger)itemCount
+                   maxConcurrency:(NSUInteger)maxConcurrency
+                          request:(STPBatchRequestBlock)request
+                         progress:(nullable STPBatchProgressBlock)progress
+                       completion:(STPBatchCompletionBlock)completion NS_DESIGNATED_INITIALIZER;
+
+/**
+ The handle returned to the caller. Cancelling it cancels the items in flight
+ and fails the items that haven't started.
+ */
+@property (nonatomic, strong, readonly) STPAPIOperation *operation;
+
+/**
+ The back-off after the first rate limited response, in seconds. Doubles
+ with each consecutive rate limited response. Defaults to 1.
+ */
+@property (nonatomic) NSTimeInterval initialBackoff;
+
+/**
+ Starts the batch. May be called from any thread.
+ */
+- (void)start;
+
+@end
+
+NS_ASSUME_NONNULL_END
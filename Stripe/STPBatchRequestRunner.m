@@ -0,0 +1,201 @@
+//
+//  STPBatchRequestRunner.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPBatchRequestRunner.h"
+
+#import "STPAPIOperation+Private.h"
+#import "STPBatchResult+Private.h"
+#import "STPDispatchFunctions.h"
+#import "StripeError.h"
+
+static NSString * const RateLimitErrorCode = @"rate_limit";
+static const NSTimeInterval DefaultInitialBackoff = 1;
+static const NSTimeInterval MaxBackoff = 16;
+static const NSUInteger MaxRateLimitedAttempts = 3;
+
+@interface STPBatchRequestRunner ()
+
+@property (nonatomic) NSUInteger itemCount;
+@property (nonatomic) NSUInteger maxConcurrency;
+@property (nonatomic, copy) STPBatchRequestBlock request;
+@property (nonatomic, copy, nullable) STPBatchProgressBlock progress;
+@property (nonatomic, copy, nullable) STPBatchCompletionBlock completion;
+@property (nonatomic, strong, readwrite) STPAPIOperation *operation;
+
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *pendingIndexes;
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *rateLimitedAttempts;
+@property (nonatomic, strong) NSMutableArray *results;
+@property (nonatomic, strong) STPBatchMetrics *metrics;
+@property (nonatomic) NSUInteger completedCount;
+@property (nonatomic) NSUInteger inFlightCount;
+@property (nonatomic) NSUInteger concurrencyLimit;
+@property (nonatomic) NSTimeInterval backoff;
+@property (nonatomic) BOOL pausedForBackoff;
+@property (nonatomic) NSTimeInterval startTime;
+
+@end
+
+@implementation STPBatchRequestRunner
+
+- (instancetype)initWithItemCount:(NSUInteger)itemCount
+                   maxConcurrency:(NSUInteger)maxConcurrency
+                          request:(STPBatchRequestBlock)request
+                         progress:(STPBatchProgressBlock)progress
+                       completion:(STPBatchCompletionBlock)completion {
+    self = [super init];
+    if (self) {
+        _itemCount = itemCount;
+        _maxConcurrency = MAX(maxConcurrency, (NSUInteger)1);
+        _concurrencyLimit = _maxConcurrency;
+        _request = [request copy];
+        _progress = [progress copy];
+        _completion = [completion copy];
+        _initialBackoff = DefaultInitialBackoff;
+        // Batches are background work, so interactive requests go first
+        _operation = [[STPAPIOperation alloc] initGroupWithPriority:STPAPIOperationPriorityLow];
+        _pendingIndexes = [NSMutableArray arrayWithCapacity:itemCount];
+        _rateLimitedAttempts = [NSMutableArray arrayWithCapacity:itemCount];
+        _results = [NSMutableArray arrayWithCapacity:itemCount];
+        for (NSUInteger i = 0; i < itemCount; i++) {
+            [_pendingIndexes addObject:@(i)];
+            [_rateLimitedAttempts addObject:@0];
+            [_results addObject:[NSNull null]];
+        }
+        _metrics = [[STPBatchMetrics alloc] initWithItemCount:itemCount];
+    }
+    return self;
+}
+
+- (void)start {
+    stpDispatchToMainThreadIfNecessary(^{
+        self.startTime = [NSProcessInfo processInfo].systemUptime;
+        self.operation.cancellationHandler = ^{
+            // Async, since -cancel may be called from within one of our callbacks
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [self startItemsIfPossible];
+            });
+        };
+        if (self.itemCount == 0) {
+            [self finish];
+            return;
+        }
+        [self startItemsIfPossible];
+    });
+}
+
+#pragma mark - Scheduling
+
+- (void)startItemsIfPossible {
+    if (self.completion == nil) {
+        return;
+    }
+    if (self.operation.isCancelled) {
+        // Fail everything that hasn't started; in-flight items report their own cancellation
+        NSArray<NSNumber *> *pendingIndexes = [self.pendingIndexes copy];
+        [self.pendingIndexes removeAllObjects];
+        for (NSNumber *index in pendingIndexes) {
+            [self recordResultAtIndex:index.unsignedIntegerValue object:nil error:[STPAPIOperation cancelledError]];
+        }
+        return;
+    }
+    if (self.pausedForBackoff) {
+        return;
+    }
+
+    while (self.inFlightCount < self.concurrencyLimit && self.pendingIndexes.count > 0) {
+        NSUInteger index = self.pendingIndexes.firstObject.unsignedIntegerValue;
+        [self.pendingIndexes removeObjectAtIndex:0];
+        self.inFlightCount++;
+        self.metrics.peakConcurrency = MAX(self.metrics.peakConcurrency, self.inFlightCount);
+
+        __block __weak STPAPIOperation *weakItemOperation = nil;
+        __block STPAPIOperation *itemOperation = nil;
+        // Our back-off is the only retry, so that a rate limited item isn't
+        // also retried by its request (and sent up to 3 x 3 times)
+        [STPAPIOperation performWithoutRetries:^{
+            itemOperation = self.request(index, ^(id object, NSError *error) {
+                if (weakItemOperation) {
+                    [self.operation removeChildOperation:weakItemOperation];
+                }
+                self.inFlightCount--;
+                [self handleResultAtIndex:index object:object error:error];
+            });
+        }];
+        weakItemOperation = itemOperation;
+        [self.operation addChildOperation:itemOperation];
+    }
+}
+
+- (void)handleResultAtIndex:(NSUInteger)index object:(id)object error:(NSError *)error {
+    NSUInteger attempts = self.rateLimitedAttempts[index].unsignedIntegerValue;
+    if ([self isRateLimitError:error]
+        && attempts + 1 < MaxRateLimitedAttempts
+        && !self.operation.isCancelled) {
+        self.rateLimitedAttempts[index] = @(attempts + 1);
+        self.metrics.rateLimitedCount++;
+        [self.pendingIndexes insertObject:@(index) atIndex:0];
+        self.concurrencyLimit = MAX(self.concurrencyLimit / 2, (NSUInteger)1);
+        [self backOff];
+        return;
+    }
+
+    if (!error) {
+        self.backoff = 0;
+        self.concurrencyLimit = MIN(self.concurrencyLimit + 1, self.maxConcurrency);
+    }
+    [self recordResultAtIndex:index object:object error:error];
+    [self startItemsIfPossible];
+}
+
+- (void)backOff {
+    if (self.pausedForBackoff) {
+        // Items that were already in flight when we started backing off
+        return;
+    }
+    self.backoff = (self.backoff == 0) ? self.initialBackoff : MIN(self.backoff * 2, MaxBackoff);
+    self.pausedForBackoff = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.backoff * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        self.pausedForBackoff = NO;
+        [self startItemsIfPossible];
+    });
+}
+
+- (BOOL)isRateLimitError:(NSError *)error {
+    return [error.domain isEqualToString:StripeDomain]
+        && [error.userInfo[STPStripeErrorCodeKey] isEqualToString:RateLimitErrorCode];
+}
+
+#pragma mark - Results
+
+- (void)recordResultAtIndex:(NSUInteger)index object:(id)object error:(NSError *)error {
+    self.results[index] = [[STPBatchItemResult alloc] initWithObject:(error ? nil : object) error:error];
+    if (error) {
+        self.metrics.failureCount++;
+    }
+    self.completedCount++;
+    if (self.progress) {
+        self.progress(self.completedCount, self.itemCount);
+    }
+    if (self.completedCount == self.itemCount) {
+        [self finish];
+    }
+}
+
+- (void)finish {
+    STPBatchCompletionBlock completion = self.completion;
+    if (!completion) {
+        return;
+    }
+    self.completion = nil;
+    self.progress = nil;
+    self.metrics.duration = [NSProcessInfo processInfo].systemUptime - self.startTime;
+    [self.operation markFinished];
+    completion([self.results copy], self.metrics);
+}
+
+@end
@@ -0,0 +1,30 @@
+//
+//  STPBatchResult+Private.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPBatchResult.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface STPBatchItemResult ()
+
+- (instancetype)initWithObject:(nullable id)object error:(nullable NSError *)error NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@interface STPBatchMetrics ()
+
+- (instancetype)initWithItemCount:(NSUInteger)itemCount NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readwrite) NSUInteger failureCount;
+@property (nonatomic, readwrite) NSUInteger rateLimitedCount;
+@property (nonatomic, readwrite) NSUInteger peakConcurrency;
+@property (nonatomic, readwrite) NSTimeInterval duration;
+
+@end
+
+NS_ASSUME_NONNULL_END
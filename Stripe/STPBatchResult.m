@@ -0,0 +1,71 @@
+//
+//  STPBatchResult.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPBatchResult.h"
+#import "STPBatchResult+Private.h"
+
+@implementation STPBatchItemResult
+
+- (instancetype)initWithObject:(id)object error:(NSError *)error {
+    self = [super init];
+    if (self) {
+        _object = object;
+        _error = error;
+    }
+    return self;
+}
+
+- (NSString *)description {
+    NSArray *props = @[
+                       // Object
+                       [NSString stringWithFormat:@"%@: %p", NSStringFromClass([self class]), self],
+
+                       // Result
+                       [NSString stringWithFormat:@"object = %@", self.object],
+                       [NSString stringWithFormat:@"error = %@", self.error],
+                       ];
+
+    return [NSString stringWithFormat:@"<%@>", [props componentsJoinedByString:@"; "]];
+}
+
+@end
+
+@implementation STPBatchMetrics
+
+- (instancetype)initWithItemCount:(NSUInteger)itemCount {
+    self = [super init];
+    if (self) {
+        _itemCount = itemCount;
+    }
+    return self;
+}
+
+- (double)throughput {
+    return self.duration > 0 ? self.itemCount / self.duration : 0;
+}
+
+- (NSString *)description {
+    NSArray *props = @[
+                       // Object
+                       [NSString stringWithFormat:@"%@: %p", NSStringFromClass([self class]), self],
+
+                       // Counts
+                       [NSString stringWithFormat:@"itemCount = %lu", (unsigned long)self.itemCount],
+                       [NSString stringWithFormat:@"failureCount = %lu", (unsigned long)self.failureCount],
+                       [NSString stringWithFormat:@"rateLimitedCount = %lu", (unsigned long)self.rateLimitedCount],
+                       [NSString stringWithFormat:@"peakConcurrency = %lu", (unsigned long)self.peakConcurrency],
+
+                       // Timing
+                       [NSString stringWithFormat:@"duration = %.4f", self.duration],
+                       [NSString stringWithFormat:@"throughput = %.2f", self.throughput],
+                       ];
+
+    return [NSString stringWithFormat:@"<%@>", [props componentsJoinedByString:@"; "]];
+}
+
+@end
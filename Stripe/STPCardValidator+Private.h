@@ -8,12 +8,28 @@
 
 #import "STPCardValidator.h"
 
+@class STPBINRange;
+
 NS_ASSUME_NONNULL_BEGIN
 
 @interface STPCardValidator (Private)
 
 + (NSArray<NSNumber *> *)cardNumberFormatForBrand:(STPCardBrand)brand;
 
+/**
+ The brand shared by all the known-brand ranges in `binRanges`, or
+ STPCardBrandUnknown if there is more than one (or none).
+ */
++ (STPCardBrand)brandForBINRanges:(NSArray<STPBINRange *> *)binRanges;
+
+/**
+ Like `validationStateForNumber:validatingCardBrand:`, for a number that is
+ already sanitized and whose most specific BIN range has already been looked up.
+ */
++ (STPCardValidationState)validationStateForSanitizedNumber:(nullable NSString *)sanitizedNumber
+                                                   binRange:(nullable STPBINRange *)binRange
+                                        validatingCardBrand:(BOOL)validatingCardBrand;
+
 @end
 
 NS_ASSUME_NONNULL_END
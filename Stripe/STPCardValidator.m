@@ -10,6 +10,7 @@
 #import "STPCardValidator+Private.h"
 
 #import "STPBINRange.h"
+#import "STPClock.h"
 #import "NSCharacterSet+Stripe.h"
 
 @implementation STPCardValidator
@@ -143,7 +144,17 @@ static NSString * _Nonnull stringByRemovingCharactersFromSet(NSString * _Nonnull
     if (![self stringIsNumeric:sanitizedNumber]) {
         return STPCardValidationStateInvalid;
     }
-    STPBINRange *binRange = [STPBINRange mostSpecificBINRangeForNumber:sanitizedNumber];
+    return [self validationStateForSanitizedNumber:sanitizedNumber
+                                          binRange:[STPBINRange mostSpecificBINRangeForNumber:sanitizedNumber]
+                               validatingCardBrand:validatingCardBrand];
+}
+
++ (STPCardValidationState)validationStateForSanitizedNumber:(NSString *)sanitizedNumber
+                                                   binRange:(STPBINRange *)binRange
+                                        validatingCardBrand:(BOOL)validatingCardBrand {
+    if (sanitizedNumber.length == 0) {
+        return STPCardValidationStateIncomplete;
+    }
     if (binRange.brand == STPCardBrandUnknown && validatingCardBrand) {
         return STPCardValidationStateInvalid;
     }
@@ -208,15 +219,18 @@ static NSString * _Nonnull stringByRemovingCharactersFromSet(NSString * _Nonnull
 
 + (STPCardBrand)brandForNumber:(NSString *)cardNumber {
     NSString *sanitizedNumber = [self sanitizedNumericStringForString:cardNumber];
-    NSSet *brands = [self possibleBrandsForNumber:sanitizedNumber];
+    return [self brandForBINRanges:[STPBINRange binRangesForNumber:sanitizedNumber]];
+}
+
++ (STPCardBrand)brandForBINRanges:(NSArray<STPBINRange *> *)binRanges {
+    NSSet *brands = [self possibleBrandsForBINRanges:binRanges];
     if (brands.count == 1) {
         return (STPCardBrand)[brands.anyObject integerValue];
     }
     return STPCardBrandUnknown;
 }
 
-+ (NSSet *)possibleBrandsForNumber:(NSString *)cardNumber {
-    NSArray<STPBINRange *> *binRanges = [STPBINRange binRangesForNumber:cardNumber];
++ (NSSet *)possibleBrandsForBINRanges:(NSArray<STPBINRange *> *)binRanges {
     NSMutableSet *possibleBrands = [NSMutableSet setWithArray:[binRanges valueForKeyPath:@"brand"]];
     [possibleBrands removeObject:@(STPCardBrandUnknown)];
     return [possibleBrands copy];
@@ -265,15 +279,11 @@ static NSString * _Nonnull stringByRemovingCharactersFromSet(NSString * _Nonnull
 }
 
 + (NSInteger)currentYear {
-    NSCalendar *calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateComponents *dateComponents = [calendar components:NSCalendarUnitYear fromDate:[NSDate date]];
-    return dateComponents.year % 100;
+    return [STPClock sharedClock].currentYear % 100;
 }
 
 + (NSInteger)currentMonth {
-    NSCalendar *calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateComponents *dateComponents = [calendar components:NSCalendarUnitMonth fromDate:[NSDate date]];
-    return dateComponents.month;
+    return [STPClock sharedClock].currentMonth;
 }
 
 @end
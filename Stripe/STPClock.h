@@ -0,0 +1,64 @@
+//
+//  STPClock.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Where the SDK gets the time. Code that reads the date, measures an interval
+ or schedules a timer asks the shared clock rather than `NSDate` or `NSTimer`,
+ so that tests can swap in a virtual clock and move time forward without
+ waiting.
+ */
+@interface STPClock : NSObject
+
+/**
+ The clock the SDK uses. Defaults to one backed by the system clock.
+ */
++ (STPClock *)sharedClock;
+
+/**
+ Replaces the shared clock. Pass nil to go back to the system clock.
+ */
++ (void)setSharedClock:(nullable STPClock *)clock;
+
+/**
+ The current wall-clock date. Use it to compare against dates from the API,
+ such as expiry dates.
+ */
+- (NSDate *)currentDate;
+
+/**
+ Seconds on a clock that only moves forward, even when the user changes the
+ date. Use it to measure intervals.
+ */
+- (NSTimeInterval)monotonicTime;
+
+/**
+ Schedules a non-repeating timer on the current run loop, after `interval`
+ seconds of this clock's time.
+ */
+- (NSTimer *)scheduledTimerWithTimeInterval:(NSTimeInterval)interval
+                                     target:(id)target
+                                   selector:(SEL)selector;
+
+/**
+ The Gregorian year of `currentDate`, e.g. 2026. Calendar math only happens
+ when the day changes, so this is cheap enough to read on every keystroke.
+ */
+@property (nonatomic, readonly) NSInteger currentYear;
+
+/**
+ The Gregorian month of `currentDate`, from 1 to 12. Cached like `currentYear`.
+ */
+@property (nonatomic, readonly) NSInteger currentMonth;
+
+@end
+
+NS_ASSUME_NONNULL_END
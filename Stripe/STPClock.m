@@ -0,0 +1,127 @@
+//
+//  STPClock.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPClock.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+static STPClock *STPSharedClockOverride;
+
+@interface STPClock ()
+
+@property (nonatomic, nullable) NSCalendar *calendar;
+@property (nonatomic) NSInteger cachedYear;
+@property (nonatomic) NSInteger cachedMonth;
+/**
+ The cached year and month are good for dates in [cacheStart, cacheEnd),
+ i.e. the day they were computed on, in seconds since the reference date.
+ */
+@property (nonatomic) NSTimeInterval cacheStart;
+@property (nonatomic) NSTimeInterval cacheEnd;
+
+@end
+
+@implementation STPClock
+
++ (STPClock *)sharedClock {
+    static STPClock *systemClock;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        systemClock = [STPClock new];
+    });
+    @synchronized ([STPClock class]) {
+        return STPSharedClockOverride ?: systemClock;
+    }
+}
+
++ (void)setSharedClock:(nullable STPClock *)clock {
+    @synchronized ([STPClock class]) {
+        STPSharedClockOverride = clock;
+    }
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(resetYearAndMonth)
+                                                     name:NSSystemTimeZoneDidChangeNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (NSDate *)currentDate {
+    return [NSDate date];
+}
+
+- (NSTimeInterval)monotonicTime {
+    return [NSProcessInfo processInfo].systemUptime;
+}
+
+- (NSTimer *)scheduledTimerWithTimeInterval:(NSTimeInterval)interval
+                                     target:(id)target
+                                   selector:(SEL)selector {
+    return [NSTimer scheduledTimerWithTimeInterval:interval
+                                            target:target
+                                          selector:selector
+                                          userInfo:nil
+                                           repeats:NO];
+}
+
+#pragma mark - Year and month
+
+- (NSInteger)currentYear {
+    @synchronized (self) {
+        [self updateYearAndMonthIfNeeded];
+        return self.cachedYear;
+    }
+}
+
+- (NSInteger)currentMonth {
+    @synchronized (self) {
+        [self updateYearAndMonthIfNeeded];
+        return self.cachedMonth;
+    }
+}
+
+- (void)updateYearAndMonthIfNeeded {
+    NSDate *date = [self currentDate];
+    NSTimeInterval time = date.timeIntervalSinceReferenceDate;
+    if (time >= self.cacheStart && time < self.cacheEnd) {
+        return;
+    }
+    if (!self.calendar) {
+        self.calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    }
+    NSDateComponents *dateComponents = [self.calendar components:(NSCalendarUnitYear | NSCalendarUnitMonth) fromDate:date];
+    self.cachedYear = dateComponents.year;
+    self.cachedMonth = dateComponents.month;
+
+    NSDate *startOfDay = [self.calendar startOfDayForDate:date];
+    NSDate *startOfNextDay = [self.calendar dateByAddingUnit:NSCalendarUnitDay value:1 toDate:startOfDay options:(NSCalendarOptions)0];
+    self.cacheStart = startOfDay.timeIntervalSinceReferenceDate;
+    self.cacheEnd = startOfNextDay.timeIntervalSinceReferenceDate;
+}
+
+- (void)resetYearAndMonth {
+    @synchronized (self) {
+        // The calendar kept the old time zone, and days start at a different time now
+        self.calendar = nil;
+        self.cacheStart = 0;
+        self.cacheEnd = 0;
+    }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -21,6 +21,23 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)updateSourcesFilteringApplePay:(BOOL)filterApplePay;
 
+/**
+ The customer's `sources` are only the first page of them. If there are more,
+ this is the ID to pass as `starting_after` to list the rest; otherwise it's nil.
+ */
+@property (nonatomic, readonly, nullable) NSString *nextSourcesPageCursor;
+
+/**
+ Decodes an entry of a customer's sources list, which can be a card or a
+ source. Returns nil for other kinds of objects.
+ */
++ (nullable id<STPSourceProtocol>)decodedSourceFromAPIResponse:(id)response;
+
+/**
+ Whether `source` is a card, or a card source, that was created with Apple Pay.
+ */
++ (BOOL)isApplePaySource:(id<STPSourceProtocol>)source;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -24,6 +24,12 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (STPPaymentMethodTuple *)filteredSourceTupleForUIWithConfiguration:(STPPaymentConfiguration *)configuration;
 
+/**
+ The sources in `sources` of the types supported by
+ STPPaymentContext/STPPaymentMethodsViewController, in the same order.
+ */
++ (NSArray<id<STPPaymentMethod>> *)filteredPaymentMethodsForUIFromSources:(NSArray<id<STPSourceProtocol>> *)sources;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -19,30 +19,33 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (STPPaymentMethodTuple *)filteredSourceTupleForUIWithConfiguration:(STPPaymentConfiguration *)configuration {
     id<STPPaymentMethod> _Nullable selectedMethod = nil;
+    NSArray<id<STPPaymentMethod>> *methods = [[self class] filteredPaymentMethodsForUIFromSources:self.sources];
+    for (id<STPPaymentMethod> method in methods) {
+        if ([((id<STPSourceProtocol>)method).stripeID isEqualToString:self.defaultSource.stripeID]) {
+            selectedMethod = method;
+        }
+    }
+
+    return [STPPaymentMethodTuple tupleWithPaymentMethods:methods
+                                    selectedPaymentMethod:selectedMethod
+                                        addApplePayMethod:configuration.applePayEnabled];
+}
+
++ (NSArray<id<STPPaymentMethod>> *)filteredPaymentMethodsForUIFromSources:(NSArray<id<STPSourceProtocol>> *)sources {
     NSMutableArray<id<STPPaymentMethod>> *methods = [NSMutableArray array];
-    for (id<STPSourceProtocol> customerSource in self.sources) {
+    for (id<STPSourceProtocol> customerSource in sources) {
         if ([customerSource isKindOfClass:[STPCard class]]) {
-            STPCard *card = (STPCard *)customerSource;
-            [methods addObject:card];
-            if ([card.stripeID isEqualToString:self.defaultSource.stripeID]) {
-                selectedMethod = card;
-            }
+            [methods addObject:(STPCard *)customerSource];
         }
         else if ([customerSource isKindOfClass:[STPSource class]]) {
             STPSource *source = (STPSource *)customerSource;
             if (source.type == STPSourceTypeCard
                 && source.cardDetails != nil) {
                 [methods addObject:source];
-                if ([source.stripeID isEqualToString:self.defaultSource.stripeID]) {
-                    selectedMethod = source;
-                }
             }
         }
     }
-
-    return [STPPaymentMethodTuple tupleWithPaymentMethods:methods
-                                    selectedPaymentMethod:selectedMethod
-                                        addApplePayMethod:configuration.applePayEnabled];
+    return methods;
 }
 
 @end
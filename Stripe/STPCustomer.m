@@ -7,6 +7,7 @@
 //
 
 #import "STPCustomer.h"
+#import "STPCustomer+Private.h"
 
 #import "NSDictionary+Stripe.h"
 #import "NSError+Stripe.h"
@@ -102,43 +103,58 @@ NS_ASSUME_NONNULL_BEGIN
     NSString *defaultSourceId = [response stp_stringForKey:@"default_source"];
     NSMutableArray *sources = [NSMutableArray new];
     for (id contents in data) {
-        if ([contents isKindOfClass:[NSDictionary class]]) {
-            NSString *object = [contents stp_stringForKey:@"object"];
-            if ([object isEqualToString:@"card"]) {
-                STPCard *card = [STPCard decodedObjectFromAPIResponse:contents];
-                BOOL includeCard = card != nil;
-                // ignore apple pay cards from the response
-                if (filterApplePay && card.isApplePayCard) {
-                    includeCard = NO;
-                }
-                if (includeCard) {
-                    [sources addObject:card];
-                    if (defaultSourceId && [card.stripeID isEqualToString:defaultSourceId]) {
-                        self.defaultSource = card;
-                    }
-                }
-            }
-            else if ([object isEqualToString:@"source"]) {
-                STPSource *source = [STPSource decodedObjectFromAPIResponse:contents];
-                BOOL includeSource = source != nil;
-                // ignore apple pay cards from the response
-                if (filterApplePay && (source.type == STPSourceTypeCard &&
-                                       source.cardDetails != nil &&
-                                       source.cardDetails.isApplePayCard)) {
-                    includeSource = NO;
-                }
-                if (includeSource) {
-                    [sources addObject:source];
-                    if (defaultSourceId && [source.stripeID isEqualToString:defaultSourceId]) {
-                        self.defaultSource = source;
-                    }
-                }
-            }
+        id<STPSourceProtocol> source = [[self class] decodedSourceFromAPIResponse:contents];
+        // ignore apple pay cards from the response
+        if (!source || (filterApplePay && [[self class] isApplePaySource:source])) {
+            continue;
+        }
+        [sources addObject:source];
+        if (defaultSourceId && [source.stripeID isEqualToString:defaultSourceId]) {
+            self.defaultSource = source;
         }
     }
     self.sources = sources;
 }
 
+- (nullable NSString *)nextSourcesPageCursor {
+    NSDictionary *sourcesDict = [self.allResponseFields stp_dictionaryForKey:@"sources"];
+    if (![sourcesDict stp_boolForKey:@"has_more" or:NO]) {
+        return nil;
+    }
+    NSDictionary *lastContents = [[sourcesDict stp_arrayForKey:@"data"] lastObject];
+    if (![lastContents isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    return [lastContents stp_stringForKey:@"id"];
+}
+
++ (nullable id<STPSourceProtocol>)decodedSourceFromAPIResponse:(id)response {
+    if (![response isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    NSString *object = [response stp_stringForKey:@"object"];
+    if ([object isEqualToString:@"card"]) {
+        return [STPCard decodedObjectFromAPIResponse:response];
+    }
+    else if ([object isEqualToString:@"source"]) {
+        return [STPSource decodedObjectFromAPIResponse:response];
+    }
+    return nil;
+}
+
++ (BOOL)isApplePaySource:(id<STPSourceProtocol>)source {
+    if ([source isKindOfClass:[STPCard class]]) {
+        return ((STPCard *)source).isApplePayCard;
+    }
+    else if ([source isKindOfClass:[STPSource class]]) {
+        STPSource *stripeSource = (STPSource *)source;
+        return (stripeSource.type == STPSourceTypeCard &&
+                stripeSource.cardDetails != nil &&
+                stripeSource.cardDetails.isApplePayCard);
+    }
+    return NO;
+}
+
 @end
 
 @interface STPCustomerDeserializer()
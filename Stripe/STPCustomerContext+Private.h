@@ -0,0 +1,43 @@
+//
+//  STPCustomerContext+Private.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPCustomerContext.h"
+
+#import "STPCustomerSourcesPage.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface STPCustomerContext ()
+
+/**
+ Requests a new ephemeral key from the key provider if the current one is
+ missing or about to expire, so that the next request doesn't have to wait for
+ one.
+ */
+- (void)prefetchEphemeralKey;
+
+/**
+ Whether the cached customer was fetched by
+ `+[STPPaymentContext prefetchWithCustomerContext:configuration:]` and hasn't
+ been used by a payment context yet. Cleared by `clearCachedCustomer`.
+ */
+@property (nonatomic) BOOL customerPrefetched;
+
+/**
+ Lists a page of the customer's sources. The page is decoded off the main
+ thread, and `completion` is called on the main thread.
+
+ @param startingAfter  The ID of the last source on the previous page, or nil for the first page.
+ */
+- (void)listSourcesWithLimit:(NSUInteger)limit
+               startingAfter:(nullable NSString *)startingAfter
+                  completion:(STPCustomerSourcesPageCompletionBlock)completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
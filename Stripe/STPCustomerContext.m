@@ -7,11 +7,15 @@
 //
 
 #import "STPCustomerContext.h"
+#import "STPCustomerContext+Private.h"
 
 #import "STPAPIClient+Private.h"
+#import "STPClock.h"
 #import "STPCustomer+Private.h"
+#import "STPCustomerSourcesIterator+Private.h"
 #import "STPEphemeralKey.h"
 #import "STPEphemeralKeyManager.h"
+#import "STPTrace.h"
 #import "STPWeakStrongMacros.h"
 #import "STPDispatchFunctions.h"
 
@@ -46,11 +50,12 @@ static NSTimeInterval const CachedCustomerMaxAge = 60;
 
 - (void)clearCachedCustomer {
     self.customer = nil;
+    self.customerPrefetched = NO;
 }
 
 - (void)setCustomer:(STPCustomer *)customer {
     _customer = customer;
-    _customerRetrievedDate = (customer) ? [NSDate date] : nil;
+    _customerRetrievedDate = (customer) ? [STPClock sharedClock].currentDate : nil;
 }
 
 - (void)setIncludeApplePaySources:(BOOL)includeApplePaySources {
@@ -62,10 +67,14 @@ static NSTimeInterval const CachedCustomerMaxAge = 60;
     if (!self.customer || !self.customerRetrievedDate) {
         return NO;
     }
-    NSDate *now = [NSDate date];
+    NSDate *now = [STPClock sharedClock].currentDate;
     return [now timeIntervalSinceDate:self.customerRetrievedDate] < CachedCustomerMaxAge;
 }
 
+- (void)prefetchEphemeralKey {
+    [self.keyManager getCustomerKey:^(__unused STPEphemeralKey *ephemeralKey, __unused NSError *error) {}];
+}
+
 - (void)retrieveCustomer:(STPCustomerCompletionBlock)completion {
     if ([self shouldUseCachedCustomer]) {
         if (completion) {
@@ -75,6 +84,7 @@ static NSTimeInterval const CachedCustomerMaxAge = 60;
         }
         return;
     }
+    NSTimeInterval traceStartTime = stpTraceBegin();
     [self.keyManager getCustomerKey:^(STPEphemeralKey *ephemeralKey, NSError *retrieveKeyError) {
         if (retrieveKeyError) {
             if (completion) {
@@ -85,6 +95,8 @@ static NSTimeInterval const CachedCustomerMaxAge = 60;
             return;
         }
         [STPAPIClient retrieveCustomerUsingKey:ephemeralKey completion:^(STPCustomer *customer, NSError *error) {
+            // Includes waiting for the ephemeral key
+            stpTraceEnd(traceStartTime, @"customer_retrieve", STPTraceCategoryCustomer);
             if (customer) {
                 [customer updateSourcesFilteringApplePay:!self.includeApplePaySources];
                 self.customer = customer;
@@ -98,6 +110,33 @@ static NSTimeInterval const CachedCustomerMaxAge = 60;
     }];
 }
 
+- (STPCustomerSourcesIterator *)sourcesIteratorWithPageSize:(NSUInteger)pageSize {
+    return [[STPCustomerSourcesIterator alloc] initWithCustomerContext:self pageSize:pageSize startingAfter:nil];
+}
+
+- (void)listSourcesWithLimit:(NSUInteger)limit
+               startingAfter:(NSString *)startingAfter
+                  completion:(STPCustomerSourcesPageCompletionBlock)completion {
+    NSTimeInterval traceStartTime = stpTraceBegin();
+    [self.keyManager getCustomerKey:^(STPEphemeralKey *ephemeralKey, NSError *retrieveKeyError) {
+        if (retrieveKeyError) {
+            stpDispatchToMainThreadIfNecessary(^{
+                completion(nil, retrieveKeyError);
+            });
+            return;
+        }
+        [STPAPIClient listSourcesForCustomerUsingKey:ephemeralKey
+                                               limit:limit
+                                       startingAfter:startingAfter
+                                          completion:^(STPCustomerSourcesPage *page, NSError *error) {
+                                              stpTraceEnd(traceStartTime, @"sources_page_list", STPTraceCategoryCustomer);
+                                              stpDispatchToMainThreadIfNecessary(^{
+                                                  completion(page, error);
+                                              });
+                                          }];
+    }];
+}
+
 - (void)attachSourceToCustomer:(id<STPSourceProtocol>)source completion:(STPErrorBlock)completion {
     [self.keyManager getCustomerKey:^(STPEphemeralKey *ephemeralKey, NSError *retrieveKeyError) {
         if (retrieveKeyError) {
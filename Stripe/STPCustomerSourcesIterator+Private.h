@@ -0,0 +1,27 @@
+//
+//  STPCustomerSourcesIterator+Private.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPCustomerSourcesIterator.h"
+
+@class STPCustomerContext;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface STPCustomerSourcesIterator ()
+
+/**
+ @param startingAfter  The ID of the source to start after, e.g. the last one
+ embedded in a retrieved customer, or nil to start with the newest source.
+ */
+- (instancetype)initWithCustomerContext:(STPCustomerContext *)customerContext
+                               pageSize:(NSUInteger)pageSize
+                          startingAfter:(nullable NSString *)startingAfter NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,100 @@
+//
+//  STPCustomerSourcesIterator.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPCustomerSourcesIterator.h"
+#import "STPCustomerSourcesIterator+Private.h"
+
+#import "STPCustomer+Private.h"
+#import "STPCustomerContext+Private.h"
+#import "STPCustomerSourcesPage.h"
+#import "STPDispatchFunctions.h"
+
+// The API's limits for `limit`
+static const NSUInteger MinPageSize = 1;
+static const NSUInteger MaxPageSize = 100;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface STPCustomerSourcesIterator ()
+
+@property (nonatomic, strong) STPCustomerContext *customerContext;
+@property (nonatomic, readwrite) NSUInteger pageSize;
+@property (nonatomic, copy, readwrite) NSArray<id<STPSourceProtocol>> *sources;
+@property (nonatomic, readwrite) BOOL hasMore;
+@property (nonatomic, readwrite, getter=isLoading) BOOL loading;
+@property (nonatomic, copy, nullable) NSString *startingAfter;
+@property (nonatomic, strong) NSMutableArray<STPSourcesPageCompletionBlock> *pageCompletions;
+
+@end
+
+@implementation STPCustomerSourcesIterator
+
+- (instancetype)initWithCustomerContext:(STPCustomerContext *)customerContext
+                               pageSize:(NSUInteger)pageSize
+                          startingAfter:(nullable NSString *)startingAfter {
+    self = [super init];
+    if (self) {
+        _customerContext = customerContext;
+        _pageSize = MIN(MAX(pageSize, MinPageSize), MaxPageSize);
+        _startingAfter = [startingAfter copy];
+        _sources = @[];
+        _hasMore = YES;
+        _pageCompletions = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)loadNextPage:(nullable STPSourcesPageCompletionBlock)completion {
+    if (completion) {
+        [self.pageCompletions addObject:[completion copy]];
+    }
+    if (self.isLoading) {
+        return;
+    }
+    if (!self.hasMore) {
+        [self finishPageWithSources:@[] error:nil];
+        return;
+    }
+
+    self.loading = YES;
+    [self.customerContext listSourcesWithLimit:self.pageSize
+                                 startingAfter:self.startingAfter
+                                    completion:^(STPCustomerSourcesPage *page, NSError *error) {
+                                        self.loading = NO;
+                                        if (!page) {
+                                            [self finishPageWithSources:nil error:error];
+                                            return;
+                                        }
+
+                                        NSMutableArray<id<STPSourceProtocol>> *sources = [NSMutableArray arrayWithCapacity:page.sources.count];
+                                        for (id<STPSourceProtocol> source in page.sources) {
+                                            if (self.customerContext.includeApplePaySources || ![STPCustomer isApplePaySource:source]) {
+                                                [sources addObject:source];
+                                            }
+                                        }
+                                        self.startingAfter = page.lastObjectID;
+                                        // Without a cursor, asking again would return the first page
+                                        self.hasMore = page.hasMore && page.lastObjectID != nil;
+                                        self.sources = [self.sources arrayByAddingObjectsFromArray:sources];
+                                        [self finishPageWithSources:sources error:nil];
+                                    }];
+}
+
+- (void)finishPageWithSources:(nullable NSArray<id<STPSourceProtocol>> *)sources error:(nullable NSError *)error {
+    NSArray<STPSourcesPageCompletionBlock> *completions = [self.pageCompletions copy];
+    [self.pageCompletions removeAllObjects];
+    stpDispatchToMainThreadIfNecessary(^{
+        for (STPSourcesPageCompletionBlock completion in completions) {
+            completion(sources, error);
+        }
+    });
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,50 @@
+//
+//  STPCustomerSourcesPage.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "STPAPIResponseDecodable.h"
+#import "STPSourceProtocol.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class STPCustomerSourcesPage;
+
+/**
+ A callback to be run with a page of a customer's sources.
+
+ @param page   The page from the response, or nil if an error occurred.
+ @param error  The error returned from the response, or nil if none occurs.
+ */
+typedef void (^STPCustomerSourcesPageCompletionBlock)(STPCustomerSourcesPage * __nullable page, NSError * __nullable error);
+
+/**
+ One page of a customer's sources, as returned by
+ https://stripe.com/docs/api#list_cards
+ */
+@interface STPCustomerSourcesPage : NSObject <STPAPIResponseDecodable>
+
+/**
+ The cards and sources on this page, including any created with Apple Pay.
+ */
+@property (nonatomic, readonly) NSArray<id<STPSourceProtocol>> *sources;
+
+/**
+ Whether there are more sources after this page.
+ */
+@property (nonatomic, readonly) BOOL hasMore;
+
+/**
+ The ID of the last object on this page, to pass as `starting_after` to list
+ the next one. This is set even if the last object couldn't be decoded.
+ */
+@property (nonatomic, readonly, nullable) NSString *lastObjectID;
+
+@end
+
+NS_ASSUME_NONNULL_END
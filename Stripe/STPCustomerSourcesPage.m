@@ -0,0 +1,68 @@
+//
+//  STPCustomerSourcesPage.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPCustomerSourcesPage.h"
+
+#import "NSDictionary+Stripe.h"
+#import "STPCustomer+Private.h"
+
+@interface STPCustomerSourcesPage ()
+@property (nonatomic, copy, readwrite) NSArray<id<STPSourceProtocol>> *sources;
+@property (nonatomic, readwrite) BOOL hasMore;
+@property (nonatomic, copy, nullable, readwrite) NSString *lastObjectID;
+@property (nonatomic, copy, readwrite) NSDictionary *allResponseFields;
+@end
+
+@implementation STPCustomerSourcesPage
+
+#pragma mark - Description
+
+- (NSString *)description {
+    NSArray *props = @[
+                       // Object
+                       [NSString stringWithFormat:@"%@: %p", NSStringFromClass([self class]), self],
+
+                       // Sources
+                       [NSString stringWithFormat:@"sources = %@", self.sources],
+                       [NSString stringWithFormat:@"hasMore = %@", (self.hasMore) ? @"YES" : @"NO"],
+                       ];
+
+    return [NSString stringWithFormat:@"<%@>", [props componentsJoinedByString:@"; "]];
+}
+
+#pragma mark - STPAPIResponseDecodable
+
++ (nullable instancetype)decodedObjectFromAPIResponse:(nullable NSDictionary *)response {
+    NSDictionary *dict = [response stp_dictionaryByRemovingNulls];
+    NSArray *data = [dict stp_arrayForKey:@"data"];
+
+    // required fields
+    if (!data || ![[dict stp_stringForKey:@"object"] isEqualToString:@"list"]) {
+        return nil;
+    }
+
+    NSMutableArray<id<STPSourceProtocol>> *sources = [NSMutableArray arrayWithCapacity:data.count];
+    for (id contents in data) {
+        id<STPSourceProtocol> source = [STPCustomer decodedSourceFromAPIResponse:contents];
+        if (source) {
+            [sources addObject:source];
+        }
+    }
+
+    STPCustomerSourcesPage *page = [self new];
+    page.sources = sources;
+    page.hasMore = [dict stp_boolForKey:@"has_more" or:NO];
+    id lastContents = data.lastObject;
+    if ([lastContents isKindOfClass:[NSDictionary class]]) {
+        page.lastObjectID = [lastContents stp_stringForKey:@"id"];
+    }
+    page.allResponseFields = dict;
+    return page;
+}
+
+@end
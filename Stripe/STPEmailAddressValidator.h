@@ -7,10 +7,18 @@
 //
 
 #import <Foundation/Foundation.h>
+#import "STPCardValidationState.h"
 
 @interface STPEmailAddressValidator : NSObject
 
 + (BOOL)stringIsValidPartialEmailAddress:(nullable NSString *)string;
 + (BOOL)stringIsValidEmailAddress:(nullable NSString *)string;
 
+/**
+ Returns STPCardValidationStateValid for a complete email address,
+ STPCardValidationStateIncomplete if more typing could still make it one, and
+ STPCardValidationStateInvalid otherwise. A nil string is incomplete.
+ */
++ (STPCardValidationState)validationStateForEmailAddress:(nullable NSString *)string;
+
 @end
@@ -8,20 +8,132 @@
 
 #import "STPEmailAddressValidator.h"
 
+/*
+ These validate the language of the regex from
+ http://www.regular-expressions.info/email.html, matched case-insensitively:
+
+ [a-z0-9!#$%&'*+/=?^_`{|}~-]+(?:\.[a-z0-9!#$%&'*+/=?^_`{|}~-]+)*@(?:[a-z0-9](?:[a-z0-9-]*[a-z0-9])?\.)+[a-z0-9](?:[a-z0-9-]*[a-z0-9])?
+
+ They're called on every keystroke, so rather than building a predicate each
+ time we run the equivalent state machine over the characters in one pass.
+ */
+typedef NS_ENUM(NSInteger, STPEmailAddressParseState) {
+    STPEmailAddressParseStateLocalPartStart,
+    STPEmailAddressParseStateLocalPart,
+    STPEmailAddressParseStateLocalPartDot,
+    STPEmailAddressParseStateDomainLabelStart,
+    STPEmailAddressParseStateDomainLabel,
+    STPEmailAddressParseStateDomainLabelHyphen,
+    STPEmailAddressParseStateInvalid,
+};
+
+// Lowercases to 'k', so the regex matched it as one
+static const unichar KelvinSign = 0x212A;
+
+static BOOL characterIsAlphanumeric(unichar c) {
+    return ((c >= 'a' && c <= 'z')
+            || (c >= 'A' && c <= 'Z')
+            || (c >= '0' && c <= '9')
+            || c == KelvinSign);
+}
+
+static BOOL characterIsLocalPartCharacter(unichar c) {
+    if (characterIsAlphanumeric(c)) {
+        return YES;
+    }
+    switch (c) {
+        case '!': case '#': case '$': case '%': case '&': case '\'': case '*':
+        case '+': case '/': case '=': case '?': case '^': case '_': case '`':
+        case '{': case '|': case '}': case '~': case '-':
+            return YES;
+        default:
+            return NO;
+    }
+}
+
+static STPEmailAddressParseState nextParseState(STPEmailAddressParseState state, unichar c, BOOL *domainHasDot) {
+    switch (state) {
+        case STPEmailAddressParseStateLocalPartStart:
+        case STPEmailAddressParseStateLocalPartDot:
+            return characterIsLocalPartCharacter(c) ? STPEmailAddressParseStateLocalPart : STPEmailAddressParseStateInvalid;
+        case STPEmailAddressParseStateLocalPart:
+            if (characterIsLocalPartCharacter(c)) {
+                return STPEmailAddressParseStateLocalPart;
+            }
+            else if (c == '.') {
+                return STPEmailAddressParseStateLocalPartDot;
+            }
+            else if (c == '@') {
+                return STPEmailAddressParseStateDomainLabelStart;
+            }
+            return STPEmailAddressParseStateInvalid;
+        case STPEmailAddressParseStateDomainLabelStart:
+            return characterIsAlphanumeric(c) ? STPEmailAddressParseStateDomainLabel : STPEmailAddressParseStateInvalid;
+        case STPEmailAddressParseStateDomainLabel:
+        case STPEmailAddressParseStateDomainLabelHyphen:
+            if (characterIsAlphanumeric(c)) {
+                return STPEmailAddressParseStateDomainLabel;
+            }
+            else if (c == '-') {
+                return STPEmailAddressParseStateDomainLabelHyphen;
+            }
+            else if (c == '.' && state == STPEmailAddressParseStateDomainLabel) {
+                *domainHasDot = YES;
+                return STPEmailAddressParseStateDomainLabelStart;
+            }
+            return STPEmailAddressParseStateInvalid;
+        case STPEmailAddressParseStateInvalid:
+            return STPEmailAddressParseStateInvalid;
+    }
+}
+
 @implementation STPEmailAddressValidator
 
 + (BOOL)stringIsValidPartialEmailAddress:(nullable NSString *)string {
-    return [[string mutableCopy] replaceOccurrencesOfString:@"@" withString:@"" options:NSLiteralSearch range:NSMakeRange(0, string.length)] <= 1;
+    CFIndex length = (CFIndex)string.length;
+    if (length == 0) {
+        return YES;
+    }
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer((__bridge CFStringRef)string, &buffer, CFRangeMake(0, length));
+    NSUInteger atSignCount = 0;
+    for (CFIndex i = 0; i < length; i++) {
+        if (CFStringGetCharacterFromInlineBuffer(&buffer, i) == '@' && ++atSignCount > 1) {
+            return NO;
+        }
+    }
+    return YES;
 }
 
 + (BOOL)stringIsValidEmailAddress:(NSString *)string {
     if (!string) {
         return NO;
     }
-    // regex from http://www.regular-expressions.info/email.html
-    NSString *pattern = @"[a-z0-9!#$%&'*+/=?^_`{|}~-]+(?:\\.[a-z0-9!#$%&'*+/=?^_`{|}~-]+)*@(?:[a-z0-9](?:[a-z0-9-]*[a-z0-9])?\\.)+[a-z0-9](?:[a-z0-9-]*[a-z0-9])?";
-    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"SELF MATCHES %@", pattern];
-    return [predicate evaluateWithObject:[string lowercaseString]];
+    return [self validationStateForEmailAddress:string] == STPCardValidationStateValid;
+}
+
++ (STPCardValidationState)validationStateForEmailAddress:(nullable NSString *)string {
+    CFIndex length = (CFIndex)string.length;
+    if (length == 0) {
+        return STPCardValidationStateIncomplete;
+    }
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer((__bridge CFStringRef)string, &buffer, CFRangeMake(0, length));
+
+    STPEmailAddressParseState state = STPEmailAddressParseStateLocalPartStart;
+    BOOL domainHasDot = NO;
+    for (CFIndex i = 0; i < length; i++) {
+        state = nextParseState(state, CFStringGetCharacterFromInlineBuffer(&buffer, i), &domainHasDot);
+        if (state == STPEmailAddressParseStateInvalid) {
+            return STPCardValidationStateInvalid;
+        }
+    }
+
+    if (state == STPEmailAddressParseStateDomainLabel && domainHasDot) {
+        return STPCardValidationStateValid;
+    }
+    // Every other state can still be completed
+    return STPCardValidationStateIncomplete;
 }
 
 @end
@@ -9,9 +9,11 @@
 #import "STPEphemeralKeyManager.h"
 
 #import "NSError+Stripe.h"
+#import "STPClock.h"
 #import "STPCustomerContext.h"
 #import "STPEphemeralKey.h"
 #import "STPPromise.h"
+#import "STPTrace.h"
 
 static NSTimeInterval const DefaultExpirationInterval = 60;
 static NSTimeInterval const MinEagerRefreshInterval = 60*60;
@@ -51,11 +53,13 @@ static NSTimeInterval const MinEagerRefreshInterval = 60*60;
 }
 
 - (BOOL)currentKeyIsUnexpired {
-    return self.customerKey && self.customerKey.expires.timeIntervalSinceNow > self.expirationInterval;
+    NSDate *now = [STPClock sharedClock].currentDate;
+    return self.customerKey && [self.customerKey.expires timeIntervalSinceDate:now] > self.expirationInterval;
 }
 
 - (BOOL)shouldPerformEagerRefresh {
-    return !self.lastEagerKeyRefresh || self.lastEagerKeyRefresh.timeIntervalSinceNow > MinEagerRefreshInterval;
+    NSDate *now = [STPClock sharedClock].currentDate;
+    return !self.lastEagerKeyRefresh || [now timeIntervalSinceDate:self.lastEagerKeyRefresh] > MinEagerRefreshInterval;
 }
 
 - (void)handleWillForegroundNotification {
@@ -63,8 +67,10 @@ static NSTimeInterval const MinEagerRefreshInterval = 60*60;
     // foreground (e.g. if there's an issue decoding the ephemeral key), throttle
     // eager refreshses to once per hour.
     if (!self.currentKeyIsUnexpired && self.shouldPerformEagerRefresh) {
-        self.lastEagerKeyRefresh = [NSDate date];
+        self.lastEagerKeyRefresh = [STPClock sharedClock].currentDate;
+        NSTimeInterval traceStartTime = stpTraceBegin();
         [self.keyProvider createCustomerKeyWithAPIVersion:self.apiVersion completion:^(NSDictionary *jsonResponse, __unused NSError *error) {
+            stpTraceEnd(traceStartTime, @"eager_key_refresh", STPTraceCategoryCustomer);
             STPEphemeralKey *key = [STPEphemeralKey decodedObjectFromAPIResponse:jsonResponse];
             if (key) {
                 self.customerKey = key;
@@ -91,7 +97,9 @@ static NSTimeInterval const MinEagerRefreshInterval = 60*60;
             }] onFailure:^(NSError *error) {
                 completion(nil, error);
             }];
+            NSTimeInterval traceStartTime = stpTraceBegin();
             [self.keyProvider createCustomerKeyWithAPIVersion:self.apiVersion completion:^(NSDictionary *jsonResponse, NSError *error) {
+                stpTraceEnd(traceStartTime, @"key_refresh", STPTraceCategoryCustomer);
                 STPEphemeralKey *key = [STPEphemeralKey decodedObjectFromAPIResponse:jsonResponse];
                 if (key) {
                     [self.createKeyPromise succeed:key];
@@ -9,6 +9,7 @@
 #import "STPFormEncoder.h"
 
 #import "STPFormEncodable.h"
+#import "STPTrace.h"
 
 FOUNDATION_EXPORT NSString * STPPercentEscapedStringFromString(NSString *string);
 FOUNDATION_EXPORT NSString * STPQueryStringFromParameters(NSDictionary *parameters);
@@ -26,9 +27,11 @@ FOUNDATION_EXPORT NSString * STPQueryStringFromParameters(NSDictionary *paramete
 }
 
 + (NSDictionary *)dictionaryForObject:(nonnull NSObject<STPFormEncodable> *)object {
+    NSTimeInterval traceStartTime = stpTraceBegin();
     NSDictionary *keyPairs = [self keyPairDictionaryForObject:object];
     NSString *rootObjectName = [object.class rootObjectName];
     NSDictionary *dict = rootObjectName != nil ? @{ rootObjectName: keyPairs } : keyPairs;
+    stpTraceEnd(traceStartTime, @"form_params", STPTraceCategoryAPI);
     return dict;
 }
 
@@ -87,7 +90,10 @@ FOUNDATION_EXPORT NSString * STPQueryStringFromParameters(NSDictionary *paramete
 }
 
 + (NSString *)queryStringFromParameters:(NSDictionary *)parameters {
-    return STPQueryStringFromParameters(parameters);
+    NSTimeInterval traceStartTime = stpTraceBegin();
+    NSString *queryString = STPQueryStringFromParameters(parameters);
+    stpTraceEnd(traceStartTime, @"form_encode", STPTraceCategoryAPI);
+    return queryString;
 }
 
 @end
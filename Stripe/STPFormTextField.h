@@ -32,6 +32,7 @@ typedef NS_ENUM(NSInteger, STPFormTextFieldAutoFormattingBehavior) {
 @property (nonatomic, readwrite, assign) BOOL selectionEnabled; // defaults to NO
 @property (nonatomic, readwrite, assign) BOOL preservesContentsOnPaste; // defaults to NO
 @property (nonatomic, readwrite, assign) STPFormTextFieldAutoFormattingBehavior autoFormattingBehavior;
+@property (nonatomic, readwrite, copy, nullable) NSString *phoneNumberCountryCode; // used by STPFormTextFieldAutoFormattingBehaviorPhoneNumbers; defaults to the current locale's
 @property (nonatomic, readwrite, weak, nullable) id<STPFormTextFieldDelegate>formDelegate;
 
 @end
@@ -89,8 +89,9 @@
     switch (self.autoformattingBehavior) {
         case STPFormTextFieldAutoFormattingBehaviorNone:
             return string;
-        case STPFormTextFieldAutoFormattingBehaviorCardNumbers:
         case STPFormTextFieldAutoFormattingBehaviorPhoneNumbers:
+            return [STPPhoneNumberValidator sanitizedPhoneNumberForString:string];
+        case STPFormTextFieldAutoFormattingBehaviorCardNumbers:
         case STPFormTextFieldAutoFormattingBehaviorExpiration:
             return [STPCardValidator sanitizedNumericStringForString:string];
     }
@@ -155,11 +156,12 @@ typedef NSAttributedString* (^STPFormTextTransformationBlock)(NSAttributedString
         case STPFormTextFieldAutoFormattingBehaviorPhoneNumbers: {
             WEAK(self);
             self.textFormattingBlock = ^NSAttributedString *(NSAttributedString *inputString) {
-                if (![STPCardValidator stringIsNumeric:inputString.string]) {
+                if (![[STPPhoneNumberValidator sanitizedPhoneNumberForString:inputString.string] isEqualToString:inputString.string]) {
                     return [inputString copy];
                 }
                 STRONG(self);
-                NSString *phoneNumber = [STPPhoneNumberValidator formattedSanitizedPhoneNumberForString:inputString.string];
+                NSString *phoneNumber = [STPPhoneNumberValidator formattedSanitizedPhoneNumberForString:inputString.string
+                                                                                        forCountryCode:self.phoneNumberCountryCode];
                 NSDictionary *attributes = [[self class] attributesForAttributedString:inputString];
                 return [[NSAttributedString alloc] initWithString:phoneNumber attributes:attributes];
             };
@@ -11,6 +11,17 @@
 #import "STPBundleLocator.h"
 #import "STPImageLibrary+Private.h"
 
+/**
+ A tinted image in the cache, along with the image it was tinted from.
+ */
+@interface STPTintedImage : NSObject
+@property (nonatomic, weak) UIImage *sourceImage;
+@property (nonatomic, strong) UIImage *image;
+@end
+
+@implementation STPTintedImage
+@end
+
 // Dummy class for locating the framework bundle
 
 @implementation STPImageLibrary
@@ -101,20 +112,96 @@
     return [self safeImageNamed:@"stp_shipping_form" templateIfAvailable:YES];
 }
 
+#pragma mark - Cache
+
+/**
+ Decoded images, keyed by asset, rendering mode and screen scale, and tinted
+ images, keyed by color and source image. Brand images are asked for on every
+ keystroke that changes the brand and in every payment method cell, so we
+ decode and tint each one once. The cache's cost is the bitmap size in bytes.
+ */
++ (NSCache<NSString *, id> *)imageCache {
+    static NSCache<NSString *, id> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [NSCache new];
+        cache.name = @"com.stripe.STPImageLibrary";
+        cache.totalCostLimit = 4 * 1024 * 1024;
+        // NSCache evicts on its own under memory pressure, but we also
+        // drop everything on a memory warning since all of it can be rebuilt
+        [[NSNotificationCenter defaultCenter] addObserverForName:UIApplicationDidReceiveMemoryWarningNotification
+                                                          object:nil
+                                                           queue:nil
+                                                      usingBlock:^(__unused NSNotification *note) {
+                                                          [cache removeAllObjects];
+                                                      }];
+    });
+    return cache;
+}
+
++ (NSUInteger)costForImage:(UIImage *)image {
+    return (NSUInteger)(image.size.width * image.scale * image.size.height * image.scale * 4);
+}
+
++ (UIImage *)decodedImageForImage:(UIImage *)image {
+    if (image.images != nil
+        || !UIEdgeInsetsEqualToEdgeInsets(image.capInsets, UIEdgeInsetsZero)
+        || CGSizeEqualToSize(image.size, CGSizeZero)) {
+        return image;
+    }
+    // imageNamed: defers decoding to the first draw, which would otherwise
+    // happen on the main thread while laying out
+    UIGraphicsBeginImageContextWithOptions(image.size, NO, image.scale);
+    [image drawAtPoint:CGPointZero];
+    UIImage *decodedImage = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    if (!decodedImage) {
+        return image;
+    }
+    return [decodedImage imageWithRenderingMode:image.renderingMode];
+}
+
 + (UIImage *)safeImageNamed:(NSString *)imageName
         templateIfAvailable:(BOOL)templateIfAvailable {
 
-    UIImage *image = [UIImage imageNamed:imageName inBundle:[STPBundleLocator stripeResourcesBundle] compatibleWithTraitCollection:nil];
+    NSString *cacheKey = [NSString stringWithFormat:@"%@|%d|%.1f", imageName, templateIfAvailable, [UIScreen mainScreen].scale];
+    UIImage *image = [[self imageCache] objectForKey:cacheKey];
+    if (image) {
+        return image;
+    }
+
+    image = [UIImage imageNamed:imageName inBundle:[STPBundleLocator stripeResourcesBundle] compatibleWithTraitCollection:nil];
 
     if (image == nil) {
         image = [UIImage imageNamed:imageName];
     }
-    if (templateIfAvailable) {
-        image = [image imageWithRenderingMode:UIImageRenderingModeAlwaysTemplate];
+    if (image != nil) {
+        if (templateIfAvailable) {
+            image = [image imageWithRenderingMode:UIImageRenderingModeAlwaysTemplate];
+        }
+        image = [self decodedImageForImage:image];
+        [[self imageCache] setObject:image forKey:cacheKey cost:[self costForImage:image]];
     }
     return image;
 }
 
++ (BOOL)shouldUseChineseUnionPayImage {
+    static NSLocale *cachedLocale;
+    static BOOL useChineseImage;
+    // currentLocale returns the same instance until the locale changes, so
+    // only look at the identifier when we get a different one
+    NSLocale *locale = [NSLocale currentLocale];
+    @synchronized (self) {
+        if (locale != cachedLocale) {
+            cachedLocale = locale;
+            useChineseImage = [[locale localeIdentifier].lowercaseString hasPrefix:@"zh"];
+        }
+        return useChineseImage;
+    }
+}
+
+#pragma mark - Brand images
+
 + (UIImage *)brandImageForCardBrand:(STPCardBrand)brand 
                            template:(BOOL)isTemplate {
     BOOL shouldUseTemplate = isTemplate;
@@ -136,7 +223,7 @@
             imageName = shouldUseTemplate ? @"stp_card_mastercard_template" : @"stp_card_mastercard";
             break;
         case STPCardBrandUnionPay:
-            if ([[[NSLocale currentLocale] localeIdentifier].lowercaseString hasPrefix:@"zh"]) {
+            if ([self shouldUseChineseUnionPayImage]) {
                 imageName = shouldUseTemplate ? @"stp_card_unionpay_template_zh" : @"stp_card_unionpay_zh";
             } else {
                 imageName = shouldUseTemplate ? @"stp_card_unionpay_template_en" : @"stp_card_unionpay_en";
@@ -155,8 +242,21 @@
     return image;
 }
 
+#pragma mark - Tinting
+
 + (UIImage *)imageWithTintColor:(UIColor *)color
                        forImage:(UIImage *)image {
+    CGFloat red, green, blue, alpha;
+    NSString *cacheKey = nil;
+    if ([color getRed:&red green:&green blue:&blue alpha:&alpha]) {
+        cacheKey = [NSString stringWithFormat:@"tint|%p|%f|%f|%f|%f", image, red, green, blue, alpha];
+        STPTintedImage *tintedImage = [[self imageCache] objectForKey:cacheKey];
+        // The source image may have been freed and its address reused
+        if (tintedImage.sourceImage == image) {
+            return tintedImage.image;
+        }
+    }
+
     UIImage *newImage;
     UIGraphicsBeginImageContextWithOptions(image.size, NO, image.scale);
     [color set];
@@ -164,6 +264,13 @@
     [templateImage drawInRect:CGRectMake(0, 0, templateImage.size.width, templateImage.size.height)];
     newImage = UIGraphicsGetImageFromCurrentImageContext();
     UIGraphicsEndImageContext();
+
+    if (cacheKey && newImage) {
+        STPTintedImage *tintedImage = [STPTintedImage new];
+        tintedImage.sourceImage = image;
+        tintedImage.image = newImage;
+        [[self imageCache] setObject:tintedImage forKey:cacheKey cost:[self costForImage:newImage]];
+    }
     return newImage;
 }
 
@@ -0,0 +1,34 @@
+//
+//  STPLocalizationUtils+Private.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPLocalizationUtils.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface STPLocalizationUtils (Private)
+
+/**
+ The bundle strings are looked up in: ours, or the main app's if it's using a
+ language we don't have.
+ */
++ (NSBundle *)localizationBundle;
+
+/**
+ The contents of `bundle`'s Localizable.strings in its preferred localization,
+ or nil if it has none.
+ */
++ (nullable NSDictionary<NSString *, NSString *> *)localizedStringTableForBundle:(NSBundle *)bundle;
+
+/**
+ The string table for `localizationBundle`, loaded on first use.
+ */
++ (nullable NSDictionary<NSString *, NSString *> *)localizedStringTable;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -16,6 +16,13 @@
  */
 + (nonnull NSString *)localizedStripeStringForKey:(nonnull NSString *)key;
 
+/**
+ Loads the string table used by `localizedStripeStringForKey:` on a background
+ queue, so the first screen we show doesn't have to. Calling this is optional;
+ the table is otherwise loaded on first use.
+ */
++ (void)prewarmLocalizedStrings;
+
 @end
 
 static inline NSString * _Nonnull STPLocalizedString(NSString* _Nonnull key, NSString * _Nullable __unused comment) {
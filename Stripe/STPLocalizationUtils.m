@@ -7,11 +7,13 @@
 //
 
 #import "STPLocalizationUtils.h"
+#import "STPLocalizationUtils+Private.h"
+
 #import "STPBundleLocator.h"
 
 @implementation STPLocalizationUtils
 
-+ (NSString *)localizedStripeStringForKey:(NSString *)key {
++ (NSBundle *)localizationBundle {
 
     /**
      If the main app has a localization that we do not support, we want to switch
@@ -40,10 +42,43 @@
         }
     });
     
-    NSBundle *bundle = useMainBundle ? [NSBundle mainBundle] : [STPBundleLocator stripeResourcesBundle];
+    return useMainBundle ? [NSBundle mainBundle] : [STPBundleLocator stripeResourcesBundle];
+}
 
-    NSString *translation = [bundle localizedStringForKey:key value:nil table:nil];
-    
++ (nullable NSDictionary<NSString *, NSString *> *)localizedStringTableForBundle:(NSBundle *)bundle {
+    // Resolves to the bundle's preferred localization, like localizedStringForKey:
+    NSString *path = [bundle pathForResource:@"Localizable" ofType:@"strings"];
+    if (!path) {
+        return nil;
+    }
+    return [NSDictionary dictionaryWithContentsOfFile:path];
+}
+
++ (nullable NSDictionary<NSString *, NSString *> *)localizedStringTable {
+    static NSDictionary<NSString *, NSString *> *table;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        table = [self localizedStringTableForBundle:[self localizationBundle]];
+    });
+    return table;
+}
+
++ (void)prewarmLocalizedStrings {
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        [self localizedStringTable];
+    });
+}
+
++ (NSString *)localizedStripeStringForKey:(NSString *)key {
+    /**
+     Looking strings up in the bundle each time showed up when building our
+     view controllers, which localize every label and placeholder, so we read
+     the table once and fall back to the bundle only for keys it doesn't have.
+     */
+    NSString *translation = [self localizedStringTable][key];
+    if (!translation) {
+        translation = [[self localizationBundle] localizedStringForKey:key value:nil table:nil];
+    }
     return translation;
 }
 
@@ -0,0 +1,535 @@
+//
+//  STPModelArchive.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPModelArchive.h"
+
+#import "NSError+Stripe.h"
+#import "STPAPIClient+Private.h"
+#import "STPCard.h"
+#import "STPCustomer.h"
+#import "STPEphemeralKey.h"
+#import "STPOrder.h"
+#import "STPPaymentIntent.h"
+#import "STPProduct.h"
+#import "STPSku.h"
+#import "STPSource.h"
+
+/*
+ Layout, with all integers little-endian:
+
+ header:  "STPA", format version (uint16), reserved (uint16),
+          API version (string), string count (uint32),
+          then the offset of each string in the string table (uint32 each),
+          entry count (uint32),
+          then (offset, length) of each entry (uint32 each)
+ entry:   class name (string index), response fields (value)
+ string:  byte count (uint32), UTF-8 bytes
+ value:   type (uint8), then
+          - a string index (uint32), or
+          - an int64 or a double (8 bytes), or
+          - for arrays and dictionaries, the element count (uint32), the byte
+            count of the elements (uint32), then the elements. A dictionary's
+            elements are alternating keys (string indexes) and values.
+
+ Every distinct string is stored once, in the string table, and entries refer
+ to it by index. The keys and most values repeat from one model to the next,
+ so a reader creates each of them once rather than once per model.
+ Containers are prefixed with their byte count so a reader can skip them.
+ */
+
+static const char ArchiveMagic[4] = {'S', 'T', 'P', 'A'};
+static const uint16_t ArchiveFormatVersion = 2;
+// Deeper than any API response, and shallow enough not to overflow the stack
+// when reading a corrupt archive
+static const NSUInteger ArchiveMaxDepth = 64;
+
+typedef NS_ENUM(uint8_t, STPArchiveValueType) {
+    STPArchiveValueTypeNull = 0,
+    STPArchiveValueTypeFalse = 1,
+    STPArchiveValueTypeTrue = 2,
+    STPArchiveValueTypeInteger = 3,
+    STPArchiveValueTypeDouble = 4,
+    STPArchiveValueTypeString = 5,
+    STPArchiveValueTypeArray = 6,
+    STPArchiveValueTypeDictionary = 7,
+};
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The classes that can be archived. Only these are instantiated when reading an
+ archive, whatever class names it contains.
+ */
+static NSArray<Class> *STPArchivableClasses(void) {
+    static NSArray<Class> *classes;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        classes = @[
+                    [STPCard class],
+                    [STPCustomer class],
+                    [STPEphemeralKey class],
+                    [STPOrder class],
+                    [STPPaymentIntent class],
+                    [STPProduct class],
+                    [STPSku class],
+                    [STPSource class],
+                    ];
+    });
+    return classes;
+}
+
+#pragma mark - Writing
+
+static void STPArchiveAppendUInt8(NSMutableData *data, uint8_t value) {
+    [data appendBytes:&value length:sizeof(value)];
+}
+
+static void STPArchiveAppendUInt16(NSMutableData *data, uint16_t value) {
+    uint16_t littleEndian = CFSwapInt16HostToLittle(value);
+    [data appendBytes:&littleEndian length:sizeof(littleEndian)];
+}
+
+static void STPArchiveAppendUInt32(NSMutableData *data, uint32_t value) {
+    uint32_t littleEndian = CFSwapInt32HostToLittle(value);
+    [data appendBytes:&littleEndian length:sizeof(littleEndian)];
+}
+
+static void STPArchiveAppendUInt64(NSMutableData *data, uint64_t value) {
+    uint64_t littleEndian = CFSwapInt64HostToLittle(value);
+    [data appendBytes:&littleEndian length:sizeof(littleEndian)];
+}
+
+static void STPArchiveReplaceUInt32(NSMutableData *data, NSUInteger location, uint32_t value) {
+    uint32_t littleEndian = CFSwapInt32HostToLittle(value);
+    [data replaceBytesInRange:NSMakeRange(location, sizeof(littleEndian)) withBytes:&littleEndian];
+}
+
+static void STPArchiveAppendString(NSMutableData *data, NSString *string) {
+    NSData *utf8 = [string dataUsingEncoding:NSUTF8StringEncoding];
+    STPArchiveAppendUInt32(data, (uint32_t)utf8.length);
+    [data appendData:utf8];
+}
+
+/**
+ Collects the distinct strings of an archive being written, in the order
+ they're first seen.
+ */
+@interface STPArchiveStringTableWriter : NSObject
+
+@property (nonatomic, strong, readonly) NSMutableArray<NSString *> *strings;
+@property (nonatomic, strong, readonly) NSMutableDictionary<NSString *, NSNumber *> *indexes;
+
+/**
+ The index of `string` in the table, adding it if it's new.
+ */
+- (uint32_t)indexOfString:(NSString *)string;
+
+@end
+
+@implementation STPArchiveStringTableWriter
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _strings = [NSMutableArray array];
+        _indexes = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (uint32_t)indexOfString:(NSString *)string {
+    NSNumber *index = self.indexes[string];
+    if (!index) {
+        index = @(self.strings.count);
+        self.indexes[string] = index;
+        [self.strings addObject:string];
+    }
+    return index.unsignedIntValue;
+}
+
+@end
+
+static void STPArchiveAppendStringIndex(NSMutableData *data, STPArchiveStringTableWriter *stringTable, NSString *string) {
+    STPArchiveAppendUInt32(data, [stringTable indexOfString:string]);
+}
+
+static void STPArchiveAppendValue(NSMutableData *data, STPArchiveStringTableWriter *stringTable, id value) {
+    if ([value isKindOfClass:[NSString class]]) {
+        STPArchiveAppendUInt8(data, STPArchiveValueTypeString);
+        STPArchiveAppendStringIndex(data, stringTable, value);
+    }
+    else if ([value isKindOfClass:[NSNumber class]]) {
+        NSNumber *number = value;
+        if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+            STPArchiveAppendUInt8(data, number.boolValue ? STPArchiveValueTypeTrue : STPArchiveValueTypeFalse);
+        }
+        else if (CFNumberIsFloatType((__bridge CFNumberRef)number)) {
+            double doubleValue = number.doubleValue;
+            uint64_t bits;
+            memcpy(&bits, &doubleValue, sizeof(bits));
+            STPArchiveAppendUInt8(data, STPArchiveValueTypeDouble);
+            STPArchiveAppendUInt64(data, bits);
+        }
+        else {
+            STPArchiveAppendUInt8(data, STPArchiveValueTypeInteger);
+            STPArchiveAppendUInt64(data, (uint64_t)number.longLongValue);
+        }
+    }
+    else if ([value isKindOfClass:[NSArray class]] || [value isKindOfClass:[NSDictionary class]]) {
+        BOOL isDictionary = [value isKindOfClass:[NSDictionary class]];
+        STPArchiveAppendUInt8(data, isDictionary ? STPArchiveValueTypeDictionary : STPArchiveValueTypeArray);
+        STPArchiveAppendUInt32(data, (uint32_t)[value count]);
+        NSUInteger byteCountLocation = data.length;
+        STPArchiveAppendUInt32(data, 0);
+        NSUInteger elementsLocation = data.length;
+        if (isDictionary) {
+            [(NSDictionary *)value enumerateKeysAndObjectsUsingBlock:^(id key, id obj, __unused BOOL *stop) {
+                STPArchiveAppendStringIndex(data, stringTable, [key description]);
+                STPArchiveAppendValue(data, stringTable, obj);
+            }];
+        }
+        else {
+            for (id element in (NSArray *)value) {
+                STPArchiveAppendValue(data, stringTable, element);
+            }
+        }
+        STPArchiveReplaceUInt32(data, byteCountLocation, (uint32_t)(data.length - elementsLocation));
+    }
+    else {
+        // NSNull, or anything that isn't JSON
+        STPArchiveAppendUInt8(data, STPArchiveValueTypeNull);
+    }
+}
+
+#pragma mark - Reading
+
+@interface STPModelArchive ()
+
+@property (nonatomic, strong) NSData *data;
+@property (nonatomic, assign) NSUInteger stringOffsetsLocation;
+@property (nonatomic, strong) NSMutableArray *strings;
+@property (nonatomic, copy) NSArray<NSValue *> *entryRanges;
+
+- (nullable NSString *)stringAtIndex:(uint32_t)index;
+
+@end
+
+typedef struct {
+    const uint8_t *bytes;
+    NSUInteger length;
+    NSUInteger offset;
+} STPArchiveReader;
+
+static BOOL STPArchiveReadBytes(STPArchiveReader *reader, void *buffer, NSUInteger length) {
+    if (length > reader->length - reader->offset) {
+        return NO;
+    }
+    memcpy(buffer, reader->bytes + reader->offset, length);
+    reader->offset += length;
+    return YES;
+}
+
+static BOOL STPArchiveReadUInt8(STPArchiveReader *reader, uint8_t *value) {
+    return STPArchiveReadBytes(reader, value, sizeof(*value));
+}
+
+static BOOL STPArchiveReadUInt16(STPArchiveReader *reader, uint16_t *value) {
+    uint16_t littleEndian;
+    if (!STPArchiveReadBytes(reader, &littleEndian, sizeof(littleEndian))) {
+        return NO;
+    }
+    *value = CFSwapInt16LittleToHost(littleEndian);
+    return YES;
+}
+
+static BOOL STPArchiveReadUInt32(STPArchiveReader *reader, uint32_t *value) {
+    uint32_t littleEndian;
+    if (!STPArchiveReadBytes(reader, &littleEndian, sizeof(littleEndian))) {
+        return NO;
+    }
+    *value = CFSwapInt32LittleToHost(littleEndian);
+    return YES;
+}
+
+static BOOL STPArchiveReadUInt64(STPArchiveReader *reader, uint64_t *value) {
+    uint64_t littleEndian;
+    if (!STPArchiveReadBytes(reader, &littleEndian, sizeof(littleEndian))) {
+        return NO;
+    }
+    *value = CFSwapInt64LittleToHost(littleEndian);
+    return YES;
+}
+
+static NSString * _Nullable STPArchiveReadString(STPArchiveReader *reader) {
+    uint32_t length;
+    if (!STPArchiveReadUInt32(reader, &length) || length > reader->length - reader->offset) {
+        return nil;
+    }
+    NSString *string = [[NSString alloc] initWithBytes:reader->bytes + reader->offset
+                                                length:length
+                                              encoding:NSUTF8StringEncoding];
+    reader->offset += length;
+    return string;
+}
+
+static NSString * _Nullable STPArchiveReadStringIndex(STPArchiveReader *reader, STPModelArchive *archive) {
+    uint32_t index;
+    return STPArchiveReadUInt32(reader, &index) ? [archive stringAtIndex:index] : nil;
+}
+
+static id _Nullable STPArchiveReadValue(STPArchiveReader *reader, STPModelArchive *archive, NSUInteger depth) {
+    uint8_t type;
+    if (depth > ArchiveMaxDepth || !STPArchiveReadUInt8(reader, &type)) {
+        return nil;
+    }
+    switch ((STPArchiveValueType)type) {
+        case STPArchiveValueTypeNull:
+            return [NSNull null];
+        case STPArchiveValueTypeFalse:
+            return @NO;
+        case STPArchiveValueTypeTrue:
+            return @YES;
+        case STPArchiveValueTypeInteger: {
+            uint64_t bits;
+            return STPArchiveReadUInt64(reader, &bits) ? @((long long)bits) : nil;
+        }
+        case STPArchiveValueTypeDouble: {
+            uint64_t bits;
+            if (!STPArchiveReadUInt64(reader, &bits)) {
+                return nil;
+            }
+            double doubleValue;
+            memcpy(&doubleValue, &bits, sizeof(doubleValue));
+            return @(doubleValue);
+        }
+        case STPArchiveValueTypeString:
+            return STPArchiveReadStringIndex(reader, archive);
+        case STPArchiveValueTypeArray:
+        case STPArchiveValueTypeDictionary: {
+            uint32_t count, byteCount;
+            if (!STPArchiveReadUInt32(reader, &count)
+                || !STPArchiveReadUInt32(reader, &byteCount)
+                || byteCount > reader->length - reader->offset
+                // Every element takes at least a byte
+                || count > byteCount) {
+                return nil;
+            }
+            // Elements can't be read past the end of their container
+            STPArchiveReader elementsReader = {reader->bytes + reader->offset, byteCount, 0};
+            reader->offset += byteCount;
+
+            if (type == STPArchiveValueTypeArray) {
+                NSMutableArray *array = [NSMutableArray arrayWithCapacity:count];
+                for (uint32_t i = 0; i < count; i++) {
+                    id element = STPArchiveReadValue(&elementsReader, archive, depth + 1);
+                    if (!element) {
+                        return nil;
+                    }
+                    [array addObject:element];
+                }
+                return [array copy];
+            }
+            else {
+                NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:count];
+                for (uint32_t i = 0; i < count; i++) {
+                    NSString *key = STPArchiveReadStringIndex(&elementsReader, archive);
+                    id element = key ? STPArchiveReadValue(&elementsReader, archive, depth + 1) : nil;
+                    if (!element) {
+                        return nil;
+                    }
+                    dictionary[key] = element;
+                }
+                return [dictionary copy];
+            }
+        }
+    }
+    return nil;
+}
+
+#pragma mark - STPModelArchive
+
+@implementation STPModelArchive
+
++ (NSData *)archivedDataWithObjects:(NSArray<id<STPAPIResponseDecodable>> *)objects {
+    NSMutableArray<NSString *> *classNames = [NSMutableArray array];
+    NSMutableArray<NSDictionary *> *responses = [NSMutableArray array];
+    for (id<STPAPIResponseDecodable> object in objects) {
+        for (Class archivableClass in STPArchivableClasses()) {
+            if ([object isKindOfClass:archivableClass]) {
+                [classNames addObject:NSStringFromClass(archivableClass)];
+                [responses addObject:object.allResponseFields ?: @{}];
+                break;
+            }
+        }
+    }
+
+    // The entries are written first, to collect the strings they refer to
+    STPArchiveStringTableWriter *stringTable = [STPArchiveStringTableWriter new];
+    NSMutableData *entries = [NSMutableData data];
+    NSMutableArray<NSValue *> *entryRanges = [NSMutableArray arrayWithCapacity:responses.count];
+    for (NSUInteger i = 0; i < responses.count; i++) {
+        NSUInteger entryLocation = entries.length;
+        STPArchiveAppendStringIndex(entries, stringTable, classNames[i]);
+        STPArchiveAppendValue(entries, stringTable, responses[i]);
+        [entryRanges addObject:[NSValue valueWithRange:NSMakeRange(entryLocation, entries.length - entryLocation)]];
+    }
+
+    NSMutableData *data = [NSMutableData data];
+    [data appendBytes:ArchiveMagic length:sizeof(ArchiveMagic)];
+    STPArchiveAppendUInt16(data, ArchiveFormatVersion);
+    STPArchiveAppendUInt16(data, 0);
+    STPArchiveAppendString(data, [STPAPIClient apiVersion]);
+    STPArchiveAppendUInt32(data, (uint32_t)stringTable.strings.count);
+    NSUInteger stringOffsetsLocation = data.length;
+    for (NSUInteger i = 0; i < stringTable.strings.count; i++) {
+        STPArchiveAppendUInt32(data, 0);
+    }
+    STPArchiveAppendUInt32(data, (uint32_t)entryRanges.count);
+    NSUInteger entryTableLocation = data.length;
+    for (NSUInteger i = 0; i < entryRanges.count; i++) {
+        STPArchiveAppendUInt32(data, 0);
+        STPArchiveAppendUInt32(data, 0);
+    }
+
+    for (NSUInteger i = 0; i < stringTable.strings.count; i++) {
+        STPArchiveReplaceUInt32(data, stringOffsetsLocation + i * sizeof(uint32_t), (uint32_t)data.length);
+        STPArchiveAppendString(data, stringTable.strings[i]);
+    }
+
+    NSUInteger entriesLocation = data.length;
+    [data appendData:entries];
+    for (NSUInteger i = 0; i < entryRanges.count; i++) {
+        NSRange range = entryRanges[i].rangeValue;
+        NSUInteger entryTableRowLocation = entryTableLocation + i * 2 * sizeof(uint32_t);
+        STPArchiveReplaceUInt32(data, entryTableRowLocation, (uint32_t)(entriesLocation + range.location));
+        STPArchiveReplaceUInt32(data, entryTableRowLocation + sizeof(uint32_t), (uint32_t)range.length);
+    }
+    return [data copy];
+}
+
+- (nullable instancetype)initWithContentsOfURL:(NSURL *)url error:(NSError **)error {
+    NSData *data = [NSData dataWithContentsOfURL:url options:NSDataReadingMappedIfSafe error:error];
+    if (!data) {
+        return nil;
+    }
+    return [self initWithData:data error:error];
+}
+
+- (nullable instancetype)initWithData:(NSData *)data error:(NSError **)error {
+    self = [super init];
+    if (self) {
+        _data = data;
+        STPArchiveReader reader = {(const uint8_t *)data.bytes, data.length, 0};
+        char magic[sizeof(ArchiveMagic)];
+        uint16_t formatVersion, reserved;
+        uint32_t stringCount = 0, entryCount = 0;
+        BOOL validHeader = (STPArchiveReadBytes(&reader, magic, sizeof(magic))
+                            && memcmp(magic, ArchiveMagic, sizeof(magic)) == 0
+                            && STPArchiveReadUInt16(&reader, &formatVersion)
+                            && formatVersion == ArchiveFormatVersion
+                            && STPArchiveReadUInt16(&reader, &reserved)
+                            && [STPArchiveReadString(&reader) isEqualToString:[STPAPIClient apiVersion]]
+                            && STPArchiveReadUInt32(&reader, &stringCount)
+                            && stringCount <= (reader.length - reader.offset) / sizeof(uint32_t));
+        if (validHeader) {
+            // String offsets are checked when each string is first read
+            _stringOffsetsLocation = reader.offset;
+            reader.offset += stringCount * sizeof(uint32_t);
+            validHeader = (STPArchiveReadUInt32(&reader, &entryCount)
+                           && entryCount <= (reader.length - reader.offset) / (2 * sizeof(uint32_t)));
+        }
+
+        NSMutableArray<NSValue *> *entryRanges = [NSMutableArray arrayWithCapacity:validHeader ? entryCount : 0];
+        for (uint32_t i = 0; validHeader && i < entryCount; i++) {
+            uint32_t offset, length;
+            validHeader = (STPArchiveReadUInt32(&reader, &offset)
+                           && STPArchiveReadUInt32(&reader, &length)
+                           && offset <= data.length
+                           && length <= data.length - offset);
+            [entryRanges addObject:[NSValue valueWithRange:NSMakeRange(offset, length)]];
+        }
+
+        if (!validHeader) {
+            if (error) {
+                *error = [NSError stp_genericFailedToParseResponseError];
+            }
+            return nil;
+        }
+        _entryRanges = entryRanges;
+        _strings = [NSMutableArray arrayWithCapacity:stringCount];
+        for (uint32_t i = 0; i < stringCount; i++) {
+            [_strings addObject:[NSNull null]];
+        }
+    }
+    return self;
+}
+
+- (nullable NSString *)stringAtIndex:(uint32_t)index {
+    if (index >= self.strings.count) {
+        return nil;
+    }
+    id string = self.strings[index];
+    if (string == [NSNull null]) {
+        STPArchiveReader offsetReader = {(const uint8_t *)self.data.bytes, self.data.length, self.stringOffsetsLocation + index * sizeof(uint32_t)};
+        uint32_t offset;
+        if (!STPArchiveReadUInt32(&offsetReader, &offset) || offset > self.data.length) {
+            return nil;
+        }
+        STPArchiveReader reader = {(const uint8_t *)self.data.bytes, self.data.length, offset};
+        string = STPArchiveReadString(&reader);
+        if (!string) {
+            return nil;
+        }
+        self.strings[index] = string;
+    }
+    return string;
+}
+
+- (NSUInteger)count {
+    return self.entryRanges.count;
+}
+
+- (nullable id<STPAPIResponseDecodable>)objectAtIndex:(NSUInteger)index {
+    if (index >= self.entryRanges.count) {
+        return nil;
+    }
+    NSRange range = self.entryRanges[index].rangeValue;
+    STPArchiveReader reader = {(const uint8_t *)self.data.bytes + range.location, range.length, 0};
+    id response = nil;
+    Class modelClass = nil;
+    // Guards the string cache; models are decoded outside the lock
+    @synchronized(self) {
+        NSString *className = STPArchiveReadStringIndex(&reader, self);
+        for (Class archivableClass in STPArchivableClasses()) {
+            if ([NSStringFromClass(archivableClass) isEqualToString:className]) {
+                modelClass = archivableClass;
+                break;
+            }
+        }
+        response = modelClass ? STPArchiveReadValue(&reader, self, 0) : nil;
+    }
+    if (![response isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    return [modelClass decodedObjectFromAPIResponse:response];
+}
+
+- (NSArray<id<STPAPIResponseDecodable>> *)allObjects {
+    NSMutableArray<id<STPAPIResponseDecodable>> *objects = [NSMutableArray arrayWithCapacity:self.count];
+    for (NSUInteger i = 0; i < self.count; i++) {
+        id<STPAPIResponseDecodable> object = [self objectAtIndex:i];
+        if (object) {
+            [objects addObject:object];
+        }
+    }
+    return [objects copy];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
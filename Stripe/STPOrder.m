@@ -8,6 +8,12 @@
 
 #import <Stripe/Stripe.h>
 
+#import "NSDictionary+Stripe.h"
+
+@interface STPOrder ()
+@property (nonatomic, copy, readwrite) NSDictionary *allResponseFields;
+@end
+
 @implementation STPOrder
 
 
@@ -35,6 +41,17 @@
             return @"unknown";
     }
 }
+
+#pragma mark - STPAPIResponseDecodable
+
++ (nullable instancetype)decodedObjectFromAPIResponse:(nullable NSDictionary *)response {
+    NSDictionary *dict = [response stp_dictionaryByRemovingNulls];
+    if (![dict stp_stringForKey:@"id"]) {
+        return nil;
+    }
+    return [[self alloc] initWithAttributeDictionary:dict];
+}
+
 @end
 
 @implementation STPOrder(PrivateMethods)
@@ -50,6 +67,7 @@
     }];
 
     if (self) {
+        _allResponseFields = [attributeDictionary stp_dictionaryByRemovingNulls];
         _orderId = dict[@"id"];
         _created = [NSDate dateWithTimeIntervalSince1970:[dict[@"created"] intValue]];
         _amount = [dict[@"amount"] integerValue];
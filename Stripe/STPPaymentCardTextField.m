@@ -336,7 +336,8 @@ CGFloat const STPPaymentCardTextFieldMinimumPadding = 10;
     self.viewModel.postalCodeRequired = postalCodeEntryEnabled;
     if (postalCodeEntryEnabled
         && !self.countryCode) {
-        self.countryCode = [[NSLocale autoupdatingCurrentLocale] objectForKey:NSLocaleCountryCode];
+        // Defaults to the locale's country
+        self.countryCode = nil;
     }
 }
 
@@ -351,6 +352,7 @@ CGFloat const STPPaymentCardTextFieldMinimumPadding = 10;
 - (void)setCountryCode:(NSString *)cCode {
     NSString *countryCode = cCode ?: [[NSLocale autoupdatingCurrentLocale] objectForKey:NSLocaleCountryCode];
 
+    self.viewModel.postalCodeCountryCodeIsDefault = (cCode == nil);
     self.viewModel.postalCodeCountryCode = countryCode;
     [self updatePostalFieldPlaceholder];
 
@@ -31,6 +31,12 @@ typedef NS_ENUM(NSInteger, STPCardFieldType) {
 @property (nonatomic, readwrite, assign) BOOL postalCodeRequired;
 @property (nonatomic, readwrite, copy, nullable) NSString *postalCode;
 @property (nonatomic, readwrite, copy, nullable) NSString *postalCodeCountryCode;
+/**
+ Whether `postalCodeCountryCode` is only the device's locale rather than a
+ country that was set explicitly. Postal codes are only held to the US ZIP
+ code format then, since the card may well be from somewhere else.
+ */
+@property (nonatomic, readwrite, assign) BOOL postalCodeCountryCodeIsDefault;
 @property (nonatomic, readonly) STPCardBrand brand;
 @property (nonatomic, readonly) BOOL isValid;
 
@@ -9,25 +9,88 @@
 #import "STPPaymentCardTextFieldViewModel.h"
 
 #import "NSString+Stripe.h"
+#import "STPBINRange.h"
 #import "STPCardValidator+Private.h"
 #import "STPPostalCodeValidator.h"
 
+/*
+ This is called on every keystroke, so rather than recomputing the brand and
+ validation states whenever they're read, we keep them up to date as fields are
+ set and only redo the work an edit can affect. In particular, the BIN ranges
+ are only looked up again when the leading digits that decide them change.
+ */
+@interface STPPaymentCardTextFieldViewModel ()
+
+@property (nonatomic, copy, nullable) NSString *binPrefix;
+@property (nonatomic, nullable) STPBINRange *binRange;
+@property (nonatomic) NSInteger maxCardNumberLength;
+@property (nonatomic) STPCardValidationState numberValidationState;
+@property (nonatomic) STPCardValidationState cvcValidationState;
+@property (nonatomic) STPCardValidationState postalCodeValidationState;
+
+@end
+
 @implementation STPPaymentCardTextFieldViewModel
 
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        [self updateBINRangeForNumber:nil];
+        [self updateNumberValidationState];
+        [self updateCVCValidationState];
+        [self updatePostalCodeValidationState];
+    }
+    return self;
+}
+
 - (void)setCardNumber:(NSString *)cardNumber {
     NSString *sanitizedNumber = [STPCardValidator sanitizedNumericStringForString:cardNumber];
-    STPCardBrand brand = [STPCardValidator brandForNumber:sanitizedNumber];
-    NSInteger maxLength = [STPCardValidator maxLengthForCardBrand:brand];
-    _cardNumber = [sanitizedNumber stp_safeSubstringToIndex:maxLength];
+    [self updateBINRangeForNumber:sanitizedNumber];
+    _cardNumber = [sanitizedNumber stp_safeSubstringToIndex:self.maxCardNumberLength];
+    [self updateNumberValidationState];
+}
+
+- (void)updateBINRangeForNumber:(nullable NSString *)sanitizedNumber {
+    NSString *binPrefix = [sanitizedNumber stp_safeSubstringToIndex:[STPBINRange maxPrefixLength]] ?: @"";
+    if (self.binPrefix && [binPrefix isEqualToString:self.binPrefix]) {
+        return;
+    }
+    self.binPrefix = binPrefix;
+
+    NSArray<STPBINRange *> *binRanges = [STPBINRange binRangesForNumber:binPrefix];
+    self.binRange = [STPBINRange mostSpecificBINRangeInRanges:binRanges];
+    STPCardBrand brand = [STPCardValidator brandForBINRanges:binRanges];
+    if (brand != _brand || self.maxCardNumberLength == 0) {
+        _brand = brand;
+        self.maxCardNumberLength = [STPCardValidator maxLengthForCardBrand:brand];
+        [self updateCVCValidationState];
+    }
+}
+
+- (void)updateNumberValidationState {
+    self.numberValidationState = [STPCardValidator validationStateForSanitizedNumber:self.cardNumber
+                                                                            binRange:self.binRange
+                                                                 validatingCardBrand:YES];
+}
+
+- (void)updateCVCValidationState {
+    self.cvcValidationState = [STPCardValidator validationStateForCVC:self.cvc cardBrand:self.brand];
+}
+
+- (void)updatePostalCodeValidationState {
+    self.postalCodeValidationState = [STPPostalCodeValidator validationStateForPostalCode:self.postalCode
+                                                                             countryCode:self.postalCodeCountryCode
+                                                                                  strict:!self.postalCodeCountryCodeIsDefault];
 }
 
 - (NSString *)compressedCardNumber {
     NSString *cardNumber = self.cardNumber;
+    STPCardBrand currentBrand = self.brand;
     if (cardNumber.length == 0) {
         cardNumber = self.defaultPlaceholder;
+        currentBrand = [STPCardValidator brandForNumber:cardNumber];
     }
 
-    STPCardBrand currentBrand = [STPCardValidator brandForNumber:cardNumber];
     if ([self validationStateForField:STPCardFieldTypeNumber] == STPCardValidationStateValid) {
         // Use fragment length
         NSUInteger length = [STPCardValidator fragmentLengthForCardBrand:currentBrand];
@@ -87,31 +150,41 @@
 - (void)setCvc:(NSString *)cvc {
     NSInteger maxLength = [STPCardValidator maxCVCLengthForCardBrand:self.brand];
     _cvc = [[STPCardValidator sanitizedNumericStringForString:cvc] stp_safeSubstringToIndex:maxLength];
+    [self updateCVCValidationState];
 }
 
 - (void)setPostalCode:(NSString *)postalCode {
     _postalCode = [STPPostalCodeValidator formattedSanitizedPostalCodeFromString:postalCode
                                                                      countryCode:self.postalCodeCountryCode
-                                                                           usage:STPPostalCodeIntendedUsageBillingAddress];
+                                                                           usage:STPPostalCodeIntendedUsageBillingAddress
+                                                                          strict:!self.postalCodeCountryCodeIsDefault];
+    [self updatePostalCodeValidationState];
 }
 
 - (void)setPostalCodeCountryCode:(NSString *)postalCodeCountryCode {
     _postalCodeCountryCode = postalCodeCountryCode;
-    _postalCode = [STPPostalCodeValidator formattedSanitizedPostalCodeFromString:self.postalCode
-                                                                     countryCode:postalCodeCountryCode
-                                                                           usage:STPPostalCodeIntendedUsageBillingAddress];
+    [self reformatPostalCode];
 }
 
-- (STPCardBrand)brand {
-    return [STPCardValidator brandForNumber:self.cardNumber];
+- (void)setPostalCodeCountryCodeIsDefault:(BOOL)postalCodeCountryCodeIsDefault {
+    _postalCodeCountryCodeIsDefault = postalCodeCountryCodeIsDefault;
+    [self reformatPostalCode];
+}
+
+- (void)reformatPostalCode {
+    _postalCode = [STPPostalCodeValidator formattedSanitizedPostalCodeFromString:self.postalCode
+                                                                     countryCode:self.postalCodeCountryCode
+                                                                           usage:STPPostalCodeIntendedUsageBillingAddress
+                                                                          strict:!self.postalCodeCountryCodeIsDefault];
+    [self updatePostalCodeValidationState];
 }
 
 - (STPCardValidationState)validationStateForField:(STPCardFieldType)fieldType {
     switch (fieldType) {
         case STPCardFieldTypeNumber:
-            return [STPCardValidator validationStateForNumber:self.cardNumber validatingCardBrand:YES];
-            break;
+            return self.numberValidationState;
         case STPCardFieldTypeExpiration: {
+            // Not cached, since this depends on the current date
             STPCardValidationState monthState = [STPCardValidator validationStateForExpirationMonth:self.expirationMonth];
             STPCardValidationState yearState = [STPCardValidator validationStateForExpirationYear:self.expirationYear inMonth:self.expirationMonth];
             if (monthState == STPCardValidationStateValid && yearState == STPCardValidationStateValid) {
@@ -124,10 +197,9 @@
             break;
         }
         case STPCardFieldTypeCVC:
-            return [STPCardValidator validationStateForCVC:self.cvc cardBrand:self.brand];
+            return self.cvcValidationState;
         case STPCardFieldTypePostalCode:
-            return [STPPostalCodeValidator validationStateForPostalCode:self.postalCode
-                                                            countryCode:self.postalCodeCountryCode];
+            return self.postalCodeValidationState;
     }
 }
 
@@ -153,6 +225,7 @@
                                  NSStringFromSelector(@selector(postalCode)),
                                  NSStringFromSelector(@selector(postalCodeRequired)),
                                  NSStringFromSelector(@selector(postalCodeCountryCode)),
+                                 NSStringFromSelector(@selector(postalCodeCountryCodeIsDefault)),
                                  ]];
 }
 
@@ -11,9 +11,11 @@
 
 #import "PKPaymentAuthorizationViewController+Stripe_Blocks.h"
 #import "STPAddCardViewController+Private.h"
+#import "STPApplePayPaymentMetrics+Private.h"
 #import "STPCustomer+SourceTuple.h"
-#import "STPCustomerContext.h"
+#import "STPCustomerContext+Private.h"
 #import "STPDispatchFunctions.h"
+#import "STPLocalizationUtils.h"
 #import "STPPaymentConfiguration+Private.h"
 #import "STPPaymentContext+Private.h"
 #import "STPPaymentContextAmountModel.h"
@@ -106,17 +108,49 @@ typedef NS_ENUM(NSUInteger, STPPaymentContextState) {
             _largeTitleDisplayMode = UINavigationItemLargeTitleDisplayModeAutomatic;
         }
         _state = STPPaymentContextStateNone;
-        [self retryLoading];
+        if ([apiAdapter isKindOfClass:[STPCustomerContext class]]) {
+            STPCustomerContext *customerContext = (STPCustomerContext *)apiAdapter;
+            if (customerContext.customerPrefetched) {
+                // Use the customer prefetchWithCustomerContext:configuration:
+                // fetched, so loading can finish before the context is returned
+                customerContext.customerPrefetched = NO;
+            }
+            else {
+                [customerContext clearCachedCustomer];
+            }
+        }
+        [self loadPaymentMethods];
     }
     return self;
 }
 
++ (void)prefetchWithCustomerContext:(STPCustomerContext *)customerContext
+                      configuration:(STPPaymentConfiguration *)configuration {
+    [STPLocalizationUtils prewarmLocalizedStrings];
+    [customerContext retrieveCustomer:^(STPCustomer *customer, __unused NSError *error) {
+        if (!customer) {
+            return;
+        }
+        customerContext.customerPrefetched = YES;
+        STPPaymentMethodTuple *tuple = [customer filteredSourceTupleForUIWithConfiguration:configuration];
+        for (id<STPPaymentMethod> paymentMethod in tuple.paymentMethods) {
+            // STPImageLibrary keeps the decoded images around for later
+            [paymentMethod image];
+            [paymentMethod templateImage];
+        }
+    }];
+}
+
 - (void)retryLoading {
     // Clear any cached customer object before refetching
     if ([self.apiAdapter isKindOfClass:[STPCustomerContext class]]) {
         STPCustomerContext *customerContext = (STPCustomerContext *)self.apiAdapter;
         [customerContext clearCachedCustomer];
     }
+    [self loadPaymentMethods];
+}
+
+- (void)loadPaymentMethods {
     WEAK(self);
     self.loadingPromise = [[[STPPromise<STPPaymentMethodTuple *> new] onSuccess:^(STPPaymentMethodTuple *tuple) {
         STRONG(self);
@@ -627,40 +661,13 @@ typedef NS_ENUM(NSUInteger, STPPaymentContextState) {
                 }
             };
             STPApplePaySourceHandlerBlock applePaySourceHandler = ^(id<STPSourceProtocol> source, STPErrorBlock completion) {
-                [self.apiAdapter attachSourceToCustomer:source completion:^(NSError *attachSourceError) {
-                    stpDispatchToMainThreadIfNecessary(^{
-                        if (attachSourceError) {
-                            completion(attachSourceError);
-                        } else {
-                            id<STPSourceProtocol> paymentResultSource = source;
-                            /**
-                             When createCardSources is false, the SDK:
-                             1. Sends the token to customers/[id]/sources. This
-                             adds token.card to the customer's sources list.
-                             Surprisingly, attaching token.card to the customer
-                             will fail.
-                             2. Returns token.card to didCreatePaymentResult,
-                             where the user tells their backend to create a charge.
-                             A charge request with the token ID and customer ID
-                             will fail because the token is not linked to the
-                             customer (the card is).
-                             */
-                            if ([source isKindOfClass:[STPToken class]]) {
-                                paymentResultSource = ((STPToken *)source).card;
-                            }
-                            STPPaymentResult *result = [[STPPaymentResult alloc] initWithSource:paymentResultSource];
-                            [self.delegate paymentContext:self didCreatePaymentResult:result completion:^(NSError * error) {
-                                // for Apple Pay, the didFinishWithStatus callback is fired later when Apple Pay VC finishes
-                                if (error) {
-                                    completion(error);
-                                } else {
-                                    completion(nil);
-                                }
-                            }];
-                        }
-                    });
-                }];
+                [self completeApplePayPaymentWithSource:source completion:completion];
             };
+            if (self.pipelinesApplePayAttachment && [self.apiAdapter isKindOfClass:[STPCustomerContext class]]) {
+                // The user takes a few seconds to authorize the payment, which
+                // is long enough to fetch a new key if the current one expired
+                [(STPCustomerContext *)self.apiAdapter prefetchEphemeralKey];
+            }
             PKPaymentAuthorizationViewController *paymentAuthVC;
             paymentAuthVC = [PKPaymentAuthorizationViewController
                              stp_controllerWithPaymentRequest:paymentRequest
@@ -687,6 +694,85 @@ typedef NS_ENUM(NSUInteger, STPPaymentContextState) {
     }];
 }
 
+- (void)completeApplePayPaymentWithSource:(id<STPSourceProtocol>)source
+                               completion:(STPErrorBlock)completion {
+    id<STPSourceProtocol> paymentResultSource = source;
+    /**
+     When createCardSources is false, the SDK:
+     1. Sends the token to customers/[id]/sources. This
+     adds token.card to the customer's sources list.
+     Surprisingly, attaching token.card to the customer
+     will fail.
+     2. Returns token.card to didCreatePaymentResult,
+     where the user tells their backend to create a charge.
+     A charge request with the token ID and customer ID
+     will fail because the token is not linked to the
+     customer (the card is).
+     */
+    if ([source isKindOfClass:[STPToken class]]) {
+        paymentResultSource = ((STPToken *)source).card;
+    }
+    STPPaymentResult *result = [[STPPaymentResult alloc] initWithSource:paymentResultSource];
+
+    // A token's card only belongs to the customer once the token has been
+    // attached, so the charge can't be created until then
+    BOOL pipelined = self.pipelinesApplePayAttachment && ![source isKindOfClass:[STPToken class]];
+    STPApplePayPaymentMetrics *metrics = [[STPApplePayPaymentMetrics alloc] initWithPipelined:pipelined];
+    NSTimeInterval startTime = [NSProcessInfo processInfo].systemUptime;
+    STPErrorBlock finish = ^(NSError *error) {
+        stpDispatchToMainThreadIfNecessary(^{
+            metrics.duration = [NSProcessInfo processInfo].systemUptime - startTime;
+            // for Apple Pay, the didFinishWithStatus callback is fired later when Apple Pay VC finishes
+            completion(error);
+            if ([self.delegate respondsToSelector:@selector(paymentContext:didCollectApplePayMetrics:)]) {
+                [self.delegate paymentContext:self didCollectApplePayMetrics:metrics];
+            }
+        });
+    };
+
+    if (pipelined) {
+        dispatch_group_t group = dispatch_group_create();
+        __block NSError *paymentResultError = nil;
+
+        dispatch_group_enter(group);
+        [self.apiAdapter attachSourceToCustomer:source completion:^(NSError *attachSourceError) {
+            metrics.attachDuration = [NSProcessInfo processInfo].systemUptime - startTime;
+            metrics.attachError = attachSourceError;
+            dispatch_group_leave(group);
+        }];
+
+        dispatch_group_enter(group);
+        [self.delegate paymentContext:self didCreatePaymentResult:result completion:^(NSError *error) {
+            metrics.paymentResultDuration = [NSProcessInfo processInfo].systemUptime - startTime;
+            paymentResultError = error;
+            dispatch_group_leave(group);
+        }];
+
+        // The charge decides the outcome: once it has succeeded, failing to
+        // save the source for next time shouldn't tell the user it didn't
+        dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+            finish(paymentResultError);
+        });
+    }
+    else {
+        [self.apiAdapter attachSourceToCustomer:source completion:^(NSError *attachSourceError) {
+            stpDispatchToMainThreadIfNecessary(^{
+                NSTimeInterval attachEndTime = [NSProcessInfo processInfo].systemUptime;
+                metrics.attachDuration = attachEndTime - startTime;
+                metrics.attachError = attachSourceError;
+                if (attachSourceError) {
+                    finish(attachSourceError);
+                    return;
+                }
+                [self.delegate paymentContext:self didCreatePaymentResult:result completion:^(NSError *error) {
+                    metrics.paymentResultDuration = [NSProcessInfo processInfo].systemUptime - attachEndTime;
+                    finish(error);
+                }];
+            });
+        }];
+    }
+}
+
 - (void)didFinishWithStatus:(STPPaymentStatus)status
                       error:(nullable NSError *)error {
     self.state = STPPaymentContextStateNone;
@@ -0,0 +1,36 @@
+//
+//  STPPaymentIntentPoller.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "STPBlocks.h"
+#import "STPPoller.h"
+
+@class STPAPIClient;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Polls a PaymentIntent until its status is no longer
+ `STPPaymentIntentStatusRequiresSourceAction` or
+ `STPPaymentIntentStatusProcessing`.
+ */
+NS_EXTENSION_UNAVAILABLE("PaymentIntent polling is not available in extensions")
+@interface STPPaymentIntentPoller : STPPoller
+
+- (instancetype)initWithAPIClient:(STPAPIClient *)apiClient
+                          timeout:(NSTimeInterval)timeout
+                       completion:(STPPollerCompletionBlock)completion NS_UNAVAILABLE;
+
+- (instancetype)initWithAPIClient:(STPAPIClient *)apiClient
+                     clientSecret:(NSString *)clientSecret
+                          timeout:(NSTimeInterval)timeout
+                       completion:(STPPaymentIntentCompletionBlock)completion NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,55 @@
+//
+//  STPPaymentIntentPoller.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPPaymentIntentPoller.h"
+
+#import "STPAPIClient+Private.h"
+#import "STPPaymentIntent.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface STPPaymentIntentPoller ()
+
+@property (nonatomic) NSString *clientSecret;
+
+@end
+
+@implementation STPPaymentIntentPoller
+
+- (instancetype)initWithAPIClient:(STPAPIClient *)apiClient
+                     clientSecret:(NSString *)clientSecret
+                          timeout:(NSTimeInterval)timeout
+                       completion:(STPPaymentIntentCompletionBlock)completion {
+    self = [super initWithAPIClient:apiClient
+                            timeout:timeout
+                         completion:(STPPollerCompletionBlock)completion];
+    if (self) {
+        _clientSecret = clientSecret;
+        [self startPolling];
+    }
+    return self;
+}
+
+- (nullable NSURLSessionDataTask *)retrieveObjectWithCompletion:(STPPollerResponseBlock)completion {
+    return [self.apiClient retrievePaymentIntentWithClientSecret:self.clientSecret
+                                              responseCompletion:completion];
+}
+
+- (BOOL)shouldContinuePollingObject:(nullable STPPaymentIntent *)paymentIntent {
+    if (!paymentIntent) {
+        return NO;
+    }
+    // The customer may have finished the redirect before the PaymentIntent
+    // is updated, and some payment methods take a while to process
+    return (paymentIntent.status == STPPaymentIntentStatusRequiresSourceAction
+            || paymentIntent.status == STPPaymentIntentStatusProcessing);
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
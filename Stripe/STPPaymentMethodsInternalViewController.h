@@ -22,6 +22,12 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)internalViewControllerDidCreateSource:(id<STPSourceProtocol>)source completion:(STPErrorBlock)completion;
 - (void)internalViewControllerDidCancel;
 
+/**
+ Called when a row near the end of the card list is about to be shown, e.g.
+ so more of the customer's payment methods can be loaded.
+ */
+- (void)internalViewControllerWillDisplayPaymentMethodsNearEnd;
+
 @end
 
 @interface STPPaymentMethodsInternalViewController : STPCoreTableViewController
@@ -36,6 +42,18 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void)updateWithPaymentMethodTuple:(STPPaymentMethodTuple *)tuple;
 
+/**
+ Adds more of the customer's payment methods to the card list, before Apple Pay,
+ e.g. as later pages of their sources are loaded. Only the new rows are
+ inserted, and methods already in the list are skipped.
+ */
+- (void)appendPaymentMethods:(NSArray<id<STPPaymentMethod>> *)paymentMethods;
+
+/**
+ Whether any of the rows near the end of the card list are on screen.
+ */
+- (BOOL)isDisplayingPaymentMethodsNearEnd;
+
 @property (nonatomic, strong, nullable) UIView *customFooterView;
 @property (nonatomic, assign) BOOL createsCardSources;
 
@@ -11,6 +11,7 @@
 #import "NSArray+Stripe.h"
 #import "STPAddCardViewController.h"
 #import "STPAddCardViewController+Private.h"
+#import "STPApplePayPaymentMethod.h"
 #import "STPCoreTableViewController.h"
 #import "STPCoreTableViewController+Private.h"
 #import "STPCustomerContext.h"
@@ -32,6 +33,9 @@ static NSString * const PaymentMethodCellReuseIdentifier = @"PaymentMethodCellRe
 static NSInteger const PaymentMethodSectionCardList = 0;
 static NSInteger const PaymentMethodSectionAddCard = 1;
 
+// How many rows from the end of the card list count as near its end
+static NSInteger const PaymentMethodsNearEndRowCount = 5;
+
 @interface STPPaymentMethodsInternalViewController () <UITableViewDataSource, UITableViewDelegate, STPAddCardViewControllerDelegate>
 
 @property (nonatomic, strong, readwrite) STPPaymentConfiguration *configuration;
@@ -188,6 +192,52 @@ static NSInteger const PaymentMethodSectionAddCard = 1;
     [self.tableView reloadSections:sections withRowAnimation:UITableViewRowAnimationAutomatic];
 }
 
+- (void)appendPaymentMethods:(NSArray<id<STPPaymentMethod>> *)paymentMethods {
+    NSUInteger insertionIndex = [self.paymentMethods indexOfObjectPassingTest:^BOOL(id<STPPaymentMethod> paymentMethod, __unused NSUInteger idx, __unused BOOL *stop) {
+        return [paymentMethod isKindOfClass:[STPApplePayPaymentMethod class]];
+    }];
+    if (insertionIndex == NSNotFound) {
+        insertionIndex = self.paymentMethods.count;
+    }
+
+    NSMutableArray<id<STPPaymentMethod>> *updatedPaymentMethods = [self.paymentMethods mutableCopy];
+    NSMutableArray<NSIndexPath *> *indexPaths = [NSMutableArray array];
+    for (id<STPPaymentMethod> paymentMethod in paymentMethods) {
+        if ([updatedPaymentMethods containsObject:paymentMethod]) {
+            continue;
+        }
+        [updatedPaymentMethods insertObject:paymentMethod atIndex:insertionIndex];
+        [indexPaths addObject:[NSIndexPath indexPathForRow:(NSInteger)insertionIndex inSection:PaymentMethodSectionCardList]];
+        insertionIndex++;
+    }
+    if (indexPaths.count == 0) {
+        return;
+    }
+
+    self.paymentMethods = updatedPaymentMethods;
+    if (self.isViewLoaded) {
+        [self.tableView insertRowsAtIndexPaths:indexPaths withRowAnimation:UITableViewRowAnimationAutomatic];
+        [self reloadRightBarButtonItemWithTableViewIsEditing:self.tableView.isEditing animated:YES];
+    }
+}
+
+- (BOOL)isDisplayingPaymentMethodsNearEnd {
+    if (!self.isViewLoaded) {
+        return NO;
+    }
+    for (NSIndexPath *indexPath in self.tableView.indexPathsForVisibleRows) {
+        if ([self isPaymentMethodRowNearEnd:indexPath]) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (BOOL)isPaymentMethodRowNearEnd:(NSIndexPath *)indexPath {
+    return (indexPath.section == PaymentMethodSectionCardList
+            && indexPath.row >= (NSInteger)self.paymentMethods.count - PaymentMethodsNearEndRowCount);
+}
+
 - (void)setCustomFooterView:(UIView *)footerView {
     _customFooterView = footerView;
     [self.stp_willAppearPromise voidOnSuccess:^{
@@ -344,6 +394,10 @@ static NSInteger const PaymentMethodSectionAddCard = 1;
     [cell stp_setBottomBorderHidden:!isBottomRow];
     [cell stp_setFakeSeparatorColor:self.theme.quaternaryBackgroundColor];
     [cell stp_setFakeSeparatorLeftInset:15.0f];
+
+    if ([self isPaymentMethodRowNearEnd:indexPath]) {
+        [self.delegate internalViewControllerWillDisplayPaymentMethodsNearEnd];
+    }
 }
 
 - (CGFloat)tableView:(UITableView *)tableView heightForFooterInSection:(NSInteger)section {
@@ -13,7 +13,9 @@
 #import "STPCard.h"
 #import "STPColorUtils.h"
 #import "STPCoreViewController+Private.h"
+#import "STPCustomer+Private.h"
 #import "STPCustomer+SourceTuple.h"
+#import "STPCustomerSourcesIterator+Private.h"
 #import "STPDispatchFunctions.h"
 #import "STPLocalizationUtils.h"
 #import "STPPaymentActivityIndicatorView.h"
@@ -33,6 +35,10 @@
 #import "UIViewController+Stripe_ParentViewController.h"
 #import "UIViewController+Stripe_Promises.h"
 
+// How many more of the customer's sources to load at a time, after the ones
+// that came with the customer
+static const NSUInteger SourcesPageSize = 20;
+
 @interface STPPaymentMethodsViewController()<STPPaymentMethodsInternalViewControllerDelegate, STPAddCardViewControllerDelegate>
 
 @property (nonatomic) STPPaymentConfiguration *configuration;
@@ -42,6 +48,7 @@
 @property (nonatomic) STPPromise<STPPaymentMethodTuple *> *loadingPromise;
 @property (nonatomic, weak) STPPaymentActivityIndicatorView *activityIndicator;
 @property (nonatomic, weak) UIViewController *internalViewController;
+@property (nonatomic, nullable) STPCustomerSourcesIterator *sourcesIterator;
 @property (nonatomic) BOOL loading;
 
 @end
@@ -123,6 +130,9 @@
                 payMethodsInternal.customFooterView = self.paymentMethodsViewControllerFooterView;
             }
             internal = payMethodsInternal;
+            if (customerContext) {
+                [self loadRemainingSourcesWithCustomerContext:customerContext];
+            }
         }
         else {
             STPAddCardViewController *addCardViewController = [[STPAddCardViewController alloc] initWithConfiguration:self.configuration theme:self.theme];
@@ -156,6 +166,59 @@
     self.loading = YES;
 }
 
+- (void)loadRemainingSourcesWithCustomerContext:(STPCustomerContext *)customerContext {
+    WEAK(self);
+    [customerContext retrieveCustomer:^(STPCustomer *customer, __unused NSError *error) {
+        STRONG(self);
+        NSString *startingAfter = customer.nextSourcesPageCursor;
+        if (!self || !startingAfter || self.sourcesIterator) {
+            return;
+        }
+        self.sourcesIterator = [[STPCustomerSourcesIterator alloc] initWithCustomerContext:customerContext
+                                                                                  pageSize:SourcesPageSize
+                                                                             startingAfter:startingAfter];
+        // The end of the list may have been shown before there was anything to load
+        [self loadNextSourcesPageIfNeeded];
+    }];
+}
+
+/**
+ Loads another page of sources if the end of the card list is on screen. Pages
+ are otherwise loaded as the customer scrolls towards the end, rather than all
+ at once.
+ */
+- (void)loadNextSourcesPageIfNeeded {
+    if (![self.internalViewController isKindOfClass:[STPPaymentMethodsInternalViewController class]]) {
+        return;
+    }
+    STPPaymentMethodsInternalViewController *paymentMethodsVC = (STPPaymentMethodsInternalViewController *)self.internalViewController;
+    if ([paymentMethodsVC isDisplayingPaymentMethodsNearEnd]) {
+        [self loadNextSourcesPage];
+    }
+}
+
+- (void)loadNextSourcesPage {
+    if (!self.sourcesIterator.hasMore || self.sourcesIterator.isLoading) {
+        return;
+    }
+    WEAK(self);
+    [self.sourcesIterator loadNextPage:^(NSArray<id<STPSourceProtocol>> *sources, __unused NSError *error) {
+        STRONG(self);
+        // If a page fails to load, the sources already shown are still usable,
+        // so there's no need to interrupt the customer with an error
+        if (!self || !sources) {
+            return;
+        }
+        if ([self.internalViewController isKindOfClass:[STPPaymentMethodsInternalViewController class]]) {
+            STPPaymentMethodsInternalViewController *paymentMethodsVC = (STPPaymentMethodsInternalViewController *)self.internalViewController;
+            [paymentMethodsVC appendPaymentMethods:[STPCustomer filteredPaymentMethodsForUIFromSources:sources]];
+        }
+        // If the page added no rows, e.g. because they were all filtered
+        // out, scrolling won't ask for the next one
+        [self loadNextSourcesPageIfNeeded];
+    }];
+}
+
 - (void)viewDidLayoutSubviews {
     [super viewDidLayoutSubviews];
     CGFloat centerX = (self.view.frame.size.width - self.activityIndicator.frame.size.width) / 2;
@@ -191,6 +254,8 @@
                     if ([self.internalViewController isKindOfClass:[STPPaymentMethodsInternalViewController class]]) {
                         STPPaymentMethodsInternalViewController *paymentMethodsVC = (STPPaymentMethodsInternalViewController *)self.internalViewController;
                         [paymentMethodsVC updateWithPaymentMethodTuple:tuple];
+                        // The tuple only has the sources that came with the customer
+                        [paymentMethodsVC appendPaymentMethods:[STPCustomer filteredPaymentMethodsForUIFromSources:self.sourcesIterator.sources]];
                     }
                 });
             }];
@@ -247,6 +312,10 @@
     [self.delegate paymentMethodsViewControllerDidCancel:self];
 }
 
+- (void)internalViewControllerWillDisplayPaymentMethodsNearEnd {
+    [self loadNextSourcesPage];
+}
+
 - (void)addCardViewControllerDidCancel:(__unused STPAddCardViewController *)addCardViewController {
     // Add card is only our direct delegate if there are no other payment methods possible
     // and we skipped directly to this screen. In this case, a cancel from it is the same as a cancel to us.
@@ -0,0 +1,83 @@
+//
+//  STPPhoneNumberMetadata.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ How phone numbers are dialed within one country: how many digits they have,
+ which digits they can start with, and how they're grouped for display.
+
+ Loaded from `stp_phone_metadata.bin` in the resources bundle, which is
+ generated by `ci_scripts/generate_phone_metadata.rb`. The file is memory-mapped
+ and only the records of countries that are asked for are read.
+ */
+@interface STPPhoneNumberMetadata : NSObject
+
+/**
+ Returns the metadata for a country, or nil if we don't have any.
+ */
++ (nullable instancetype)metadataForCountryCode:(nullable NSString *)countryCode;
+
+/**
+ Parses one country's record out of metadata file contents. Returns nil if the
+ country isn't in the file or the file is malformed.
+ */
++ (nullable instancetype)metadataForCountryCode:(NSString *)countryCode
+                                       fromData:(NSData *)data;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ The fewest and most digits a number can have.
+ */
+@property (nonatomic, readonly) NSUInteger minLength;
+@property (nonatomic, readonly) NSUInteger maxLength;
+
+/**
+ The country calling code, e.g. 44 in the UK.
+ */
+@property (nonatomic, copy, readonly) NSString *callingCode;
+
+/**
+ The trunk prefix numbers are dialed with inside the country but not after the
+ calling code, e.g. 0 in the UK. Empty if there isn't one.
+ */
+@property (nonatomic, copy, readonly) NSString *nationalPrefix;
+
+/**
+ Returns the digits of `string` as dialed within the country, which is what
+ the methods below take. A number that starts with + or 00 and this country's
+ calling code has the calling code replaced with the trunk prefix, e.g.
+ +44 7700 900123 becomes 07700900123 in the UK. Returns an empty string while
+ only a prefix of the calling code has been typed, and nil if the number has
+ another country's calling code.
+ */
+- (nullable NSString *)nationalNumberForString:(NSString *)string;
+
+/**
+ Returns YES if `digits` (digits only) is a complete number.
+ */
+- (BOOL)isValidNumber:(NSString *)digits;
+
+/**
+ Returns YES if `digits` (digits only) could be the start of a number.
+ */
+- (BOOL)isValidPartialNumber:(NSString *)digits;
+
+/**
+ Groups `string` for display, truncating it to `maxLength` characters. Every
+ character is treated as a digit, so this also formats redacted numbers.
+ Strings shorter than the first group are returned as is.
+ */
+- (NSString *)formattedNumberForString:(NSString *)string;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,272 @@
+//
+//  STPPhoneNumberMetadata.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPPhoneNumberMetadata.h"
+
+#import "STPBundleLocator.h"
+#import "STPCardValidator.h"
+
+// See ci_scripts/generate_phone_metadata.rb for the file format
+static const char MetadataMagic[4] = {'S', 'T', 'P', 'N'};
+static const uint8_t MetadataVersion = 2;
+static const NSUInteger HeaderLength = 8;
+static const NSUInteger IndexEntryLength = 6;
+
+static const unichar TemplateDigit = 'X';
+// Dialed before the calling code instead of +, e.g. 0044 for +44
+static NSString * const InternationalPrefix = @"00";
+
+@interface STPPhoneNumberMetadata ()
+
+@property (nonatomic) NSUInteger minLength;
+@property (nonatomic) NSUInteger maxLength;
+@property (nonatomic) uint16_t leadingDigitMask;
+@property (nonatomic, copy) NSString *callingCode;
+@property (nonatomic, copy) NSString *nationalPrefix;
+@property (nonatomic, copy) NSArray<NSString *> *formatLeadingDigits;
+@property (nonatomic, copy) NSArray<NSString *> *formatTemplates;
+
+@end
+
+@implementation STPPhoneNumberMetadata
+
+#pragma mark - Loading
+
++ (nullable NSData *)metadataFileData {
+    static NSData *data;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *path = [[STPBundleLocator stripeResourcesBundle] pathForResource:@"stp_phone_metadata" ofType:@"bin"];
+        if (path) {
+            data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+        }
+    });
+    return data;
+}
+
++ (instancetype)metadataForCountryCode:(NSString *)countryCode {
+    NSString *sanitizedCountryCode = countryCode.uppercaseString;
+    if (sanitizedCountryCode.length != 2) {
+        return nil;
+    }
+
+    static NSMutableDictionary<NSString *, id> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [NSMutableDictionary new];
+    });
+
+    @synchronized (cache) {
+        id metadata = cache[sanitizedCountryCode];
+        if (!metadata) {
+            NSData *data = [self metadataFileData];
+            metadata = (data ? [self metadataForCountryCode:sanitizedCountryCode fromData:data] : nil) ?: [NSNull null];
+            cache[sanitizedCountryCode] = metadata;
+        }
+        return (metadata == [NSNull null]) ? nil : metadata;
+    }
+}
+
+static uint16_t readUInt16(const uint8_t *bytes) {
+    uint16_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt16LittleToHost(value);
+}
+
+static uint32_t readUInt32(const uint8_t *bytes) {
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt32LittleToHost(value);
+}
+
++ (instancetype)metadataForCountryCode:(NSString *)countryCode fromData:(NSData *)data {
+    const uint8_t *bytes = data.bytes;
+    NSUInteger length = data.length;
+    if (length < HeaderLength
+        || memcmp(bytes, MetadataMagic, sizeof(MetadataMagic)) != 0
+        || bytes[4] != MetadataVersion
+        || countryCode.length != 2) {
+        return nil;
+    }
+    NSUInteger countryCount = readUInt16(bytes + 6);
+    if (length < HeaderLength + countryCount * IndexEntryLength) {
+        return nil;
+    }
+
+    // The index is sorted by country code
+    char code[2] = {(char)[countryCode characterAtIndex:0], (char)[countryCode characterAtIndex:1]};
+    NSUInteger low = 0;
+    NSUInteger high = countryCount;
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        const uint8_t *entry = bytes + HeaderLength + middle * IndexEntryLength;
+        int comparison = memcmp(code, entry, sizeof(code));
+        if (comparison == 0) {
+            NSUInteger recordOffset = readUInt32(entry + 2);
+            if (recordOffset >= length) {
+                return nil;
+            }
+            return [[self alloc] initWithRecord:bytes + recordOffset length:length - recordOffset];
+        }
+        else if (comparison < 0) {
+            high = middle;
+        }
+        else {
+            low = middle + 1;
+        }
+    }
+    return nil;
+}
+
+static NSString * _Nullable readString(const uint8_t *record, NSUInteger recordLength, NSUInteger *offset) {
+    if (*offset >= recordLength || *offset + 1 + record[*offset] > recordLength) {
+        return nil;
+    }
+    NSString *string = [[NSString alloc] initWithBytes:record + *offset + 1
+                                                length:record[*offset]
+                                              encoding:NSASCIIStringEncoding];
+    *offset += 1 + record[*offset];
+    return string;
+}
+
+- (nullable instancetype)initWithRecord:(const uint8_t *)record length:(NSUInteger)recordLength {
+    self = [super init];
+    if (self) {
+        NSUInteger offset = 4;
+        if (recordLength < offset) {
+            return nil;
+        }
+        _minLength = record[0];
+        _maxLength = record[1];
+        _leadingDigitMask = readUInt16(record + 2);
+        _callingCode = readString(record, recordLength, &offset);
+        _nationalPrefix = readString(record, recordLength, &offset);
+        if (!_callingCode || !_nationalPrefix || offset >= recordLength) {
+            return nil;
+        }
+        NSUInteger formatCount = record[offset++];
+
+        NSMutableArray<NSString *> *formatLeadingDigits = [NSMutableArray arrayWithCapacity:formatCount];
+        NSMutableArray<NSString *> *formatTemplates = [NSMutableArray arrayWithCapacity:formatCount];
+        for (NSUInteger i = 0; i < formatCount * 2; i++) {
+            NSString *string = readString(record, recordLength, &offset);
+            if (!string) {
+                return nil;
+            }
+            [(i % 2 == 0 ? formatLeadingDigits : formatTemplates) addObject:string];
+        }
+        _formatLeadingDigits = [formatLeadingDigits copy];
+        _formatTemplates = [formatTemplates copy];
+    }
+    return self;
+}
+
+#pragma mark - Validation
+
+- (NSString *)nationalNumberForString:(NSString *)string {
+    NSString *trimmedString = [string stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+    NSString *digits = [STPCardValidator sanitizedNumericStringForString:trimmedString];
+    BOOL international = [trimmedString hasPrefix:@"+"];
+    if (!international && [digits hasPrefix:InternationalPrefix]) {
+        international = YES;
+        digits = [digits substringFromIndex:InternationalPrefix.length];
+    }
+    if (!international) {
+        return digits;
+    }
+
+    if (digits.length < self.callingCode.length) {
+        // Still typing the calling code
+        return [self.callingCode hasPrefix:digits] ? @"" : nil;
+    }
+    if (![digits hasPrefix:self.callingCode]) {
+        return nil;
+    }
+    NSString *number = [digits substringFromIndex:self.callingCode.length];
+    // Some people keep the trunk prefix, e.g. +44 (0)7700 900123
+    if (self.nationalPrefix.length == 0 || number.length == 0 || [number hasPrefix:self.nationalPrefix]) {
+        return number;
+    }
+    return [self.nationalPrefix stringByAppendingString:number];
+}
+
+- (BOOL)numberCanStartWithDigit:(unichar)digit {
+    return digit >= '0' && digit <= '9' && (self.leadingDigitMask & (1 << (digit - '0')));
+}
+
+- (BOOL)isValidNumber:(NSString *)digits {
+    return (digits.length >= self.minLength
+            && digits.length <= self.maxLength
+            && [self numberCanStartWithDigit:[digits characterAtIndex:0]]);
+}
+
+- (BOOL)isValidPartialNumber:(NSString *)digits {
+    return (digits.length == 0
+            || (digits.length <= self.maxLength
+                && [self numberCanStartWithDigit:[digits characterAtIndex:0]]));
+}
+
+#pragma mark - Formatting
+
+- (nullable NSString *)templateForString:(NSString *)string {
+    for (NSUInteger i = 0; i < self.formatTemplates.count; i++) {
+        NSString *leadingDigits = self.formatLeadingDigits[i];
+        BOOL matches = YES;
+        for (NSUInteger j = 0; j < leadingDigits.length && j < string.length; j++) {
+            unichar leadingDigit = [leadingDigits characterAtIndex:j];
+            if (leadingDigit != TemplateDigit && leadingDigit != [string characterAtIndex:j]) {
+                matches = NO;
+                break;
+            }
+        }
+        if (matches) {
+            return self.formatTemplates[i];
+        }
+    }
+    return nil;
+}
+
+- (NSString *)formattedNumberForString:(NSString *)string {
+    NSString *number = (string.length > self.maxLength) ? [string substringToIndex:self.maxLength] : string;
+    NSString *template = [self templateForString:number];
+    if (!template) {
+        return number;
+    }
+
+    NSUInteger firstGroupLength = 0;
+    NSUInteger templateIndex = 0;
+    for (; templateIndex < template.length && [template characterAtIndex:templateIndex] != TemplateDigit; templateIndex++);
+    for (; templateIndex < template.length && [template characterAtIndex:templateIndex] == TemplateDigit; templateIndex++) {
+        firstGroupLength++;
+    }
+    if (number.length < firstGroupLength) {
+        return number;
+    }
+
+    NSMutableString *formatted = [NSMutableString stringWithCapacity:template.length];
+    NSUInteger numberIndex = 0;
+    for (templateIndex = 0; templateIndex < template.length; templateIndex++) {
+        unichar templateCharacter = [template characterAtIndex:templateIndex];
+        if (templateCharacter == TemplateDigit) {
+            if (numberIndex == number.length) {
+                break;
+            }
+            [formatted appendFormat:@"%C", [number characterAtIndex:numberIndex++]];
+        }
+        else {
+            // Separators after a finished group are added right away, e.g. "(555) "
+            [formatted appendFormat:@"%C", templateCharacter];
+        }
+    }
+    if (numberIndex < number.length) {
+        [formatted appendString:[number substringFromIndex:numberIndex]];
+    }
+    return [formatted copy];
+}
+
+@end
@@ -19,6 +19,23 @@ NS_ASSUME_NONNULL_BEGIN
 + (BOOL)stringIsValidPhoneNumber:(NSString *)string
                   forCountryCode:(nullable NSString *)countryCode;
 
+/**
+ Returns YES if we know how numbers are written in the country, i.e. the other
+ methods do more than pass numbers through.
+ */
++ (BOOL)canFormatPhoneNumbersForCountryCode:(nullable NSString *)countryCode;
+
+/**
+ Returns the digits of `string`, keeping a leading + for numbers dialed with
+ their country calling code.
+ */
++ (NSString *)sanitizedPhoneNumberForString:(NSString *)string;
+
+/**
+ Groups the digits of `string` the way numbers are written in the country.
+ Numbers dialed with + or 00 keep their prefix, and are returned ungrouped and
+ untruncated, since they can be longer than national numbers.
+ */
 + (NSString *)formattedSanitizedPhoneNumberForString:(NSString *)string;
 + (NSString *)formattedSanitizedPhoneNumberForString:(NSString *)string
                                       forCountryCode:(nullable NSString *)countryCode;
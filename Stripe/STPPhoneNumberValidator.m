@@ -8,9 +8,9 @@
 
 #import "STPPhoneNumberValidator.h"
 
-
-#import "NSString+Stripe.h"
 #import "STPCardValidator.h"
+#import "STPPhoneNumberMetadata.h"
+
 @implementation STPPhoneNumberValidator
 
 + (NSString *)countryCodeOrCurrentLocaleCountryFromString:(nullable NSString *)nillableCode {
@@ -35,9 +35,11 @@
 + (BOOL)stringIsValidPartialPhoneNumber:(NSString *)string
                          forCountryCode:(nullable NSString *)nillableCode {
     NSString *countryCode = [self countryCodeOrCurrentLocaleCountryFromString:nillableCode];
-    
-    if ([countryCode isEqualToString:@"US"]) {
-        return [STPCardValidator sanitizedNumericStringForString:string].length <= 10;
+    STPPhoneNumberMetadata *metadata = [STPPhoneNumberMetadata metadataForCountryCode:countryCode];
+
+    if (metadata) {
+        NSString *nationalNumber = [metadata nationalNumberForString:string];
+        return nationalNumber && [metadata isValidPartialNumber:nationalNumber];
     }
     else {
         return YES;
@@ -47,15 +49,28 @@
 + (BOOL)stringIsValidPhoneNumber:(NSString *)string 
                   forCountryCode:(nullable NSString *)nillableCode {
     NSString *countryCode = [self countryCodeOrCurrentLocaleCountryFromString:nillableCode];
-    
-    if ([countryCode isEqualToString:@"US"]) {
-        return [STPCardValidator sanitizedNumericStringForString:string].length == 10;
+    STPPhoneNumberMetadata *metadata = [STPPhoneNumberMetadata metadataForCountryCode:countryCode];
+
+    if (metadata) {
+        NSString *nationalNumber = [metadata nationalNumberForString:string];
+        return nationalNumber && [metadata isValidNumber:nationalNumber];
     }
     else {
         return YES;
     }
 }
 
++ (BOOL)canFormatPhoneNumbersForCountryCode:(nullable NSString *)nillableCode {
+    NSString *countryCode = [self countryCodeOrCurrentLocaleCountryFromString:nillableCode];
+    return [STPPhoneNumberMetadata metadataForCountryCode:countryCode] != nil;
+}
+
++ (NSString *)sanitizedPhoneNumberForString:(NSString *)string {
+    NSString *trimmedString = [string stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+    NSString *digits = [STPCardValidator sanitizedNumericStringForString:trimmedString];
+    return [trimmedString hasPrefix:@"+"] ? [@"+" stringByAppendingString:digits] : digits;
+}
+
 + (NSString *)formattedSanitizedPhoneNumberForString:(NSString *)string {
     return [self formattedSanitizedPhoneNumberForString:string
                                          forCountryCode:nil];
@@ -64,7 +79,13 @@
 + (NSString *)formattedSanitizedPhoneNumberForString:(NSString *)string 
                                       forCountryCode:(nullable NSString *)nillableCode {
     NSString *countryCode = [self countryCodeOrCurrentLocaleCountryFromString:nillableCode];
-    NSString *sanitized = [STPCardValidator sanitizedNumericStringForString:string];
+    NSString *sanitized = [self sanitizedPhoneNumberForString:string];
+    STPPhoneNumberMetadata *metadata = [STPPhoneNumberMetadata metadataForCountryCode:countryCode];
+    if ([sanitized hasPrefix:@"+"]
+        || (metadata && ![[metadata nationalNumberForString:sanitized] isEqualToString:sanitized])) {
+        // Numbers dialed with + or 00 aren't grouped, or cut to the national length
+        return sanitized;
+    }
     return [self formattedPhoneNumberForString:sanitized
                                 forCountryCode:countryCode];
 }
@@ -89,23 +110,11 @@
 
 + (NSString *)formattedPhoneNumberForString:(NSString *)string 
                              forCountryCode:(NSString *)countryCode {
-    
-    if (![countryCode isEqualToString:@"US"]) {
+    STPPhoneNumberMetadata *metadata = [STPPhoneNumberMetadata metadataForCountryCode:countryCode];
+    if (!metadata) {
         return string;
     }
-    if (string.length >= 6) {
-        return [NSString stringWithFormat:@"(%@) %@-%@",
-                [string stp_safeSubstringToIndex:3],
-                [[string stp_safeSubstringToIndex:6] stp_safeSubstringFromIndex:3],
-                [[string stp_safeSubstringToIndex:10] stp_safeSubstringFromIndex:6]
-                ];
-    } else if (string.length >= 3) {
-        return [NSString stringWithFormat:@"(%@) %@",
-                [string stp_safeSubstringToIndex:3],
-                [string stp_safeSubstringFromIndex:3]
-                ];
-    }
-    return string;
+    return [metadata formattedNumberForString:string];
 }
 
 @end
@@ -0,0 +1,64 @@
+//
+//  STPPoller.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class STPAPIClient;
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef void (^STPPollerCompletionBlock)(id __nullable object, NSError * __nullable error);
+typedef void (^STPPollerResponseBlock)(id __nullable object, NSHTTPURLResponse * __nullable response, NSError * __nullable error);
+
+/**
+ Repeatedly retrieves an API object until it reaches a state its subclass
+ considers final, backing off on server errors, retrying on connectivity
+ errors, and pausing while the app is in the background.
+
+ Don't use this class directly; subclasses override
+ `retrieveObjectWithCompletion:` and `shouldContinuePollingObject:`, and call
+ `startPolling` at the end of their initializer.
+ */
+NS_EXTENSION_UNAVAILABLE("Polling is not available in extensions")
+@interface STPPoller : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithAPIClient:(STPAPIClient *)apiClient
+                          timeout:(NSTimeInterval)timeout
+                       completion:(STPPollerCompletionBlock)completion NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, weak, readonly) STPAPIClient *apiClient;
+
+/**
+ Makes the first request right away, then polls until the object is final,
+ the timeout is reached, or `stopPolling` is called.
+ */
+- (void)startPolling;
+
+/**
+ Stops polling and cancels the request in progress. The completion block
+ isn't called.
+ */
+- (void)stopPolling;
+
+#pragma mark - For subclasses
+
+/**
+ Retrieves the object being polled.
+ */
+- (nullable NSURLSessionDataTask *)retrieveObjectWithCompletion:(STPPollerResponseBlock)completion;
+
+/**
+ Whether to keep polling after retrieving `object`. Defaults to NO.
+ */
+- (BOOL)shouldContinuePollingObject:(nullable id)object;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,231 @@
+//
+//  STPPoller.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPPoller.h"
+
+#import <UIKit/UIKit.h>
+
+#import "NSError+Stripe.h"
+#import "STPAPIClient.h"
+#import "STPClock.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+static NSTimeInterval const DefaultPollInterval = 1.5;
+static NSTimeInterval const MaxPollInterval = 24;
+// Stop polling after 5 minutes
+static NSTimeInterval const MaxTimeout = 60*5;
+// Stop polling after 5 consecutive non-200 responses
+static NSTimeInterval const MaxRetries = 5;
+
+@interface STPPoller ()
+
+@property (nonatomic, weak, readwrite) STPAPIClient *apiClient;
+@property (nonatomic, copy) STPPollerCompletionBlock completion;
+@property (nonatomic, nullable) id latestObject;
+@property (nonatomic) NSTimeInterval pollInterval;
+@property (nonatomic) NSTimeInterval timeout;
+@property (nonatomic, nullable) NSURLSessionDataTask *dataTask;
+@property (nonatomic, nullable) NSTimer *timer;
+@property (nonatomic) STPClock *clock;
+@property (nonatomic) NSTimeInterval startTime;
+@property (nonatomic) NSInteger retryCount;
+@property (nonatomic) NSInteger requestCount;
+@property (nonatomic) BOOL pollingPaused;
+@property (nonatomic) BOOL pollingStopped;
+
+@end
+
+@implementation STPPoller
+
+- (instancetype)initWithAPIClient:(STPAPIClient *)apiClient
+                          timeout:(NSTimeInterval)timeout
+                       completion:(STPPollerCompletionBlock)completion {
+    self = [super init];
+    if (self) {
+        _apiClient = apiClient;
+        _completion = completion;
+        _pollInterval = DefaultPollInterval;
+        _timeout = timeout;
+        _clock = [STPClock sharedClock];
+        _startTime = [_clock monotonicTime];
+        _retryCount = 0;
+        _requestCount = 0;
+        _pollingPaused = NO;
+        _pollingStopped = NO;
+        NSNotificationCenter *notificationCenter = [NSNotificationCenter defaultCenter];
+        [notificationCenter addObserver:self
+                               selector:@selector(restartPolling)
+                                   name:UIApplicationDidBecomeActiveNotification
+                                 object:nil];
+        [notificationCenter addObserver:self
+                               selector:@selector(restartPolling)
+                                   name:UIApplicationWillEnterForegroundNotification
+                                 object:nil];
+        [notificationCenter addObserver:self
+                               selector:@selector(pausePolling)
+                                   name:UIApplicationWillResignActiveNotification
+                                 object:nil];
+        [notificationCenter addObserver:self
+                               selector:@selector(pausePolling)
+                                   name:UIApplicationDidEnterBackgroundNotification
+                                 object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)startPolling {
+    if (self.pollingStopped || self.timer || self.dataTask) {
+        return;
+    }
+    if (!self.apiClient) {
+        [self cleanupAndFireCompletionWithObject:nil error:nil];
+        return;
+    }
+    [self poll];
+}
+
+- (nullable NSURLSessionDataTask *)retrieveObjectWithCompletion:(__unused STPPollerResponseBlock)completion {
+    NSAssert(NO, @"Subclasses of STPPoller must override retrieveObjectWithCompletion:");
+    return nil;
+}
+
+- (BOOL)shouldContinuePollingObject:(__unused nullable id)object {
+    return NO;
+}
+
+- (void)pollAfter:(NSTimeInterval)interval lastError:(nullable NSError *)error {
+    NSTimeInterval totalTime = [self.clock monotonicTime] - self.startTime;
+    BOOL shouldTimeout = (self.requestCount > 0 &&
+                          (totalTime >= MIN(self.timeout, MaxTimeout) || self.retryCount >= MaxRetries));
+    if (!self.apiClient || shouldTimeout) {
+        [self cleanupAndFireCompletionWithObject:self.latestObject
+                                           error:error];
+        return;
+    }
+    if (self.pollingPaused || self.pollingStopped) {
+        return;
+    }
+    self.timer = [self.clock scheduledTimerWithTimeInterval:interval
+                                                     target:self
+                                                   selector:@selector(poll)];
+}
+
+- (void)poll {
+    self.timer = nil;
+    UIApplication *application = [UIApplication sharedApplication];
+    __block UIBackgroundTaskIdentifier bgTaskID = UIBackgroundTaskInvalid;
+    bgTaskID = [application beginBackgroundTaskWithExpirationHandler:^{
+        self.dataTask = nil;
+        [application endBackgroundTask:bgTaskID];
+        bgTaskID = UIBackgroundTaskInvalid;
+    }];
+    self.dataTask = [self retrieveObjectWithCompletion:^(id object, NSHTTPURLResponse *response, NSError *error) {
+        [self continueWithObject:object response:response error:error];
+        self.requestCount++;
+        self.dataTask = nil;
+        [application endBackgroundTask:bgTaskID];
+        bgTaskID = UIBackgroundTaskInvalid;
+    }];
+}
+
+- (void)continueWithObject:(nullable id)object
+                  response:(nullable NSHTTPURLResponse *)response
+                     error:(nullable NSError *)error {
+    if (response) {
+        NSUInteger status = response.statusCode;
+        if (status >= 400 && status < 500) {
+            // Don't retry requests that 4xx
+            [self cleanupAndFireCompletionWithObject:self.latestObject
+                                               error:error];
+        } else if (status == 200) {
+            self.pollInterval = DefaultPollInterval;
+            self.retryCount = 0;
+            self.latestObject = object;
+            if ([self shouldContinuePollingObject:object]) {
+                [self pollAfter:self.pollInterval lastError:nil];
+            } else {
+                [self cleanupAndFireCompletionWithObject:self.latestObject
+                                                   error:nil];
+            }
+        } else {
+            // Backoff and increment retry count
+            self.pollInterval = MIN(self.pollInterval*2, MaxPollInterval);
+            self.retryCount++;
+            [self pollAfter:self.pollInterval lastError:error];
+        }
+    } else {
+        // Retry if there's a connectivity error
+        if (error.code == kCFURLErrorNotConnectedToInternet ||
+            error.code == kCFURLErrorNetworkConnectionLost) {
+            self.retryCount++;
+            [self pollAfter:self.pollInterval lastError:error];
+        } else {
+            // Don't call completion if the request was cancelled
+            if (error.code != kCFURLErrorCancelled) {
+                [self cleanupAndFireCompletionWithObject:self.latestObject
+                                                   error:error];
+            }
+            [self stopPolling];
+        }
+    }
+}
+
+- (void)restartPolling {
+    if (self.pollingStopped) {
+        return;
+    }
+    self.pollingPaused = NO;
+    if (!self.timer && !self.dataTask) {
+        [self pollAfter:0 lastError:nil];
+    }
+}
+
+// Pauses polling, without canceling the request in progress.
+- (void)pausePolling {
+    self.pollingPaused = YES;
+    if (self.timer) {
+        [self.timer invalidate];
+        self.timer = nil;
+    }
+}
+
+- (void)cleanupAndFireCompletionWithObject:(nullable id)object
+                                     error:(nullable NSError *)error {
+    if (!self.pollingStopped) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (!error && !object) {
+                self.completion(nil, [NSError stp_genericConnectionError]);
+            } else {
+                self.completion(object, error);
+            }
+        });
+        [self stopPolling];
+    }
+}
+
+// Stops polling and cancels the request in progress.
+- (void)stopPolling {
+    self.pollingStopped = YES;
+    if (self.timer) {
+        [self.timer invalidate];
+        self.timer = nil;
+    }
+    if (self.dataTask) {
+        [self.dataTask cancel];
+        self.dataTask = nil;
+    }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
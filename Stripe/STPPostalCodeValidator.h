@@ -19,7 +19,26 @@ typedef NS_ENUM(NSUInteger, STPPostalCodeIntendedUsage) {
 + (STPCardValidationState)validationStateForPostalCode:(nullable NSString *)postalCode
                                            countryCode:(nullable NSString *)countryCode;
 
+/**
+ The same as `validationStateForPostalCode:countryCode:` if `strict` is YES.
+ Otherwise only US ZIP codes are held to their format, and other postal codes
+ only have to be non-empty. Use this when `countryCode` is only a guess (e.g.
+ the device's locale), and may not be the country of the postal code at all.
+ */
++ (STPCardValidationState)validationStateForPostalCode:(nullable NSString *)postalCode
+                                           countryCode:(nullable NSString *)countryCode
+                                                strict:(BOOL)strict;
+
 + (nullable NSString *)formattedSanitizedPostalCodeFromString:(nullable NSString *)postalCode
                                                   countryCode:(nullable NSString *)countryCode
                                                         usage:(STPPostalCodeIntendedUsage)usage;
+
+/**
+ The same as `formattedSanitizedPostalCodeFromString:countryCode:usage:` if
+ `strict` is YES. Otherwise only US ZIP codes are formatted.
+ */
++ (nullable NSString *)formattedSanitizedPostalCodeFromString:(nullable NSString *)postalCode
+                                                  countryCode:(nullable NSString *)countryCode
+                                                        usage:(STPPostalCodeIntendedUsage)usage
+                                                       strict:(BOOL)strict;
 @end
@@ -10,120 +10,496 @@
 
 #import "STPCardValidator.h"
 #import "STPPhoneNumberValidator.h"
-#import "NSCharacterSet+Stripe.h"
 #import "NSString+Stripe.h"
 
 static NSString *const STPCountryCodeUnitedStates = @"US";
 
-@implementation STPPostalCodeValidator
+#pragma mark - Postal code formats
 
-+ (STPCardValidationState)validationStateForPostalCode:(NSString *)postalCode
-                                           countryCode:(NSString *)countryCode {
-    NSString *sanitizedCountryCode = countryCode.uppercaseString;
-    if ([self postalCodeIsRequiredForCountryCode:countryCode]) {
-        if ([sanitizedCountryCode isEqualToString:STPCountryCodeUnitedStates]) {
-            return [self validationStateForUSPostalCode:postalCode];
+/**
+ Postal code formats by country. Each format is one or more patterns separated
+ by `|`, where `9` is a digit, `A` is a letter, and a space or hyphen is a
+ separator, which may be typed as either or left out.
+ */
+static const struct {
+    const char *countryCode;
+    const char *patterns;
+} STPPostalCodePatterns[] = {
+    { "AD", "AA999" },
+    { "AF", "9999" },
+    { "AL", "9999" },
+    { "AM", "9999" },
+    { "AR", "A9999AAA|9999" },
+    { "AT", "9999" },
+    { "AU", "9999" },
+    { "BA", "99999" },
+    { "BD", "9999" },
+    { "BE", "9999" },
+    { "BG", "9999" },
+    { "BH", "999|9999" },
+    { "BN", "AA9999" },
+    { "BR", "99999-999" },
+    { "BT", "99999" },
+    { "BY", "999999" },
+    { "CA", "A9A 9A9" },
+    { "CH", "9999" },
+    { "CL", "9999999" },
+    { "CN", "999999" },
+    { "CO", "999999" },
+    { "CR", "99999" },
+    { "CU", "99999" },
+    { "CV", "9999" },
+    { "CY", "9999" },
+    { "CZ", "999 99" },
+    { "DE", "99999" },
+    { "DK", "9999" },
+    { "DO", "99999" },
+    { "DZ", "99999" },
+    { "EC", "999999" },
+    { "EE", "99999" },
+    { "EG", "99999" },
+    { "ES", "99999" },
+    { "ET", "9999" },
+    { "FI", "99999" },
+    { "FO", "999" },
+    { "FR", "99999" },
+    { "GB", "A9 9AA|A99 9AA|AA9 9AA|AA99 9AA|A9A 9AA|AA9A 9AA" },
+    { "GE", "9999" },
+    { "GF", "99999" },
+    { "GG", "AA9 9AA|AA99 9AA" },
+    { "GL", "9999" },
+    { "GP", "99999" },
+    { "GR", "999 99" },
+    { "GT", "99999" },
+    { "HR", "99999" },
+    { "HU", "9999" },
+    { "ID", "99999" },
+    { "IL", "9999999" },
+    { "IM", "AA9 9AA|AA99 9AA" },
+    { "IN", "999999" },
+    { "IQ", "99999" },
+    { "IR", "99999-99999" },
+    { "IS", "999" },
+    { "IT", "99999" },
+    { "JE", "AA9 9AA|AA99 9AA" },
+    { "JO", "99999" },
+    { "JP", "999-9999" },
+    { "KG", "999999" },
+    { "KH", "99999" },
+    { "KR", "99999" },
+    { "KW", "99999" },
+    { "KZ", "999999" },
+    { "LA", "99999" },
+    { "LI", "9999" },
+    { "LK", "99999" },
+    { "LR", "9999" },
+    { "LS", "999" },
+    { "LT", "99999" },
+    { "LU", "9999" },
+    { "MA", "99999" },
+    { "MC", "99999" },
+    { "ME", "99999" },
+    { "MG", "999" },
+    { "MK", "9999" },
+    { "MM", "99999" },
+    { "MQ", "99999" },
+    { "MT", "AAA 9999" },
+    { "MV", "99999" },
+    { "MX", "99999" },
+    { "MY", "99999" },
+    { "MZ", "9999" },
+    { "NC", "99999" },
+    { "NE", "9999" },
+    { "NG", "999999" },
+    { "NI", "99999" },
+    { "NL", "9999 AA" },
+    { "NO", "9999" },
+    { "NP", "99999" },
+    { "NZ", "9999" },
+    { "OM", "999" },
+    { "PE", "99999" },
+    { "PF", "99999" },
+    { "PG", "999" },
+    { "PH", "9999" },
+    { "PK", "99999" },
+    { "PL", "99-999" },
+    { "PM", "99999" },
+    { "PR", "99999|99999-9999" },
+    { "PT", "9999-999" },
+    { "PY", "9999" },
+    { "RE", "99999" },
+    { "RO", "999999" },
+    { "RS", "99999" },
+    { "RU", "999999" },
+    { "SE", "999 99" },
+    { "SG", "999999" },
+    { "SI", "9999" },
+    { "SJ", "9999" },
+    { "SK", "999 99" },
+    { "SM", "99999" },
+    { "SN", "99999" },
+    { "SZ", "A999" },
+    { "TH", "99999" },
+    { "TJ", "999999" },
+    { "TM", "999999" },
+    { "TN", "9999" },
+    { "TR", "99999" },
+    { "TW", "999|99999" },
+    { "UA", "99999" },
+    { "US", "99999|99999-9999" },
+    { "UY", "99999" },
+    { "UZ", "999999" },
+    { "VA", "99999" },
+    { "VE", "9999" },
+    { "VN", "999999" },
+    { "YT", "99999" },
+    { "ZM", "99999" },
+};
+
+typedef NS_ENUM(NSInteger, STPPostalCodeCharacterClass) {
+    STPPostalCodeCharacterClassDigit,
+    STPPostalCodeCharacterClassLetter,
+    STPPostalCodeCharacterClassSeparator,
+    STPPostalCodeCharacterClassOther,
+};
+
+static const NSUInteger STPPostalCodeCharacterClassCount = STPPostalCodeCharacterClassOther;
+static const NSUInteger MaxPatternCount = 8;
+static const NSUInteger MaxPatternLength = 15;
+// State sets are bitsets of pattern positions, so there can't be more than
+// 64 positions; GB's six patterns are the largest table entry, at 33 states
+static const NSUInteger MaxStateCount = 64;
+static const int8_t NoState = -1;
+
+static STPPostalCodeCharacterClass characterClassForCharacter(unichar character) {
+    if (character >= '0' && character <= '9') {
+        return STPPostalCodeCharacterClassDigit;
+    }
+    else if ((character >= 'A' && character <= 'Z') || (character >= 'a' && character <= 'z')) {
+        return STPPostalCodeCharacterClassLetter;
+    }
+    else if (character == ' ' || character == '-') {
+        return STPPostalCodeCharacterClassSeparator;
+    }
+    else {
+        return STPPostalCodeCharacterClassOther;
+    }
+}
+
+static STPPostalCodeCharacterClass characterClassForPatternCharacter(char character) {
+    switch (character) {
+        case '9':
+            return STPPostalCodeCharacterClassDigit;
+        case 'A':
+            return STPPostalCodeCharacterClassLetter;
+        default:
+            return STPPostalCodeCharacterClassSeparator;
+    }
+}
+
+typedef struct {
+    int8_t next[STPPostalCodeCharacterClassCount];
+    BOOL accepting;
+} STPPostalCodeState;
+
+typedef NS_ENUM(NSInteger, STPPostalCodePatternMatch) {
+    STPPostalCodePatternMatchNone,
+    STPPostalCodePatternMatchPartial,
+    STPPostalCodePatternMatchComplete,
+};
+
+/**
+ A country's postal code patterns. They're compiled into a DFA over character
+ classes, so validating a postal code is a single pass over its characters
+ with no allocations.
+ */
+@interface STPPostalCodeFormat : NSObject
+
+- (nullable instancetype)initWithPatterns:(const char *)patterns;
+- (STPCardValidationState)validationStateForPostalCode:(nullable NSString *)postalCode;
+- (nullable NSString *)formattedPostalCodeFromString:(nullable NSString *)postalCode;
+
+@end
+
+@implementation STPPostalCodeFormat {
+    char _patterns[MaxPatternCount][MaxPatternLength + 1];
+    NSUInteger _patternCount;
+    STPPostalCodeState _states[MaxStateCount];
+}
+
+- (instancetype)initWithPatterns:(const char *)patterns {
+    self = [super init];
+    if (self) {
+        /*
+         Every position in every pattern, including the one past its end, gets
+         a bit. A DFA state is the set of positions the input so far could have
+         reached. Separators may be left out, so being in front of one also
+         means being just past it.
+         */
+        STPPostalCodeCharacterClass classes[64];
+        uint64_t separatorPositions = 0;
+        uint64_t acceptingPositions = 0;
+        uint64_t startPositions = 1;
+        NSUInteger positionCount = 0;
+        NSUInteger patternLength = 0;
+        for (const char *c = patterns; ; c++) {
+            if (positionCount >= 64 || patternLength > MaxPatternLength || _patternCount >= MaxPatternCount) {
+                NSAssert(NO, @"Postal code patterns are too long: %s", patterns);
+                return nil;
+            }
+            if (*c == '|' || *c == '\0') {
+                _patterns[_patternCount][patternLength] = '\0';
+                _patternCount++;
+                acceptingPositions |= (1ULL << positionCount);
+                positionCount++;
+                if (*c == '\0') {
+                    break;
+                }
+                startPositions |= (1ULL << positionCount);
+                patternLength = 0;
+                continue;
+            }
+            _patterns[_patternCount][patternLength++] = *c;
+            classes[positionCount] = characterClassForPatternCharacter(*c);
+            if (classes[positionCount] == STPPostalCodeCharacterClassSeparator) {
+                separatorPositions |= (1ULL << positionCount);
+            }
+            positionCount++;
         }
-        else {
-            if (postalCode.length > 0) {
-                return STPCardValidationStateValid;
+
+        uint64_t (^closure)(uint64_t) = ^uint64_t(uint64_t positions) {
+            // Patterns never have two separators in a row, but loop anyway
+            uint64_t skipped;
+            while ((skipped = (positions | ((positions & separatorPositions) << 1))) != positions) {
+                positions = skipped;
             }
-            else {
-                return STPCardValidationStateIncomplete;
+            return positions;
+        };
+
+        uint64_t stateSets[MaxStateCount];
+        NSUInteger stateCount = 1;
+        stateSets[0] = closure(startPositions);
+        for (NSUInteger state = 0; state < stateCount; state++) {
+            uint64_t positions = stateSets[state];
+            _states[state].accepting = (positions & acceptingPositions) != 0;
+            for (NSUInteger characterClass = 0; characterClass < STPPostalCodeCharacterClassCount; characterClass++) {
+                uint64_t nextPositions = 0;
+                for (NSUInteger position = 0; position < positionCount; position++) {
+                    uint64_t bit = (1ULL << position);
+                    if ((positions & bit)
+                        && !(acceptingPositions & bit)
+                        && classes[position] == (STPPostalCodeCharacterClass)characterClass) {
+                        nextPositions |= (bit << 1);
+                    }
+                }
+                if (nextPositions == 0) {
+                    _states[state].next[characterClass] = NoState;
+                    continue;
+                }
+                nextPositions = closure(nextPositions);
+                NSUInteger nextState = 0;
+                while (nextState < stateCount && stateSets[nextState] != nextPositions) {
+                    nextState++;
+                }
+                if (nextState == stateCount) {
+                    if (stateCount == MaxStateCount) {
+                        NSAssert(NO, @"Postal code patterns need too many states: %s", patterns);
+                        return nil;
+                    }
+                    stateSets[stateCount++] = nextPositions;
+                }
+                _states[state].next[characterClass] = (int8_t)nextState;
             }
         }
     }
-    else {
-        return STPCardValidationStateValid;
+    return self;
+}
+
+- (STPCardValidationState)validationStateForPostalCode:(NSString *)postalCode {
+    int8_t state = 0;
+    for (NSUInteger i = 0; i < postalCode.length; i++) {
+        STPPostalCodeCharacterClass characterClass = characterClassForCharacter([postalCode characterAtIndex:i]);
+        if (characterClass == STPPostalCodeCharacterClassOther) {
+            return STPCardValidationStateInvalid;
+        }
+        state = _states[state].next[characterClass];
+        if (state == NoState) {
+            return STPCardValidationStateInvalid;
+        }
+    }
+    return _states[state].accepting ? STPCardValidationStateValid : STPCardValidationStateIncomplete;
+}
+
+/**
+ Matches `characters` (letters and digits only) against a pattern and writes
+ them to `formatted` with the pattern's separators between them.
+ */
+- (STPPostalCodePatternMatch)matchPattern:(const char *)pattern
+                               characters:(const unichar *)characters
+                                   length:(NSUInteger)length
+                                formatted:(unichar *)formatted
+                          formattedLength:(NSUInteger *)formattedLength {
+    NSUInteger index = 0;
+    *formattedLength = 0;
+    for (const char *c = pattern; *c != '\0'; c++) {
+        STPPostalCodeCharacterClass characterClass = characterClassForPatternCharacter(*c);
+        if (characterClass == STPPostalCodeCharacterClassSeparator) {
+            if (index > 0 && index < length) {
+                formatted[(*formattedLength)++] = (unichar)*c;
+            }
+            continue;
+        }
+        if (index == length) {
+            return STPPostalCodePatternMatchPartial;
+        }
+        if (characterClassForCharacter(characters[index]) != characterClass) {
+            return STPPostalCodePatternMatchNone;
+        }
+        formatted[(*formattedLength)++] = characters[index++];
     }
+    return (index == length) ? STPPostalCodePatternMatchComplete : STPPostalCodePatternMatchNone;
 }
 
-static NSUInteger countOfCharactersFromSetInString(NSString * _Nonnull string, NSCharacterSet * _Nonnull cs) {
-    NSRange range = [string rangeOfCharacterFromSet:cs];
-    NSUInteger count = 0;
-    if (range.location != NSNotFound) {
-        NSUInteger lastPosition = NSMaxRange(range);
-        count += range.length;
-        while (lastPosition < string.length) {
-            range = [string rangeOfCharacterFromSet:cs options:(NSStringCompareOptions)kNilOptions range:NSMakeRange(lastPosition, string.length - lastPosition)];
-            if (range.location == NSNotFound) {
+- (NSString *)formattedPostalCodeFromString:(NSString *)postalCode {
+    unichar characters[MaxPatternLength];
+    NSUInteger length = 0;
+    for (NSUInteger i = 0; i < postalCode.length; i++) {
+        unichar character = [postalCode characterAtIndex:i];
+        switch (characterClassForCharacter(character)) {
+            case STPPostalCodeCharacterClassSeparator:
+                // Separators are put back where the format has them
                 break;
+            case STPPostalCodeCharacterClassLetter:
+                if (character >= 'a' && character <= 'z') {
+                    character -= ('a' - 'A');
+                }
+                // Fall through
+            case STPPostalCodeCharacterClassDigit:
+                if (length == MaxPatternLength) {
+                    return postalCode;
+                }
+                characters[length++] = character;
+                break;
+            case STPPostalCodeCharacterClassOther:
+                // Doesn't fit the format; leave it as is and let validation flag it
+                return postalCode;
+        }
+    }
+
+    /*
+     A complete match wins. Otherwise, only insert separators if every pattern
+     the input could still become agrees on where they go, so the text doesn't
+     jump around while typing.
+     */
+    unichar formatted[MaxPatternLength];
+    NSUInteger formattedLength = 0;
+    unichar partialFormatted[MaxPatternLength];
+    NSUInteger partialFormattedLength = 0;
+    NSUInteger partialMatchCount = 0;
+    BOOL partialMatchesAgree = YES;
+    for (NSUInteger i = 0; i < _patternCount; i++) {
+        STPPostalCodePatternMatch match = [self matchPattern:_patterns[i]
+                                                  characters:characters
+                                                      length:length
+                                                   formatted:formatted
+                                             formattedLength:&formattedLength];
+        if (match == STPPostalCodePatternMatchComplete) {
+            return [NSString stringWithCharacters:formatted length:formattedLength];
+        }
+        else if (match == STPPostalCodePatternMatchPartial) {
+            if (partialMatchCount == 0) {
+                memcpy(partialFormatted, formatted, formattedLength * sizeof(unichar));
+                partialFormattedLength = formattedLength;
             }
-            else {
-                count += range.length;
-                lastPosition = NSMaxRange(range);
+            else if (formattedLength != partialFormattedLength
+                     || memcmp(partialFormatted, formatted, formattedLength * sizeof(unichar)) != 0) {
+                partialMatchesAgree = NO;
             }
+            partialMatchCount++;
         }
     }
 
-    return count;
+    if (partialMatchCount == 0) {
+        return postalCode;
+    }
+    else if (partialMatchesAgree) {
+        return [NSString stringWithCharacters:partialFormatted length:partialFormattedLength];
+    }
+    else {
+        return [NSString stringWithCharacters:characters length:length];
+    }
 }
 
+@end
 
-+ (STPCardValidationState)validationStateForUSPostalCode:(NSString *)postalCode {
-    NSString *firstFive = [postalCode stp_safeSubstringToIndex:5];
-    NSUInteger firstFiveLength = firstFive.length;
-    NSUInteger totalLength = postalCode.length;
+@implementation STPPostalCodeValidator
 
-    BOOL firstFiveIsNumeric = [STPCardValidator stringIsNumeric:firstFive];
-    if (!firstFiveIsNumeric) {
-        // Non-numbers included in first five characters
-        return STPCardValidationStateInvalid;
-    }
-    else if (firstFiveLength < 5) {
-        // Incomplete ZIP with only numbers
-        return STPCardValidationStateIncomplete;
-    }
-    else if (totalLength == 5) {
-        // Valid 5 digit zip
-        return STPCardValidationStateValid;
++ (nullable STPPostalCodeFormat *)postalCodeFormatForCountryCode:(NSString *)countryCode {
+    static NSDictionary<NSString *, STPPostalCodeFormat *> *formatsByCountryCode;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSUInteger count = sizeof(STPPostalCodePatterns) / sizeof(STPPostalCodePatterns[0]);
+        NSMutableDictionary *formats = [NSMutableDictionary dictionaryWithCapacity:count];
+        for (NSUInteger i = 0; i < count; i++) {
+            STPPostalCodeFormat *format = [[STPPostalCodeFormat alloc] initWithPatterns:STPPostalCodePatterns[i].patterns];
+            if (format) {
+                formats[@(STPPostalCodePatterns[i].countryCode)] = format;
+            }
+        }
+        formatsByCountryCode = [formats copy];
+    });
+    return formatsByCountryCode[countryCode.uppercaseString];
+}
+
++ (NSArray<NSString *> *)countryCodesWithPostalCodeFormats {
+    NSUInteger count = sizeof(STPPostalCodePatterns) / sizeof(STPPostalCodePatterns[0]);
+    NSMutableArray<NSString *> *countryCodes = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [countryCodes addObject:@(STPPostalCodePatterns[i].countryCode)];
     }
-    else {
-        // ZIP+4 territory
-        NSUInteger numberOfDigits = countOfCharactersFromSetInString(postalCode, [NSCharacterSet stp_asciiDigitCharacterSet]);
+    return [countryCodes copy];
+}
 
-        if (numberOfDigits > 9) {
-            // Too many digits
-            return STPCardValidationStateInvalid;
++ (STPCardValidationState)validationStateForPostalCode:(NSString *)postalCode
+                                           countryCode:(NSString *)countryCode {
+    return [self validationStateForPostalCode:postalCode countryCode:countryCode strict:YES];
+}
+
++ (STPCardValidationState)validationStateForPostalCode:(NSString *)postalCode
+                                           countryCode:(NSString *)countryCode
+                                                strict:(BOOL)strict {
+    if ([self postalCodeIsRequiredForCountryCode:countryCode]) {
+        STPPostalCodeFormat *format = nil;
+        if (strict || [countryCode.uppercaseString isEqualToString:STPCountryCodeUnitedStates]) {
+            format = [self postalCodeFormatForCountryCode:countryCode];
         }
-        else if (numberOfDigits == totalLength) {
-            // All numeric postal code entered
-            if (numberOfDigits == 9) {
+        if (format) {
+            return [format validationStateForPostalCode:postalCode];
+        }
+        else {
+            if (postalCode.length > 0) {
                 return STPCardValidationStateValid;
             }
             else {
                 return STPCardValidationStateIncomplete;
             }
-
-        }
-        else if ((numberOfDigits + 1) == totalLength) {
-            // Possibly has a separator character for ZIP+4, check to see if
-            // its in the right place
-
-            NSString *separatorCharacter = [postalCode substringWithRange:NSMakeRange(5, 1)];
-            if (countOfCharactersFromSetInString(separatorCharacter, [NSCharacterSet stp_asciiDigitCharacterSet]) == 0) {
-                // Non-digit is in right position to be separator
-                if (numberOfDigits == 9) {
-                    return STPCardValidationStateValid;
-                }
-                else {
-                    return STPCardValidationStateIncomplete;
-                }
-            }
-            else {
-                // Non-digit is in wrong position to be separator
-                return STPCardValidationStateInvalid;
-            }
-        }
-        else {
-            // Not a valid zip code (too many non-numeric characters)
-            return STPCardValidationStateInvalid;
         }
     }
+    else {
+        return STPCardValidationStateValid;
+    }
 }
+
 + (NSString *)formattedSanitizedPostalCodeFromString:(NSString *)postalCode
                                          countryCode:(NSString *)countryCode
                                                usage:(STPPostalCodeIntendedUsage)usage {
+    return [self formattedSanitizedPostalCodeFromString:postalCode countryCode:countryCode usage:usage strict:YES];
+}
+
++ (NSString *)formattedSanitizedPostalCodeFromString:(NSString *)postalCode
+                                         countryCode:(NSString *)countryCode
+                                               usage:(STPPostalCodeIntendedUsage)usage
+                                              strict:(BOOL)strict {
     if (countryCode == nil) {
         return postalCode;
     }
@@ -134,7 +510,8 @@ static NSUInteger countOfCharactersFromSetInString(NSString * _Nonnull string, N
                                                      usage:usage];
     }
     else {
-        return postalCode;
+        STPPostalCodeFormat *format = strict ? [self postalCodeFormatForCountryCode:sanitizedCountryCode] : nil;
+        return format ? [format formattedPostalCodeFromString:postalCode] : postalCode;
     }
 
 }
@@ -178,7 +555,16 @@ static NSUInteger countOfCharactersFromSetInString(NSString * _Nonnull string, N
     }
 }
 
-+ (NSArray *)countriesWithNoPostalCodes {
++ (NSSet<NSString *> *)countriesWithNoPostalCodes {
+    static NSSet<NSString *> *countries;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        countries = [NSSet setWithArray:[self countriesWithNoPostalCodesList]];
+    });
+    return countries;
+}
+
++ (NSArray *)countriesWithNoPostalCodesList {
     return @[ @"AE",
               @"AG",
               @"AN",
@@ -7,9 +7,14 @@
 //
 
 #import "STPProduct.h"
+#import "NSDictionary+Stripe.h"
 #import "STPPackage.h"
 #import "STPSku.h"
 
+@interface STPProduct ()
+@property (nonatomic, copy, readwrite) NSDictionary *allResponseFields;
+@end
+
 @implementation STPProduct
 
 - (instancetype)init {
@@ -50,6 +55,16 @@
     return (maxPrice <= -1) ? nil : @(maxPrice);
 }
 
+#pragma mark - STPAPIResponseDecodable
+
++ (nullable instancetype)decodedObjectFromAPIResponse:(nullable NSDictionary *)response {
+    NSDictionary *dict = [response stp_dictionaryByRemovingNulls];
+    if (![dict stp_stringForKey:@"id"]) {
+        return nil;
+    }
+    return [[self alloc] initWithAttributeDictionary:dict];
+}
+
 @end
 
 @implementation STPProduct(PrivateMethods)
@@ -66,6 +81,7 @@
     }];
 
     if (self) {
+        _allResponseFields = [attributeDictionary stp_dictionaryByRemovingNulls];
         _prodId = dict[@"id"];
         _active = [dict[@"active"] boolValue];
         _shippable = [dict[@"shippable"] boolValue];
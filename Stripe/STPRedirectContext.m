@@ -9,6 +9,7 @@
 #import "STPRedirectContext.h"
 #import "STPRedirectContext+Private.h"
 
+#import "STPAPIClient.h"
 #import "STPBlocks.h"
 #import "STPDispatchFunctions.h"
 #import "STPPaymentIntent.h"
@@ -76,6 +77,22 @@ typedef void (^STPBoolCompletionBlock)(BOOL success);
                                 }];
 }
 
+- (nullable instancetype)initWithPaymentIntent:(STPPaymentIntent *)paymentIntent
+                                     apiClient:(STPAPIClient *)apiClient
+                                pollingTimeout:(NSTimeInterval)timeout
+                                    completion:(STPPaymentIntentCompletionBlock)completion {
+    return [self initWithPaymentIntent:paymentIntent completion:^(NSString *clientSecret, NSError * _Nullable error) {
+        if (error) {
+            completion(nil, error);
+        }
+        else {
+            [apiClient startPollingPaymentIntentWithClientSecret:clientSecret
+                                                         timeout:timeout
+                                                      completion:completion];
+        }
+    }];
+}
+
 /**
  Failable initializer for the general case of STPRedirectContext, some URLs and a completion block.
  */
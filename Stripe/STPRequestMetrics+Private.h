@@ -0,0 +1,49 @@
+//
+//  STPRequestMetrics+Private.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPRequestMetrics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface STPRequestMetrics ()
+
+- (instancetype)initWithEndpoint:(NSString *)endpoint HTTPMethod:(NSString *)HTTPMethod NS_DESIGNATED_INITIALIZER;
+
+/**
+ Replaces the object identifiers in an API endpoint with `:id`, so that
+ requests for different objects are grouped together.
+
+ @param endpoint An endpoint relative to the API base URL, e.g. `sources/src_123`
+ @return The normalized endpoint, e.g. `sources/:id`
+ */
++ (NSString *)normalizedEndpoint:(NSString *)endpoint;
+
+@property (nonatomic, readwrite) NSInteger statusCode;
+@property (nonatomic, nullable, readwrite) NSError *error;
+@property (nonatomic, readwrite) NSUInteger retryCount;
+@property (nonatomic, readwrite) NSTimeInterval retryDuration;
+@property (nonatomic, readwrite) NSTimeInterval domainLookupDuration;
+@property (nonatomic, readwrite) NSTimeInterval connectDuration;
+@property (nonatomic, readwrite) NSTimeInterval secureConnectionDuration;
+@property (nonatomic, readwrite) NSTimeInterval requestDuration;
+@property (nonatomic, readwrite) NSTimeInterval timeToFirstByte;
+@property (nonatomic, readwrite) NSTimeInterval transferDuration;
+@property (nonatomic, readwrite) NSTimeInterval formEncodeDuration;
+@property (nonatomic, readwrite) NSTimeInterval JSONParseDuration;
+@property (nonatomic, readwrite) NSTimeInterval modelDecodeDuration;
+@property (nonatomic, readwrite) NSTimeInterval mainThreadDispatchDelay;
+@property (nonatomic, readwrite) NSTimeInterval totalDuration;
+
+/**
+ Fills in the network timings from the final transaction of the task metrics.
+ */
+- (void)applyTaskMetrics:(NSURLSessionTaskMetrics *)taskMetrics API_AVAILABLE(ios(10.0));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,94 @@
+//
+//  STPRequestMetrics.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPRequestMetrics.h"
+#import "STPRequestMetrics+Private.h"
+
+static NSString * const IdentifierPlaceholder = @":id";
+
+@implementation STPRequestMetrics
+
+- (instancetype)initWithEndpoint:(NSString *)endpoint HTTPMethod:(NSString *)HTTPMethod {
+    self = [super init];
+    if (self) {
+        _endpoint = [[self class] normalizedEndpoint:endpoint];
+        _HTTPMethod = [HTTPMethod copy];
+    }
+    return self;
+}
+
++ (NSString *)normalizedEndpoint:(NSString *)endpoint {
+    NSCharacterSet *digits = [NSCharacterSet decimalDigitCharacterSet];
+    NSArray<NSString *> *components = [endpoint componentsSeparatedByString:@"/"];
+    NSMutableArray<NSString *> *normalizedComponents = [NSMutableArray arrayWithCapacity:components.count];
+    for (NSString *component in components) {
+        // Endpoint names never contain digits, object identifiers (cus_123, src_1DaIA7...) always do
+        if ([component rangeOfCharacterFromSet:digits].location != NSNotFound) {
+            [normalizedComponents addObject:IdentifierPlaceholder];
+        }
+        else {
+            [normalizedComponents addObject:component];
+        }
+    }
+    return [normalizedComponents componentsJoinedByString:@"/"];
+}
+
+static NSTimeInterval durationBetweenDates(NSDate *startDate, NSDate *endDate) {
+    if (startDate == nil || endDate == nil) {
+        return 0;
+    }
+    return MAX([endDate timeIntervalSinceDate:startDate], 0);
+}
+
+- (void)applyTaskMetrics:(NSURLSessionTaskMetrics *)taskMetrics {
+    // Earlier transactions are redirects or retried connections, the last one produced the response
+    NSURLSessionTaskTransactionMetrics *transaction = taskMetrics.transactionMetrics.lastObject;
+    if (transaction == nil) {
+        return;
+    }
+    self.domainLookupDuration = durationBetweenDates(transaction.domainLookupStartDate, transaction.domainLookupEndDate);
+    self.connectDuration = durationBetweenDates(transaction.connectStartDate, transaction.connectEndDate);
+    self.secureConnectionDuration = durationBetweenDates(transaction.secureConnectionStartDate, transaction.secureConnectionEndDate);
+    self.requestDuration = durationBetweenDates(transaction.requestStartDate, transaction.requestEndDate);
+    self.timeToFirstByte = durationBetweenDates(transaction.requestStartDate, transaction.responseStartDate);
+    self.transferDuration = durationBetweenDates(transaction.responseStartDate, transaction.responseEndDate);
+}
+
+- (NSString *)description {
+    NSArray *props = @[
+                       // Object
+                       [NSString stringWithFormat:@"%@: %p", NSStringFromClass([self class]), self],
+
+                       // Request
+                       [NSString stringWithFormat:@"endpoint = %@", self.endpoint],
+                       [NSString stringWithFormat:@"HTTPMethod = %@", self.HTTPMethod],
+                       [NSString stringWithFormat:@"statusCode = %ld", (long)self.statusCode],
+                       [NSString stringWithFormat:@"error = %@", self.error],
+                       [NSString stringWithFormat:@"retryCount = %lu", (unsigned long)self.retryCount],
+                       [NSString stringWithFormat:@"retryDuration = %.4f", self.retryDuration],
+
+                       // Network
+                       [NSString stringWithFormat:@"domainLookupDuration = %.4f", self.domainLookupDuration],
+                       [NSString stringWithFormat:@"connectDuration = %.4f", self.connectDuration],
+                       [NSString stringWithFormat:@"secureConnectionDuration = %.4f", self.secureConnectionDuration],
+                       [NSString stringWithFormat:@"requestDuration = %.4f", self.requestDuration],
+                       [NSString stringWithFormat:@"timeToFirstByte = %.4f", self.timeToFirstByte],
+                       [NSString stringWithFormat:@"transferDuration = %.4f", self.transferDuration],
+
+                       // SDK
+                       [NSString stringWithFormat:@"formEncodeDuration = %.4f", self.formEncodeDuration],
+                       [NSString stringWithFormat:@"JSONParseDuration = %.4f", self.JSONParseDuration],
+                       [NSString stringWithFormat:@"modelDecodeDuration = %.4f", self.modelDecodeDuration],
+                       [NSString stringWithFormat:@"mainThreadDispatchDelay = %.4f", self.mainThreadDispatchDelay],
+                       [NSString stringWithFormat:@"totalDuration = %.4f", self.totalDuration],
+                       ];
+
+    return [NSString stringWithFormat:@"<%@>", [props componentsJoinedByString:@"; "]];
+}
+
+@end
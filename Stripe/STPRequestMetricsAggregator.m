@@ -0,0 +1,140 @@
+//
+//  STPRequestMetricsAggregator.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPRequestMetricsAggregator.h"
+
+static const NSUInteger DefaultWindowSize = 100;
+
+#pragma mark - STPRequestMetricsHistogram
+
+@interface STPRequestMetricsHistogram ()
+
+- (instancetype)initWithDurations:(NSArray<NSNumber *> *)durations;
+
+@end
+
+@implementation STPRequestMetricsHistogram
+
++ (NSArray<NSNumber *> *)defaultBucketUpperBounds {
+    static NSArray<NSNumber *> *bounds;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        bounds = @[@0.01, @0.025, @0.05, @0.1, @0.25, @0.5, @1, @2.5, @5, @10, @(DBL_MAX)];
+    });
+    return bounds;
+}
+
+- (instancetype)initWithDurations:(NSArray<NSNumber *> *)durations {
+    self = [super init];
+    if (self) {
+        NSArray<NSNumber *> *bounds = [[self class] defaultBucketUpperBounds];
+        NSUInteger *counts = calloc(bounds.count, sizeof(NSUInteger));
+        for (NSNumber *duration in durations) {
+            for (NSUInteger idx = 0; idx < bounds.count; idx++) {
+                if (duration.doubleValue <= bounds[idx].doubleValue) {
+                    counts[idx]++;
+                    break;
+                }
+            }
+        }
+        NSMutableArray<NSNumber *> *bucketCounts = [NSMutableArray arrayWithCapacity:bounds.count];
+        for (NSUInteger idx = 0; idx < bounds.count; idx++) {
+            [bucketCounts addObject:@(counts[idx])];
+        }
+        free(counts);
+
+        _bucketUpperBounds = bounds;
+        _bucketCounts = [bucketCounts copy];
+        _sampleCount = durations.count;
+    }
+    return self;
+}
+
+- (NSTimeInterval)approximateDurationAtPercentile:(double)percentile {
+    if (self.sampleCount == 0) {
+        return 0;
+    }
+    NSUInteger rank = (NSUInteger)ceil(MIN(MAX(percentile, 0), 1) * self.sampleCount);
+    NSUInteger cumulative = 0;
+    for (NSUInteger idx = 0; idx < self.bucketCounts.count; idx++) {
+        cumulative += self.bucketCounts[idx].unsignedIntegerValue;
+        if (cumulative >= MAX(rank, (NSUInteger)1)) {
+            return self.bucketUpperBounds[idx].doubleValue;
+        }
+    }
+    return self.bucketUpperBounds.lastObject.doubleValue;
+}
+
+@end
+
+#pragma mark - STPRequestMetricsAggregator
+
+@interface STPRequestMetricsAggregator ()
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<STPRequestMetrics *> *> *metricsByEndpoint;
+
+@end
+
+@implementation STPRequestMetricsAggregator
+
+- (instancetype)init {
+    return [self initWithWindowSize:DefaultWindowSize];
+}
+
+- (instancetype)initWithWindowSize:(NSUInteger)windowSize {
+    self = [super init];
+    if (self) {
+        _windowSize = MAX(windowSize, (NSUInteger)1);
+        _metricsByEndpoint = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSArray<NSString *> *)endpoints {
+    @synchronized (self) {
+        return [self.metricsByEndpoint.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    }
+}
+
+- (NSArray<STPRequestMetrics *> *)recentMetricsForEndpoint:(NSString *)endpoint {
+    @synchronized (self) {
+        return [self.metricsByEndpoint[endpoint] copy] ?: @[];
+    }
+}
+
+- (STPRequestMetricsHistogram *)histogramForEndpoint:(NSString *)endpoint {
+    NSArray<STPRequestMetrics *> *recentMetrics = [self recentMetricsForEndpoint:endpoint];
+    if (recentMetrics.count == 0) {
+        return nil;
+    }
+    return [[STPRequestMetricsHistogram alloc] initWithDurations:[recentMetrics valueForKey:NSStringFromSelector(@selector(totalDuration))]];
+}
+
+- (void)reset {
+    @synchronized (self) {
+        [self.metricsByEndpoint removeAllObjects];
+    }
+}
+
+#pragma mark - STPRequestMetricsObserver
+
+- (void)apiClient:(__unused STPAPIClient *)apiClient didCollectRequestMetrics:(STPRequestMetrics *)metrics {
+    @synchronized (self) {
+        NSMutableArray<STPRequestMetrics *> *window = self.metricsByEndpoint[metrics.endpoint];
+        if (window == nil) {
+            window = [NSMutableArray arrayWithCapacity:self.windowSize];
+            self.metricsByEndpoint[metrics.endpoint] = window;
+        }
+        if (window.count == self.windowSize) {
+            [window removeObjectAtIndex:0];
+        }
+        [window addObject:metrics];
+    }
+}
+
+@end
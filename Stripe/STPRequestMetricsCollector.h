@@ -0,0 +1,73 @@
+//
+//  STPRequestMetricsCollector.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class STPAPIClient, STPRequestMetrics;
+
+/**
+ Gathers the SDK-side and network timings of a single `STPAPIRequest` and
+ delivers the resulting `STPRequestMetrics` to the client's metrics observer
+ once the completion block has run and the session has reported its task
+ metrics, whichever happens last.
+ */
+@interface STPRequestMetricsCollector : NSObject
+
+/**
+ Returns nil when the client has no metrics observer, so that requests pay
+ nothing for metrics nobody is listening to.
+ */
++ (nullable instancetype)collectorWithAPIClient:(STPAPIClient *)apiClient
+                                       endpoint:(NSString *)endpoint
+                                     HTTPMethod:(NSString *)HTTPMethod;
+
+/**
+ A monotonic timestamp, in seconds, for measuring SDK-side durations.
+ */
++ (NSTimeInterval)currentTime;
+
+@property (nonatomic, strong, readonly) STPRequestMetrics *metrics;
+
+- (void)recordFormEncodeDuration:(NSTimeInterval)duration;
+- (void)recordJSONParseDuration:(NSTimeInterval)duration;
+- (void)recordModelDecodeDuration:(NSTimeInterval)duration;
+
+/**
+ Asks the client's session to report task metrics for the task. Must be
+ called before the task is resumed. When a request is retried, call again
+ with each new task; only the latest task's metrics are kept.
+ */
+- (void)observeTask:(NSURLSessionTask *)task;
+
+/**
+ Records that the request is being sent again. Call right before resuming
+ the retry's task.
+ */
+- (void)recordRetry;
+
+/**
+ Records the outcome of the request. Call when the response has been parsed
+ and the completion block is about to be dispatched to the main thread.
+ */
+- (void)recordResponse:(nullable NSHTTPURLResponse *)response error:(nullable NSError *)error;
+
+/**
+ Call on the main thread right before running the completion block.
+ */
+- (void)recordCompletionStarted;
+
+/**
+ Call on the main thread after the completion block has run.
+ */
+- (void)finish;
+
+@end
+
+NS_ASSUME_NONNULL_END
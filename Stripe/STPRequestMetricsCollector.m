@@ -0,0 +1,128 @@
+//
+//  STPRequestMetricsCollector.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPRequestMetricsCollector.h"
+
+#import "STPAPIClient.h"
+#import "STPAPIClient+Private.h"
+#import "STPDispatchFunctions.h"
+#import "STPRequestMetrics+Private.h"
+#import "STPURLSessionDelegate.h"
+
+@interface STPRequestMetricsCollector ()
+
+@property (nonatomic, strong) STPAPIClient *apiClient;
+@property (nonatomic, strong, readwrite) STPRequestMetrics *metrics;
+@property (nonatomic) NSTimeInterval startTime;
+@property (nonatomic) NSTimeInterval responseTime;
+@property (nonatomic) NSUInteger pendingTaskMetricsCount;
+@property (nonatomic) NSUInteger observedTaskCount;
+@property (nonatomic) BOOL finished;
+@property (nonatomic) BOOL delivered;
+
+@end
+
+@implementation STPRequestMetricsCollector
+
++ (instancetype)collectorWithAPIClient:(STPAPIClient *)apiClient
+                              endpoint:(NSString *)endpoint
+                            HTTPMethod:(NSString *)HTTPMethod {
+    if (apiClient.metricsObserver == nil) {
+        return nil;
+    }
+    STPRequestMetricsCollector *collector = [self new];
+    collector.apiClient = apiClient;
+    collector.metrics = [[STPRequestMetrics alloc] initWithEndpoint:endpoint HTTPMethod:HTTPMethod];
+    collector.startTime = [self currentTime];
+    return collector;
+}
+
++ (NSTimeInterval)currentTime {
+    return [NSProcessInfo processInfo].systemUptime;
+}
+
+- (void)recordFormEncodeDuration:(NSTimeInterval)duration {
+    self.metrics.formEncodeDuration += duration;
+}
+
+- (void)recordJSONParseDuration:(NSTimeInterval)duration {
+    self.metrics.JSONParseDuration += duration;
+}
+
+- (void)recordModelDecodeDuration:(NSTimeInterval)duration {
+    self.metrics.modelDecodeDuration += duration;
+}
+
+- (void)observeTask:(NSURLSessionTask *)task {
+    if (@available(iOS 10.0, *)) {
+        id<NSURLSessionDelegate> sessionDelegate = self.apiClient.urlSession.delegate;
+        if (![sessionDelegate isKindOfClass:[STPURLSessionDelegate class]]) {
+            return;
+        }
+        NSUInteger taskIndex;
+        @synchronized (self) {
+            self.pendingTaskMetricsCount++;
+            taskIndex = ++self.observedTaskCount;
+        }
+        [(STPURLSessionDelegate *)sessionDelegate setMetricsHandler:^(NSURLSessionTaskMetrics *taskMetrics) {
+            BOOL shouldDeliver = NO;
+            @synchronized (self) {
+                // A failed attempt may report after its retry has started
+                if (taskIndex == self.observedTaskCount) {
+                    [self.metrics applyTaskMetrics:taskMetrics];
+                }
+                self.pendingTaskMetricsCount--;
+                shouldDeliver = self.finished && self.pendingTaskMetricsCount == 0;
+            }
+            if (shouldDeliver) {
+                stpDispatchToMainThreadIfNecessary(^{
+                    [self deliverIfNeeded];
+                });
+            }
+        } forTask:task];
+    }
+}
+
+- (void)recordRetry {
+    self.metrics.retryCount++;
+    self.metrics.retryDuration = [[self class] currentTime] - self.startTime;
+}
+
+- (void)recordResponse:(NSHTTPURLResponse *)response error:(NSError *)error {
+    self.metrics.statusCode = response.statusCode;
+    self.metrics.error = error;
+    self.responseTime = [[self class] currentTime];
+}
+
+- (void)recordCompletionStarted {
+    NSTimeInterval now = [[self class] currentTime];
+    self.metrics.mainThreadDispatchDelay = now - self.responseTime;
+    self.metrics.totalDuration = now - self.startTime;
+}
+
+- (void)finish {
+    BOOL shouldDeliver = NO;
+    @synchronized (self) {
+        self.finished = YES;
+        shouldDeliver = self.pendingTaskMetricsCount == 0;
+    }
+    if (shouldDeliver) {
+        [self deliverIfNeeded];
+    }
+}
+
+- (void)deliverIfNeeded {
+    if (self.delivered) {
+        return;
+    }
+    self.delivered = YES;
+    [self.apiClient.metricsObserver apiClient:self.apiClient didCollectRequestMetrics:self.metrics];
+    self.apiClient = nil;
+}
+
+@end
@@ -7,11 +7,16 @@
 //
 
 #import "STPSku.h"
+#import "NSDictionary+Stripe.h"
 #import "STPPackage.h"
 #import "STPOrderItem.h"
 #import "STPInventory.h"
 #import "STPProduct.h"
 
+@interface STPSku ()
+@property (nonatomic, copy, readwrite) NSDictionary *allResponseFields;
+@end
+
 @implementation STPSku
 
 - (instancetype)init {
@@ -22,6 +27,16 @@
     return self;
 }
 
+#pragma mark - STPAPIResponseDecodable
+
++ (nullable instancetype)decodedObjectFromAPIResponse:(nullable NSDictionary *)response {
+    NSDictionary *dict = [response stp_dictionaryByRemovingNulls];
+    if (![dict stp_stringForKey:@"id"]) {
+        return nil;
+    }
+    return [[self alloc] initWithAttributeDictionary:dict];
+}
+
 @end
 
 // This method is used internally by Stripe to deserialize API responses and exposed here for convenience and testing purposes only. You should not use it in
@@ -39,6 +54,7 @@
     }];
 
     if (self) {
+        _allResponseFields = [attributeDictionary stp_dictionaryByRemovingNulls];
         _skuId = dict[@"id"];
         _active = [dict[@"active"] boolValue];
         _currency = dict[@"currency"];
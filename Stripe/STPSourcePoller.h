@@ -8,23 +8,24 @@
 
 #import <Foundation/Foundation.h>
 #import "STPBlocks.h"
+#import "STPPoller.h"
 
 @class STPAPIClient;
 
 NS_ASSUME_NONNULL_BEGIN
 
 NS_EXTENSION_UNAVAILABLE("Source polling is not available in extensions")
-@interface STPSourcePoller : NSObject
+@interface STPSourcePoller : STPPoller
 
-- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithAPIClient:(STPAPIClient *)apiClient
+                          timeout:(NSTimeInterval)timeout
+                       completion:(STPPollerCompletionBlock)completion NS_UNAVAILABLE;
 
 - (instancetype)initWithAPIClient:(STPAPIClient *)apiClient
                      clientSecret:(NSString *)clientSecret
                          sourceID:(NSString *)sourceID
                           timeout:(NSTimeInterval)timeout
-                       completion:(STPSourceCompletionBlock)completion;
-
-- (void)stopPolling;
+                       completion:(STPSourceCompletionBlock)completion NS_DESIGNATED_INITIALIZER;
 
 @end
 
@@ -13,9 +13,14 @@
 #import "STPTelemetryClient.h"
 #import "STPAPIClient.h"
 #import "STPAPIClient+Private.h"
+#import "STPClock.h"
 
 @interface STPTelemetryClient ()
-@property (nonatomic) NSDate *appOpenTime;
+/**
+ When the app last became active, in `-[STPClock monotonicTime]`. 0 if it
+ hasn't yet.
+ */
+@property (nonatomic) NSTimeInterval appOpenTime;
 @property (nonatomic, readwrite) NSURLSession *urlSession;
 @end
 
@@ -63,7 +68,7 @@
 }
 
 - (void)applicationDidBecomeActive {
-    self.appOpenTime = [NSDate date];
+    self.appOpenTime = [[STPClock sharedClock] monotonicTime];
 }
 
 - (NSString *)muid {
@@ -75,7 +80,7 @@
     if (!self.appOpenTime) {
         return @(0);
     }
-    NSTimeInterval seconds = [[NSDate date] timeIntervalSinceDate:self.appOpenTime];
+    NSTimeInterval seconds = [[STPClock sharedClock] monotonicTime] - self.appOpenTime;
     NSInteger millis = (NSInteger)round(seconds*1000);
     return @(MAX(millis, 0));
 }
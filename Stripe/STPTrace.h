@@ -0,0 +1,29 @@
+//
+//  STPTrace.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+extern NSString *const STPTraceCategoryAPI;
+extern NSString *const STPTraceCategoryCustomer;
+extern NSString *const STPTraceCategoryImage;
+extern NSString *const STPTraceCategoryPolling;
+
+/**
+ Starts a span. Returns 0 without reading the clock if there's no tracer.
+ */
+NSTimeInterval stpTraceBegin(void);
+
+/**
+ Ends a span started by `stpTraceBegin` and reports it to the tracer. Does
+ nothing if `startTime` is 0, i.e. if tracing was off when the span started.
+ */
+void stpTraceEnd(NSTimeInterval startTime, NSString *name, NSString *category);
+
+NS_ASSUME_NONNULL_END
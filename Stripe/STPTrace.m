@@ -0,0 +1,55 @@
+//
+//  STPTrace.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPTrace.h"
+
+#import <stdatomic.h>
+
+#import "STPTracer.h"
+
+NSString *const STPTraceCategoryAPI = @"api";
+NSString *const STPTraceCategoryCustomer = @"customer";
+NSString *const STPTraceCategoryImage = @"image";
+NSString *const STPTraceCategoryPolling = @"polling";
+
+// Checked before anything else, so that spans cost one load while tracing is off
+static atomic_bool STPTracingEnabled;
+static id<STPTracer> STPCurrentTracer;
+
+NSTimeInterval stpTraceBegin(void) {
+    if (!atomic_load_explicit(&STPTracingEnabled, memory_order_relaxed)) {
+        return 0;
+    }
+    return [NSProcessInfo processInfo].systemUptime;
+}
+
+void stpTraceEnd(NSTimeInterval startTime, NSString *name, NSString *category) {
+    if (startTime == 0 || !atomic_load_explicit(&STPTracingEnabled, memory_order_relaxed)) {
+        return;
+    }
+    NSTimeInterval endTime = [NSProcessInfo processInfo].systemUptime;
+    id<STPTracer> tracer = [Stripe tracer];
+    [tracer recordSpanWithName:name category:category startTime:startTime endTime:endTime];
+}
+
+@implementation Stripe (Tracing)
+
++ (id<STPTracer>)tracer {
+    @synchronized ([Stripe class]) {
+        return STPCurrentTracer;
+    }
+}
+
++ (void)setTracer:(id<STPTracer>)tracer {
+    @synchronized ([Stripe class]) {
+        STPCurrentTracer = tracer;
+        atomic_store(&STPTracingEnabled, tracer != nil);
+    }
+}
+
+@end
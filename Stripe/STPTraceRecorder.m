@@ -0,0 +1,122 @@
+//
+//  STPTraceRecorder.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPTracer.h"
+
+#import <pthread.h>
+
+static const NSUInteger DefaultMaxSpanCount = 100000;
+static const double MicrosecondsPerSecond = 1000000;
+
+@interface STPTraceRecorder ()
+
+@property (nonatomic) NSUInteger maxSpanCount;
+@property (nonatomic) NSMutableArray<NSDictionary *> *spanEvents;
+/**
+ A `thread_name` metadata event for each thread that has ended a span, so
+ that trace viewers label the tracks.
+ */
+@property (nonatomic) NSMutableDictionary<NSNumber *, NSDictionary *> *threadNameEvents;
+
+@end
+
+@implementation STPTraceRecorder
+
+- (instancetype)init {
+    return [self initWithMaxSpanCount:DefaultMaxSpanCount];
+}
+
+- (instancetype)initWithMaxSpanCount:(NSUInteger)maxSpanCount {
+    self = [super init];
+    if (self) {
+        _maxSpanCount = maxSpanCount;
+        _spanEvents = [NSMutableArray array];
+        _threadNameEvents = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSUInteger)spanCount {
+    @synchronized (self) {
+        return self.spanEvents.count;
+    }
+}
+
+- (void)recordSpanWithName:(NSString *)name
+                  category:(NSString *)category
+                 startTime:(NSTimeInterval)startTime
+                   endTime:(NSTimeInterval)endTime {
+    NSNumber *processID = @([NSProcessInfo processInfo].processIdentifier);
+    NSNumber *threadID = @(pthread_mach_thread_np(pthread_self()));
+    NSDictionary *event = @{
+                            @"name": name,
+                            @"cat": category,
+                            @"ph": @"X",
+                            @"ts": @((int64_t)(startTime * MicrosecondsPerSecond)),
+                            @"dur": @((int64_t)(MAX(endTime - startTime, 0) * MicrosecondsPerSecond)),
+                            @"pid": processID,
+                            @"tid": threadID,
+                            };
+
+    @synchronized (self) {
+        if (self.spanEvents.count >= self.maxSpanCount) {
+            return;
+        }
+        [self.spanEvents addObject:event];
+        if (!self.threadNameEvents[threadID]) {
+            self.threadNameEvents[threadID] = @{
+                                                @"name": @"thread_name",
+                                                @"ph": @"M",
+                                                @"pid": processID,
+                                                @"tid": threadID,
+                                                @"args": @{@"name": [self currentThreadName]},
+                                                };
+        }
+    }
+}
+
+- (NSString *)currentThreadName {
+    if ([NSThread isMainThread]) {
+        return @"main";
+    }
+    NSString *threadName = [NSThread currentThread].name;
+    if (threadName.length > 0) {
+        return threadName;
+    }
+    const char *queueLabel = dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL);
+    if (queueLabel && queueLabel[0] != '\0') {
+        return @(queueLabel);
+    }
+    return [NSString stringWithFormat:@"thread %u", pthread_mach_thread_np(pthread_self())];
+}
+
+- (NSData *)traceData {
+    NSMutableArray<NSDictionary *> *events = [NSMutableArray array];
+    @synchronized (self) {
+        [events addObjectsFromArray:self.threadNameEvents.allValues];
+        [events addObjectsFromArray:self.spanEvents];
+    }
+    NSDictionary *trace = @{
+                            @"traceEvents": events,
+                            @"displayTimeUnit": @"ms",
+                            };
+    return [NSJSONSerialization dataWithJSONObject:trace options:(NSJSONWritingOptions)0 error:nil];
+}
+
+- (BOOL)writeTraceToURL:(NSURL *)url error:(NSError **)error {
+    return [[self traceData] writeToURL:url options:NSDataWritingAtomic error:error];
+}
+
+- (void)reset {
+    @synchronized (self) {
+        [self.spanEvents removeAllObjects];
+        [self.threadNameEvents removeAllObjects];
+    }
+}
+
+@end
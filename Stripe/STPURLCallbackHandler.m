@@ -37,7 +37,20 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 @interface STPURLCallbackHandler ()
-@property (nonatomic) NSArray <STPURLCallback *> *callbacks;
+
+/**
+ Callbacks bucketed by `dispatchKeyForURLComponents:`. Buckets are immutable
+ and replaced on every change, so dispatch can iterate one without holding
+ the lock while listeners run (and possibly unregister themselves).
+ */
+@property (nonatomic) NSMutableDictionary<NSString *, NSArray<STPURLCallback *> *> *callbacksByKey;
+
+/**
+ The keys each listener is registered under, so unregistering only touches
+ that listener's buckets. Weak keys, so deallocated listeners drop out.
+ */
+@property (nonatomic) NSMapTable<id<STPURLCallbackListener>, NSMutableSet<NSString *> *> *keysByListener;
+
 @end
 
 @implementation STPURLCallbackHandler
@@ -55,21 +68,59 @@ NS_ASSUME_NONNULL_BEGIN
 - (instancetype)init {
     self = [super init];
     if (self) {
-        _callbacks = [NSArray new];
+        _callbacksByKey = [NSMutableDictionary new];
+        _keysByListener = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)
+                                                valueOptions:NSPointerFunctionsStrongMemory];
     }
     return self;
 }
 
+/**
+ Callbacks can only match URLs with the same scheme, host and path (see
+ `stp_matchesURLComponents:`), so those make up the key. Returns nil for
+ components that can never match.
+ */
++ (nullable NSString *)dispatchKeyForURLComponents:(nullable NSURLComponents *)components {
+    if (!components.scheme || !components.host || !components.path) {
+        return nil;
+    }
+    // A collision only puts two URLs in the same bucket; matching still
+    // compares each component
+    return [NSString stringWithFormat:@"%@://%@%@", components.scheme, components.host, components.path];
+}
+
 - (BOOL)handleURLCallback:(NSURL *)url {
 
     NSURLComponents *components = [[NSURLComponents alloc] initWithURL:url
                                                resolvingAgainstBaseURL:NO];
+    NSString *key = [[self class] dispatchKeyForURLComponents:components];
+    if (!key) {
+        return NO;
+    }
+
+    NSArray<STPURLCallback *> *callbacks;
+    @synchronized (self) {
+        callbacks = self.callbacksByKey[key];
+    }
 
     BOOL resultsOrred = NO;
+    BOOL hasReleasedListeners = NO;
 
-    for (STPURLCallback *callback in self.callbacks) {
-        if ([callback.urlComponents stp_matchesURLComponents:components]) {
-            resultsOrred |= [callback.listener handleURLCallback:url];
+    for (STPURLCallback *callback in callbacks) {
+        id<STPURLCallbackListener> listener = callback.listener;
+        if (!listener) {
+            hasReleasedListeners = YES;
+        }
+        else if ([callback.urlComponents stp_matchesURLComponents:components]) {
+            resultsOrred |= [listener handleURLCallback:url];
+        }
+    }
+
+    if (hasReleasedListeners) {
+        @synchronized (self) {
+            [self removeCallbacksForKey:key passingTest:^BOOL(STPURLCallback *callback) {
+                return callback.listener == nil;
+            }];
         }
     }
 
@@ -83,25 +134,61 @@ NS_ASSUME_NONNULL_BEGIN
     callback.listener = listener;
     callback.urlComponents = [[NSURLComponents alloc] initWithURL:url
                                           resolvingAgainstBaseURL:NO];
-
-    if (callback.listener && callback.urlComponents) {
-        NSMutableArray <STPURLCallback *> *callbacksCopy = self.callbacks.mutableCopy;
-        [callbacksCopy addObject:callback];
-        self.callbacks = callbacksCopy.copy;
+    NSString *key = [[self class] dispatchKeyForURLComponents:callback.urlComponents];
+
+    if (callback.listener && key) {
+        @synchronized (self) {
+            // Drop anything left behind by listeners that were deallocated
+            // without unregistering, so buckets don't grow without bound
+            [self removeCallbacksForKey:key passingTest:^BOOL(STPURLCallback *existingCallback) {
+                return existingCallback.listener == nil;
+            }];
+            NSArray<STPURLCallback *> *callbacks = self.callbacksByKey[key] ?: @[];
+            self.callbacksByKey[key] = [callbacks arrayByAddingObject:callback];
+
+            NSMutableSet<NSString *> *keys = [self.keysByListener objectForKey:listener];
+            if (!keys) {
+                keys = [NSMutableSet new];
+                [self.keysByListener setObject:keys forKey:listener];
+            }
+            [keys addObject:key];
+        }
     }
 }
 
 - (void)unregisterListener:(id<STPURLCallbackListener>)listener {
-    NSMutableArray *callbacksToRemove = [NSMutableArray new];
-
-    for (STPURLCallback *callback in self.callbacks) {
-        if (listener == callback.listener) {
-            [callbacksToRemove addObject:callback];
+    @synchronized (self) {
+        NSSet<NSString *> *keys = [[self.keysByListener objectForKey:listener] copy];
+        [self.keysByListener removeObjectForKey:listener];
+
+        for (NSString *key in keys) {
+            [self removeCallbacksForKey:key passingTest:^BOOL(STPURLCallback *callback) {
+                id<STPURLCallbackListener> callbackListener = callback.listener;
+                return callbackListener == nil || callbackListener == listener;
+            }];
         }
     }
-    NSMutableArray <STPURLCallback *> *callbacksCopy = self.callbacks.mutableCopy;
-    [callbacksCopy removeObjectsInArray:callbacksToRemove];
-    self.callbacks = callbacksCopy.copy;
+}
+
+/**
+ Must be called while synchronized on self.
+ */
+- (void)removeCallbacksForKey:(NSString *)key passingTest:(BOOL (^)(STPURLCallback *callback))test {
+    NSArray<STPURLCallback *> *callbacks = self.callbacksByKey[key];
+    NSIndexSet *indexesToRemove = [callbacks indexesOfObjectsPassingTest:^BOOL(STPURLCallback *callback, __unused NSUInteger idx, __unused BOOL *stop) {
+        return test(callback);
+    }];
+    if (indexesToRemove.count == 0) {
+        return;
+    }
+    if (indexesToRemove.count == callbacks.count) {
+        [self.callbacksByKey removeObjectForKey:key];
+    }
+    else {
+        NSMutableArray<STPURLCallback *> *callbacksCopy = callbacks.mutableCopy;
+        [callbacksCopy removeObjectsAtIndexes:indexesToRemove];
+        self.callbacksByKey[key] = callbacksCopy.copy;
+    }
 }
 
 @end
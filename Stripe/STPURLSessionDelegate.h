@@ -0,0 +1,31 @@
+//
+//  STPURLSessionDelegate.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef void (^STPURLSessionTaskMetricsHandler)(NSURLSessionTaskMetrics *taskMetrics) API_AVAILABLE(ios(10.0));
+
+/**
+ The delegate of `STPAPIClient`'s URL session. Tasks are still created with
+ completion handlers; this only routes task-level events that are not
+ delivered to completion handlers back to whoever created the task.
+ */
+@interface STPURLSessionDelegate : NSObject <NSURLSessionTaskDelegate>
+
+/**
+ Registers a block to be called, on the session's delegate queue, when the
+ session has finished collecting metrics for the task. Must be called before
+ the task is resumed. The handler is released after it has been called.
+ */
+- (void)setMetricsHandler:(STPURLSessionTaskMetricsHandler)handler forTask:(NSURLSessionTask *)task API_AVAILABLE(ios(10.0));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,46 @@
+//
+//  STPURLSessionDelegate.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPURLSessionDelegate.h"
+
+@interface STPURLSessionDelegate ()
+
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, id> *metricsHandlers;
+
+@end
+
+@implementation STPURLSessionDelegate
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _metricsHandlers = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)setMetricsHandler:(STPURLSessionTaskMetricsHandler)handler forTask:(NSURLSessionTask *)task {
+    @synchronized (self.metricsHandlers) {
+        self.metricsHandlers[@(task.taskIdentifier)] = [handler copy];
+    }
+}
+
+#pragma mark - NSURLSessionTaskDelegate
+
+- (void)URLSession:(__unused NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics API_AVAILABLE(ios(10.0)) {
+    STPURLSessionTaskMetricsHandler handler = nil;
+    @synchronized (self.metricsHandlers) {
+        handler = self.metricsHandlers[@(task.taskIdentifier)];
+        [self.metricsHandlers removeObjectForKey:@(task.taskIdentifier)];
+    }
+    if (handler) {
+        handler(metrics);
+    }
+}
+
+@end
@@ -0,0 +1,67 @@
+//
+//  STPUploadPreprocessingQueue.h
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+@class STPAPIOperation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef id _Nullable (^STPUploadPreprocessingBlock)(void);
+typedef void (^STPUploadPreprocessingCompletionBlock)(id _Nullable result, NSError * _Nullable error);
+
+/**
+ Runs the expensive part of preparing an upload, e.g. encoding a photo as JPEG,
+ off the main thread.
+
+ At most `maxConcurrentJobCount` jobs run at once, and only while the memory
+ they're estimated to need fits in `byteBudget`; other jobs wait, in the order
+ they were added. A job that needs more than the whole budget runs on its own.
+ */
+@interface STPUploadPreprocessingQueue : NSObject
+
+/**
+ The queue used by `STPAPIClient` for image uploads.
+ */
++ (instancetype)sharedQueue;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithMaxConcurrentJobCount:(NSUInteger)maxConcurrentJobCount
+                                   byteBudget:(NSUInteger)byteBudget NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) NSUInteger maxConcurrentJobCount;
+@property (nonatomic, readonly) NSUInteger byteBudget;
+
+/**
+ The estimated cost of the jobs that are running.
+ */
+@property (nonatomic, readonly) NSUInteger bytesInUse;
+
+/**
+ Roughly how much memory encoding `image` takes: its decoded bitmap, plus a
+ resized copy in case it has to be scaled down to fit a maximum file size.
+ */
++ (NSUInteger)estimatedCostOfEncodingImage:(UIImage *)image;
+
+/**
+ Adds a job.
+
+ @param cost        The memory the job is estimated to need, in bytes.
+ @param block       The work, run on a background queue.
+ @param completion  Called on the main queue with the block's result, or with an `NSURLErrorCancelled` error if the job is cancelled.
+ @return A handle to cancel the job with. A job that is already running can't
+ be interrupted, but its result is dropped.
+ */
+- (STPAPIOperation *)addJobWithCost:(NSUInteger)cost
+                              block:(STPUploadPreprocessingBlock)block
+                         completion:(STPUploadPreprocessingCompletionBlock)completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,160 @@
+//
+//  STPUploadPreprocessingQueue.m
+//  Stripe
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPUploadPreprocessingQueue.h"
+
+#import "STPAPIOperation+Private.h"
+
+static const NSUInteger SharedMaxConcurrentJobCount = 2;
+// Two 12 megapixel photos, e.g. the front and back of an ID document
+static const NSUInteger SharedByteBudget = 200 * 1024 * 1024;
+
+@interface STPUploadPreprocessingJob : NSObject
+
+@property (nonatomic) NSUInteger cost;
+@property (nonatomic, copy, nullable) STPUploadPreprocessingBlock block;
+@property (nonatomic, copy, nullable) STPUploadPreprocessingCompletionBlock completion;
+@property (nonatomic, strong) STPAPIOperation *operation;
+
+@end
+
+@implementation STPUploadPreprocessingJob
+@end
+
+@interface STPUploadPreprocessingQueue ()
+
+@property (nonatomic, readwrite) NSUInteger maxConcurrentJobCount;
+@property (nonatomic, readwrite) NSUInteger byteBudget;
+@property (nonatomic, readwrite) NSUInteger bytesInUse;
+
+@property (nonatomic, strong) dispatch_queue_t workQueue;
+@property (nonatomic, strong) NSMutableArray<STPUploadPreprocessingJob *> *pendingJobs;
+@property (nonatomic) NSUInteger runningJobCount;
+
+@end
+
+@implementation STPUploadPreprocessingQueue
+
++ (instancetype)sharedQueue {
+    static STPUploadPreprocessingQueue *sharedQueue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedQueue = [[self alloc] initWithMaxConcurrentJobCount:SharedMaxConcurrentJobCount
+                                                       byteBudget:SharedByteBudget];
+    });
+    return sharedQueue;
+}
+
+- (instancetype)initWithMaxConcurrentJobCount:(NSUInteger)maxConcurrentJobCount
+                                   byteBudget:(NSUInteger)byteBudget {
+    self = [super init];
+    if (self) {
+        _maxConcurrentJobCount = MAX(maxConcurrentJobCount, (NSUInteger)1);
+        _byteBudget = byteBudget;
+        _workQueue = dispatch_queue_create("com.stripe.uploadpreprocessing", DISPATCH_QUEUE_CONCURRENT);
+        dispatch_set_target_queue(_workQueue, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0));
+        _pendingJobs = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (NSUInteger)bytesInUse {
+    @synchronized (self) {
+        return _bytesInUse;
+    }
+}
+
++ (NSUInteger)estimatedCostOfEncodingImage:(UIImage *)image {
+    CGFloat pixelCount = (image.size.width * image.scale) * (image.size.height * image.scale);
+    return (NSUInteger)(pixelCount * 4) * 2;
+}
+
+#pragma mark - Jobs
+
+- (STPAPIOperation *)addJobWithCost:(NSUInteger)cost
+                              block:(STPUploadPreprocessingBlock)block
+                         completion:(STPUploadPreprocessingCompletionBlock)completion {
+    STPUploadPreprocessingJob *job = [STPUploadPreprocessingJob new];
+    job.cost = cost;
+    job.block = block;
+    job.completion = completion;
+    job.operation = [[STPAPIOperation alloc] initGroupWithPriority:STPAPIOperationPriorityDefault];
+
+    __weak STPUploadPreprocessingJob *weakJob = job;
+    job.operation.cancellationHandler = ^{
+        STPUploadPreprocessingJob *strongJob = weakJob;
+        if (!strongJob) {
+            return;
+        }
+        BOOL wasPending;
+        @synchronized (self) {
+            wasPending = [self.pendingJobs containsObject:strongJob];
+            [self.pendingJobs removeObjectIdenticalTo:strongJob];
+        }
+        // A running job reports its cancellation when its block returns
+        if (wasPending) {
+            [self finishJob:strongJob withResult:nil];
+        }
+    };
+
+    @synchronized (self) {
+        [self.pendingJobs addObject:job];
+    }
+    [self startJobsIfPossible];
+    return job.operation;
+}
+
+- (void)startJobsIfPossible {
+    NSMutableArray<STPUploadPreprocessingJob *> *jobsToStart = [NSMutableArray array];
+    @synchronized (self) {
+        // Strictly in order, so a large job isn't starved by smaller ones
+        while (self.pendingJobs.count > 0 && self.runningJobCount < self.maxConcurrentJobCount) {
+            STPUploadPreprocessingJob *job = self.pendingJobs.firstObject;
+            BOOL fitsInBudget = _bytesInUse + job.cost <= self.byteBudget;
+            if (!fitsInBudget && self.runningJobCount > 0) {
+                break;
+            }
+            [self.pendingJobs removeObjectAtIndex:0];
+            self.runningJobCount++;
+            _bytesInUse += job.cost;
+            [jobsToStart addObject:job];
+        }
+    }
+
+    for (STPUploadPreprocessingJob *job in jobsToStart) {
+        dispatch_async(self.workQueue, ^{
+            id result = job.operation.isCancelled ? nil : job.block();
+            @synchronized (self) {
+                self.runningJobCount--;
+                self->_bytesInUse -= job.cost;
+            }
+            [self finishJob:job withResult:result];
+            [self startJobsIfPossible];
+        });
+    }
+}
+
+- (void)finishJob:(STPUploadPreprocessingJob *)job withResult:(id)result {
+    dispatch_async(dispatch_get_main_queue(), ^{
+        STPUploadPreprocessingCompletionBlock completion = job.completion;
+        job.completion = nil;
+        job.block = nil;
+        if (!completion) {
+            return;
+        }
+        [job.operation markFinished];
+        if (job.operation.isCancelled) {
+            completion(nil, [STPAPIOperation cancelledError]);
+        }
+        else {
+            completion(result, nil);
+        }
+    });
+}
+
+@end
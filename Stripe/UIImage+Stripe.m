@@ -8,9 +8,12 @@
 
 #import "UIImage+Stripe.h"
 
+#import "STPTrace.h"
+
 @implementation UIImage (Stripe)
 
 - (NSData *)stp_jpegDataWithMaxFileSize:(NSUInteger)maxBytes {
+    NSTimeInterval traceStartTime = stpTraceBegin();
     CGFloat scale = 1.0;
     NSData *imageData = UIImageJPEGRepresentation(self, 0.5);
 
@@ -39,6 +42,7 @@
         } while (imageData.length > maxBytes);
 
     }
+    stpTraceEnd(traceStartTime, @"image_compress", STPTraceCategoryImage);
     return imageData;
 }
 
@@ -96,7 +96,7 @@
 }
 
 - (void)test_arrayByRemovingNulls_returnsImmutableCopy {
-    NSArray *array = @[@"id", @"type"];
+    NSMutableArray *array = [@[@"id", @"type"] mutableCopy];
     NSArray *result = [array stp_arrayByRemovingNulls];
 
     XCTAssert(result);
@@ -104,4 +104,15 @@
     XCTAssertFalse([result isKindOfClass:[NSMutableArray class]]);
 }
 
+- (void)test_arrayByRemovingNulls_sharesUnchangedArrays {
+    NSArray *array = @[@"id", @"type"];
+    XCTAssertEqual([array stp_arrayByRemovingNulls], array);
+
+    NSDictionary *dictionary = @{@"id": @"card_123"};
+    NSArray *result = [@[@"id", [NSNull null], dictionary] stp_arrayByRemovingNulls];
+    NSArray *expected = @[@"id", dictionary];
+    XCTAssertEqualObjects(result, expected);
+    XCTAssertEqual(result.lastObject, dictionary);
+}
+
 @end
@@ -83,7 +83,7 @@
 }
 
 - (void)test_dictionaryByRemovingNullsValidatingRequiredFields_returnsImmutableCopy {
-    NSDictionary *dictionary = @{@"id": @"card_123"};
+    NSMutableDictionary *dictionary = [@{@"id": @"card_123"} mutableCopy];
     NSDictionary *result = [dictionary stp_dictionaryByRemovingNulls];
 
     XCTAssert(result);
@@ -91,6 +91,35 @@
     XCTAssertFalse([result isKindOfClass:[NSMutableDictionary class]]);
 }
 
+- (void)test_dictionaryByRemovingNulls_sharesUnchangedDictionaries {
+    NSDictionary *card = @{@"id": @"card_123", @"metadata": @{@"key": @"value"}};
+    NSDictionary *dictionary = @{@"id": @"cus_123", @"default_source": [NSNull null], @"sources": @{@"data": @[card]}};
+    NSDictionary *result = [dictionary stp_dictionaryByRemovingNulls];
+
+    XCTAssertNotEqual(result, dictionary);
+    XCTAssertNil(result[@"default_source"]);
+    XCTAssertEqual(result[@"sources"], dictionary[@"sources"]);
+    XCTAssertEqual([result[@"sources"][@"data"] firstObject], card);
+    XCTAssertEqual([card stp_dictionaryByRemovingNulls], card);
+}
+
+- (void)test_dictionaryByRemovingNulls_internsKnownFields {
+    // Long enough that they aren't tagged pointers, which would be equal anyway
+    NSString *status = @"requires_source_action_for_testing";
+    NSString *identifier = @"src_1234567890abcdefghijklmnop";
+    NSDictionary *first = @{@"id": [identifier mutableCopy], @"status": [status mutableCopy], @"owner": @{@"email": [NSNull null]}};
+    NSDictionary *second = @{@"id": [identifier mutableCopy], @"status": [status mutableCopy], @"owner": @{@"email": [NSNull null]}};
+
+    NSDictionary *firstResult = [first stp_dictionaryByRemovingNulls];
+    NSDictionary *secondResult = [second stp_dictionaryByRemovingNulls];
+    XCTAssertEqualObjects(firstResult[@"status"], status);
+    XCTAssertEqual(firstResult[@"status"], secondResult[@"status"]);
+    // Other fields are left alone
+    XCTAssertEqual(firstResult[@"id"], first[@"id"]);
+    // Once interned, there's nothing left to change
+    XCTAssertEqual([firstResult stp_dictionaryByRemovingNulls], firstResult);
+}
+
 #pragma mark - dictionaryByRemovingNonStrings
 
 - (void)test_dictionaryByRemovingNonStrings_basicCases {
@@ -240,6 +269,18 @@
     XCTAssertNil([dict stp_stringForKey:@"b"]);
 }
 
+- (void)testStringForKey_internsKnownFields {
+    NSString *currency = @"currency_long_enough_for_the_heap";
+    NSDictionary *first = @{@"currency": [currency mutableCopy], @"name": [currency mutableCopy]};
+    NSDictionary *second = @{@"currency": [currency mutableCopy], @"name": [currency mutableCopy]};
+
+    NSString *firstCurrency = [first stp_stringForKey:@"currency"];
+    XCTAssertEqualObjects(firstCurrency, currency);
+    XCTAssertFalse([firstCurrency isKindOfClass:[NSMutableString class]]);
+    XCTAssertEqual(firstCurrency, [second stp_stringForKey:@"currency"]);
+    XCTAssertNotEqual([first stp_stringForKey:@"name"], [second stp_stringForKey:@"name"]);
+}
+
 - (void)testURLForKey {
     NSDictionary *dict = @{
                            @"a": @"https://example.com",
@@ -0,0 +1,81 @@
+//
+//  STPAPIClientLoadTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "STPNetworkReplayLoadHarness.h"
+
+@interface STPAPIClientLoadTest : XCTestCase
+@end
+
+@implementation STPAPIClientLoadTest
+
+- (STPNetworkReplayLoadReport *)runWithConfiguration:(STPNetworkReplayLoadConfiguration *)configuration {
+    STPNetworkReplayLoadHarness *harness = [[STPNetworkReplayLoadHarness alloc] initWithConfiguration:configuration];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"load run"];
+    __block STPNetworkReplayLoadReport *report;
+    [harness runWithCompletion:^(STPNetworkReplayLoadReport *runReport) {
+        report = runReport;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:60 handler:nil];
+
+    // Every run has to produce a complete report, whatever the error rates
+    XCTAssertEqual(report.operationCount, configuration.operationCount);
+    XCTAssertLessThanOrEqual(report.failureCount, report.operationCount);
+    XCTAssertGreaterThan(report.duration, 0);
+    XCTAssertGreaterThanOrEqual(report.p50Latency, 0);
+    XCTAssertGreaterThanOrEqual(report.p99Latency, report.p50Latency);
+    XCTAssertGreaterThanOrEqual(report.mainThreadBlockedTime, 0);
+    return report;
+}
+
+- (void)testBurstOfMixedOperations {
+    STPNetworkReplayLoadConfiguration *configuration = [STPNetworkReplayLoadConfiguration new];
+    configuration.operationCount = 200;
+    configuration.maxConcurrentOperations = 50;
+    configuration.latency = 0.02;
+    configuration.jitter = 0.03;
+
+    STPNetworkReplayLoadReport *report = [self runWithConfiguration:configuration];
+    XCTAssertEqual(report.operationCount, 200U);
+    XCTAssertEqual(report.failureCount, 0U);
+    XCTAssertGreaterThan(report.throughput, 0);
+    XCTAssertGreaterThanOrEqual(report.p50Latency, 0.02);
+    XCTAssertGreaterThanOrEqual(report.p99Latency, report.p50Latency);
+    XCTAssertGreaterThan(report.peakMemoryFootprint, 0U);
+}
+
+- (void)testErrorInjection {
+    STPNetworkReplayLoadConfiguration *configuration = [STPNetworkReplayLoadConfiguration new];
+    configuration.operationCount = 40;
+    configuration.latency = 0;
+    configuration.connectionErrorRate = 0.5;
+    configuration.serverErrorRate = 0.5;
+    configuration.maxRetryCount = 0;
+
+    STPNetworkReplayLoadReport *report = [self runWithConfiguration:configuration];
+    XCTAssertEqual(report.operationCount, 40U);
+    XCTAssertEqual(report.failureCount, 40U);
+}
+
+- (void)testRetriesAbsorbTransientErrors {
+    STPNetworkReplayLoadConfiguration *configuration = [STPNetworkReplayLoadConfiguration new];
+    configuration.operationCount = 40;
+    configuration.latency = 0;
+    configuration.connectionErrorRate = 0.1;
+    configuration.serverErrorRate = 0.1;
+    configuration.maxRetryCount = 2;
+
+    // Each operation fails only if all three attempts fail (0.8% chance)
+    STPNetworkReplayLoadReport *report = [self runWithConfiguration:configuration];
+    XCTAssertEqual(report.operationCount, 40U);
+    XCTAssertLessThan(report.failureCount, 4U);
+}
+
+@end
@@ -14,6 +14,7 @@
 @interface STPAPIClient (Testing)
 
 @property (nonatomic, readwrite) NSURLSession *urlSession;
+@property (nonatomic, readonly) NSCache<NSString *, NSURL *> *endpointURLCache;
 
 @end
 
@@ -67,4 +68,58 @@
     XCTAssertEqualObjects(accountHeader, @"acct_123");
 }
 
+- (void)testDefaultHeadersAreReused {
+    STPAPIClient *sut = [[STPAPIClient alloc] initWithPublishableKey:@"pk_foo"];
+    NSURL *url = [NSURL URLWithString:@"https://www.stripe.com"];
+    NSDictionary *headers = [sut configuredRequestForURL:url].allHTTPHeaderFields;
+    XCTAssertNotNil(headers[@"X-Stripe-User-Agent"]);
+    XCTAssertEqualObjects(headers[@"Stripe-Version"], [STPAPIClient apiVersion]);
+    XCTAssertEqualObjects([sut configuredRequestForURL:url].allHTTPHeaderFields, headers);
+
+    sut.stripeAccount = @"acct_123";
+    sut.stripeAccount = nil;
+    XCTAssertEqualObjects([sut configuredRequestForURL:url].allHTTPHeaderFields, headers);
+}
+
+- (void)testURLForEndpoint {
+    STPAPIClient *sut = [[STPAPIClient alloc] initWithPublishableKey:@"pk_foo"];
+    XCTAssertEqualObjects([sut URLForEndpoint:@"tokens"], [NSURL URLWithString:@"https://api.stripe.com/v1/tokens"]);
+    XCTAssertEqualObjects([sut URLForEndpoint:@"customers/cus_123/sources"], [NSURL URLWithString:@"https://api.stripe.com/v1/customers/cus_123/sources"]);
+
+    sut.apiURL = [NSURL URLWithString:@"https://example.com/v1"];
+    XCTAssertEqualObjects([sut URLForEndpoint:@"tokens"], [NSURL URLWithString:@"https://example.com/v1/tokens"]);
+    XCTAssertEqualObjects([sut URLForEndpoint:@"customers/cus_123"], [NSURL URLWithString:@"https://example.com/v1/customers/cus_123"]);
+}
+
+- (void)testURLForEndpointOnlyCachesResources {
+    STPAPIClient *sut = [[STPAPIClient alloc] initWithPublishableKey:@"pk_foo"];
+    [sut URLForEndpoint:@"customers/cus_123/sources/src_123"];
+    XCTAssertNil([sut.endpointURLCache objectForKey:@"customers/cus_123/sources/src_123"]);
+    XCTAssertEqualObjects([sut.endpointURLCache objectForKey:@"customers"], [NSURL URLWithString:@"https://api.stripe.com/v1/customers"]);
+}
+
+#pragma mark - Performance
+
+- (void)testRequestConstructionPerformance {
+    STPAPIClient *sut = [[STPAPIClient alloc] initWithPublishableKey:@"pk_foo"];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 1000; i++) {
+            [sut configuredRequestForURL:[sut URLForEndpoint:@"tokens"]];
+        }
+    }];
+}
+
+- (void)testRequestConstructionPerformanceAfterKeyChange {
+    // The cost of building the headers and URL again for every request
+    STPAPIClient *sut = [[STPAPIClient alloc] initWithPublishableKey:@"pk_foo"];
+    NSURL *apiURL = sut.apiURL;
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 1000; i++) {
+            sut.publishableKey = @"pk_foo";
+            sut.apiURL = apiURL;
+            [sut configuredRequestForURL:[sut URLForEndpoint:@"tokens"]];
+        }
+    }];
+}
+
 @end
@@ -0,0 +1,181 @@
+//
+//  STPAPIOperationQueueTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "STPAPIOperation+Private.h"
+#import "STPAPIOperationQueue.h"
+
+@interface STPAPIOperationQueueTest : XCTestCase
+
+@property (nonatomic, strong) STPAPIOperationQueue *queue;
+@property (nonatomic, strong) NSMutableArray<NSString *> *startedOperations;
+@property (nonatomic, strong) NSMutableArray<NSString *> *cancelledOperations;
+
+@end
+
+@implementation STPAPIOperationQueueTest
+
+- (void)setUp {
+    [super setUp];
+    self.queue = [[STPAPIOperationQueue alloc] initWithMaxConcurrentOperationCount:1];
+    self.startedOperations = [NSMutableArray array];
+    self.cancelledOperations = [NSMutableArray array];
+}
+
+- (STPAPIOperation *)addOperationNamed:(NSString *)name priority:(STPAPIOperationPriority)priority {
+    STPAPIOperation *operation = [[STPAPIOperation alloc] initWithPriority:priority startBlock:^NSURLSessionTask *{
+        [self.startedOperations addObject:name];
+        return nil;
+    } cancelBlock:^(NSError *error) {
+        XCTAssertEqualObjects(error.domain, NSURLErrorDomain);
+        XCTAssertEqual(error.code, NSURLErrorCancelled);
+        [self.cancelledOperations addObject:name];
+    }];
+    [self.queue addOperation:operation];
+    return operation;
+}
+
+- (void)testStartsOperationsInPriorityOrder {
+    STPAPIOperation *first = [self addOperationNamed:@"first" priority:STPAPIOperationPriorityLow];
+    STPAPIOperation *refresh = [self addOperationNamed:@"refresh" priority:STPAPIOperationPriorityLow];
+    STPAPIOperation *token = [self addOperationNamed:@"token" priority:STPAPIOperationPriorityDefault];
+    STPAPIOperation *confirm = [self addOperationNamed:@"confirm" priority:STPAPIOperationPriorityHigh];
+    STPAPIOperation *token2 = [self addOperationNamed:@"token2" priority:STPAPIOperationPriorityDefault];
+
+    XCTAssertEqualObjects(self.startedOperations, @[@"first"]);
+    XCTAssertEqual(self.queue.runningOperationCount, 1U);
+    XCTAssertEqual(self.queue.pendingOperationCount, 4U);
+
+    for (STPAPIOperation *operation in @[first, confirm, token, token2, refresh]) {
+        [operation markFinished];
+    }
+    NSArray *expected = @[@"first", @"confirm", @"token", @"token2", @"refresh"];
+    XCTAssertEqualObjects(self.startedOperations, expected);
+    XCTAssertEqual(self.queue.runningOperationCount, 0U);
+    XCTAssertEqual(self.queue.pendingOperationCount, 0U);
+}
+
+- (void)testRaisingPriorityOfPendingOperation {
+    STPAPIOperation *first = [self addOperationNamed:@"first" priority:STPAPIOperationPriorityDefault];
+    STPAPIOperation *second = [self addOperationNamed:@"second" priority:STPAPIOperationPriorityDefault];
+    STPAPIOperation *third = [self addOperationNamed:@"third" priority:STPAPIOperationPriorityDefault];
+
+    third.priority = STPAPIOperationPriorityHigh;
+    [first markFinished];
+    [third markFinished];
+    [second markFinished];
+    NSArray *expected = @[@"first", @"third", @"second"];
+    XCTAssertEqualObjects(self.startedOperations, expected);
+}
+
+- (void)testCancelPendingOperation {
+    STPAPIOperation *first = [self addOperationNamed:@"first" priority:STPAPIOperationPriorityDefault];
+    STPAPIOperation *second = [self addOperationNamed:@"second" priority:STPAPIOperationPriorityDefault];
+
+    [second cancel];
+    XCTAssertTrue(second.isCancelled);
+    XCTAssertTrue(second.isFinished);
+    XCTAssertEqualObjects(self.cancelledOperations, @[@"second"]);
+    XCTAssertEqual(self.queue.pendingOperationCount, 0U);
+
+    [first markFinished];
+    XCTAssertEqualObjects(self.startedOperations, @[@"first"]);
+}
+
+- (void)testCancelFinishedOperationDoesNothing {
+    STPAPIOperation *operation = [self addOperationNamed:@"first" priority:STPAPIOperationPriorityDefault];
+    [operation markFinished];
+    [operation cancel];
+    XCTAssertFalse(operation.isCancelled);
+    XCTAssertEqual(self.cancelledOperations.count, 0U);
+}
+
+- (void)testCancelRunningOperationCancelsTask {
+    NSURLSessionDataTask *task = [[NSURLSession sharedSession] dataTaskWithURL:[NSURL URLWithString:@"https://api.stripe.com"]];
+    STPAPIOperation *operation = [[STPAPIOperation alloc] initWithPriority:STPAPIOperationPriorityHigh startBlock:^NSURLSessionTask *{
+        return task;
+    } cancelBlock:^(__unused NSError *error) {
+        XCTFail(@"Running operations report cancellation through their task");
+    }];
+    [self.queue addOperation:operation];
+
+    XCTAssertEqual(operation.task, task);
+    XCTAssertEqual(task.priority, NSURLSessionTaskPriorityHigh);
+    operation.priority = STPAPIOperationPriorityLow;
+    XCTAssertEqual(task.priority, NSURLSessionTaskPriorityLow);
+
+    [operation cancel];
+    XCTAssertEqual(task.state, NSURLSessionTaskStateCanceling);
+}
+
+- (void)testCancelGroupCancelsCurrentStep {
+    STPAPIOperation *group = [[STPAPIOperation alloc] initGroupWithPriority:STPAPIOperationPriorityHigh];
+    [self addOperationNamed:@"blocker" priority:STPAPIOperationPriorityDefault];
+    STPAPIOperation *step = [self addOperationNamed:@"step" priority:STPAPIOperationPriorityDefault];
+    group.currentOperation = step;
+    XCTAssertEqual(step.priority, STPAPIOperationPriorityHigh);
+
+    [group cancel];
+    XCTAssertTrue(step.isCancelled);
+    XCTAssertEqualObjects(self.cancelledOperations, @[@"step"]);
+
+    // Steps added after cancellation are cancelled right away
+    STPAPIOperation *nextStep = [self addOperationNamed:@"nextStep" priority:STPAPIOperationPriorityDefault];
+    group.currentOperation = nextStep;
+    XCTAssertTrue(nextStep.isCancelled);
+}
+
+- (void)testYieldingSlotWhileWaitingToRetry {
+    STPAPIOperation *first = [self addOperationNamed:@"first" priority:STPAPIOperationPriorityDefault];
+    STPAPIOperation *second = [self addOperationNamed:@"second" priority:STPAPIOperationPriorityDefault];
+
+    // The retry waits behind whatever took the slot in the meantime
+    [first yieldSlot];
+    XCTAssertEqualObjects(self.startedOperations, (@[@"first", @"second"]));
+    [first requeueWithStartBlock:^NSURLSessionTask *{
+        [self.startedOperations addObject:@"first retry"];
+        return nil;
+    }];
+    XCTAssertEqual(self.queue.pendingOperationCount, 1U);
+
+    [second markFinished];
+    XCTAssertEqualObjects(self.startedOperations, (@[@"first", @"second", @"first retry"]));
+    [first markFinished];
+    XCTAssertEqual(self.queue.runningOperationCount, 0U);
+}
+
+- (void)testCancelWhileWaitingToRetry {
+    STPAPIOperation *operation = [self addOperationNamed:@"first" priority:STPAPIOperationPriorityDefault];
+    [operation yieldSlot];
+    [operation cancel];
+    XCTAssertEqual(self.cancelledOperations.count, 0U);
+
+    [operation requeueWithStartBlock:^NSURLSessionTask *{
+        XCTFail(@"Cancelled operations aren't retried");
+        return nil;
+    }];
+    XCTAssertEqualObjects(self.cancelledOperations, @[@"first"]);
+    XCTAssertTrue(operation.isFinished);
+    XCTAssertEqual(self.queue.runningOperationCount, 0U);
+}
+
+- (void)testRaisingMaxConcurrentOperationCount {
+    [self addOperationNamed:@"first" priority:STPAPIOperationPriorityDefault];
+    [self addOperationNamed:@"second" priority:STPAPIOperationPriorityDefault];
+    [self addOperationNamed:@"third" priority:STPAPIOperationPriorityDefault];
+
+    self.queue.maxConcurrentOperationCount = 2;
+    XCTAssertEqualObjects(self.startedOperations, (@[@"first", @"second"]));
+    XCTAssertEqual(self.queue.pendingOperationCount, 1U);
+
+    self.queue.maxConcurrentOperationCount = 0;
+    XCTAssertEqual(self.queue.maxConcurrentOperationCount, 1U);
+}
+
+@end
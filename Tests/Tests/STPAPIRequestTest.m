@@ -8,6 +8,7 @@
 
 #import <XCTest/XCTest.h>
 #import <OCMock/OCMock.h>
+#import <OHHTTPStubs/OHHTTPStubs.h>
 #import <Stripe/Stripe.h>
 
 #import "STPAPIRequest.h"
@@ -15,6 +16,7 @@
 #import "NSError+Stripe.h"
 #import "STPAPIClient.h"
 #import "STPAPIClient+Private.h"
+#import "STPRequestMetricsCollector.h"
 #import "STPTestUtils.h"
 
 @interface STPAPIRequest ()
@@ -23,8 +25,13 @@
                  body:(NSData *)body
                 error:(NSError *)error
         deserializers:(NSArray<id<STPAPIResponseDecodable>>*)deserializers
+     metricsCollector:(STPRequestMetricsCollector *)metricsCollector
            completion:(STPAPIResponseBlock)completion;
 
++ (BOOL)shouldRetryResponse:(NSURLResponse *)response error:(NSError *)error;
+
++ (NSTimeInterval)delayBeforeRetryAttempt:(NSUInteger)attempt response:(NSURLResponse *)response;
+
 @end
 
 @interface STPAPIRequestTest : XCTestCase
@@ -33,6 +40,11 @@
 
 @implementation STPAPIRequestTest
 
+- (void)tearDown {
+    [OHHTTPStubs removeAllStubs];
+    [super tearDown];
+}
+
 - (void)testPostWithAPIClient {
     XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
 
@@ -47,7 +59,7 @@
     }]]).andReturn(dataTaskMock);
 
     STPAPIClient *apiClientMock = OCMClassMock([STPAPIClient class]);
-    OCMStub([apiClientMock apiURL]).andReturn([NSURL URLWithString:@"https://api.stripe.com"]);
+    OCMStub([apiClientMock URLForEndpoint:@"endpoint"]).andReturn([NSURL URLWithString:@"https://api.stripe.com/endpoint"]);
     OCMStub([apiClientMock urlSession]).andReturn(urlSessionMock);
     OCMStub([apiClientMock configuredRequestForURL:[OCMArg isKindOfClass:[NSURL class]]]).andDo(^(NSInvocation *invocation)
                                                                                                 {
@@ -63,6 +75,7 @@
                                      body:[OCMArg any]
                                     error:[OCMArg any]
                             deserializers:[OCMArg any]
+                         metricsCollector:[OCMArg any]
                                completion:[OCMArg checkWithBlock:^BOOL(STPAPIResponseBlock completion) {
         completion((STPCard *)@"card", (NSHTTPURLResponse *)@"httpURLResponse", (NSError *)@"error");
         return YES;
@@ -95,6 +108,7 @@
             XCTAssertEqualObjects(request.URL, [NSURL URLWithString:@"https://api.stripe.com/endpoint"]);
             XCTAssertEqualObjects(request.HTTPMethod, @"POST");
             XCTAssertEqualObjects([[NSString alloc] initWithData:request.HTTPBody encoding:NSUTF8StringEncoding], @"key=value");
+            XCTAssertNotNil([request valueForHTTPHeaderField:@"Idempotency-Key"]);
             return YES;
         }] completionHandler:[OCMArg any]]);
 
@@ -105,7 +119,7 @@
             XCTAssert([deserializers.firstObject isKindOfClass:[STPCard class]]);
             XCTAssertEqual(deserializers.count, (NSUInteger)1);
             return YES;
-        }] completion:[OCMArg any]]);
+        }] metricsCollector:[OCMArg any] completion:[OCMArg any]]);
     }];
 }
 
@@ -123,7 +137,7 @@
     }]]).andReturn(dataTaskMock);
 
     STPAPIClient *apiClientMock = OCMClassMock([STPAPIClient class]);
-    OCMStub([apiClientMock apiURL]).andReturn([NSURL URLWithString:@"https://api.stripe.com"]);
+    OCMStub([apiClientMock URLForEndpoint:@"endpoint"]).andReturn([NSURL URLWithString:@"https://api.stripe.com/endpoint"]);
     OCMStub([apiClientMock urlSession]).andReturn(urlSessionMock);
     OCMStub([apiClientMock configuredRequestForURL:[OCMArg isKindOfClass:[NSURL class]]]).andDo(^(NSInvocation *invocation)
                                                                                                 {
@@ -139,6 +153,7 @@
                                      body:[OCMArg any]
                                     error:[OCMArg any]
                             deserializers:[OCMArg any]
+                         metricsCollector:[OCMArg any]
                                completion:[OCMArg checkWithBlock:^BOOL(STPAPIResponseBlock completion) {
         completion((STPCard *)@"card", (NSHTTPURLResponse *)@"httpURLResponse", (NSError *)@"error");
         return YES;
@@ -181,7 +196,7 @@
             XCTAssert([deserializers.firstObject isKindOfClass:[STPCard class]]);
             XCTAssertEqual(deserializers.count, (NSUInteger)1);
             return YES;
-        }] completion:[OCMArg any]]);
+        }] metricsCollector:[OCMArg any] completion:[OCMArg any]]);
     }];
 }
 
@@ -199,7 +214,7 @@
     }]]).andReturn(dataTaskMock);
 
     STPAPIClient *apiClientMock = OCMClassMock([STPAPIClient class]);
-    OCMStub([apiClientMock apiURL]).andReturn([NSURL URLWithString:@"https://api.stripe.com"]);
+    OCMStub([apiClientMock URLForEndpoint:@"endpoint"]).andReturn([NSURL URLWithString:@"https://api.stripe.com/endpoint"]);
     OCMStub([apiClientMock urlSession]).andReturn(urlSessionMock);
     OCMStub([apiClientMock configuredRequestForURL:[OCMArg isKindOfClass:[NSURL class]]]).andDo(^(NSInvocation *invocation)
                                                                         {
@@ -215,6 +230,7 @@
                                      body:[OCMArg any]
                                     error:[OCMArg any]
                             deserializers:[OCMArg any]
+                         metricsCollector:[OCMArg any]
                                completion:[OCMArg checkWithBlock:^BOOL(STPAPIResponseBlock completion) {
         completion((STPCard *)@"card", (NSHTTPURLResponse *)@"httpURLResponse", (NSError *)@"error");
         return YES;
@@ -257,7 +273,7 @@
             XCTAssert([deserializers.firstObject isKindOfClass:[STPCard class]]);
             XCTAssertEqual(deserializers.count, (NSUInteger)1);
             return YES;
-        }] completion:[OCMArg any]]);
+        }] metricsCollector:[OCMArg any] completion:[OCMArg any]]);
     }];
 }
 
@@ -276,6 +292,7 @@
                             body:body
                            error:errorParameter
                    deserializers:deserializers
+                metricsCollector:nil
                       completion:^(id<STPAPIResponseDecodable> object, NSHTTPURLResponse *response, NSError *error) {
                           XCTAssertEqualObjects(object, [STPSource decodedObjectFromAPIResponse:json]);
                           XCTAssertEqualObjects(response, httpURLResponse);
@@ -299,6 +316,7 @@
                             body:body
                            error:errorParameter
                    deserializers:deserializers
+                metricsCollector:nil
                       completion:^(id<STPAPIResponseDecodable> object, NSHTTPURLResponse *response, NSError *error) {
                           XCTAssertNil(object);
                           XCTAssertEqualObjects(response, httpURLResponse);
@@ -322,6 +340,7 @@
                             body:body
                            error:errorParameter
                    deserializers:deserializers
+                metricsCollector:nil
                       completion:^(id<STPAPIResponseDecodable> object, NSHTTPURLResponse *response, NSError *error) {
                           XCTAssertEqualObjects(((STPCustomer *)object).stripeID, [STPCustomer decodedObjectFromAPIResponse:json].stripeID);
                           XCTAssertEqualObjects(response, httpURLResponse);
@@ -345,6 +364,7 @@
                             body:body
                            error:errorParameter
                    deserializers:deserializers
+                metricsCollector:nil
                       completion:^(id<STPAPIResponseDecodable> object, NSHTTPURLResponse *response, NSError *error) {
                           XCTAssertNil(object);
                           XCTAssertEqualObjects(response, httpURLResponse);
@@ -367,6 +387,7 @@
                             body:body
                            error:errorParameter
                    deserializers:deserializers
+                metricsCollector:nil
                       completion:^(id<STPAPIResponseDecodable> object, NSHTTPURLResponse *response, NSError *error) {
                           XCTAssertNil(object);
                           XCTAssertEqualObjects(response, httpURLResponse);
@@ -396,6 +417,7 @@
                             body:body
                            error:errorParameter
                    deserializers:deserializers
+                metricsCollector:nil
                       completion:^(id<STPAPIResponseDecodable> object, NSHTTPURLResponse *response, NSError *error) {
                           XCTAssertNil(object);
                           XCTAssertEqualObjects(response, httpURLResponse);
@@ -425,6 +447,7 @@
                             body:body
                            error:errorParameter
                    deserializers:deserializers
+                metricsCollector:nil
                       completion:^(id<STPAPIResponseDecodable> object, NSHTTPURLResponse *response, NSError *error) {
                           XCTAssertNil(object);
                           XCTAssertEqualObjects(response, httpURLResponse);
@@ -448,6 +471,7 @@
                             body:body
                            error:errorParameter
                    deserializers:deserializers
+                metricsCollector:nil
                       completion:^(id<STPAPIResponseDecodable> object, NSHTTPURLResponse *response, NSError *error) {
                           XCTAssertNil(object);
                           XCTAssertEqualObjects(response, httpURLResponse);
@@ -471,6 +495,7 @@
                             body:body
                            error:errorParameter
                    deserializers:deserializers
+                metricsCollector:nil
                       completion:^(id<STPAPIResponseDecodable> object, NSHTTPURLResponse *response, NSError *error) {
                           XCTAssertNil(object);
                           XCTAssertEqualObjects(response, httpURLResponse);
@@ -481,4 +506,146 @@
     [self waitForExpectationsWithTimeout:2.0 handler:nil];
 }
 
+#pragma mark - Retries
+
+- (void)testShouldRetryResponse {
+    NSURL *url = [NSURL URLWithString:@"https://api.stripe.com/v1/tokens"];
+    NSHTTPURLResponse *(^responseWithStatusCode)(NSInteger) = ^(NSInteger statusCode) {
+        return [[NSHTTPURLResponse alloc] initWithURL:url statusCode:statusCode HTTPVersion:nil headerFields:nil];
+    };
+    NSError *(^urlError)(NSInteger) = ^(NSInteger code) {
+        return [NSError errorWithDomain:NSURLErrorDomain code:code userInfo:nil];
+    };
+
+    XCTAssertTrue([STPAPIRequest shouldRetryResponse:nil error:urlError(NSURLErrorNetworkConnectionLost)]);
+    XCTAssertTrue([STPAPIRequest shouldRetryResponse:nil error:urlError(NSURLErrorTimedOut)]);
+    XCTAssertTrue([STPAPIRequest shouldRetryResponse:nil error:urlError(NSURLErrorNotConnectedToInternet)]);
+    XCTAssertTrue([STPAPIRequest shouldRetryResponse:responseWithStatusCode(429) error:nil]);
+    XCTAssertTrue([STPAPIRequest shouldRetryResponse:responseWithStatusCode(500) error:nil]);
+    XCTAssertTrue([STPAPIRequest shouldRetryResponse:responseWithStatusCode(503) error:nil]);
+
+    XCTAssertFalse([STPAPIRequest shouldRetryResponse:nil error:urlError(NSURLErrorCancelled)]);
+    XCTAssertFalse([STPAPIRequest shouldRetryResponse:nil error:urlError(NSURLErrorBadServerResponse)]);
+    XCTAssertFalse([STPAPIRequest shouldRetryResponse:nil error:[NSError errorWithDomain:StripeDomain code:STPAPIError userInfo:nil]]);
+    XCTAssertFalse([STPAPIRequest shouldRetryResponse:responseWithStatusCode(200) error:nil]);
+    XCTAssertFalse([STPAPIRequest shouldRetryResponse:responseWithStatusCode(400) error:nil]);
+    XCTAssertFalse([STPAPIRequest shouldRetryResponse:responseWithStatusCode(402) error:nil]);
+}
+
+- (void)testDelayBeforeRetryAttempt {
+    for (NSUInteger i = 0; i < 100; i++) {
+        NSTimeInterval firstDelay = [STPAPIRequest delayBeforeRetryAttempt:0 response:nil];
+        XCTAssertGreaterThanOrEqual(firstDelay, 0.25);
+        XCTAssertLessThanOrEqual(firstDelay, 0.5);
+
+        NSTimeInterval secondDelay = [STPAPIRequest delayBeforeRetryAttempt:1 response:nil];
+        XCTAssertGreaterThanOrEqual(secondDelay, 0.5);
+        XCTAssertLessThanOrEqual(secondDelay, 1);
+
+        NSTimeInterval cappedDelay = [STPAPIRequest delayBeforeRetryAttempt:20 response:nil];
+        XCTAssertGreaterThanOrEqual(cappedDelay, 2);
+        XCTAssertLessThanOrEqual(cappedDelay, 4);
+    }
+
+    NSHTTPURLResponse *rateLimited = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@"https://api.stripe.com/v1/tokens"]
+                                                                 statusCode:429
+                                                                HTTPVersion:nil
+                                                               headerFields:@{@"Retry-After": @"3"}];
+    XCTAssertGreaterThanOrEqual([STPAPIRequest delayBeforeRetryAttempt:0 response:rateLimited], 3);
+}
+
+- (void)testPostRetriesServerErrorWithSameIdempotencyKey {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"post"];
+    NSMutableArray<NSString *> *idempotencyKeys = [NSMutableArray array];
+    [OHHTTPStubs stubRequestsPassingTest:^BOOL(__unused NSURLRequest *request) {
+        return YES;
+    } withStubResponse:^OHHTTPStubsResponse *(NSURLRequest *request) {
+        NSString *idempotencyKey = [request valueForHTTPHeaderField:@"Idempotency-Key"];
+        @synchronized(idempotencyKeys) {
+            [idempotencyKeys addObject:idempotencyKey ?: @""];
+            if (idempotencyKeys.count == 1) {
+                return [OHHTTPStubsResponse responseWithJSONObject:@{@"error": @{@"type": @"api_error"}} statusCode:500 headers:nil];
+            }
+        }
+        return [OHHTTPStubsResponse responseWithJSONObject:[STPTestUtils jsonNamed:@"Card"] statusCode:200 headers:nil];
+    }];
+
+    STPAPIClient *apiClient = [[STPAPIClient alloc] initWithPublishableKey:@"pk_test_123"];
+    STPRequestMetricsAggregator *aggregator = [STPRequestMetricsAggregator new];
+    apiClient.metricsObserver = aggregator;
+    [STPAPIRequest<STPCard *> postWithAPIClient:apiClient
+                                       endpoint:@"tokens"
+                                     parameters:@{@"key": @"value"}
+                                   deserializer:[STPCard new]
+                                     completion:^(STPCard *card, __unused NSHTTPURLResponse *response, NSError *error) {
+                                         XCTAssertNotNil(card);
+                                         XCTAssertNil(error);
+                                         [expectation fulfill];
+                                     }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    XCTAssertEqual(idempotencyKeys.count, 2U);
+    XCTAssertGreaterThan(idempotencyKeys.firstObject.length, 0U);
+    XCTAssertEqualObjects(idempotencyKeys.firstObject, idempotencyKeys.lastObject);
+
+    // Metrics are delivered once the session has also reported task metrics
+    XCTestExpectation *metricsExpectation = [self expectationWithDescription:@"metrics"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.5 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        STPRequestMetrics *metrics = [aggregator recentMetricsForEndpoint:@"tokens"].firstObject;
+        XCTAssertEqual(metrics.retryCount, 1U);
+        XCTAssertGreaterThanOrEqual(metrics.retryDuration, 0.25);
+        XCTAssertEqual(metrics.statusCode, 200);
+        [metricsExpectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
+- (void)testPostDoesNotRetryClientError {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"post"];
+    __block NSUInteger requestCount = 0;
+    [OHHTTPStubs stubRequestsPassingTest:^BOOL(__unused NSURLRequest *request) {
+        return YES;
+    } withStubResponse:^OHHTTPStubsResponse *(__unused NSURLRequest *request) {
+        requestCount++;
+        return [OHHTTPStubsResponse responseWithJSONObject:@{@"error": @{@"type": @"card_error", @"message": @"Your card was declined."}} statusCode:402 headers:nil];
+    }];
+
+    STPAPIClient *apiClient = [[STPAPIClient alloc] initWithPublishableKey:@"pk_test_123"];
+    [STPAPIRequest<STPCard *> postWithAPIClient:apiClient
+                                       endpoint:@"tokens"
+                                     parameters:@{@"key": @"value"}
+                                   deserializer:[STPCard new]
+                                     completion:^(STPCard *card, __unused NSHTTPURLResponse *response, NSError *error) {
+                                         XCTAssertNil(card);
+                                         XCTAssertNotNil(error);
+                                         [expectation fulfill];
+                                     }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(requestCount, 1U);
+}
+
+- (void)testRetriesDisabled {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"get"];
+    __block NSUInteger requestCount = 0;
+    [OHHTTPStubs stubRequestsPassingTest:^BOOL(__unused NSURLRequest *request) {
+        return YES;
+    } withStubResponse:^OHHTTPStubsResponse *(__unused NSURLRequest *request) {
+        requestCount++;
+        return [OHHTTPStubsResponse responseWithError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil]];
+    }];
+
+    STPAPIClient *apiClient = [[STPAPIClient alloc] initWithPublishableKey:@"pk_test_123"];
+    apiClient.maxRetryCount = 0;
+    [STPAPIRequest<STPCard *> getWithAPIClient:apiClient
+                                      endpoint:@"tokens/tok_123"
+                                    parameters:@{}
+                                  deserializer:[STPCard new]
+                                    completion:^(__unused STPCard *card, __unused NSHTTPURLResponse *response, NSError *error) {
+                                        XCTAssertEqual(error.code, NSURLErrorNetworkConnectionLost);
+                                        [expectation fulfill];
+                                    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(requestCount, 1U);
+}
+
 @end
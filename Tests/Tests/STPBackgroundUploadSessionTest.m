@@ -0,0 +1,188 @@
+//
+//  STPBackgroundUploadSessionTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <OHHTTPStubs/OHHTTPStubs.h>
+#import <Stripe/Stripe.h>
+
+#import "STPBackgroundUploadSession+Private.h"
+#import "STPTestUtils.h"
+
+@interface STPBackgroundUploadSessionTest : XCTestCase
+@property (nonatomic) NSURL *directoryURL;
+@property (nonatomic) NSMutableArray<STPBackgroundUploadSession *> *sessions;
+@end
+
+@implementation STPBackgroundUploadSessionTest
+
+- (void)setUp {
+    [super setUp];
+    self.directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString isDirectory:YES];
+    self.sessions = [NSMutableArray array];
+}
+
+- (void)tearDown {
+    for (STPBackgroundUploadSession *session in self.sessions) {
+        [session invalidate];
+    }
+    [OHHTTPStubs removeAllStubs];
+    [[NSFileManager defaultManager] removeItemAtURL:self.directoryURL error:nil];
+    [super tearDown];
+}
+
+- (STPBackgroundUploadSession *)makeSession {
+    STPBackgroundUploadSession *session = [[STPBackgroundUploadSession alloc] initWithIdentifier:@"test"
+                                                                                   configuration:[NSURLSessionConfiguration defaultSessionConfiguration]
+                                                                                    directoryURL:self.directoryURL];
+    session.apiClient = [[STPAPIClient alloc] initWithPublishableKey:@"pk_test_123"];
+    [self.sessions addObject:session];
+    return session;
+}
+
+- (UIImage *)image {
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(40, 40), YES, 1);
+    [[UIColor redColor] setFill];
+    UIRectFill(CGRectMake(0, 0, 40, 40));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    return image;
+}
+
+- (NSArray<NSString *> *)filesWithExtension:(NSString *)extension {
+    NSArray<NSString *> *fileNames = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:self.directoryURL.path error:nil];
+    return [fileNames filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"pathExtension == %@", extension]];
+}
+
+/**
+ Stands in for the files API: checks that the request is a multipart upload
+ whose body is on disk, then replies with `statusCode` and `json`.
+ */
+- (void)stubUploadsWithStatusCode:(int)statusCode json:(NSDictionary *)json {
+    [OHHTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest *request) {
+        return [request.URL.host isEqualToString:@"uploads.stripe.com"];
+    } withStubResponse:^OHHTTPStubsResponse *(NSURLRequest *request) {
+        XCTAssertEqualObjects(request.HTTPMethod, @"POST");
+        XCTAssertEqualObjects(request.URL.path, @"/v1/files");
+        XCTAssertTrue([[request valueForHTTPHeaderField:@"Content-Type"] hasPrefix:@"multipart/form-data; boundary="]);
+
+        NSArray<NSString *> *bodyFiles = [self filesWithExtension:@"body"];
+        XCTAssertEqual(bodyFiles.count, 1U);
+        NSData *body = [NSData dataWithContentsOfURL:[self.directoryURL URLByAppendingPathComponent:bodyFiles.firstObject]];
+        NSString *bodyPrefix = [[NSString alloc] initWithData:[body subdataWithRange:NSMakeRange(0, MIN(body.length, (NSUInteger)300))] encoding:NSASCIIStringEncoding];
+        XCTAssertTrue([bodyPrefix containsString:@"name=\"purpose\""]);
+        XCTAssertTrue([bodyPrefix containsString:@"dispute_evidence"]);
+
+        return [OHHTTPStubsResponse responseWithJSONObject:json statusCode:statusCode headers:nil];
+    }];
+}
+
+- (void)testUpload {
+    [self stubUploadsWithStatusCode:200 json:[STPTestUtils jsonNamed:@"FileUpload"]];
+    STPBackgroundUploadSession *session = [self makeSession];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"upload"];
+    STPBackgroundUpload *upload = [session uploadImage:[self image] purpose:STPFilePurposeDisputeEvidence completion:^(STPFile *file, NSError *error) {
+        XCTAssertEqualObjects(file.fileId, @"file_1AZl0o2eZvKYlo2CoIkwLzfd");
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    XCTAssertEqual(upload.state, STPBackgroundUploadStateUploading);
+    XCTAssertEqualObjects(session.uploads, @[upload]);
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    XCTAssertEqual(upload.state, STPBackgroundUploadStateCompleted);
+    XCTAssertGreaterThan(upload.countOfBytesExpectedToSend, 0);
+    XCTAssertNotNil(upload.file);
+    XCTAssertEqual(session.uploads.count, 0U);
+    XCTAssertEqual([self filesWithExtension:@"body"].count, 0U);
+    XCTAssertEqual([self filesWithExtension:@"json"].count, 0U);
+}
+
+- (void)testFailedUpload {
+    [self stubUploadsWithStatusCode:400 json:@{@"error": @{@"type": @"invalid_request_error", @"message": @"Invalid file"}}];
+    STPBackgroundUploadSession *session = [self makeSession];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"upload"];
+    STPBackgroundUpload *upload = [session uploadImage:[self image] purpose:STPFilePurposeDisputeEvidence completion:^(STPFile *file, NSError *error) {
+        XCTAssertNil(file);
+        XCTAssertEqual(error.code, STPInvalidRequestError);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    XCTAssertEqual(upload.state, STPBackgroundUploadStateFailed);
+    XCTAssertNotNil(upload.error);
+    XCTAssertEqual([self filesWithExtension:@"body"].count, 0U);
+}
+
+- (void)testResultIsKeptForLaterLaunch {
+    [self stubUploadsWithStatusCode:200 json:[STPTestUtils jsonNamed:@"FileUpload"]];
+    STPBackgroundUploadSession *session = [self makeSession];
+
+    STPBackgroundUpload *upload = [session uploadImage:[self image] purpose:STPFilePurposeDisputeEvidence completion:nil];
+    NSString *identifier = upload.identifier;
+    NSPredicate *completed = [NSPredicate predicateWithFormat:@"state == %ld", (long)STPBackgroundUploadStateCompleted];
+    [self expectationForPredicate:completed evaluatedWithObject:upload handler:nil];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual([self filesWithExtension:@"json"].count, 1U);
+
+    // A new session with the same directory stands in for a relaunch
+    STPBackgroundUploadSession *relaunchedSession = [self makeSession];
+    XCTAssertEqual(relaunchedSession.uploads.count, 1U);
+    STPBackgroundUpload *restoredUpload = relaunchedSession.uploads.firstObject;
+    XCTAssertEqualObjects(restoredUpload.identifier, identifier);
+    XCTAssertEqual(restoredUpload.state, STPBackgroundUploadStateCompleted);
+
+    __block STPFile *restoredFile = nil;
+    [relaunchedSession addCompletion:^(STPFile *file, __unused NSError *error) {
+        restoredFile = file;
+    } forUploadWithIdentifier:identifier];
+    XCTAssertEqualObjects(restoredFile.fileId, @"file_1AZl0o2eZvKYlo2CoIkwLzfd");
+    XCTAssertEqual(relaunchedSession.uploads.count, 0U);
+    XCTAssertEqual([self filesWithExtension:@"json"].count, 0U);
+
+    // The result is only delivered once
+    __block NSError *secondError = nil;
+    [relaunchedSession addCompletion:^(__unused STPFile *file, NSError *error) {
+        secondError = error;
+    } forUploadWithIdentifier:identifier];
+    XCTAssertEqualObjects(secondError.domain, StripeDomain);
+}
+
+- (void)testCancel {
+    [OHHTTPStubs stubRequestsPassingTest:^BOOL(__unused NSURLRequest *request) {
+        return YES;
+    } withStubResponse:^OHHTTPStubsResponse *(__unused NSURLRequest *request) {
+        return [[OHHTTPStubsResponse responseWithJSONObject:[STPTestUtils jsonNamed:@"FileUpload"] statusCode:200 headers:nil] responseTime:5];
+    }];
+    STPBackgroundUploadSession *session = [self makeSession];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"upload"];
+    STPBackgroundUpload *upload = [session uploadImage:[self image] purpose:STPFilePurposeDisputeEvidence completion:^(STPFile *file, NSError *error) {
+        XCTAssertNil(file);
+        XCTAssertEqual(error.code, NSURLErrorCancelled);
+        [expectation fulfill];
+    }];
+    [session cancelUploadWithIdentifier:upload.identifier];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(upload.state, STPBackgroundUploadStateFailed);
+}
+
+- (void)testHandleEventsForBackgroundURLSession {
+    STPBackgroundUploadSession *session = [self makeSession];
+    XCTAssertFalse([session handleEventsForBackgroundURLSession:@"other" completionHandler:^{}]);
+
+    __block BOOL called = NO;
+    XCTAssertTrue([session handleEventsForBackgroundURLSession:@"test" completionHandler:^{
+        called = YES;
+    }]);
+    [(id<NSURLSessionDelegate>)session URLSessionDidFinishEventsForBackgroundURLSession:[NSURLSession sharedSession]];
+    XCTAssertTrue(called);
+}
+
+@end
@@ -0,0 +1,200 @@
+//
+//  STPBatchRequestRunnerTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <Stripe/Stripe.h>
+
+#import "STPAPIOperation+Private.h"
+#import "STPBatchRequestRunner.h"
+
+@interface STPBatchRequestRunnerTest : XCTestCase
+@end
+
+@implementation STPBatchRequestRunnerTest
+
+- (void)completeAfterDelay:(NSTimeInterval)delay block:(dispatch_block_t)block {
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), block);
+}
+
+- (NSError *)rateLimitError {
+    return [NSError errorWithDomain:StripeDomain
+                               code:STPInvalidRequestError
+                           userInfo:@{STPStripeErrorCodeKey: @"rate_limit"}];
+}
+
+- (void)testResultsAreInInputOrderWithinConcurrencyLimit {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"batch"];
+    __block NSUInteger inFlightCount = 0;
+    __block NSUInteger maxInFlightCount = 0;
+    __block NSUInteger progressCount = 0;
+
+    STPBatchRequestRunner *runner = [[STPBatchRequestRunner alloc] initWithItemCount:20 maxConcurrency:3 request:^STPAPIOperation *(NSUInteger index, STPBatchItemCompletionBlock completion) {
+        inFlightCount++;
+        maxInFlightCount = MAX(maxInFlightCount, inFlightCount);
+        // Later items finish sooner, so completion order differs from input order
+        [self completeAfterDelay:0.01 * (20 - index) block:^{
+            inFlightCount--;
+            if (index % 2 == 0) {
+                completion(@(index), nil);
+            }
+            else {
+                completion(nil, [NSError errorWithDomain:StripeDomain code:STPCardError userInfo:nil]);
+            }
+        }];
+        return [STPAPIOperation new];
+    } progress:^(NSUInteger completedCount, NSUInteger totalCount) {
+        progressCount++;
+        XCTAssertEqual(completedCount, progressCount);
+        XCTAssertEqual(totalCount, 20U);
+    } completion:^(NSArray<STPBatchItemResult *> *results, STPBatchMetrics *metrics) {
+        XCTAssertEqual(results.count, 20U);
+        for (NSUInteger i = 0; i < results.count; i++) {
+            if (i % 2 == 0) {
+                XCTAssertEqualObjects(results[i].object, @(i));
+                XCTAssertNil(results[i].error);
+            }
+            else {
+                XCTAssertNil(results[i].object);
+                XCTAssertEqual(results[i].error.code, STPCardError);
+            }
+        }
+        XCTAssertEqual(metrics.itemCount, 20U);
+        XCTAssertEqual(metrics.failureCount, 10U);
+        XCTAssertEqual(metrics.rateLimitedCount, 0U);
+        XCTAssertEqual(metrics.peakConcurrency, 3U);
+        XCTAssertGreaterThan(metrics.throughput, 0);
+        [expectation fulfill];
+    }];
+    [runner start];
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(maxInFlightCount, 3U);
+    XCTAssertEqual(progressCount, 20U);
+}
+
+- (void)testRateLimitedItemsAreRequeued {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"batch"];
+    NSMutableArray<NSNumber *> *requestedIndexes = [NSMutableArray array];
+
+    STPBatchRequestRunner *runner = [[STPBatchRequestRunner alloc] initWithItemCount:4 maxConcurrency:2 request:^STPAPIOperation *(NSUInteger index, STPBatchItemCompletionBlock completion) {
+        BOOL firstAttempt = ![requestedIndexes containsObject:@(index)];
+        [requestedIndexes addObject:@(index)];
+        [self completeAfterDelay:0.01 block:^{
+            if (index == 1 && firstAttempt) {
+                completion(nil, [self rateLimitError]);
+            }
+            else {
+                completion(@(index), nil);
+            }
+        }];
+        return [STPAPIOperation new];
+    } progress:nil completion:^(NSArray<STPBatchItemResult *> *results, STPBatchMetrics *metrics) {
+        NSArray *objects = [results valueForKey:@"object"];
+        NSArray *expectedObjects = @[@0, @1, @2, @3];
+        XCTAssertEqualObjects(objects, expectedObjects);
+        XCTAssertEqual(metrics.failureCount, 0U);
+        XCTAssertEqual(metrics.rateLimitedCount, 1U);
+        [expectation fulfill];
+    }];
+    runner.initialBackoff = 0.05;
+    [runner start];
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(requestedIndexes.count, 5U);
+    XCTAssertEqual([requestedIndexes indexesOfObjectsPassingTest:^BOOL(NSNumber *index, __unused NSUInteger idx, __unused BOOL *stop) {
+        return index.unsignedIntegerValue == 1;
+    }].count, 2U);
+}
+
+- (void)testItemsAreFailedAfterRepeatedRateLimiting {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"batch"];
+    __block NSUInteger requestCount = 0;
+
+    STPBatchRequestRunner *runner = [[STPBatchRequestRunner alloc] initWithItemCount:1 maxConcurrency:1 request:^STPAPIOperation *(__unused NSUInteger index, STPBatchItemCompletionBlock completion) {
+        requestCount++;
+        [self completeAfterDelay:0 block:^{
+            completion(nil, [self rateLimitError]);
+        }];
+        return [STPAPIOperation new];
+    } progress:nil completion:^(NSArray<STPBatchItemResult *> *results, STPBatchMetrics *metrics) {
+        XCTAssertEqualObjects(results.firstObject.error.userInfo[STPStripeErrorCodeKey], @"rate_limit");
+        XCTAssertEqual(metrics.failureCount, 1U);
+        XCTAssertEqual(metrics.rateLimitedCount, 2U);
+        [expectation fulfill];
+    }];
+    runner.initialBackoff = 0.01;
+    [runner start];
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(requestCount, 3U);
+}
+
+- (void)testCancelFailsItemsThatHaveNotStarted {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"batch"];
+    __block STPBatchRequestRunner *runner = [[STPBatchRequestRunner alloc] initWithItemCount:5 maxConcurrency:1 request:^STPAPIOperation *(NSUInteger index, STPBatchItemCompletionBlock completion) {
+        STPAPIOperation *operation = [STPAPIOperation new];
+        [self completeAfterDelay:0.05 block:^{
+            completion(@(index), nil);
+        }];
+        if (index == 0) {
+            [runner.operation cancel];
+        }
+        return operation;
+    } progress:nil completion:^(NSArray<STPBatchItemResult *> *results, STPBatchMetrics *metrics) {
+        XCTAssertEqualObjects(results[0].object, @0);
+        for (NSUInteger i = 1; i < results.count; i++) {
+            XCTAssertEqualObjects(results[i].error.domain, NSURLErrorDomain);
+            XCTAssertEqual(results[i].error.code, NSURLErrorCancelled);
+        }
+        XCTAssertEqual(metrics.failureCount, 4U);
+        [expectation fulfill];
+    }];
+    [runner start];
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertTrue(runner.operation.isFinished);
+}
+
+- (void)testItemRequestsAreNotRetried {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"batch"];
+    __block STPAPIOperation *itemOperation = nil;
+    STPBatchRequestRunner *runner = [[STPBatchRequestRunner alloc] initWithItemCount:1 maxConcurrency:1 request:^STPAPIOperation *(NSUInteger index, STPBatchItemCompletionBlock completion) {
+        itemOperation = [[STPAPIOperation alloc] initWithPriority:STPAPIOperationPriorityDefault startBlock:^NSURLSessionTask *{
+            return nil;
+        } cancelBlock:^(__unused NSError *error) {}];
+        [self completeAfterDelay:0 block:^{
+            completion(@(index), nil);
+        }];
+        return itemOperation;
+    } progress:nil completion:^(__unused NSArray<STPBatchItemResult *> *results, __unused STPBatchMetrics *metrics) {
+        [expectation fulfill];
+    }];
+    [runner start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertTrue(itemOperation.retriesDisabled);
+    XCTAssertFalse([[STPAPIOperation alloc] initWithPriority:STPAPIOperationPriorityDefault startBlock:^NSURLSessionTask *{
+        return nil;
+    } cancelBlock:^(__unused NSError *error) {}].retriesDisabled);
+}
+
+- (void)testEmptyBatch {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"batch"];
+    STPBatchRequestRunner *runner = [[STPBatchRequestRunner alloc] initWithItemCount:0 maxConcurrency:4 request:^STPAPIOperation *(__unused NSUInteger index, __unused STPBatchItemCompletionBlock completion) {
+        XCTFail(@"No requests should be made");
+        return [STPAPIOperation new];
+    } progress:nil completion:^(NSArray<STPBatchItemResult *> *results, STPBatchMetrics *metrics) {
+        XCTAssertEqual(results.count, 0U);
+        XCTAssertEqual(metrics.itemCount, 0U);
+        [expectation fulfill];
+    }];
+    [runner start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
+@end
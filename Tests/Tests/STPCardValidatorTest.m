@@ -11,6 +11,7 @@
 
 #import "STPCardValidationState.h"
 #import "STPCardValidator.h"
+#import "STPVirtualClock.h"
 
 @interface STPCardValidator (Testing)
 
@@ -30,6 +31,11 @@
 
 @implementation STPCardValidatorTest
 
+- (void)tearDown {
+    [STPClock setSharedClock:nil];
+    [super tearDown];
+}
+
 + (NSArray *)cardData {
     return @[
              @[@(STPCardBrandVisa), @"4242424242424242", @(STPCardValidationStateValid)],
@@ -208,6 +214,23 @@
     }
 }
 
+- (void)testYearValidationUsesClock {
+    NSCalendar *calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    NSDateComponents *components = [NSDateComponents new];
+    components.year = 2015;
+    components.month = 8;
+    components.day = 31;
+    components.hour = 12;
+    STPVirtualClock *clock = [[STPVirtualClock alloc] initWithDate:[calendar dateFromComponents:components]];
+    [STPClock setSharedClock:clock];
+
+    XCTAssertEqual([STPCardValidator validationStateForExpirationYear:@"15" inMonth:@"8"], STPCardValidationStateValid);
+    // The card expires when September starts
+    [clock advanceBy:24*60*60];
+    XCTAssertEqual([STPCardValidator validationStateForExpirationYear:@"15" inMonth:@"8"], STPCardValidationStateInvalid);
+    XCTAssertEqual([STPCardValidator validationStateForExpirationYear:@"15" inMonth:@"9"], STPCardValidationStateValid);
+}
+
 - (void)testCVCLength {
     NSArray *tests = @[
                        @[@(STPCardBrandVisa), @3],
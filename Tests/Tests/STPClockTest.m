@@ -0,0 +1,110 @@
+//
+//  STPClockTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "STPClock.h"
+#import "STPVirtualClock.h"
+
+@interface STPClockTest : XCTestCase
+@property (nonatomic) STPVirtualClock *clock;
+@property (nonatomic) NSMutableArray<NSNumber *> *fireTimes;
+@end
+
+@implementation STPClockTest
+
+- (void)tearDown {
+    [STPClock setSharedClock:nil];
+    [super tearDown];
+}
+
+- (NSDate *)dateWithYear:(NSInteger)year month:(NSInteger)month day:(NSInteger)day hour:(NSInteger)hour {
+    NSCalendar *calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    NSDateComponents *components = [NSDateComponents new];
+    components.year = year;
+    components.month = month;
+    components.day = day;
+    components.hour = hour;
+    return [calendar dateFromComponents:components];
+}
+
+- (void)testSystemClock {
+    STPClock *clock = [STPClock sharedClock];
+    NSCalendar *calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    NSDateComponents *components = [calendar components:(NSCalendarUnitYear | NSCalendarUnitMonth) fromDate:[NSDate date]];
+    XCTAssertEqual(clock.currentYear, components.year);
+    XCTAssertEqual(clock.currentMonth, components.month);
+    XCTAssertEqualWithAccuracy(clock.currentDate.timeIntervalSinceNow, 0, 1);
+    XCTAssertEqualWithAccuracy(clock.monotonicTime, [NSProcessInfo processInfo].systemUptime, 1);
+}
+
+- (void)testSetSharedClock {
+    STPClock *systemClock = [STPClock sharedClock];
+    STPVirtualClock *clock = [STPVirtualClock new];
+    [STPClock setSharedClock:clock];
+    XCTAssertEqual([STPClock sharedClock], clock);
+    [STPClock setSharedClock:nil];
+    XCTAssertEqual([STPClock sharedClock], systemClock);
+}
+
+- (void)testYearAndMonthFollowDayChanges {
+    STPVirtualClock *clock = [[STPVirtualClock alloc] initWithDate:[self dateWithYear:2026 month:12 day:31 hour:22]];
+    XCTAssertEqual(clock.currentYear, 2026);
+    XCTAssertEqual(clock.currentMonth, 12);
+
+    [clock advanceBy:60*60];
+    XCTAssertEqual(clock.currentYear, 2026);
+
+    [clock advanceBy:60*60];
+    XCTAssertEqual(clock.currentYear, 2027);
+    XCTAssertEqual(clock.currentMonth, 1);
+
+    [clock advanceBy:31*24*60*60];
+    XCTAssertEqual(clock.currentMonth, 2);
+}
+
+- (void)recordFire:(__unused NSTimer *)timer {
+    [self.fireTimes addObject:@(self.clock.monotonicTime)];
+}
+
+- (void)failFire:(__unused NSTimer *)timer {
+    XCTFail(@"An invalidated timer shouldn't fire");
+}
+
+- (void)testVirtualTimers {
+    self.clock = [STPVirtualClock new];
+    self.fireTimes = [NSMutableArray array];
+    NSTimeInterval startTime = self.clock.monotonicTime;
+
+    NSTimer *laterTimer = [self.clock scheduledTimerWithTimeInterval:5 target:self selector:@selector(recordFire:)];
+    NSTimer *invalidatedTimer = [self.clock scheduledTimerWithTimeInterval:2 target:self selector:@selector(failFire:)];
+    [self.clock scheduledTimerWithTimeInterval:1 target:self selector:@selector(recordFire:)];
+    [invalidatedTimer invalidate];
+
+    [self.clock advanceBy:3];
+    XCTAssertEqualObjects(self.fireTimes, @[@(startTime + 1)]);
+    XCTAssertTrue(laterTimer.isValid);
+
+    [self.clock advanceBy:3];
+    NSArray *expectedFireTimes = @[@(startTime + 1), @(startTime + 5)];
+    XCTAssertEqualObjects(self.fireTimes, expectedFireTimes);
+    XCTAssertFalse(laterTimer.isValid);
+    XCTAssertEqual(self.clock.monotonicTime, startTime + 6);
+}
+
+- (void)testPerformanceOfCurrentYearAndMonth {
+    STPClock *clock = [STPClock sharedClock];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10000; i++) {
+            (void)clock.currentYear;
+            (void)clock.currentMonth;
+        }
+    }];
+}
+
+@end
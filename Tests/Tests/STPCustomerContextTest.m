@@ -11,6 +11,8 @@
 #import <Stripe/Stripe.h>
 #import "STPAPIClient+Private.h"
 #import "STPCustomerContext.h"
+#import "STPCustomerContext+Private.h"
+#import "STPCustomerSourcesPage.h"
 #import "STPEphemeralKeyManager.h"
 #import "STPFixtures.h"
 
@@ -107,6 +109,28 @@
     [self waitForExpectationsWithTimeout:2 handler:nil];
 }
 
+- (void)testPrefetchEphemeralKeyOnlyFetchesKey {
+    STPEphemeralKey *customerKey = [STPFixtures ephemeralKey];
+    // apiClient.retrieveCustomer should only be called when the context is initialized
+    [self stubRetrieveCustomerUsingKey:customerKey
+                     returningCustomer:[STPFixtures customerWithSingleCardTokenSource]
+                         expectedCount:1];
+    __block NSInteger getCustomerKeyCount = 0;
+    id mockKeyManager = OCMClassMock([STPEphemeralKeyManager class]);
+    OCMStub([mockKeyManager getCustomerKey:[OCMArg any]])
+    .andDo(^(NSInvocation *invocation) {
+        STPEphemeralKeyCompletionBlock completion;
+        [invocation getArgument:&completion atIndex:2];
+        getCustomerKeyCount++;
+        completion(customerKey, nil);
+    });
+    STPCustomerContext *sut = [[STPCustomerContext alloc] initWithKeyManager:mockKeyManager];
+    [sut prefetchEphemeralKey];
+
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    XCTAssertEqual(getCustomerKeyCount, 2);
+}
+
 - (void)testRetrieveCustomerUsesCachedCustomerIfNotExpired {
     STPEphemeralKey *customerKey = [STPFixtures ephemeralKey];
     STPCustomer *expectedCustomer = [STPFixtures customerWithSingleCardTokenSource];
@@ -315,6 +339,41 @@
     [self waitForExpectationsWithTimeout:2 handler:nil];
 }
 
+- (void)testListSourcesCallsAPIClientCorrectly {
+    STPEphemeralKey *customerKey = [STPFixtures ephemeralKey];
+    STPCustomer *expectedCustomer = [STPFixtures customerWithSingleCardTokenSource];
+    id mockAPIClient = OCMClassMock([STPAPIClient class]);
+    [self stubRetrieveCustomerUsingKey:customerKey
+                     returningCustomer:expectedCustomer
+                         expectedCount:1
+                         mockAPIClient:mockAPIClient];
+    STPCustomerSourcesPage *expectedPage = [STPCustomerSourcesPage decodedObjectFromAPIResponse:@{@"object": @"list", @"data": @[], @"has_more": @NO}];
+    XCTestExpectation *exp = [self expectationWithDescription:@"listSources"];
+    OCMStub([mockAPIClient listSourcesForCustomerUsingKey:[OCMArg isEqual:customerKey]
+                                                    limit:20
+                                            startingAfter:[OCMArg isEqual:@"card_123"]
+                                               completion:[OCMArg any]])
+    .andDo(^(NSInvocation *invocation) {
+        STPCustomerSourcesPageCompletionBlock completion;
+        [invocation getArgument:&completion atIndex:5];
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+            completion(expectedPage, nil);
+        });
+        [exp fulfill];
+    });
+    id mockKeyManager = [self mockKeyManagerWithKey:customerKey];
+    STPCustomerContext *sut = [[STPCustomerContext alloc] initWithKeyManager:mockKeyManager];
+    XCTestExpectation *exp2 = [self expectationWithDescription:@"listSourcesCompletion"];
+    [sut listSourcesWithLimit:20 startingAfter:@"card_123" completion:^(STPCustomerSourcesPage *page, NSError *error) {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertEqual(page, expectedPage);
+        XCTAssertNil(error);
+        [exp2 fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
 #pragma mark - includeApplePaySources
 
 - (void)testFiltersApplePaySourcesByDefault {
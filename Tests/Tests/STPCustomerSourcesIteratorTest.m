@@ -0,0 +1,204 @@
+//
+//  STPCustomerSourcesIteratorTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <OCMock/OCMock.h>
+#import <Stripe/Stripe.h>
+
+#import "STPCustomerContext+Private.h"
+#import "STPCustomerSourcesIterator+Private.h"
+#import "STPCustomerSourcesPage.h"
+#import "STPTestUtils.h"
+
+@interface STPCustomerSourcesIteratorTest : XCTestCase
+@end
+
+@implementation STPCustomerSourcesIteratorTest
+
+- (NSDictionary *)cardJSONWithID:(NSString *)stripeID {
+    NSMutableDictionary *card = [[STPTestUtils jsonNamed:@"Card"] mutableCopy];
+    card[@"id"] = stripeID;
+    return card;
+}
+
+- (NSDictionary *)pageJSONWithCards:(NSArray<NSDictionary *> *)cards hasMore:(BOOL)hasMore {
+    return @{
+             @"object": @"list",
+             @"data": cards,
+             @"has_more": @(hasMore),
+             @"url": @"/v1/customers/cus_123/sources",
+             };
+}
+
+- (STPCustomerSourcesPage *)pageWithCardIDs:(NSArray<NSString *> *)cardIDs hasMore:(BOOL)hasMore {
+    NSMutableArray *cards = [NSMutableArray array];
+    for (NSString *cardID in cardIDs) {
+        [cards addObject:[self cardJSONWithID:cardID]];
+    }
+    return [STPCustomerSourcesPage decodedObjectFromAPIResponse:[self pageJSONWithCards:cards hasMore:hasMore]];
+}
+
+/**
+ Stubs `listSourcesWithLimit:startingAfter:completion:` to return `pages` by
+ their `startingAfter` cursor, with `[NSNull null]` for the first page.
+ */
+- (id)mockCustomerContextWithPages:(NSDictionary<id, STPCustomerSourcesPage *> *)pages
+                   startingAfters:(NSMutableArray *)startingAfters {
+    id mockCustomerContext = OCMClassMock([STPCustomerContext class]);
+    OCMStub([mockCustomerContext listSourcesWithLimit:10 startingAfter:[OCMArg any] completion:[OCMArg any]])
+    .andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained NSString *startingAfter;
+        STPCustomerSourcesPageCompletionBlock completion;
+        [invocation getArgument:&startingAfter atIndex:3];
+        [invocation getArgument:&completion atIndex:4];
+        id key = startingAfter ?: [NSNull null];
+        [startingAfters addObject:key];
+        completion(pages[key], nil);
+    });
+    return mockCustomerContext;
+}
+
+- (void)testDecodingPage {
+    NSDictionary *json = [self pageJSONWithCards:@[[self cardJSONWithID:@"card_1"], @{@"object": @"bank_account", @"id": @"ba_2"}]
+                                         hasMore:YES];
+    STPCustomerSourcesPage *page = [STPCustomerSourcesPage decodedObjectFromAPIResponse:json];
+    XCTAssertEqual(page.sources.count, 1U);
+    XCTAssertEqualObjects(page.sources.firstObject.stripeID, @"card_1");
+    XCTAssertTrue(page.hasMore);
+    // The cursor is the last object, even though it's not a card or source
+    XCTAssertEqualObjects(page.lastObjectID, @"ba_2");
+
+    XCTAssertNil([STPCustomerSourcesPage decodedObjectFromAPIResponse:@{@"object": @"customer", @"data": @[]}]);
+}
+
+- (void)testLoadsPagesInOrder {
+    NSMutableArray *startingAfters = [NSMutableArray array];
+    id mockCustomerContext = [self mockCustomerContextWithPages:@{
+                                                                  [NSNull null]: [self pageWithCardIDs:@[@"card_1", @"card_2"] hasMore:YES],
+                                                                  @"card_2": [self pageWithCardIDs:@[@"card_3"] hasMore:NO],
+                                                                  }
+                                                 startingAfters:startingAfters];
+    STPCustomerSourcesIterator *sut = [[STPCustomerSourcesIterator alloc] initWithCustomerContext:mockCustomerContext pageSize:10 startingAfter:nil];
+    XCTAssertTrue(sut.hasMore);
+
+    __block NSArray *firstPage;
+    [sut loadNextPage:^(NSArray<id<STPSourceProtocol>> *sources, NSError *error) {
+        XCTAssertNil(error);
+        firstPage = sources;
+    }];
+    XCTAssertEqualObjects([firstPage valueForKey:@"stripeID"], (@[@"card_1", @"card_2"]));
+    XCTAssertTrue(sut.hasMore);
+    XCTAssertFalse(sut.isLoading);
+
+    __block NSArray *secondPage;
+    [sut loadNextPage:^(NSArray<id<STPSourceProtocol>> *sources, __unused NSError *error) {
+        secondPage = sources;
+    }];
+    XCTAssertEqualObjects([secondPage valueForKey:@"stripeID"], @[@"card_3"]);
+    XCTAssertEqualObjects([sut.sources valueForKey:@"stripeID"], (@[@"card_1", @"card_2", @"card_3"]));
+    XCTAssertFalse(sut.hasMore);
+
+    // There's nothing left to request
+    __block NSArray *emptyPage;
+    [sut loadNextPage:^(NSArray<id<STPSourceProtocol>> *sources, __unused NSError *error) {
+        emptyPage = sources;
+    }];
+    XCTAssertEqualObjects(emptyPage, @[]);
+    XCTAssertEqualObjects(startingAfters, (@[[NSNull null], @"card_2"]));
+}
+
+- (void)testStartsAfterCursor {
+    NSMutableArray *startingAfters = [NSMutableArray array];
+    id mockCustomerContext = [self mockCustomerContextWithPages:@{@"card_10": [self pageWithCardIDs:@[@"card_11"] hasMore:NO]}
+                                                 startingAfters:startingAfters];
+    STPCustomerSourcesIterator *sut = [[STPCustomerSourcesIterator alloc] initWithCustomerContext:mockCustomerContext pageSize:10 startingAfter:@"card_10"];
+    [sut loadNextPage:nil];
+    XCTAssertEqualObjects([sut.sources valueForKey:@"stripeID"], @[@"card_11"]);
+    XCTAssertEqualObjects(startingAfters, @[@"card_10"]);
+}
+
+- (void)testFiltersApplePaySources {
+    NSMutableDictionary *applePayCard = [[self cardJSONWithID:@"card_2"] mutableCopy];
+    applePayCard[@"tokenization_method"] = @"apple_pay";
+    STPCustomerSourcesPage *page = [STPCustomerSourcesPage decodedObjectFromAPIResponse:[self pageJSONWithCards:@[[self cardJSONWithID:@"card_1"], applePayCard] hasMore:NO]];
+    id mockCustomerContext = [self mockCustomerContextWithPages:@{[NSNull null]: page} startingAfters:[NSMutableArray array]];
+
+    STPCustomerSourcesIterator *sut = [[STPCustomerSourcesIterator alloc] initWithCustomerContext:mockCustomerContext pageSize:10 startingAfter:nil];
+    [sut loadNextPage:nil];
+    XCTAssertEqualObjects([sut.sources valueForKey:@"stripeID"], @[@"card_1"]);
+
+    OCMStub([mockCustomerContext includeApplePaySources]).andReturn(YES);
+    sut = [[STPCustomerSourcesIterator alloc] initWithCustomerContext:mockCustomerContext pageSize:10 startingAfter:nil];
+    [sut loadNextPage:nil];
+    XCTAssertEqualObjects([sut.sources valueForKey:@"stripeID"], (@[@"card_1", @"card_2"]));
+}
+
+- (void)testLoadWhileLoadingWaitsForSamePage {
+    __block STPCustomerSourcesPageCompletionBlock pendingCompletion;
+    __block NSUInteger requestCount = 0;
+    id mockCustomerContext = OCMClassMock([STPCustomerContext class]);
+    OCMStub([mockCustomerContext listSourcesWithLimit:10 startingAfter:[OCMArg any] completion:[OCMArg any]])
+    .andDo(^(NSInvocation *invocation) {
+        STPCustomerSourcesPageCompletionBlock completion;
+        [invocation getArgument:&completion atIndex:4];
+        pendingCompletion = [completion copy];
+        requestCount++;
+    });
+
+    STPCustomerSourcesIterator *sut = [[STPCustomerSourcesIterator alloc] initWithCustomerContext:mockCustomerContext pageSize:10 startingAfter:nil];
+    __block NSUInteger completionCount = 0;
+    for (NSUInteger i = 0; i < 2; i++) {
+        [sut loadNextPage:^(NSArray<id<STPSourceProtocol>> *sources, __unused NSError *error) {
+            XCTAssertEqual(sources.count, 1U);
+            completionCount++;
+        }];
+    }
+    XCTAssertTrue(sut.isLoading);
+    XCTAssertEqual(requestCount, 1U);
+
+    pendingCompletion([self pageWithCardIDs:@[@"card_1"] hasMore:YES], nil);
+    XCTAssertEqual(completionCount, 2U);
+    XCTAssertEqual(sut.sources.count, 1U);
+}
+
+- (void)testErrorRetriesSamePage {
+    NSError *expectedError = [NSError errorWithDomain:@"foo" code:123 userInfo:nil];
+    NSMutableArray *startingAfters = [NSMutableArray array];
+    __block BOOL fail = YES;
+    id mockCustomerContext = OCMClassMock([STPCustomerContext class]);
+    OCMStub([mockCustomerContext listSourcesWithLimit:10 startingAfter:[OCMArg any] completion:[OCMArg any]])
+    .andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained NSString *startingAfter;
+        STPCustomerSourcesPageCompletionBlock completion;
+        [invocation getArgument:&startingAfter atIndex:3];
+        [invocation getArgument:&completion atIndex:4];
+        [startingAfters addObject:startingAfter];
+        if (fail) {
+            completion(nil, expectedError);
+        }
+        else {
+            completion([self pageWithCardIDs:@[@"card_6"] hasMore:NO], nil);
+        }
+    });
+
+    STPCustomerSourcesIterator *sut = [[STPCustomerSourcesIterator alloc] initWithCustomerContext:mockCustomerContext pageSize:10 startingAfter:@"card_5"];
+    __block NSError *loadError;
+    [sut loadNextPage:^(NSArray<id<STPSourceProtocol>> *sources, NSError *error) {
+        XCTAssertNil(sources);
+        loadError = error;
+    }];
+    XCTAssertEqualObjects(loadError, expectedError);
+    XCTAssertTrue(sut.hasMore);
+
+    fail = NO;
+    [sut loadNextPage:nil];
+    XCTAssertEqualObjects([sut.sources valueForKey:@"stripeID"], @[@"card_6"]);
+    XCTAssertEqualObjects(startingAfters, (@[@"card_5", @"card_5"]));
+}
+
+@end
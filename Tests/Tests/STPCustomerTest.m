@@ -7,10 +7,14 @@
 //
 
 #import <XCTest/XCTest.h>
+#import <malloc/malloc.h>
+#import "NSDictionary+Stripe.h"
 #import "STPCustomer.h"
+#import "STPCustomer+Private.h"
 
 #import "StripeError.h"
 #import "STPAddress.h"
+#import "STPCard.h"
 #import "STPSourceProtocol.h"
 #import "STPTestUtils.h"
 
@@ -67,4 +71,131 @@
     XCTAssertEqualObjects(sut.shippingAddress.state, customer[@"shipping"][@"address"][@"state"]);
 }
 
+- (void)testNextSourcesPageCursor {
+    NSMutableDictionary *customer = [[STPTestUtils jsonNamed:@"Customer"] mutableCopy];
+    NSDictionary *card1 = [STPTestUtils jsonNamed:@"Card"];
+    NSMutableDictionary *card2 = [[STPTestUtils jsonNamed:@"Card"] mutableCopy];
+    card2[@"id"] = @"card_456";
+    customer[@"sources"] = @{@"object": @"list", @"data": @[card1, card2], @"has_more": @YES};
+    STPCustomer *sut = [STPCustomer decodedObjectFromAPIResponse:customer];
+    XCTAssertEqualObjects(sut.nextSourcesPageCursor, @"card_456");
+
+    customer[@"sources"] = @{@"object": @"list", @"data": @[card1, card2], @"has_more": @NO};
+    sut = [STPCustomer decodedObjectFromAPIResponse:customer];
+    XCTAssertNil(sut.nextSourcesPageCursor);
+}
+
+#pragma mark - Large responses
+
+/**
+ A customer with `cardCount` cards, round tripped through `NSJSONSerialization`
+ so its containers are immutable, like a real API response.
+ */
+- (NSDictionary *)customerJSONWithCardCount:(NSUInteger)cardCount {
+    NSDictionary *json;
+    @autoreleasepool {
+        NSMutableArray *cards = [NSMutableArray array];
+        for (NSUInteger i = 0; i < cardCount; i++) {
+            NSMutableDictionary *card = [[STPTestUtils jsonNamed:@"Card"] mutableCopy];
+            card[@"id"] = [NSString stringWithFormat:@"card_%lu", (unsigned long)i];
+            [cards addObject:card];
+        }
+        NSMutableDictionary *customer = [[STPTestUtils jsonNamed:@"Customer"] mutableCopy];
+        customer[@"default_source"] = @"card_0";
+        customer[@"sources"] = @{@"object": @"list", @"data": cards};
+        NSData *data = [NSJSONSerialization dataWithJSONObject:customer options:0 error:nil];
+        json = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+    }
+    return json;
+}
+
+/**
+ A copy of `object` with a new, mutable container at every level, which
+ stp_dictionaryByRemovingNulls has to copy in full.
+ */
+- (id)mutableDeepCopyOfJSONObject:(id)object {
+    if ([object isKindOfClass:[NSDictionary class]]) {
+        NSMutableDictionary *copy = [NSMutableDictionary dictionary];
+        [(NSDictionary *)object enumerateKeysAndObjectsUsingBlock:^(id key, id value, __unused BOOL *stop) {
+            copy[key] = [self mutableDeepCopyOfJSONObject:value];
+        }];
+        return copy;
+    }
+    else if ([object isKindOfClass:[NSArray class]]) {
+        NSMutableArray *copy = [NSMutableArray array];
+        for (id value in (NSArray *)object) {
+            [copy addObject:[self mutableDeepCopyOfJSONObject:value]];
+        }
+        return copy;
+    }
+    return object;
+}
+
+- (size_t)allocatedBytes {
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+    return statistics.size_in_use;
+}
+
+- (void)testDecoding_sharesResponseFieldsWithSources {
+    NSDictionary *json = [self customerJSONWithCardCount:3];
+    STPCustomer *sut = [STPCustomer decodedObjectFromAPIResponse:json];
+    NSArray *cardsJSON = sut.allResponseFields[@"sources"][@"data"];
+    XCTAssertEqual(sut.sources.count, 3U);
+    for (NSUInteger i = 0; i < sut.sources.count; i++) {
+        STPCard *card = (STPCard *)sut.sources[i];
+        XCTAssertEqual(card.allResponseFields, cardsJSON[i]);
+    }
+}
+
+- (void)testDecoding_largeResponseAllocations {
+    NSUInteger customerCount = 10;
+    NSUInteger cardCount = 500;
+    NSMutableArray<NSDictionary *> *jsons = [NSMutableArray array];
+    NSMutableArray<STPCustomer *> *customers = [NSMutableArray array];
+
+    size_t startBytes = [self allocatedBytes];
+    for (NSUInteger i = 0; i < customerCount; i++) {
+        [jsons addObject:[self customerJSONWithCardCount:cardCount]];
+    }
+    size_t jsonBytes = [self allocatedBytes] - startBytes;
+
+    @autoreleasepool {
+        for (NSDictionary *json in jsons) {
+            [customers addObject:[STPCustomer decodedObjectFromAPIResponse:json]];
+        }
+    }
+    size_t decodedBytes = [self allocatedBytes] - startBytes - jsonBytes;
+    XCTAssertEqual(customers.count, customerCount);
+
+    // The deep-copy path sources took before they shared their response fields
+    // with the customer's: the customer kept a copy of the whole response, and
+    // each card another copy of its own
+    NSMutableArray<STPCustomer *> *baselineCustomers = [NSMutableArray array];
+    NSMutableArray<NSDictionary *> *baselineCardResponseFields = [NSMutableArray array];
+    size_t baselineStartBytes = [self allocatedBytes];
+    @autoreleasepool {
+        for (NSDictionary *json in jsons) {
+            [baselineCustomers addObject:[STPCustomer decodedObjectFromAPIResponse:[self mutableDeepCopyOfJSONObject:json]]];
+            for (NSDictionary *card in json[@"sources"][@"data"]) {
+                [baselineCardResponseFields addObject:[[self mutableDeepCopyOfJSONObject:card] stp_dictionaryByRemovingNulls]];
+            }
+        }
+    }
+    size_t baselineBytes = [self allocatedBytes] - baselineStartBytes;
+    XCTAssertEqual(baselineCardResponseFields.count, customerCount * cardCount);
+
+    // At least 10% less, so that allocator noise alone can't pass
+    XCTAssertLessThan((double)decodedBytes, 0.9 * baselineBytes);
+}
+
+- (void)testDecoding_largeResponsePerformance {
+    NSDictionary *json = [self customerJSONWithCardCount:500];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10; i++) {
+            [STPCustomer decodedObjectFromAPIResponse:json];
+        }
+    }];
+}
+
 @end
@@ -38,4 +38,101 @@
     }
 }
 
+- (void)testValidationStates {
+    NSArray *tests = @[
+                       @[@"", @(STPCardValidationStateIncomplete)],
+                       @[@"test", @(STPCardValidationStateIncomplete)],
+                       @[@"test.", @(STPCardValidationStateIncomplete)],
+                       @[@"test@", @(STPCardValidationStateIncomplete)],
+                       @[@"test@test", @(STPCardValidationStateIncomplete)],
+                       @[@"test@test-", @(STPCardValidationStateIncomplete)],
+                       @[@"test@test.", @(STPCardValidationStateIncomplete)],
+                       @[@"test@test.com", @(STPCardValidationStateValid)],
+                       @[@"first.last@sub.test-domain.co", @(STPCardValidationStateValid)],
+                       @[@".test", @(STPCardValidationStateInvalid)],
+                       @[@"test..", @(STPCardValidationStateInvalid)],
+                       @[@"test.@", @(STPCardValidationStateInvalid)],
+                       @[@"te st", @(STPCardValidationStateInvalid)],
+                       @[@"test@@", @(STPCardValidationStateInvalid)],
+                       @[@"test@-", @(STPCardValidationStateInvalid)],
+                       @[@"test@test-.", @(STPCardValidationStateInvalid)],
+                       @[@"test@test..com", @(STPCardValidationStateInvalid)],
+                       @[@"tést@test.com", @(STPCardValidationStateInvalid)],
+                       ];
+    for (NSArray *test in tests) {
+        XCTAssertEqual([STPEmailAddressValidator validationStateForEmailAddress:test[0]], [test[1] integerValue], @"%@", test[0]);
+    }
+    XCTAssertEqual([STPEmailAddressValidator validationStateForEmailAddress:nil], STPCardValidationStateIncomplete);
+}
+
+- (void)testPartialEmails {
+    XCTAssertTrue([STPEmailAddressValidator stringIsValidPartialEmailAddress:nil]);
+    XCTAssertTrue([STPEmailAddressValidator stringIsValidPartialEmailAddress:@""]);
+    XCTAssertTrue([STPEmailAddressValidator stringIsValidPartialEmailAddress:@"test@"]);
+    XCTAssertFalse([STPEmailAddressValidator stringIsValidPartialEmailAddress:@"test@@"]);
+    XCTAssertFalse([STPEmailAddressValidator stringIsValidPartialEmailAddress:@"a@b@c"]);
+}
+
+/**
+ The regex the validator replaced, which defines the language it accepts.
+ */
+- (BOOL)regexMatchesEmailAddress:(NSString *)string {
+    NSString *pattern = @"[a-z0-9!#$%&'*+/=?^_`{|}~-]+(?:\\.[a-z0-9!#$%&'*+/=?^_`{|}~-]+)*@(?:[a-z0-9](?:[a-z0-9-]*[a-z0-9])?\\.)+[a-z0-9](?:[a-z0-9-]*[a-z0-9])?";
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"SELF MATCHES %@", pattern];
+    return [predicate evaluateWithObject:[string lowercaseString]];
+}
+
+- (NSString *)randomStringFromAlphabet:(NSString *)alphabet maxLength:(NSUInteger)maxLength {
+    NSUInteger length = (NSUInteger)(drand48() * (maxLength + 1));
+    NSMutableString *string = [NSMutableString stringWithCapacity:length];
+    for (NSUInteger i = 0; i < length; i++) {
+        unichar character = [alphabet characterAtIndex:(NSUInteger)(drand48() * alphabet.length)];
+        [string appendString:[NSString stringWithCharacters:&character length:1]];
+    }
+    return string;
+}
+
+- (void)testDifferentialFuzzAgainstRegex {
+    // Weighted towards the characters that matter to the grammar
+    NSString *alphabet = @"aZ9..--@@_+' \"é\u212A\u0130";
+    long seed = 4242;
+    srand48(seed);
+
+    for (NSUInteger i = 0; i < 20000; i++) {
+        NSString *string = [self randomStringFromAlphabet:alphabet maxLength:12];
+        BOOL regexMatches = [self regexMatchesEmailAddress:string];
+        STPCardValidationState state = [STPEmailAddressValidator validationStateForEmailAddress:string];
+
+        XCTAssertEqual([STPEmailAddressValidator stringIsValidEmailAddress:string], regexMatches,
+                       @"Mismatch for \"%@\" (seed %ld)", string, seed);
+        XCTAssertEqual(state == STPCardValidationStateValid, regexMatches,
+                       @"Mismatch for \"%@\" (seed %ld)", string, seed);
+
+        if (state == STPCardValidationStateInvalid) {
+            // Nothing typed after an invalid prefix can make it valid
+            for (NSUInteger j = 0; j < 3; j++) {
+                NSString *extended = [string stringByAppendingString:[self randomStringFromAlphabet:alphabet maxLength:8]];
+                XCTAssertFalse([self regexMatchesEmailAddress:extended],
+                               @"\"%@\" was invalid but \"%@\" matches (seed %ld)", string, extended, seed);
+            }
+        }
+        else if (state == STPCardValidationStateIncomplete) {
+            // Something typed after an incomplete prefix can make it valid
+            BOOL needsCharacter = (string.length == 0
+                                   || [string hasSuffix:@"@"]
+                                   || [string hasSuffix:@"."]
+                                   || [string hasSuffix:@"-"]);
+            NSString *completion = needsCharacter ? @"a" : @"";
+            if ([string rangeOfString:@"@"].location == NSNotFound) {
+                completion = [completion stringByAppendingString:@"@a.a"];
+            }
+            else if (![self regexMatchesEmailAddress:[string stringByAppendingString:completion]]) {
+                completion = [completion stringByAppendingString:@".a"];
+            }
+            XCTAssertTrue([self regexMatchesEmailAddress:[string stringByAppendingString:completion]],
+                          @"\"%@\" was incomplete but can't be completed (seed %ld)", string, seed);
+        }
+    }
+}
+
 @end
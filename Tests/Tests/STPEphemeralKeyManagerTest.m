@@ -13,6 +13,7 @@
 #import "STPEphemeralKey.h"
 #import "STPEphemeralKeyManager.h"
 #import "STPFixtures.h"
+#import "STPVirtualClock.h"
 
 @interface STPEphemeralKeyManager (Testing)
 @property (nonatomic) STPEphemeralKey *customerKey;
@@ -32,6 +33,11 @@
     self.apiVersion = @"2015-03-03";
 }
 
+- (void)tearDown {
+    [STPClock setSharedClock:nil];
+    [super tearDown];
+}
+
 - (id)mockKeyProviderWithKeyResponse:(NSDictionary *)keyResponse {
     XCTestExpectation *exp = [self expectationWithDescription:@"createCustomerKey"];
     id mockKeyProvider = OCMProtocolMock(@protocol(STPEphemeralKeyProvider));
@@ -173,4 +179,34 @@
     [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationWillEnterForegroundNotification object:nil];
 }
 
+- (void)testEnterForegroundRefreshesAgainAfterAnHour {
+    __block NSUInteger refreshCount = 0;
+    id mockKeyProvider = OCMProtocolMock(@protocol(STPEphemeralKeyProvider));
+    OCMStub([mockKeyProvider createCustomerKeyWithAPIVersion:[OCMArg isEqual:self.apiVersion]
+                                                  completion:[OCMArg any]])
+    .andDo(^(NSInvocation *invocation) {
+        STPJSONResponseCompletionBlock completion;
+        [invocation getArgument:&completion atIndex:3];
+        refreshCount++;
+        // Leaves the manager without a key, so only the throttle stops the next refresh
+        completion(nil, [NSError stp_genericConnectionError]);
+    });
+    STPVirtualClock *clock = [[STPVirtualClock alloc] initWithDate:[NSDate dateWithTimeIntervalSince1970:1500000000]];
+    [STPClock setSharedClock:clock];
+    STPEphemeralKeyManager *sut = [[STPEphemeralKeyManager alloc] initWithKeyProvider:mockKeyProvider apiVersion:self.apiVersion];
+    sut.lastEagerKeyRefresh = clock.currentDate;
+
+    [clock advanceBy:30*60];
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationWillEnterForegroundNotification object:nil];
+    XCTAssertEqual(refreshCount, 0U);
+
+    [clock advanceBy:31*60];
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationWillEnterForegroundNotification object:nil];
+    XCTAssertEqual(refreshCount, 1U);
+    XCTAssertEqualObjects(sut.lastEagerKeyRefresh, clock.currentDate);
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationWillEnterForegroundNotification object:nil];
+    XCTAssertEqual(refreshCount, 1U);
+}
+
 @end
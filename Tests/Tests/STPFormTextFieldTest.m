@@ -29,6 +29,23 @@
     XCTAssertEqualObjects(sut.text, @"(123) 456-789");
 }
 
+- (void)testAutoFormattingBehavior_InternationalPhoneNumbers {
+    STPFormTextField *sut = [STPFormTextField new];
+    sut.autoFormattingBehavior = STPFormTextFieldAutoFormattingBehaviorPhoneNumbers;
+    sut.phoneNumberCountryCode = @"GB";
+    sut.delegate = nil; // installs the delegate proxy that sanitizes typed text
+    sut.text = @"07700900123";
+    XCTAssertEqualObjects(sut.text, @"07700 900123");
+
+    // Pasted or typed with the calling code
+    BOOL changed = [sut.delegate textField:sut shouldChangeCharactersInRange:NSMakeRange(0, sut.text.length) replacementString:@"+44 7700 900123"];
+    XCTAssertFalse(changed);
+    XCTAssertEqualObjects(sut.text, @"+447700900123");
+
+    [sut.delegate textField:sut shouldChangeCharactersInRange:NSMakeRange(sut.text.length, 0) replacementString:@"4"];
+    XCTAssertEqualObjects(sut.text, @"+4477009001234");
+}
+
 - (void)testAutoFormattingBehavior_CardNumbers {
     STPFormTextField *sut = [STPFormTextField new];
     sut.autoFormattingBehavior = STPFormTextFieldAutoFormattingBehaviorCardNumbers;
@@ -183,4 +183,35 @@
     }
 }
 
+- (void)testImagesAreCached {
+    UIImage *image = [STPImageLibrary brandImageForCardBrand:STPCardBrandVisa];
+    XCTAssertNotNil(image);
+    XCTAssertEqual([STPImageLibrary brandImageForCardBrand:STPCardBrandVisa], image);
+    XCTAssertEqual(image.renderingMode, UIImageRenderingModeAutomatic);
+
+    UIImage *templateImage = [STPImageLibrary templatedBrandImageForCardBrand:STPCardBrandVisa];
+    XCTAssertNotEqual(templateImage, image);
+    XCTAssertEqual(templateImage.renderingMode, UIImageRenderingModeAlwaysTemplate);
+    XCTAssertEqual([STPImageLibrary templatedBrandImageForCardBrand:STPCardBrandVisa], templateImage);
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    UIImage *reloadedImage = [STPImageLibrary brandImageForCardBrand:STPCardBrandVisa];
+    XCTAssertNotEqual(reloadedImage, image);
+    AssertEqualImages(reloadedImage, image);
+}
+
+- (void)testTintedImagesAreCached {
+    UIImage *image = [STPImageLibrary addIcon];
+    UIImage *redImage = [STPImageLibrary imageWithTintColor:[UIColor redColor] forImage:image];
+    XCTAssertEqual([STPImageLibrary imageWithTintColor:[UIColor redColor] forImage:image], redImage);
+    XCTAssertEqual([STPImageLibrary imageWithTintColor:[UIColor colorWithRed:1 green:0 blue:0 alpha:1] forImage:image], redImage);
+
+    UIImage *blueImage = [STPImageLibrary imageWithTintColor:[UIColor blueColor] forImage:image];
+    XCTAssertNotEqual(blueImage, redImage);
+    XCTAssertNotEqualObjects(UIImagePNGRepresentation(blueImage), UIImagePNGRepresentation(redImage));
+
+    UIImage *otherImage = [STPImageLibrary checkmarkIcon];
+    XCTAssertNotEqual([STPImageLibrary imageWithTintColor:[UIColor redColor] forImage:otherImage], redImage);
+}
+
 @end
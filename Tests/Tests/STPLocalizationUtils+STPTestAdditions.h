@@ -10,4 +10,10 @@
 
 @interface STPLocalizationUtils (TestAdditions)
 + (void)overrideLanguageTo:(nullable NSString *)string;
+
+/**
+ Makes `localizedStripeStringForKey:` look every string up in the bundle, like
+ it did before it had a string table. Used to benchmark the table.
+ */
++ (void)setStringTableDisabled:(BOOL)disabled;
 @end
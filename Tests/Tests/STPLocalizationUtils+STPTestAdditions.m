@@ -7,25 +7,31 @@
 //
 
 #import "STPLocalizationUtils+STPTestAdditions.h"
+#import "STPLocalizationUtils+Private.h"
 #import "STPBundleLocator.h"
 
 @implementation STPLocalizationUtils (TestAdditions)
 
 static NSString *languageOverride = nil;
+static BOOL stringTableDisabled = NO;
 
 + (void)overrideLanguageTo:(NSString *)string {
     languageOverride = string;
 }
 
++ (void)setStringTableDisabled:(BOOL)disabled {
+    stringTableDisabled = disabled;
+}
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wobjc-protocol-method-implementation"
 
 
 /**
- Clobber the real implementation with this one that lets us change
+ Clobber the real implementations with these ones that let us change
  the lproj
  */
-+ (NSString *)localizedStripeStringForKey:(NSString *)key {
++ (NSBundle *)localizationBundle {
     NSBundle *bundle = [STPBundleLocator stripeResourcesBundle];
     
     if (languageOverride) {
@@ -35,7 +41,25 @@ static NSString *languageOverride = nil;
             bundle = [NSBundle bundleWithPath:lprojPath];
         }
     }
-    return [bundle localizedStringForKey:key value:nil table:nil];
+    return bundle;
+}
+
++ (NSDictionary<NSString *, NSString *> *)localizedStringTable {
+    if (stringTableDisabled) {
+        return nil;
+    }
+
+    static NSMutableDictionary<NSString *, NSDictionary *> *tablesByLanguage;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        tablesByLanguage = [NSMutableDictionary new];
+    });
+
+    NSString *language = languageOverride ?: @"";
+    if (!tablesByLanguage[language]) {
+        tablesByLanguage[language] = [self localizedStringTableForBundle:[self localizationBundle]] ?: @{};
+    }
+    return tablesByLanguage[language];
 }
 #pragma clang diagnostic pop
 
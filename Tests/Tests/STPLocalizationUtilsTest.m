@@ -0,0 +1,72 @@
+//
+//  STPLocalizationUtilsTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <Stripe/Stripe.h>
+
+#import "STPBundleLocator.h"
+#import "STPFixtures.h"
+#import "STPLocalizationUtils.h"
+#import "STPLocalizationUtils+Private.h"
+#import "STPLocalizationUtils+STPTestAdditions.h"
+
+@interface STPLocalizationUtilsTest : XCTestCase
+@end
+
+@implementation STPLocalizationUtilsTest
+
+- (void)tearDown {
+    [STPLocalizationUtils overrideLanguageTo:nil];
+    [STPLocalizationUtils setStringTableDisabled:NO];
+    [super tearDown];
+}
+
+- (void)testStringTableMatchesBundleLookups {
+    for (NSString *language in @[@"en", @"de", @"ja"]) {
+        [STPLocalizationUtils overrideLanguageTo:language];
+        NSBundle *bundle = [STPLocalizationUtils localizationBundle];
+        NSDictionary<NSString *, NSString *> *table = [STPLocalizationUtils localizedStringTableForBundle:bundle];
+        XCTAssertGreaterThan(table.count, 0U, @"%@", language);
+        for (NSString *key in table) {
+            XCTAssertEqualObjects([STPLocalizationUtils localizedStripeStringForKey:key],
+                                  [bundle localizedStringForKey:key value:nil table:nil]);
+        }
+    }
+}
+
+- (void)testMissingKeysFallBackToBundle {
+    NSString *key = @"Not a localized string";
+    XCTAssertNil([STPLocalizationUtils localizedStringTable][key]);
+    XCTAssertEqualObjects([STPLocalizationUtils localizedStripeStringForKey:key], key);
+}
+
+- (void)measureAddCardViewControllerConstruction {
+    STPPaymentConfiguration *config = [STPFixtures paymentConfiguration];
+    config.requiredBillingAddressFields = STPBillingAddressFieldsFull;
+    // Load the table and warm up UIKit outside of the measurement
+    [[[STPAddCardViewController alloc] initWithConfiguration:config theme:[STPTheme defaultTheme]] view];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 20; i++) {
+            STPAddCardViewController *addCardVC = [[STPAddCardViewController alloc] initWithConfiguration:config
+                                                                                                    theme:[STPTheme defaultTheme]];
+            [addCardVC view];
+        }
+    }];
+}
+
+- (void)testAddCardViewControllerConstructionPerformance {
+    [self measureAddCardViewControllerConstruction];
+}
+
+- (void)testAddCardViewControllerConstructionPerformanceWithoutStringTable {
+    [STPLocalizationUtils setStringTableDisabled:YES];
+    [self measureAddCardViewControllerConstruction];
+}
+
+@end
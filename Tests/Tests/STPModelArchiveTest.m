@@ -0,0 +1,227 @@
+//
+//  STPModelArchiveTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <Stripe/Stripe.h>
+
+#import "STPFixtures.h"
+#import "STPTestUtils.h"
+
+// Loading from an archive must take at most this fraction of the time taken
+// to load the same models from JSON
+static const double ArchiveToJSONLoadTimeRatio = 0.9;
+static const NSUInteger LoadTimeRuns = 5;
+
+@interface STPModelArchiveTest : XCTestCase
+@end
+
+@implementation STPModelArchiveTest
+
+- (NSDictionary *)productResponse {
+    return @{
+             @"id": @"prod_123",
+             @"object": @"product",
+             @"active": @YES,
+             @"shippable": @NO,
+             @"name": @"Socks",
+             @"images": @[@"https://example.com/socks.png"],
+             @"metadata": @{},
+             };
+}
+
+- (NSArray<STPSource *> *)sourcesWithCount:(NSUInteger)count {
+    NSDictionary *json = [STPTestUtils jsonNamed:STPTestJSONSourceCard];
+    NSMutableArray<STPSource *> *sources = [NSMutableArray array];
+    for (NSUInteger i = 0; i < count; i++) {
+        NSMutableDictionary *response = [json mutableCopy];
+        response[@"id"] = [NSString stringWithFormat:@"src_%lu", (unsigned long)i];
+        [sources addObject:[STPSource decodedObjectFromAPIResponse:response]];
+    }
+    return sources;
+}
+
+- (NSData *)JSONDataForSources:(NSArray<STPSource *> *)sources {
+    NSMutableArray *responses = [NSMutableArray array];
+    for (STPSource *source in sources) {
+        [responses addObject:source.allResponseFields];
+    }
+    return [NSJSONSerialization dataWithJSONObject:responses options:(NSJSONWritingOptions)0 error:nil];
+}
+
+- (void)loadSourcesFromJSONData:(NSData *)json {
+    NSArray *decodedResponses = [NSJSONSerialization JSONObjectWithData:json options:(NSJSONReadingOptions)0 error:nil];
+    for (NSDictionary *response in decodedResponses) {
+        [STPSource decodedObjectFromAPIResponse:response];
+    }
+}
+
+- (void)loadObjectsFromArchiveData:(NSData *)data {
+    STPModelArchive *archive = [[STPModelArchive alloc] initWithData:data error:nil];
+    [archive allObjects];
+}
+
+/**
+ The fastest of several runs, which is the least affected by whatever else
+ the machine is doing.
+ */
+- (CFTimeInterval)bestTimeOfBlock:(void (^)(void))block {
+    CFTimeInterval bestTime = DBL_MAX;
+    for (NSUInteger i = 0; i < LoadTimeRuns; i++) {
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        block();
+        bestTime = MIN(bestTime, CFAbsoluteTimeGetCurrent() - start);
+    }
+    return bestTime;
+}
+
+- (void)testRoundTrip {
+    NSArray<id<STPAPIResponseDecodable>> *objects = @[
+                                                      [STPFixtures customerWithSingleCardSourceSource],
+                                                      [STPFixtures card],
+                                                      [STPFixtures cardSource],
+                                                      [STPFixtures paymentIntent],
+                                                      [STPFixtures ephemeralKey],
+                                                      [STPProduct decodedObjectFromAPIResponse:[self productResponse]],
+                                                      ];
+    NSData *data = [STPModelArchive archivedDataWithObjects:objects];
+    NSError *error = nil;
+    STPModelArchive *archive = [[STPModelArchive alloc] initWithData:data error:&error];
+    XCTAssertNotNil(archive);
+    XCTAssertNil(error);
+    XCTAssertEqual(archive.count, objects.count);
+
+    NSArray<id<STPAPIResponseDecodable>> *decoded = [archive allObjects];
+    XCTAssertEqual(decoded.count, objects.count);
+    for (NSUInteger i = 0; i < objects.count; i++) {
+        XCTAssertEqual([decoded[i] class], [objects[i] class]);
+        XCTAssertEqualObjects(decoded[i].allResponseFields, objects[i].allResponseFields);
+    }
+    XCTAssertEqualObjects(((STPCustomer *)decoded[0]).stripeID, ((STPCustomer *)objects[0]).stripeID);
+    XCTAssertEqualObjects(((STPSource *)decoded[2]).stripeID, ((STPSource *)objects[2]).stripeID);
+    XCTAssertEqualObjects(((STPProduct *)decoded[5]).prodId, @"prod_123");
+}
+
+- (void)testObjectAtIndex {
+    NSArray<STPSource *> *sources = [self sourcesWithCount:10];
+    STPModelArchive *archive = [[STPModelArchive alloc] initWithData:[STPModelArchive archivedDataWithObjects:sources] error:nil];
+
+    STPSource *source = (STPSource *)[archive objectAtIndex:7];
+    XCTAssertEqualObjects(source.stripeID, @"src_7");
+    XCTAssertNil([archive objectAtIndex:10]);
+}
+
+- (void)testStringsAreSharedBetweenObjects {
+    STPModelArchive *archive = [[STPModelArchive alloc] initWithData:[STPModelArchive archivedDataWithObjects:[self sourcesWithCount:2]] error:nil];
+
+    NSDictionary *first = [archive objectAtIndex:0].allResponseFields;
+    NSDictionary *second = [archive objectAtIndex:1].allResponseFields;
+    XCTAssertEqualObjects(first[@"type"], @"card");
+    XCTAssertEqual(first[@"type"], second[@"type"]);
+    XCTAssertEqual(first.allKeys.count, second.allKeys.count);
+    XCTAssertNotEqualObjects(first[@"id"], second[@"id"]);
+}
+
+- (void)testUnsupportedObjectsAreLeftOut {
+    NSArray *objects = @[[STPFixtures cardSource], [STPFixtures cardToken]];
+    STPModelArchive *archive = [[STPModelArchive alloc] initWithData:[STPModelArchive archivedDataWithObjects:objects] error:nil];
+    XCTAssertEqual(archive.count, 1U);
+}
+
+- (void)testRejectsInvalidData {
+    NSData *data = [STPModelArchive archivedDataWithObjects:@[[STPFixtures cardSource]]];
+    NSError *error = nil;
+
+    NSMutableData *badMagic = [data mutableCopy];
+    ((uint8_t *)badMagic.mutableBytes)[0] = 'X';
+    XCTAssertNil([[STPModelArchive alloc] initWithData:badMagic error:&error]);
+    XCTAssertEqualObjects(error.domain, StripeDomain);
+
+    error = nil;
+    XCTAssertNil([[STPModelArchive alloc] initWithData:[data subdataWithRange:NSMakeRange(0, 10)] error:&error]);
+    XCTAssertNotNil(error);
+
+    error = nil;
+    XCTAssertNil([[STPModelArchive alloc] initWithData:[NSData data] error:&error]);
+    XCTAssertNotNil(error);
+}
+
+- (void)testRejectsOtherAPIVersion {
+    NSData *data = [STPModelArchive archivedDataWithObjects:@[[STPFixtures cardSource]]];
+    NSData *version = [[STPAPIClient apiVersion] dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableData *otherVersion = [data mutableCopy];
+    NSRange versionRange = [otherVersion rangeOfData:version options:0 range:NSMakeRange(0, otherVersion.length)];
+    XCTAssertNotEqual(versionRange.location, (NSUInteger)NSNotFound);
+    ((uint8_t *)otherVersion.mutableBytes)[versionRange.location] = '1';
+
+    NSError *error = nil;
+    XCTAssertNil([[STPModelArchive alloc] initWithData:otherVersion error:&error]);
+    XCTAssertNotNil(error);
+}
+
+- (void)testCorruptEntryDecodesToNil {
+    NSData *data = [STPModelArchive archivedDataWithObjects:@[[STPFixtures cardSource]]];
+    NSMutableData *corrupt = [data mutableCopy];
+    // 0xFF is neither a value type nor valid UTF-8
+    memset((uint8_t *)corrupt.mutableBytes + corrupt.length - 16, 0xFF, 16);
+
+    STPModelArchive *archive = [[STPModelArchive alloc] initWithData:corrupt error:nil];
+    XCTAssertEqual(archive.count, 1U);
+    XCTAssertNil([archive objectAtIndex:0]);
+    XCTAssertEqual([archive allObjects].count, 0U);
+}
+
+- (void)testFileRoundTrip {
+    NSURL *url = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    NSData *data = [STPModelArchive archivedDataWithObjects:[self sourcesWithCount:3]];
+    XCTAssertTrue([data writeToURL:url atomically:YES]);
+
+    NSError *error = nil;
+    STPModelArchive *archive = [[STPModelArchive alloc] initWithContentsOfURL:url error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqual([archive allObjects].count, 3U);
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+
+    error = nil;
+    XCTAssertNil([[STPModelArchive alloc] initWithContentsOfURL:url error:&error]);
+    XCTAssertNotNil(error);
+}
+
+#pragma mark - Performance
+
+- (void)testPerformanceOfLoadingFromJSON {
+    NSData *json = [self JSONDataForSources:[self sourcesWithCount:500]];
+
+    [self measureBlock:^{
+        [self loadSourcesFromJSONData:json];
+    }];
+}
+
+- (void)testPerformanceOfLoadingFromArchive {
+    NSData *data = [STPModelArchive archivedDataWithObjects:[self sourcesWithCount:500]];
+
+    [self measureBlock:^{
+        [self loadObjectsFromArchiveData:data];
+    }];
+}
+
+- (void)testLoadingFromArchiveIsFasterThanJSON {
+    NSArray<STPSource *> *sources = [self sourcesWithCount:500];
+    NSData *json = [self JSONDataForSources:sources];
+    NSData *data = [STPModelArchive archivedDataWithObjects:sources];
+
+    CFTimeInterval jsonTime = [self bestTimeOfBlock:^{
+        [self loadSourcesFromJSONData:json];
+    }];
+    CFTimeInterval archiveTime = [self bestTimeOfBlock:^{
+        [self loadObjectsFromArchiveData:data];
+    }];
+    XCTAssertLessThanOrEqual(archiveTime, jsonTime * ArchiveToJSONLoadTimeRatio,
+                             @"archive: %.2fms, JSON: %.2fms", archiveTime * 1000, jsonTime * 1000);
+}
+
+@end
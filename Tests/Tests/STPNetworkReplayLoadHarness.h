@@ -0,0 +1,141 @@
+//
+//  STPNetworkReplayLoadHarness.h
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The kinds of STPAPIClient operations the load harness can drive.
+ */
+typedef NS_ENUM(NSUInteger, STPReplayOperationKind) {
+    /**
+     `createTokenWithCard:completion:`, served from
+     `STPCardFunctionalTest/testCreateCardToken`.
+     */
+    STPReplayOperationKindToken,
+    /**
+     `retrieveSourceWithId:clientSecret:completion:`, served from
+     `STPSourceFunctionalTest/testRetrieveSourcesofort`.
+     */
+    STPReplayOperationKindSource,
+    /**
+     `retrieveCustomerUsingKey:completion:`, served from the `Customer` JSON
+     fixture (there is no recorded customer traffic).
+     */
+    STPReplayOperationKindCustomer,
+    /**
+     `retrievePaymentIntentWithClientSecret:completion:`, served from
+     `STPPaymentIntentFunctionalTest/testRetrievePreviousCreatedPaymentIntent`.
+     */
+    STPReplayOperationKindPaymentIntent,
+};
+
+/**
+ Knobs for a single load run.
+ */
+@interface STPNetworkReplayLoadConfiguration : NSObject
+
+/**
+ Total number of operations to perform. Defaults to 100.
+ */
+@property (nonatomic) NSUInteger operationCount;
+
+/**
+ How many operations may be in flight at once. Defaults to 10. The SDK's
+ shared `STPAPIOperationQueue` is widened to match for the run, so that its
+ limit doesn't cap the load instead.
+ */
+@property (nonatomic) NSUInteger maxConcurrentOperations;
+
+/**
+ The kinds of operations to perform, as boxed `STPReplayOperationKind` values.
+ Operations are assigned round-robin. Defaults to all kinds.
+ */
+@property (nonatomic, copy) NSArray<NSNumber *> *operationKinds;
+
+/**
+ Base latency added to every stubbed response, in seconds. Defaults to 0.05.
+ */
+@property (nonatomic) NSTimeInterval latency;
+
+/**
+ Maximum extra latency added to each response, drawn uniformly from
+ [0, jitter]. Defaults to 0.
+ */
+@property (nonatomic) NSTimeInterval jitter;
+
+/**
+ Fraction (0-1) of requests that fail with `NSURLErrorNetworkConnectionLost`.
+ Defaults to 0.
+ */
+@property (nonatomic) double connectionErrorRate;
+
+/**
+ Fraction (0-1) of requests that are answered with an HTTP 500.
+ Defaults to 0.
+ */
+@property (nonatomic) double serverErrorRate;
+
+/**
+ `STPAPIClient.maxRetryCount` for the run, applied to the shared client too
+ (customer requests use its settings). Defaults to the client's default.
+ */
+@property (nonatomic) NSUInteger maxRetryCount;
+
+@end
+
+/**
+ The results of a load run.
+ */
+@interface STPNetworkReplayLoadReport : NSObject
+
+@property (nonatomic, readonly) NSUInteger operationCount;
+@property (nonatomic, readonly) NSUInteger failureCount;
+/**
+ Wall-clock duration of the run, in seconds.
+ */
+@property (nonatomic, readonly) NSTimeInterval duration;
+/**
+ Completed operations per second.
+ */
+@property (nonatomic, readonly) double throughput;
+@property (nonatomic, readonly) NSTimeInterval p50Latency;
+@property (nonatomic, readonly) NSTimeInterval p99Latency;
+/**
+ Total time the main run loop was late by more than one frame while the run
+ was in progress, in seconds.
+ */
+@property (nonatomic, readonly) NSTimeInterval mainThreadBlockedTime;
+/**
+ Highest physical memory footprint sampled during the run, in bytes.
+ */
+@property (nonatomic, readonly) uint64_t peakMemoryFootprint;
+
+@end
+
+/**
+ Serves the `recorded_network_traffic` fixtures from an in-process HTTP stand-in
+ (via OHHTTPStubs) with configurable latency, jitter and error injection, and
+ drives an STPAPIClient with many concurrent operations against it.
+
+ Create a harness, call `runWithCompletion:` from the main thread, and wait
+ for the completion to be called. Stubs are installed for the duration of the
+ run only.
+ */
+@interface STPNetworkReplayLoadHarness : NSObject
+
+- (instancetype)initWithConfiguration:(STPNetworkReplayLoadConfiguration *)configuration;
+
+@property (nonatomic, readonly) STPNetworkReplayLoadConfiguration *configuration;
+
+- (void)runWithCompletion:(void (^)(STPNetworkReplayLoadReport *report))completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
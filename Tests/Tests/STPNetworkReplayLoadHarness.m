@@ -0,0 +1,428 @@
+//
+//  STPNetworkReplayLoadHarness.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <mach/mach.h>
+#import <OHHTTPStubs/OHHTTPStubs.h>
+#import <QuartzCore/QuartzCore.h>
+#import <Stripe/Stripe.h>
+
+#import "STPNetworkReplayLoadHarness.h"
+
+#import "STPAPIClient+Private.h"
+#import "STPAPIOperationQueue.h"
+#import "STPFixtures.h"
+#import "STPTestUtils.h"
+
+static NSString * const RecordedTrafficDirectory = @"recorded_network_traffic";
+static NSString * const ReplayPublishableKey = @"pk_test_vOo1umqsYxSrP5UXfOeL3ecm";
+static NSString * const ReplaySourceID = @"src_1DaIA7BbvEcIpqUbxjjijxR9";
+static NSString * const ReplaySourceClientSecret = @"src_client_secret_replay";
+static NSString * const ReplayPaymentIntentClientSecret = @"pi_1ChlnaIl4IdHmuTbVnM2HCCf_secret_0T6n3wuf21l04Jun2ZCOB8rOZ";
+static const NSTimeInterval MainThreadProbeInterval = 1.0 / 60.0;
+static const NSTimeInterval MemoryProbeInterval = 0.01;
+
+#pragma mark - Recording
+
+/**
+ A single request/response pair parsed from a Mocktail (`.tail`) file.
+ */
+@interface STPReplayRecording : NSObject
+
+@property (nonatomic, copy) NSString *method;
+@property (nonatomic) NSRegularExpression *pathExpression;
+@property (nonatomic) int statusCode;
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *headers;
+@property (nonatomic) NSData *body;
+
++ (nullable instancetype)recordingWithContentsOfURL:(NSURL *)url;
++ (instancetype)recordingWithMethod:(NSString *)method pathPattern:(NSString *)pattern JSON:(NSDictionary *)json;
+- (BOOL)matchesRequest:(NSURLRequest *)request;
+
+@end
+
+@implementation STPReplayRecording
+
++ (instancetype)recordingWithContentsOfURL:(NSURL *)url {
+    NSString *contents = [NSString stringWithContentsOfURL:url encoding:NSUTF8StringEncoding error:NULL];
+    if (!contents) {
+        return nil;
+    }
+    // Mocktail layout: method, path regex, status, content type, headers, blank line, body
+    NSRange separator = [contents rangeOfString:@"\n\n"];
+    if (separator.location == NSNotFound) {
+        return nil;
+    }
+    NSArray<NSString *> *lines = [[contents substringToIndex:separator.location] componentsSeparatedByString:@"\n"];
+    if (lines.count < 4) {
+        return nil;
+    }
+
+    STPReplayRecording *recording = [self new];
+    recording.method = lines[0];
+    recording.pathExpression = [NSRegularExpression regularExpressionWithPattern:lines[1] options:(NSRegularExpressionOptions)0 error:NULL];
+    recording.statusCode = [lines[2] intValue];
+
+    NSMutableDictionary *headers = [NSMutableDictionary dictionary];
+    headers[@"Content-Type"] = lines[3];
+    for (NSUInteger idx = 4; idx < lines.count; idx++) {
+        NSRange colon = [lines[idx] rangeOfString:@": "];
+        if (colon.location != NSNotFound) {
+            NSString *key = [lines[idx] substringToIndex:colon.location];
+            // The body length changes with re-encoding, let the URL loading system compute it
+            if (![key isEqualToString:@"Content-Length"]) {
+                headers[key] = [lines[idx] substringFromIndex:NSMaxRange(colon)];
+            }
+        }
+    }
+    recording.headers = headers;
+    recording.body = [[contents substringFromIndex:NSMaxRange(separator)] dataUsingEncoding:NSUTF8StringEncoding];
+    return recording.pathExpression ? recording : nil;
+}
+
++ (instancetype)recordingWithMethod:(NSString *)method pathPattern:(NSString *)pattern JSON:(NSDictionary *)json {
+    STPReplayRecording *recording = [self new];
+    recording.method = method;
+    recording.pathExpression = [NSRegularExpression regularExpressionWithPattern:pattern options:(NSRegularExpressionOptions)0 error:NULL];
+    recording.statusCode = 200;
+    recording.headers = @{@"Content-Type": @"application/json"};
+    recording.body = [NSJSONSerialization dataWithJSONObject:json options:(NSJSONWritingOptions)kNilOptions error:NULL];
+    return recording;
+}
+
+- (BOOL)matchesRequest:(NSURLRequest *)request {
+    if (![request.HTTPMethod isEqualToString:self.method]) {
+        return NO;
+    }
+    NSString *absoluteURL = request.URL.absoluteString;
+    return [self.pathExpression firstMatchInString:absoluteURL options:(NSMatchingOptions)0 range:NSMakeRange(0, absoluteURL.length)] != nil;
+}
+
+@end
+
+#pragma mark - Configuration
+
+@implementation STPNetworkReplayLoadConfiguration
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _operationCount = 100;
+        _maxConcurrentOperations = 10;
+        _operationKinds = @[@(STPReplayOperationKindToken),
+                            @(STPReplayOperationKindSource),
+                            @(STPReplayOperationKindCustomer),
+                            @(STPReplayOperationKindPaymentIntent)];
+        _latency = 0.05;
+        _maxRetryCount = [STPAPIClient new].maxRetryCount;
+    }
+    return self;
+}
+
+@end
+
+#pragma mark - Report
+
+@interface STPNetworkReplayLoadReport ()
+
+@property (nonatomic, readwrite) NSUInteger operationCount;
+@property (nonatomic, readwrite) NSUInteger failureCount;
+@property (nonatomic, readwrite) NSTimeInterval duration;
+@property (nonatomic, readwrite) double throughput;
+@property (nonatomic, readwrite) NSTimeInterval p50Latency;
+@property (nonatomic, readwrite) NSTimeInterval p99Latency;
+@property (nonatomic, readwrite) NSTimeInterval mainThreadBlockedTime;
+@property (nonatomic, readwrite) uint64_t peakMemoryFootprint;
+
+@end
+
+@implementation STPNetworkReplayLoadReport
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %lu ops (%lu failed) in %.3fs, %.1f ops/s, p50 %.1fms, p99 %.1fms, main thread blocked %.1fms, peak footprint %.1fMB>",
+            NSStringFromClass([self class]),
+            (unsigned long)self.operationCount,
+            (unsigned long)self.failureCount,
+            self.duration,
+            self.throughput,
+            self.p50Latency * 1000,
+            self.p99Latency * 1000,
+            self.mainThreadBlockedTime * 1000,
+            self.peakMemoryFootprint / (1024.0 * 1024.0)];
+}
+
+@end
+
+#pragma mark - Harness
+
+@interface STPNetworkReplayLoadHarness ()
+
+@property (nonatomic, readwrite) STPNetworkReplayLoadConfiguration *configuration;
+@property (nonatomic) NSArray<STPReplayRecording *> *recordings;
+@property (nonatomic) STPAPIClient *apiClient;
+@property (nonatomic) id<OHHTTPStubsDescriptor> stub;
+@property (nonatomic) NSUInteger sharedClientMaxRetryCount;
+@property (nonatomic) NSUInteger sharedQueueMaxConcurrentOperationCount;
+
+// Run state, only touched on the main thread
+@property (nonatomic) NSUInteger nextOperationIndex;
+@property (nonatomic) NSUInteger inFlightCount;
+@property (nonatomic) NSUInteger failureCount;
+@property (nonatomic) NSMutableArray<NSNumber *> *latencies;
+@property (nonatomic) CFTimeInterval startTime;
+@property (nonatomic) NSTimer *mainThreadProbe;
+@property (nonatomic) CFTimeInterval lastProbeTime;
+@property (nonatomic) NSTimeInterval mainThreadBlockedTime;
+@property (nonatomic, copy) void (^completion)(STPNetworkReplayLoadReport *);
+
+// Memory sampling, only touched on memoryQueue
+@property (nonatomic) dispatch_queue_t memoryQueue;
+@property (nonatomic) dispatch_source_t memoryTimer;
+@property (nonatomic) uint64_t peakMemoryFootprint;
+
+@end
+
+@implementation STPNetworkReplayLoadHarness
+
+- (instancetype)initWithConfiguration:(STPNetworkReplayLoadConfiguration *)configuration {
+    self = [super init];
+    if (self) {
+        _configuration = configuration;
+        _memoryQueue = dispatch_queue_create("com.stripe.tests.replayload.memory", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+#pragma mark Stubs
+
+- (NSArray<STPReplayRecording *> *)loadRecordings {
+    NSArray<NSString *> *recordingPaths = @[
+                                            @"STPCardFunctionalTest/testCreateCardToken",
+                                            @"STPSourceFunctionalTest/testRetrieveSourcesofort",
+                                            @"STPPaymentIntentFunctionalTest/testRetrievePreviousCreatedPaymentIntent",
+                                            ];
+    NSBundle *bundle = [NSBundle bundleForClass:[self class]];
+    NSMutableArray *recordings = [NSMutableArray array];
+    for (NSString *recordingPath in recordingPaths) {
+        NSURL *directory = [bundle URLForResource:[RecordedTrafficDirectory stringByAppendingPathComponent:recordingPath] withExtension:nil];
+        NSArray<NSURL *> *files = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:directory
+                                                                includingPropertiesForKeys:nil
+                                                                                   options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                                     error:NULL];
+        for (NSURL *file in files) {
+            STPReplayRecording *recording = [STPReplayRecording recordingWithContentsOfURL:file];
+            if (recording) {
+                [recordings addObject:recording];
+            }
+        }
+    }
+    [recordings addObject:[STPReplayRecording recordingWithMethod:@"GET"
+                                                      pathPattern:@"/v1/customers/[^/?]+$"
+                                                             JSON:[STPTestUtils jsonNamed:STPTestJSONCustomer]]];
+    return recordings;
+}
+
+- (void)installStubs {
+    self.recordings = [self loadRecordings];
+    NSArray<STPReplayRecording *> *recordings = self.recordings;
+    STPNetworkReplayLoadConfiguration *configuration = self.configuration;
+
+    self.stub = [OHHTTPStubs stubRequestsPassingTest:^BOOL(__unused NSURLRequest *request) {
+        return YES;
+    } withStubResponse:^OHHTTPStubsResponse *(NSURLRequest *request) {
+        NSTimeInterval responseTime = configuration.latency + configuration.jitter * arc4random_uniform(UINT32_MAX) / (double)UINT32_MAX;
+        double roll = arc4random_uniform(UINT32_MAX) / (double)UINT32_MAX;
+
+        OHHTTPStubsResponse *response = nil;
+        if (roll < configuration.connectionErrorRate) {
+            response = [OHHTTPStubsResponse responseWithError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil]];
+        }
+        else if (roll < configuration.connectionErrorRate + configuration.serverErrorRate) {
+            NSData *body = [@"{\"error\":{\"type\":\"api_error\",\"message\":\"Injected failure\"}}" dataUsingEncoding:NSUTF8StringEncoding];
+            response = [OHHTTPStubsResponse responseWithData:body statusCode:500 headers:@{@"Content-Type": @"application/json"}];
+        }
+        else {
+            for (STPReplayRecording *recording in recordings) {
+                if ([recording matchesRequest:request]) {
+                    response = [OHHTTPStubsResponse responseWithData:recording.body statusCode:recording.statusCode headers:recording.headers];
+                    break;
+                }
+            }
+        }
+        if (!response) {
+            response = [OHHTTPStubsResponse responseWithError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorResourceUnavailable userInfo:nil]];
+        }
+        return [response requestTime:0 responseTime:responseTime];
+    }];
+}
+
+- (void)removeStubs {
+    if (self.stub) {
+        [OHHTTPStubs removeStub:self.stub];
+        self.stub = nil;
+    }
+}
+
+#pragma mark Run
+
+- (void)runWithCompletion:(void (^)(STPNetworkReplayLoadReport *))completion {
+    NSCAssert([NSThread isMainThread], @"The load harness must be started from the main thread");
+    NSCAssert(self.completion == nil, @"The load harness is already running");
+    [self installStubs];
+
+    self.apiClient = [[STPAPIClient alloc] initWithPublishableKey:ReplayPublishableKey];
+    self.apiClient.maxRetryCount = self.configuration.maxRetryCount;
+    self.sharedClientMaxRetryCount = [STPAPIClient sharedClient].maxRetryCount;
+    [STPAPIClient sharedClient].maxRetryCount = self.configuration.maxRetryCount;
+    self.sharedQueueMaxConcurrentOperationCount = [STPAPIOperationQueue sharedQueue].maxConcurrentOperationCount;
+    [STPAPIOperationQueue sharedQueue].maxConcurrentOperationCount = MAX(self.configuration.maxConcurrentOperations, self.sharedQueueMaxConcurrentOperationCount);
+    self.completion = completion;
+    self.nextOperationIndex = 0;
+    self.inFlightCount = 0;
+    self.failureCount = 0;
+    self.latencies = [NSMutableArray arrayWithCapacity:self.configuration.operationCount];
+    self.mainThreadBlockedTime = 0;
+    self.peakMemoryFootprint = 0;
+    [self startProbes];
+
+    self.startTime = CACurrentMediaTime();
+    [self scheduleOperations];
+}
+
+- (void)scheduleOperations {
+    while (self.inFlightCount < MAX(self.configuration.maxConcurrentOperations, (NSUInteger)1)
+           && self.nextOperationIndex < self.configuration.operationCount) {
+        NSUInteger index = self.nextOperationIndex++;
+        NSArray<NSNumber *> *kinds = self.configuration.operationKinds;
+        STPReplayOperationKind kind = (STPReplayOperationKind)[kinds[index % kinds.count] unsignedIntegerValue];
+        self.inFlightCount++;
+
+        CFTimeInterval operationStart = CACurrentMediaTime();
+        [self performOperationOfKind:kind completion:^(BOOL success) {
+            [self.latencies addObject:@(CACurrentMediaTime() - operationStart)];
+            if (!success) {
+                self.failureCount++;
+            }
+            self.inFlightCount--;
+            [self scheduleOperations];
+        }];
+    }
+
+    if (self.inFlightCount == 0 && self.nextOperationIndex >= self.configuration.operationCount) {
+        [self finish];
+    }
+}
+
+- (void)performOperationOfKind:(STPReplayOperationKind)kind completion:(void (^)(BOOL success))completion {
+    switch (kind) {
+        case STPReplayOperationKindToken: {
+            [self.apiClient createTokenWithCard:[STPFixtures cardParams] completion:^(STPToken *token, __unused NSError *error) {
+                completion(token != nil);
+            }];
+            break;
+        }
+        case STPReplayOperationKindSource: {
+            [self.apiClient retrieveSourceWithId:ReplaySourceID clientSecret:ReplaySourceClientSecret completion:^(STPSource *source, __unused NSError *error) {
+                completion(source != nil);
+            }];
+            break;
+        }
+        case STPReplayOperationKindCustomer: {
+            [STPAPIClient retrieveCustomerUsingKey:[STPFixtures ephemeralKey] completion:^(STPCustomer *customer, __unused NSError *error) {
+                completion(customer != nil);
+            }];
+            break;
+        }
+        case STPReplayOperationKindPaymentIntent: {
+            [self.apiClient retrievePaymentIntentWithClientSecret:ReplayPaymentIntentClientSecret completion:^(STPPaymentIntent *paymentIntent, __unused NSError *error) {
+                completion(paymentIntent != nil);
+            }];
+            break;
+        }
+    }
+}
+
+- (void)finish {
+    NSTimeInterval duration = CACurrentMediaTime() - self.startTime;
+    [self stopProbes];
+    [self removeStubs];
+    [STPAPIClient sharedClient].maxRetryCount = self.sharedClientMaxRetryCount;
+    [STPAPIOperationQueue sharedQueue].maxConcurrentOperationCount = self.sharedQueueMaxConcurrentOperationCount;
+
+    NSArray<NSNumber *> *sortedLatencies = [self.latencies sortedArrayUsingSelector:@selector(compare:)];
+    STPNetworkReplayLoadReport *report = [STPNetworkReplayLoadReport new];
+    report.operationCount = sortedLatencies.count;
+    report.failureCount = self.failureCount;
+    report.duration = duration;
+    report.throughput = duration > 0 ? sortedLatencies.count / duration : 0;
+    report.p50Latency = [self percentile:0.50 ofSortedValues:sortedLatencies];
+    report.p99Latency = [self percentile:0.99 ofSortedValues:sortedLatencies];
+    report.mainThreadBlockedTime = self.mainThreadBlockedTime;
+    dispatch_sync(self.memoryQueue, ^{
+        report.peakMemoryFootprint = self.peakMemoryFootprint;
+    });
+
+    void (^completion)(STPNetworkReplayLoadReport *) = self.completion;
+    self.completion = nil;
+    completion(report);
+}
+
+- (NSTimeInterval)percentile:(double)percentile ofSortedValues:(NSArray<NSNumber *> *)values {
+    if (values.count == 0) {
+        return 0;
+    }
+    NSUInteger index = (NSUInteger)ceil(percentile * values.count) - 1;
+    return [values[MIN(index, values.count - 1)] doubleValue];
+}
+
+#pragma mark Probes
+
+- (void)startProbes {
+    // A main run loop timer that fires late means something blocked the main thread
+    self.lastProbeTime = CACurrentMediaTime();
+    self.mainThreadProbe = [NSTimer timerWithTimeInterval:MainThreadProbeInterval target:self selector:@selector(mainThreadProbeFired) userInfo:nil repeats:YES];
+    [[NSRunLoop mainRunLoop] addTimer:self.mainThreadProbe forMode:NSRunLoopCommonModes];
+
+    self.memoryTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.memoryQueue);
+    dispatch_source_set_timer(self.memoryTimer, DISPATCH_TIME_NOW, (uint64_t)(MemoryProbeInterval * NSEC_PER_SEC), NSEC_PER_MSEC);
+    __weak typeof(self) weakSelf = self;
+    dispatch_source_set_event_handler(self.memoryTimer, ^{
+        typeof(self) strongSelf = weakSelf;
+        strongSelf.peakMemoryFootprint = MAX(strongSelf.peakMemoryFootprint, [[strongSelf class] currentMemoryFootprint]);
+    });
+    dispatch_resume(self.memoryTimer);
+}
+
+- (void)stopProbes {
+    [self.mainThreadProbe invalidate];
+    self.mainThreadProbe = nil;
+    [self mainThreadProbeFired];
+
+    dispatch_source_cancel(self.memoryTimer);
+    self.memoryTimer = nil;
+    dispatch_sync(self.memoryQueue, ^{
+        self.peakMemoryFootprint = MAX(self.peakMemoryFootprint, [[self class] currentMemoryFootprint]);
+    });
+}
+
+- (void)mainThreadProbeFired {
+    CFTimeInterval now = CACurrentMediaTime();
+    NSTimeInterval lateness = (now - self.lastProbeTime) - MainThreadProbeInterval;
+    if (lateness > MainThreadProbeInterval) {
+        self.mainThreadBlockedTime += lateness;
+    }
+    self.lastProbeTime = now;
+}
+
++ (uint64_t)currentMemoryFootprint {
+    task_vm_info_data_t info;
+    mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+    kern_return_t result = task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count);
+    return result == KERN_SUCCESS ? info.phys_footprint : 0;
+}
+
+@end
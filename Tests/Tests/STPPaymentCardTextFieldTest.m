@@ -411,6 +411,25 @@
     XCTAssertNotEqualObjects(@"Apt 3", sut.cardParams.address.line2, @"caller changed their copy after setCardParams:");
 }
 
+- (void)testPostalCodeCountryDefaultsToLocale {
+    STPPaymentCardTextField *sut = [STPPaymentCardTextField new];
+    sut.postalCodeEntryEnabled = YES;
+    XCTAssertEqualObjects(sut.countryCode, [[NSLocale autoupdatingCurrentLocale] objectForKey:NSLocaleCountryCode]);
+    XCTAssertTrue(sut.viewModel.postalCodeCountryCodeIsDefault);
+
+    // The locale's country doesn't have to be the card's, so any postal code goes
+    sut.viewModel.postalCodeCountryCode = @"GB";
+    sut.viewModel.postalCode = @"75001";
+    XCTAssertEqual([sut.viewModel validationStateForField:STPCardFieldTypePostalCode], STPCardValidationStateValid);
+
+    sut.countryCode = @"GB";
+    XCTAssertFalse(sut.viewModel.postalCodeCountryCodeIsDefault);
+    XCTAssertEqual([sut.viewModel validationStateForField:STPCardFieldTypePostalCode], STPCardValidationStateInvalid);
+
+    sut.countryCode = nil;
+    XCTAssertTrue(sut.viewModel.postalCodeCountryCodeIsDefault);
+}
+
 @end
 
 @interface STPPaymentCardTextFieldUITests : XCTestCase
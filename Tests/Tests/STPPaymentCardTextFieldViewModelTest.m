@@ -8,7 +8,10 @@
 
 @import XCTest;
 
+#import <OCMock/OCMock.h>
+
 #import "Stripe.h"
+#import "STPBINRange.h"
 #import "STPPaymentCardTextFieldViewModel.h"
 
 @interface STPPaymentCardTextFieldViewModelTest : XCTestCase
@@ -112,4 +115,82 @@
     XCTAssertEqualObjects(self.viewModel.compressedCardNumber, @"930902");
 }
 
+- (void)testBINLookupsPerTypedDigit {
+    __block NSUInteger lookupCount = 0;
+    id binRangeMock = OCMClassMock([STPBINRange class]);
+    OCMStub([binRangeMock binRangesForNumber:[OCMArg any]])
+    .andDo(^(__unused NSInvocation *invocation) {
+        lookupCount++;
+    })
+    .andForwardToRealObject();
+
+    NSString *number = @"4242424242424242";
+    NSUInteger prefixLength = [STPBINRange maxPrefixLength];
+    for (NSUInteger length = 1; length <= number.length; length++) {
+        lookupCount = 0;
+        self.viewModel.cardNumber = [number substringToIndex:length];
+
+        // Reading state is free, however often the text field asks
+        XCTAssertEqual(self.viewModel.brand, STPCardBrandVisa);
+        [self.viewModel validationStateForField:STPCardFieldTypeNumber];
+        [self.viewModel validationStateForField:STPCardFieldTypeCVC];
+        [self.viewModel isValid];
+
+        // Only digits within the BIN prefix can change the matching ranges
+        XCTAssertEqual(lookupCount, (length <= prefixLength) ? 1U : 0U, @"%lu digits", (unsigned long)length);
+    }
+    XCTAssertEqual([self.viewModel validationStateForField:STPCardFieldTypeNumber], STPCardValidationStateValid);
+
+    // Deleting a trailing digit outside the prefix doesn't need a lookup either
+    lookupCount = 0;
+    self.viewModel.cardNumber = [number substringToIndex:number.length - 1];
+    XCTAssertEqual(lookupCount, 0U);
+    XCTAssertEqual([self.viewModel validationStateForField:STPCardFieldTypeNumber], STPCardValidationStateIncomplete);
+
+    [binRangeMock stopMocking];
+}
+
+- (void)testCachedStateMatchesValidator {
+    NSArray<NSString *> *numbers = @[@"", @"4", @"41", @"4136000000008", @"4136000000000",
+                                     @"378282246310005", @"3782822463100050", @"6011111111111117",
+                                     @"30569309025904", @"5555555555554444", @"1234567812345678"];
+    for (NSString *number in numbers) {
+        self.viewModel.cardNumber = number;
+        XCTAssertEqual(self.viewModel.brand, [STPCardValidator brandForNumber:self.viewModel.cardNumber], @"%@", number);
+        XCTAssertEqual([self.viewModel validationStateForField:STPCardFieldTypeNumber],
+                       [STPCardValidator validationStateForNumber:self.viewModel.cardNumber validatingCardBrand:YES], @"%@", number);
+    }
+
+    // The CVC state follows brand changes
+    self.viewModel.cardNumber = nil;
+    self.viewModel.cvc = @"1234";
+    XCTAssertEqual([self.viewModel validationStateForField:STPCardFieldTypeCVC], STPCardValidationStateValid);
+    self.viewModel.cardNumber = @"4242";
+    XCTAssertEqual([self.viewModel validationStateForField:STPCardFieldTypeCVC], STPCardValidationStateInvalid);
+    self.viewModel.cardNumber = @"3782";
+    XCTAssertEqual([self.viewModel validationStateForField:STPCardFieldTypeCVC], STPCardValidationStateValid);
+}
+
+- (void)testPostalCodeForDefaultCountry {
+    // A French card used on a device set to the UK
+    self.viewModel.postalCodeCountryCode = @"GB";
+    self.viewModel.postalCodeCountryCodeIsDefault = YES;
+    self.viewModel.postalCode = @"75001";
+    XCTAssertEqualObjects(self.viewModel.postalCode, @"75001");
+    XCTAssertEqual([self.viewModel validationStateForField:STPCardFieldTypePostalCode], STPCardValidationStateValid);
+    self.viewModel.postalCode = @"";
+    XCTAssertEqual([self.viewModel validationStateForField:STPCardFieldTypePostalCode], STPCardValidationStateIncomplete);
+
+    // Once the country is set explicitly, the postal code has to fit it
+    self.viewModel.postalCode = @"75001";
+    self.viewModel.postalCodeCountryCodeIsDefault = NO;
+    XCTAssertEqual([self.viewModel validationStateForField:STPCardFieldTypePostalCode], STPCardValidationStateInvalid);
+
+    // US ZIP codes are checked either way
+    self.viewModel.postalCodeCountryCode = @"US";
+    self.viewModel.postalCodeCountryCodeIsDefault = YES;
+    self.viewModel.postalCode = @"1234";
+    XCTAssertEqual([self.viewModel validationStateForField:STPCardFieldTypePostalCode], STPCardValidationStateIncomplete);
+}
+
 @end
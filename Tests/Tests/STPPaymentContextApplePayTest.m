@@ -14,15 +14,20 @@
 #import "STPMocks.h"
 #import "STPPaymentContext.h"
 
+static const NSTimeInterval RoundTripDuration = 0.2;
+
 @interface STPPaymentContext (Testing)
 @property (nonatomic) PKShippingMethod *selectedShippingMethod;
 - (PKPaymentRequest *)buildPaymentRequest;
+- (void)completeApplePayPaymentWithSource:(id<STPSourceProtocol>)source
+                               completion:(STPErrorBlock)completion;
 @end
 
 /**
  These tests cover STPPaymentContext's Apple Pay specific behavior:
  - building a PKPaymentRequest
  - determining paymentSummaryItems
+ - completing a payment, with and without pipelining
  */
 @interface STPPaymentContextApplePayTest : XCTestCase
 @end
@@ -196,4 +201,147 @@
     XCTAssertTrue(context.paymentAmount == 100);
 }
 
+#pragma mark - completeApplePayPaymentWithSource
+
+- (STPPaymentContext *)buildPaymentContextWithAttachError:(NSError *)attachError
+                                       paymentResultError:(NSError *)paymentResultError
+                                                  metrics:(STPApplePayPaymentMetrics * __strong *)metrics {
+    id customerContext = OCMClassMock([STPCustomerContext class]);
+    OCMStub([customerContext retrieveCustomer:[OCMArg any]]).andDo(^(NSInvocation *invocation){
+        STPCustomerCompletionBlock completion;
+        [invocation getArgument:&completion atIndex:2];
+        completion([STPFixtures customerWithSingleCardTokenSource], nil);
+    });
+    OCMStub([customerContext attachSourceToCustomer:[OCMArg any] completion:[OCMArg any]]).andDo(^(NSInvocation *invocation){
+        __unsafe_unretained STPErrorBlock unretainedCompletion;
+        [invocation getArgument:&unretainedCompletion atIndex:3];
+        STPErrorBlock completion = unretainedCompletion;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(RoundTripDuration * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            completion(attachError);
+        });
+    });
+    id delegate = OCMProtocolMock(@protocol(STPPaymentContextDelegate));
+    OCMStub([delegate paymentContext:[OCMArg any] didCreatePaymentResult:[OCMArg any] completion:[OCMArg any]]).andDo(^(NSInvocation *invocation){
+        __unsafe_unretained STPErrorBlock unretainedCompletion;
+        [invocation getArgument:&unretainedCompletion atIndex:4];
+        STPErrorBlock completion = unretainedCompletion;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(RoundTripDuration * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            completion(paymentResultError);
+        });
+    });
+    OCMStub([delegate paymentContext:[OCMArg any] didCollectApplePayMetrics:[OCMArg any]]).andDo(^(NSInvocation *invocation){
+        __unsafe_unretained STPApplePayPaymentMetrics *collectedMetrics;
+        [invocation getArgument:&collectedMetrics atIndex:3];
+        *metrics = collectedMetrics;
+    });
+
+    STPPaymentContext *context = [[STPPaymentContext alloc] initWithCustomerContext:customerContext
+                                                                      configuration:[STPFixtures paymentConfiguration]
+                                                                              theme:[STPTheme defaultTheme]];
+    context.delegate = delegate;
+    return context;
+}
+
+- (void)testCompleteApplePayPayment_sequential {
+    STPApplePayPaymentMetrics *metrics = nil;
+    STPPaymentContext *context = [self buildPaymentContextWithAttachError:nil paymentResultError:nil metrics:&metrics];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    [context completeApplePayPaymentWithSource:[STPFixtures cardSource] completion:^(NSError *error) {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    XCTAssertFalse(metrics.pipelined);
+    XCTAssertGreaterThanOrEqual(metrics.duration, 2 * RoundTripDuration);
+    XCTAssertGreaterThanOrEqual(metrics.attachDuration, RoundTripDuration);
+    XCTAssertGreaterThanOrEqual(metrics.paymentResultDuration, RoundTripDuration);
+    XCTAssertEqual(metrics.timeSaved, 0);
+}
+
+- (void)testCompleteApplePayPayment_pipelined {
+    STPApplePayPaymentMetrics *metrics = nil;
+    STPPaymentContext *context = [self buildPaymentContextWithAttachError:nil paymentResultError:nil metrics:&metrics];
+    context.pipelinesApplePayAttachment = YES;
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    [context completeApplePayPaymentWithSource:[STPFixtures cardSource] completion:^(NSError *error) {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    XCTAssertTrue(metrics.pipelined);
+    XCTAssertGreaterThanOrEqual(metrics.duration, RoundTripDuration);
+    XCTAssertLessThan(metrics.duration, 2 * RoundTripDuration);
+    XCTAssertGreaterThan(metrics.timeSaved, 0);
+    XCTAssertEqualWithAccuracy(metrics.timeSaved, metrics.attachDuration + metrics.paymentResultDuration - metrics.duration, 0.0001);
+}
+
+- (void)testCompleteApplePayPayment_pipelinedPaymentResultError {
+    NSError *chargeError = [NSError errorWithDomain:@"test" code:1 userInfo:nil];
+    STPApplePayPaymentMetrics *metrics = nil;
+    STPPaymentContext *context = [self buildPaymentContextWithAttachError:nil paymentResultError:chargeError metrics:&metrics];
+    context.pipelinesApplePayAttachment = YES;
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    [context completeApplePayPaymentWithSource:[STPFixtures cardSource] completion:^(NSError *error) {
+        XCTAssertEqualObjects(error, chargeError);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
+- (void)testCompleteApplePayPayment_pipelinedAttachErrorDoesNotFailPayment {
+    NSError *attachError = [NSError errorWithDomain:@"test" code:2 userInfo:nil];
+    STPApplePayPaymentMetrics *metrics = nil;
+    STPPaymentContext *context = [self buildPaymentContextWithAttachError:attachError paymentResultError:nil metrics:&metrics];
+    context.pipelinesApplePayAttachment = YES;
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    [context completeApplePayPaymentWithSource:[STPFixtures cardSource] completion:^(NSError *error) {
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    XCTAssertEqualObjects(metrics.attachError, attachError);
+}
+
+- (void)testCompleteApplePayPayment_sequentialAttachErrorFailsPayment {
+    NSError *attachError = [NSError errorWithDomain:@"test" code:2 userInfo:nil];
+    STPApplePayPaymentMetrics *metrics = nil;
+    STPPaymentContext *context = [self buildPaymentContextWithAttachError:attachError paymentResultError:nil metrics:&metrics];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    [context completeApplePayPaymentWithSource:[STPFixtures cardSource] completion:^(NSError *error) {
+        XCTAssertEqualObjects(error, attachError);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    XCTAssertEqualObjects(metrics.attachError, attachError);
+    // The charge is never attempted with a source that couldn't be attached
+    XCTAssertEqual(metrics.paymentResultDuration, 0);
+}
+
+- (void)testCompleteApplePayPayment_pipelinedTokenIsAttachedFirst {
+    NSError *attachError = [NSError errorWithDomain:@"test" code:2 userInfo:nil];
+    STPApplePayPaymentMetrics *metrics = nil;
+    STPPaymentContext *context = [self buildPaymentContextWithAttachError:attachError paymentResultError:nil metrics:&metrics];
+    context.pipelinesApplePayAttachment = YES;
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    [context completeApplePayPaymentWithSource:[STPFixtures cardToken] completion:^(NSError *error) {
+        XCTAssertEqualObjects(error, attachError);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    XCTAssertFalse(metrics.pipelined);
+    XCTAssertEqualObjects(metrics.attachError, attachError);
+    // The token's card is only charged once the token has been attached
+    XCTAssertEqual(metrics.paymentResultDuration, 0);
+}
+
 @end
@@ -0,0 +1,113 @@
+//
+//  STPPaymentContextPrefetchTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <OCMock/OCMock.h>
+#import <Stripe/Stripe.h>
+
+#import "STPAPIClient+Private.h"
+#import "STPEphemeralKeyManager.h"
+#import "STPFixtures.h"
+
+@interface STPCustomerContext (Testing)
+- (instancetype)initWithKeyManager:(STPEphemeralKeyManager *)keyManager;
+@end
+
+@interface STPPaymentContextPrefetchTest : XCTestCase
+@property (nonatomic) id mockAPIClient;
+@property (nonatomic) NSInteger retrieveCustomerCount;
+@end
+
+@implementation STPPaymentContextPrefetchTest
+
+- (void)setUp {
+    [super setUp];
+    STPCustomer *customer = [STPFixtures customerWithSingleCardTokenSource];
+    self.mockAPIClient = OCMClassMock([STPAPIClient class]);
+    OCMStub([self.mockAPIClient retrieveCustomerUsingKey:[OCMArg any] completion:[OCMArg any]])
+    .andDo(^(NSInvocation *invocation) {
+        STPCustomerCompletionBlock completion;
+        [invocation getArgument:&completion atIndex:3];
+        self.retrieveCustomerCount++;
+        completion(customer, nil);
+    });
+}
+
+- (void)tearDown {
+    [self.mockAPIClient stopMocking];
+    [super tearDown];
+}
+
+- (STPCustomerContext *)buildCustomerContext {
+    STPEphemeralKey *customerKey = [STPFixtures ephemeralKey];
+    id mockKeyManager = OCMClassMock([STPEphemeralKeyManager class]);
+    OCMStub([mockKeyManager getCustomerKey:[OCMArg any]])
+    .andDo(^(NSInvocation *invocation) {
+        STPEphemeralKeyCompletionBlock completion;
+        [invocation getArgument:&completion atIndex:2];
+        completion(customerKey, nil);
+    });
+    return [[STPCustomerContext alloc] initWithKeyManager:mockKeyManager];
+}
+
+- (void)testContextLoadsSynchronouslyAfterPrefetch {
+    STPCustomerContext *customerContext = [self buildCustomerContext];
+    STPPaymentConfiguration *configuration = [STPFixtures paymentConfiguration];
+    [STPPaymentContext prefetchWithCustomerContext:customerContext configuration:configuration];
+    NSInteger prefetchRetrieveCount = self.retrieveCustomerCount;
+
+    STPPaymentContext *paymentContext = [[STPPaymentContext alloc] initWithCustomerContext:customerContext
+                                                                              configuration:configuration
+                                                                                      theme:[STPTheme defaultTheme]];
+    XCTAssertFalse(paymentContext.loading);
+    XCTAssertEqual(paymentContext.paymentMethods.count, 1U);
+    XCTAssertEqual(self.retrieveCustomerCount, prefetchRetrieveCount);
+}
+
+- (void)testContextRefetchesCustomerWithoutPrefetch {
+    STPCustomerContext *customerContext = [self buildCustomerContext];
+    NSInteger retrieveCount = self.retrieveCustomerCount;
+
+    STPPaymentContext *paymentContext = [[STPPaymentContext alloc] initWithCustomerContext:customerContext
+                                                                              configuration:[STPFixtures paymentConfiguration]
+                                                                                      theme:[STPTheme defaultTheme]];
+    XCTAssertEqual(self.retrieveCustomerCount, retrieveCount + 1);
+    XCTAssertFalse(paymentContext.loading);
+}
+
+- (void)testPrefetchedCustomerIsOnlyUsedOnce {
+    STPCustomerContext *customerContext = [self buildCustomerContext];
+    STPPaymentConfiguration *configuration = [STPFixtures paymentConfiguration];
+    [STPPaymentContext prefetchWithCustomerContext:customerContext configuration:configuration];
+    NSInteger prefetchRetrieveCount = self.retrieveCustomerCount;
+
+    __unused STPPaymentContext *firstContext = [[STPPaymentContext alloc] initWithCustomerContext:customerContext
+                                                                                   configuration:configuration
+                                                                                           theme:[STPTheme defaultTheme]];
+    XCTAssertEqual(self.retrieveCustomerCount, prefetchRetrieveCount);
+    __unused STPPaymentContext *secondContext = [[STPPaymentContext alloc] initWithCustomerContext:customerContext
+                                                                                    configuration:configuration
+                                                                                            theme:[STPTheme defaultTheme]];
+    XCTAssertEqual(self.retrieveCustomerCount, prefetchRetrieveCount + 1);
+}
+
+- (void)testRetryLoadingRefetchesCustomer {
+    STPCustomerContext *customerContext = [self buildCustomerContext];
+    STPPaymentConfiguration *configuration = [STPFixtures paymentConfiguration];
+    [STPPaymentContext prefetchWithCustomerContext:customerContext configuration:configuration];
+    STPPaymentContext *paymentContext = [[STPPaymentContext alloc] initWithCustomerContext:customerContext
+                                                                              configuration:configuration
+                                                                                      theme:[STPTheme defaultTheme]];
+    NSInteger retrieveCount = self.retrieveCustomerCount;
+
+    [paymentContext retryLoading];
+    XCTAssertEqual(self.retrieveCustomerCount, retrieveCount + 1);
+    XCTAssertFalse(paymentContext.loading);
+}
+
+@end
@@ -0,0 +1,149 @@
+//
+//  STPPaymentIntentPollerTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <OHHTTPStubs/OHHTTPStubs.h>
+#import <Stripe/Stripe.h>
+
+#import "STPTestUtils.h"
+#import "STPVirtualClock.h"
+
+static NSString * const ClientSecret = @"pi_1Cl15wIl4IdHmuTbCWrpJXN6_secret_EkKtQ7Sg75hLDFKqFG8DtWcaK";
+
+@interface STPPaymentIntentPollerTest : XCTestCase
+@property (nonatomic) STPAPIClient *apiClient;
+@end
+
+@implementation STPPaymentIntentPollerTest
+
+- (void)setUp {
+    [super setUp];
+    self.apiClient = [[STPAPIClient alloc] initWithPublishableKey:@"pk_test_123"];
+}
+
+- (void)tearDown {
+    [STPClock setSharedClock:nil];
+    [OHHTTPStubs removeAllStubs];
+    [super tearDown];
+}
+
+/**
+ Replies to each PaymentIntent request with the next of `statuses`, repeating
+ the last one. Returns the requests received so far.
+ */
+- (NSMutableArray *)stubPaymentIntentWithStatuses:(NSArray<NSString *> *)statuses {
+    NSMutableArray *requests = [NSMutableArray array];
+    [OHHTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest *request) {
+        return [request.URL.path isEqualToString:@"/v1/payment_intents/pi_1Cl15wIl4IdHmuTbCWrpJXN6"];
+    } withStubResponse:^OHHTTPStubsResponse *(NSURLRequest *request) {
+        XCTAssertTrue([request.URL.query containsString:@"client_secret="]);
+        NSString *status;
+        @synchronized (requests) {
+            status = statuses[MIN(requests.count, statuses.count - 1)];
+            [requests addObject:request];
+        }
+        NSMutableDictionary *json = [[STPTestUtils jsonNamed:@"PaymentIntent"] mutableCopy];
+        json[@"status"] = status;
+        return [OHHTTPStubsResponse responseWithJSONObject:json statusCode:200 headers:nil];
+    }];
+    return requests;
+}
+
+- (void)testStopsAtTerminalStatus {
+    NSMutableArray *requests = [self stubPaymentIntentWithStatuses:@[@"succeeded"]];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"poll"];
+    [self.apiClient startPollingPaymentIntentWithClientSecret:ClientSecret timeout:10 completion:^(STPPaymentIntent *paymentIntent, NSError *error) {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertEqual(paymentIntent.status, STPPaymentIntentStatusSucceeded);
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(requests.count, 1U);
+}
+
+- (void)testPollsWhileRequiringSourceActionOrProcessing {
+    NSMutableArray *requests = [self stubPaymentIntentWithStatuses:@[@"requires_source_action", @"processing", @"requires_capture"]];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"poll"];
+    [self.apiClient startPollingPaymentIntentWithClientSecret:ClientSecret timeout:30 completion:^(STPPaymentIntent *paymentIntent, NSError *error) {
+        XCTAssertEqual(paymentIntent.status, STPPaymentIntentStatusRequiresCapture);
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    XCTAssertEqual(requests.count, 3U);
+}
+
+- (void)testTimesOutOnClockTime {
+    STPVirtualClock *clock = [STPVirtualClock new];
+    [STPClock setSharedClock:clock];
+    NSMutableArray *requests = [self stubPaymentIntentWithStatuses:@[@"processing"]];
+    NSMutableArray<STPPaymentIntent *> *results = [NSMutableArray array];
+    [self.apiClient startPollingPaymentIntentWithClientSecret:ClientSecret timeout:10 completion:^(STPPaymentIntent *paymentIntent, NSError *error) {
+        XCTAssertNil(error);
+        if (paymentIntent) {
+            [results addObject:paymentIntent];
+        }
+    }];
+
+    // Each response schedules the next poll on the clock, so no real time passes
+    NSPredicate *pollScheduled = [NSPredicate predicateWithFormat:@"scheduledTimerCount == 1"];
+    [self expectationForPredicate:pollScheduled evaluatedWithObject:clock handler:nil];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    [clock advanceBy:1.5];
+
+    [self expectationForPredicate:pollScheduled evaluatedWithObject:clock handler:nil];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    [clock advanceBy:10];
+
+    // The first response after the timeout ends polling
+    [self expectationForPredicate:[NSPredicate predicateWithFormat:@"count == 1"] evaluatedWithObject:results handler:nil];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(results.firstObject.status, STPPaymentIntentStatusProcessing);
+    XCTAssertEqual(requests.count, 3U);
+    XCTAssertEqual(clock.scheduledTimerCount, 0U);
+}
+
+- (void)testDoesNotRetryClientErrors {
+    __block NSUInteger requestCount = 0;
+    [OHHTTPStubs stubRequestsPassingTest:^BOOL(__unused NSURLRequest *request) {
+        return YES;
+    } withStubResponse:^OHHTTPStubsResponse *(__unused NSURLRequest *request) {
+        requestCount++;
+        NSDictionary *json = @{@"error": @{@"type": @"invalid_request_error", @"message": @"No such payment_intent"}};
+        return [OHHTTPStubsResponse responseWithJSONObject:json statusCode:404 headers:nil];
+    }];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"poll"];
+    [self.apiClient startPollingPaymentIntentWithClientSecret:ClientSecret timeout:10 completion:^(STPPaymentIntent *paymentIntent, NSError *error) {
+        XCTAssertNil(paymentIntent);
+        XCTAssertNotNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(requestCount, 1U);
+}
+
+- (void)testStopPolling {
+    NSMutableArray *requests = [self stubPaymentIntentWithStatuses:@[@"requires_source_action"]];
+
+    [self.apiClient startPollingPaymentIntentWithClientSecret:ClientSecret timeout:10 completion:^(__unused STPPaymentIntent *paymentIntent, __unused NSError *error) {
+        XCTFail(@"The completion block shouldn't be called after polling is stopped");
+    }];
+    NSPredicate *requested = [NSPredicate predicateWithFormat:@"count > 0"];
+    [self expectationForPredicate:requested evaluatedWithObject:requests handler:nil];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    [self.apiClient stopPollingPaymentIntentWithClientSecret:ClientSecret];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:2]];
+    XCTAssertEqual(requests.count, 1U);
+}
+
+@end
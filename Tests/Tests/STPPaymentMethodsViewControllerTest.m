@@ -8,9 +8,12 @@
 
 #import <XCTest/XCTest.h>
 #import <OCMock/OCMock.h>
+#import "STPCoreTableViewController+Private.h"
 #import "STPFixtures.h"
 #import "STPMocks.h"
+#import "STPPaymentMethodTuple.h"
 #import "STPPaymentMethodsInternalViewController.h"
+#import "STPTestUtils.h"
 
 @interface STPPaymentMethodsViewController (Testing)
 @property(nonatomic, weak)UIViewController *internalViewController;
@@ -218,4 +221,41 @@
 
 #pragma clang diagnostic pop
 
+/**
+ The internal view controller should tell its delegate when the last few cards
+ are about to be shown, so more can be loaded, and not before.
+ */
+- (void)testInternalViewControllerReportsRowsNearEndOfList {
+    NSMutableArray<STPCard *> *cards = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 10; i++) {
+        NSMutableDictionary *json = [[STPTestUtils jsonNamed:STPTestJSONCard] mutableCopy];
+        json[@"id"] = [NSString stringWithFormat:@"card_%lu", (unsigned long)i];
+        [cards addObject:[STPCard decodedObjectFromAPIResponse:json]];
+    }
+    STPPaymentMethodTuple *tuple = [STPPaymentMethodTuple tupleWithPaymentMethods:cards selectedPaymentMethod:nil];
+    id<STPPaymentMethodsInternalViewControllerDelegate> delegate = OCMProtocolMock(@protocol(STPPaymentMethodsInternalViewControllerDelegate));
+    __block NSUInteger nearEndCount = 0;
+    OCMStub([delegate internalViewControllerWillDisplayPaymentMethodsNearEnd]).andDo(^(__unused NSInvocation *invocation){
+        nearEndCount++;
+    });
+    STPPaymentMethodsInternalViewController *sut = [[STPPaymentMethodsInternalViewController alloc] initWithConfiguration:[STPFixtures paymentConfiguration]
+                                                                                                           customerContext:nil
+                                                                                                                     theme:[STPTheme defaultTheme]
+                                                                                                      prefilledInformation:nil
+                                                                                                           shippingAddress:nil
+                                                                                                        paymentMethodTuple:tuple
+                                                                                                                  delegate:delegate];
+    XCTAssertNotNil(sut.view);
+    UITableView *tableView = sut.tableView;
+    // Only count the rows shown below, not any shown while loading the view
+    nearEndCount = 0;
+
+    [tableView.delegate tableView:tableView willDisplayCell:[UITableViewCell new] forRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+    [tableView.delegate tableView:tableView willDisplayCell:[UITableViewCell new] forRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]];
+    XCTAssertEqual(nearEndCount, 0U);
+
+    [tableView.delegate tableView:tableView willDisplayCell:[UITableViewCell new] forRowAtIndexPath:[NSIndexPath indexPathForRow:9 inSection:0]];
+    XCTAssertEqual(nearEndCount, 1U);
+}
+
 @end
@@ -7,6 +7,7 @@
 //
 
 #import <XCTest/XCTest.h>
+#import "STPPhoneNumberMetadata.h"
 #import "STPPhoneNumberValidator.h"
 
 static NSString *const kUSCountryCode = @"US";
@@ -48,4 +49,122 @@ static NSString *const kUKCountryCode = @"UK";
     XCTAssertEqualObjects([STPPhoneNumberValidator formattedRedactedPhoneNumberForString:@"+86******1234" forCountryCode:kUKCountryCode], @"+86 ••••••1234");
 }
 
+- (void)testInternationalPhoneNumbers {
+    XCTAssertTrue([STPPhoneNumberValidator stringIsValidPhoneNumber:@"07700 900123" forCountryCode:@"GB"]);
+    XCTAssertTrue([STPPhoneNumberValidator stringIsValidPhoneNumber:@"020 7946 0000" forCountryCode:@"gb"]);
+    XCTAssertFalse([STPPhoneNumberValidator stringIsValidPhoneNumber:@"7700 900123" forCountryCode:@"GB"]);
+    XCTAssertFalse([STPPhoneNumberValidator stringIsValidPhoneNumber:@"07700 9001" forCountryCode:@"GB"]);
+    XCTAssertTrue([STPPhoneNumberValidator stringIsValidPhoneNumber:@"06 12 34 56 78" forCountryCode:@"FR"]);
+    XCTAssertFalse([STPPhoneNumberValidator stringIsValidPhoneNumber:@"06 12 34 56 789" forCountryCode:@"FR"]);
+    XCTAssertFalse([STPPhoneNumberValidator stringIsValidPhoneNumber:@"155-555-5555" forCountryCode:kUSCountryCode]);
+
+    XCTAssertTrue([STPPhoneNumberValidator stringIsValidPartialPhoneNumber:@"" forCountryCode:@"GB"]);
+    XCTAssertTrue([STPPhoneNumberValidator stringIsValidPartialPhoneNumber:@"077" forCountryCode:@"GB"]);
+    XCTAssertFalse([STPPhoneNumberValidator stringIsValidPartialPhoneNumber:@"77" forCountryCode:@"GB"]);
+    XCTAssertFalse([STPPhoneNumberValidator stringIsValidPartialPhoneNumber:@"077009001234" forCountryCode:@"GB"]);
+    XCTAssertTrue([STPPhoneNumberValidator stringIsValidPartialPhoneNumber:@"555-555-5555" forCountryCode:kUSCountryCode]);
+    XCTAssertFalse([STPPhoneNumberValidator stringIsValidPartialPhoneNumber:@"555-555-55555" forCountryCode:kUSCountryCode]);
+
+    // Countries we don't have metadata for accept anything
+    XCTAssertTrue([STPPhoneNumberValidator stringIsValidPhoneNumber:@"1" forCountryCode:kUKCountryCode]);
+    XCTAssertFalse([STPPhoneNumberValidator canFormatPhoneNumbersForCountryCode:kUKCountryCode]);
+    XCTAssertTrue([STPPhoneNumberValidator canFormatPhoneNumbersForCountryCode:@"GB"]);
+}
+
+- (void)testInternationalPrefix {
+    NSArray *validNumbers = @[
+                              @[@"GB", @"+44 7700 900123"],
+                              @[@"GB", @"0044 7700 900123"],
+                              @[@"GB", @"+44 (0)7700 900123"],
+                              @[@"GB", @"+442079460000"],
+                              @[@"FR", @"+33 6 12 34 56 78"],
+                              @[@"JP", @"+81 90-1234-5678"],
+                              @[@"US", @"+1 (555) 555-5555"],
+                              @[@"US", @"001 555 555 5555"],
+                              @[@"IT", @"+39 06 1234 5678"],
+                              @[@"HK", @"+852 2345 6789"],
+                              ];
+    for (NSArray *test in validNumbers) {
+        XCTAssertTrue([STPPhoneNumberValidator stringIsValidPhoneNumber:test[1] forCountryCode:test[0]],
+                      @"%@ number should be valid: %@", test[0], test[1]);
+    }
+
+    NSArray *invalidNumbers = @[
+                                @[@"GB", @"+44 7700 9001"],
+                                @[@"GB", @"+1 555 555 5555"],
+                                @[@"GB", @"0033 6 12 34 56 78"],
+                                @[@"US", @"+1 155 555 5555"],
+                                @[@"US", @"+44 7700 900123"],
+                                @[@"US", @"+"],
+                                ];
+    for (NSArray *test in invalidNumbers) {
+        XCTAssertFalse([STPPhoneNumberValidator stringIsValidPhoneNumber:test[1] forCountryCode:test[0]],
+                       @"%@ number should be invalid: %@", test[0], test[1]);
+    }
+
+    XCTAssertTrue([STPPhoneNumberValidator stringIsValidPartialPhoneNumber:@"+" forCountryCode:@"GB"]);
+    XCTAssertTrue([STPPhoneNumberValidator stringIsValidPartialPhoneNumber:@"+4" forCountryCode:@"GB"]);
+    XCTAssertTrue([STPPhoneNumberValidator stringIsValidPartialPhoneNumber:@"004" forCountryCode:@"GB"]);
+    XCTAssertTrue([STPPhoneNumberValidator stringIsValidPartialPhoneNumber:@"+44 77" forCountryCode:@"GB"]);
+    XCTAssertFalse([STPPhoneNumberValidator stringIsValidPartialPhoneNumber:@"+3" forCountryCode:@"GB"]);
+    XCTAssertFalse([STPPhoneNumberValidator stringIsValidPartialPhoneNumber:@"+44 7700 9001234" forCountryCode:@"GB"]);
+
+    // Numbers dialed with + or 00 keep their prefix, and aren't grouped or cut short
+    XCTAssertEqualObjects([STPPhoneNumberValidator sanitizedPhoneNumberForString:@" +44 (0)7700 900123"], @"+4407700900123");
+    XCTAssertEqualObjects([STPPhoneNumberValidator sanitizedPhoneNumberForString:@"07700 900123"], @"07700900123");
+    XCTAssertEqualObjects([STPPhoneNumberValidator formattedSanitizedPhoneNumberForString:@"+44 7700 900123" forCountryCode:@"GB"], @"+447700900123");
+    XCTAssertEqualObjects([STPPhoneNumberValidator formattedSanitizedPhoneNumberForString:@"+1 (555) 555-5555" forCountryCode:kUSCountryCode], @"+15555555555");
+    XCTAssertEqualObjects([STPPhoneNumberValidator formattedSanitizedPhoneNumberForString:@"+" forCountryCode:@"GB"], @"+");
+    XCTAssertTrue([STPPhoneNumberValidator stringIsValidPhoneNumber:@"+447700900123" forCountryCode:@"GB"]);
+    XCTAssertEqualObjects([STPPhoneNumberValidator formattedSanitizedPhoneNumberForString:@"00447700900123" forCountryCode:@"GB"], @"00447700900123");
+    XCTAssertEqualObjects([STPPhoneNumberValidator formattedSanitizedPhoneNumberForString:@"0033612345678" forCountryCode:@"GB"], @"0033612345678");
+}
+
+- (void)testFormattedInternationalPhoneNumbers {
+    NSArray *tests = @[
+                       @[@"GB", @"0770", @"0770"],
+                       @[@"GB", @"07700", @"07700 "],
+                       @[@"GB", @"07700900123", @"07700 900123"],
+                       @[@"GB", @"02079460000", @"020 7946 0000"],
+                       @[@"FR", @"0612345678", @"06 12 34 56 78"],
+                       @[@"JP", @"09012345678", @"090-1234-5678"],
+                       @[@"JP", @"0312345678", @"03-1234-5678"],
+                       @[@"BR", @"11987654321", @"(11) 98765-4321"],
+                       @[@"BR", @"1123456789", @"(11) 2345-6789"],
+                       @[@"CA", @"4165550123", @"(416) 555-0123"],
+                       ];
+    for (NSArray *test in tests) {
+        XCTAssertEqualObjects([STPPhoneNumberValidator formattedSanitizedPhoneNumberForString:test[1] forCountryCode:test[0]],
+                              test[2],
+                              @"Formatting test failed for %@ number: %@", test[0], test[1]);
+    }
+    XCTAssertEqualObjects([STPPhoneNumberValidator formattedRedactedPhoneNumberForString:@"+44*******0123" forCountryCode:@"GB"], @"+44 ••••• ••0123");
+}
+
+- (void)testMetadataParsing {
+    // One country, "ZZ": calling code 999, 3-5 digits starting with 1, formatted as XX-XXX
+    const uint8_t bytes[] = {
+        'S', 'T', 'P', 'N', 2, 0, 1, 0,
+        'Z', 'Z', 14, 0, 0, 0,
+        3, 5, 0x02, 0x00, 3, '9', '9', '9', 0, 1, 0, 6, 'X', 'X', '-', 'X', 'X', 'X',
+    };
+    NSData *data = [NSData dataWithBytes:bytes length:sizeof(bytes)];
+    STPPhoneNumberMetadata *metadata = [STPPhoneNumberMetadata metadataForCountryCode:@"ZZ" fromData:data];
+    XCTAssertNotNil(metadata);
+    XCTAssertEqual(metadata.minLength, 3U);
+    XCTAssertEqual(metadata.maxLength, 5U);
+    XCTAssertEqualObjects(metadata.callingCode, @"999");
+    XCTAssertEqualObjects(metadata.nationalPrefix, @"");
+    XCTAssertEqualObjects([metadata nationalNumberForString:@"+999 123"], @"123");
+    XCTAssertTrue([metadata isValidNumber:@"123"]);
+    XCTAssertFalse([metadata isValidNumber:@"023"]);
+    XCTAssertFalse([metadata isValidNumber:@"12"]);
+    XCTAssertEqualObjects([metadata formattedNumberForString:@"123456"], @"12-345");
+
+    XCTAssertNil([STPPhoneNumberMetadata metadataForCountryCode:@"ZY" fromData:data]);
+    XCTAssertNil([STPPhoneNumberMetadata metadataForCountryCode:@"ZZ" fromData:[data subdataWithRange:NSMakeRange(0, data.length - 1)]]);
+    XCTAssertNil([STPPhoneNumberMetadata metadataForCountryCode:@"ZZ" fromData:[data subdataWithRange:NSMakeRange(0, 10)]]);
+    XCTAssertNil([STPPhoneNumberMetadata metadataForCountryCode:@"ZZ" fromData:[@"not metadata" dataUsingEncoding:NSUTF8StringEncoding]]);
+}
+
 @end
@@ -9,6 +9,13 @@
 #import <XCTest/XCTest.h>
 #import "STPPostalCodeValidator.h"
 
+@interface STPPostalCodeValidator (Testing)
+
++ (NSArray<NSString *> *)countryCodesWithPostalCodeFormats;
++ (id)postalCodeFormatForCountryCode:(NSString *)countryCode;
+
+@end
+
 @interface STPPostalCodeValidatorTest : XCTestCase
 
 @end
@@ -87,4 +94,125 @@
     }   
 }
 
+- (void)testInternationalPostalCodes {
+    NSArray *tests = @[
+                       @[@"CA", @"K1A 0B1", @(STPCardValidationStateValid)],
+                       @[@"CA", @"k1a0b1", @(STPCardValidationStateValid)],
+                       @[@"CA", @"K1A", @(STPCardValidationStateIncomplete)],
+                       @[@"CA", @"K1A 0B", @(STPCardValidationStateIncomplete)],
+                       @[@"CA", @"11A 0B1", @(STPCardValidationStateInvalid)],
+                       @[@"CA", @"K1A 0B12", @(STPCardValidationStateInvalid)],
+                       @[@"GB", @"SW1A 1AA", @(STPCardValidationStateValid)],
+                       @[@"GB", @"M1 1AE", @(STPCardValidationStateValid)],
+                       @[@"GB", @"M11AE", @(STPCardValidationStateValid)],
+                       @[@"GB", @"CR2 6XH", @(STPCardValidationStateValid)],
+                       @[@"GB", @"DN55 1PT", @(STPCardValidationStateValid)],
+                       @[@"GB", @"M11", @(STPCardValidationStateIncomplete)],
+                       @[@"GB", @"M1 1A1", @(STPCardValidationStateInvalid)],
+                       @[@"DE", @"10115", @(STPCardValidationStateValid)],
+                       @[@"DE", @"1011", @(STPCardValidationStateIncomplete)],
+                       @[@"DE", @"1011A", @(STPCardValidationStateInvalid)],
+                       @[@"NL", @"1012 AB", @(STPCardValidationStateValid)],
+                       @[@"NL", @"1012", @(STPCardValidationStateIncomplete)],
+                       @[@"JP", @"100-0001", @(STPCardValidationStateValid)],
+                       @[@"JP", @"1000001", @(STPCardValidationStateValid)],
+                       @[@"JP", @"100-000", @(STPCardValidationStateIncomplete)],
+                       @[@"JP", @"1000-001", @(STPCardValidationStateInvalid)],
+                       @[@"BR", @"01310-100", @(STPCardValidationStateValid)],
+                       @[@"TW", @"100", @(STPCardValidationStateValid)],
+                       @[@"TW", @"1000", @(STPCardValidationStateIncomplete)],
+                       @[@"TW", @"10001", @(STPCardValidationStateValid)],
+                       @[@"de", @"10115", @(STPCardValidationStateValid)],
+                       @[@"MT", @"VLT 1117", @(STPCardValidationStateValid)],
+                       @[@"TR", @"06100", @(STPCardValidationStateValid)],
+                       @[@"JE", @"JE2 3AB", @(STPCardValidationStateValid)],
+                       @[@"RO", @"01014", @(STPCardValidationStateIncomplete)],
+                       ];
+    for (NSArray *test in tests) {
+        XCTAssertEqual([STPPostalCodeValidator validationStateForPostalCode:test[1]
+                                                                countryCode:test[0]],
+                       [test[2] integerValue],
+                       @"Postal code test failed for %@ code: %@", test[0], test[1]);
+    }
+}
+
+- (void)testEveryPostalCodeFormatCompiles {
+    NSArray<NSString *> *countryCodes = [STPPostalCodeValidator countryCodesWithPostalCodeFormats];
+    XCTAssertGreaterThan(countryCodes.count, 100U);
+    for (NSString *countryCode in countryCodes) {
+        XCTAssertNotNil([STPPostalCodeValidator postalCodeFormatForCountryCode:countryCode],
+                        @"Postal code format for %@ didn't compile", countryCode);
+        XCTAssertTrue([STPPostalCodeValidator postalCodeIsRequiredForCountryCode:countryCode],
+                      @"%@ has a postal code format but is listed as having no postal codes", countryCode);
+    }
+}
+
+- (void)testPostalCodeNotRequired {
+    XCTAssertFalse([STPPostalCodeValidator postalCodeIsRequiredForCountryCode:@"IE"]);
+    XCTAssertFalse([STPPostalCodeValidator postalCodeIsRequiredForCountryCode:@"hk"]);
+    XCTAssertTrue([STPPostalCodeValidator postalCodeIsRequiredForCountryCode:@"US"]);
+    XCTAssertTrue([STPPostalCodeValidator postalCodeIsRequiredForCountryCode:nil]);
+    XCTAssertEqual([STPPostalCodeValidator validationStateForPostalCode:@""
+                                                            countryCode:@"IE"],
+                   STPCardValidationStateValid);
+}
+
+- (void)testFormattedPostalCodes {
+    NSArray *tests = @[
+                       @[@"CA", @"k1a0b1", @"K1A 0B1"],
+                       @[@"CA", @"K1A-0B1", @"K1A 0B1"],
+                       @[@"CA", @"K1A0", @"K1A 0"],
+                       @[@"CA", @"K1A ", @"K1A"],
+                       @[@"GB", @"sw1a1aa", @"SW1A 1AA"],
+                       @[@"GB", @"M11AE", @"M1 1AE"],
+                       // Could still be "M1 1AE" or "M11 1AE"
+                       @[@"GB", @"M11", @"M11"],
+                       @[@"NL", @"1012ab", @"1012 AB"],
+                       @[@"JP", @"1000001", @"100-0001"],
+                       @[@"PL", @"00 950", @"00-950"],
+                       @[@"DE", @"10115", @"10115"],
+                       // Codes that don't fit are left alone
+                       @[@"DE", @"1011A", @"1011A"],
+                       @[@"CA", @"K1A#0B1", @"K1A#0B1"],
+                       // Countries without a known format are left alone
+                       @[@"UK", @"abc 123", @"abc 123"],
+                       ];
+    for (NSArray *test in tests) {
+        XCTAssertEqualObjects([STPPostalCodeValidator formattedSanitizedPostalCodeFromString:test[1]
+                                                                                 countryCode:test[0]
+                                                                                       usage:STPPostalCodeIntendedUsageBillingAddress],
+                              test[2],
+                              @"Formatting test failed for %@ code: %@", test[0], test[1]);
+    }
+}
+
+- (void)testFormattedUSPostalCodes {
+    XCTAssertEqualObjects([STPPostalCodeValidator formattedSanitizedPostalCodeFromString:@"123456789"
+                                                                             countryCode:@"US"
+                                                                                   usage:STPPostalCodeIntendedUsageBillingAddress],
+                          @"12345");
+    XCTAssertEqualObjects([STPPostalCodeValidator formattedSanitizedPostalCodeFromString:@"123456789"
+                                                                             countryCode:@"US"
+                                                                                   usage:STPPostalCodeIntendedUsageShippingAddress],
+                          @"12345-6789");
+}
+
+- (void)testLenientPostalCodes {
+    XCTAssertEqual([STPPostalCodeValidator validationStateForPostalCode:@"75001" countryCode:@"GB" strict:NO],
+                   STPCardValidationStateValid);
+    XCTAssertEqual([STPPostalCodeValidator validationStateForPostalCode:@"" countryCode:@"GB" strict:NO],
+                   STPCardValidationStateIncomplete);
+    XCTAssertEqual([STPPostalCodeValidator validationStateForPostalCode:@"75001" countryCode:@"GB" strict:YES],
+                   STPCardValidationStateInvalid);
+    XCTAssertEqual([STPPostalCodeValidator validationStateForPostalCode:@"ABCDE" countryCode:@"US" strict:NO],
+                   STPCardValidationStateInvalid);
+    XCTAssertEqual([STPPostalCodeValidator validationStateForPostalCode:@"" countryCode:@"IE" strict:NO],
+                   STPCardValidationStateValid);
+    XCTAssertEqualObjects([STPPostalCodeValidator formattedSanitizedPostalCodeFromString:@"sw1a1aa"
+                                                                             countryCode:@"GB"
+                                                                                   usage:STPPostalCodeIntendedUsageBillingAddress
+                                                                                  strict:NO],
+                          @"sw1a1aa");
+}
+
 @end
@@ -11,6 +11,7 @@
 
 #import "NSError+Stripe.h"
 #import "NSURLComponents+Stripe.h"
+#import "STPAPIClient.h"
 #import "STPFixtures.h"
 #import "STPRedirectContext.h"
 #import "STPRedirectContext+Private.h"
@@ -147,6 +148,48 @@
     XCTAssertTrue(completionCalled);
 }
 
+- (void)testPaymentIntentPollingStartsOnReturn {
+    STPPaymentIntent *paymentIntent = [STPFixtures paymentIntent];
+    STPPaymentIntent *polledPaymentIntent = [STPFixtures paymentIntent];
+    id apiClient = OCMClassMock([STPAPIClient class]);
+    OCMStub([apiClient startPollingPaymentIntentWithClientSecret:paymentIntent.clientSecret
+                                                         timeout:10
+                                                      completion:[OCMArg any]])
+    .andDo(^(NSInvocation *invocation) {
+        STPPaymentIntentCompletionBlock pollCompletion;
+        [invocation getArgument:&pollCompletion atIndex:4];
+        pollCompletion(polledPaymentIntent, nil);
+    });
+
+    __block BOOL completionCalled = NO;
+    STPRedirectContext *sut = [[STPRedirectContext alloc] initWithPaymentIntent:paymentIntent apiClient:apiClient pollingTimeout:10 completion:^(STPPaymentIntent *completionPaymentIntent, NSError *error) {
+        XCTAssertEqual(completionPaymentIntent, polledPaymentIntent);
+        XCTAssertNil(error);
+        completionCalled = YES;
+    }];
+    XCTAssertEqualObjects(sut.returnURL, paymentIntent.nextSourceAction.authorizeWithURL.returnURL);
+
+    sut.completion(nil);
+    XCTAssertTrue(completionCalled);
+}
+
+- (void)testPaymentIntentPollingSkippedAfterRedirectError {
+    STPPaymentIntent *paymentIntent = [STPFixtures paymentIntent];
+    id apiClient = OCMClassMock([STPAPIClient class]);
+    OCMReject([apiClient startPollingPaymentIntentWithClientSecret:[OCMArg any] timeout:10 completion:[OCMArg any]]);
+    NSError *fakeError = [NSError new];
+
+    __block BOOL completionCalled = NO;
+    STPRedirectContext *sut = [[STPRedirectContext alloc] initWithPaymentIntent:paymentIntent apiClient:apiClient pollingTimeout:10 completion:^(STPPaymentIntent *completionPaymentIntent, NSError *error) {
+        XCTAssertNil(completionPaymentIntent);
+        XCTAssertEqual(error, fakeError);
+        completionCalled = YES;
+    }];
+
+    sut.completion(fakeError);
+    XCTAssertTrue(completionCalled);
+}
+
 - (void)testInitWithPaymentIntentFailures {
     NSMutableDictionary *json = [[STPTestUtils jsonNamed:STPTestJSONPaymentIntent] mutableCopy];
     json[@"next_source_action"] = [json[@"next_source_action"] mutableCopy];
@@ -0,0 +1,94 @@
+//
+//  STPRequestMetricsAggregatorTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <Stripe/Stripe.h>
+
+#import "STPRequestMetrics+Private.h"
+#import "STPRequestMetricsCollector.h"
+
+@interface STPRequestMetricsAggregatorTest : XCTestCase
+
+@end
+
+@implementation STPRequestMetricsAggregatorTest
+
+- (STPRequestMetrics *)metricsForEndpoint:(NSString *)endpoint totalDuration:(NSTimeInterval)totalDuration {
+    STPRequestMetrics *metrics = [[STPRequestMetrics alloc] initWithEndpoint:endpoint HTTPMethod:@"GET"];
+    metrics.totalDuration = totalDuration;
+    return metrics;
+}
+
+- (void)testNormalizedEndpoint {
+    XCTAssertEqualObjects([STPRequestMetrics normalizedEndpoint:@"tokens"], @"tokens");
+    XCTAssertEqualObjects([STPRequestMetrics normalizedEndpoint:@"sources/src_1DaIA7BbvEcIpqUbxjjijxR9"], @"sources/:id");
+    XCTAssertEqualObjects([STPRequestMetrics normalizedEndpoint:@"customers/cus_123/sources/card_123"], @"customers/:id/sources/:id");
+    XCTAssertEqualObjects([STPRequestMetrics normalizedEndpoint:@"payment_intents/pi_123/confirm"], @"payment_intents/:id/confirm");
+}
+
+- (void)testGroupsByEndpoint {
+    STPRequestMetricsAggregator *aggregator = [STPRequestMetricsAggregator new];
+    [aggregator apiClient:[STPAPIClient sharedClient] didCollectRequestMetrics:[self metricsForEndpoint:@"sources/src_1" totalDuration:0.1]];
+    [aggregator apiClient:[STPAPIClient sharedClient] didCollectRequestMetrics:[self metricsForEndpoint:@"sources/src_2" totalDuration:0.2]];
+    [aggregator apiClient:[STPAPIClient sharedClient] didCollectRequestMetrics:[self metricsForEndpoint:@"tokens" totalDuration:0.3]];
+
+    XCTAssertEqualObjects(aggregator.endpoints, (@[@"sources/:id", @"tokens"]));
+    XCTAssertEqual([aggregator recentMetricsForEndpoint:@"sources/:id"].count, 2U);
+    XCTAssertEqual([aggregator recentMetricsForEndpoint:@"tokens"].count, 1U);
+    XCTAssertNil([aggregator histogramForEndpoint:@"customers/:id"]);
+
+    [aggregator reset];
+    XCTAssertEqualObjects(aggregator.endpoints, @[]);
+}
+
+- (void)testWindowDropsOldestMetrics {
+    STPRequestMetricsAggregator *aggregator = [[STPRequestMetricsAggregator alloc] initWithWindowSize:3];
+    for (NSUInteger idx = 1; idx <= 5; idx++) {
+        [aggregator apiClient:[STPAPIClient sharedClient] didCollectRequestMetrics:[self metricsForEndpoint:@"tokens" totalDuration:idx]];
+    }
+    NSArray<STPRequestMetrics *> *recentMetrics = [aggregator recentMetricsForEndpoint:@"tokens"];
+    XCTAssertEqualObjects([recentMetrics valueForKey:@"totalDuration"], (@[@3, @4, @5]));
+}
+
+- (void)testHistogram {
+    STPRequestMetricsAggregator *aggregator = [STPRequestMetricsAggregator new];
+    for (NSUInteger idx = 0; idx < 98; idx++) {
+        [aggregator apiClient:[STPAPIClient sharedClient] didCollectRequestMetrics:[self metricsForEndpoint:@"tokens" totalDuration:0.04]];
+    }
+    [aggregator apiClient:[STPAPIClient sharedClient] didCollectRequestMetrics:[self metricsForEndpoint:@"tokens" totalDuration:0.7]];
+    [aggregator apiClient:[STPAPIClient sharedClient] didCollectRequestMetrics:[self metricsForEndpoint:@"tokens" totalDuration:30]];
+
+    STPRequestMetricsHistogram *histogram = [aggregator histogramForEndpoint:@"tokens"];
+    XCTAssertEqual(histogram.sampleCount, 100U);
+    XCTAssertEqual(histogram.bucketCounts.count, histogram.bucketUpperBounds.count);
+    XCTAssertEqualObjects([histogram.bucketCounts valueForKeyPath:@"@sum.self"], @100);
+    XCTAssertEqualWithAccuracy([histogram approximateDurationAtPercentile:0.5], 0.05, 0.0001);
+    XCTAssertEqualWithAccuracy([histogram approximateDurationAtPercentile:0.99], 1, 0.0001);
+    XCTAssertEqual([histogram approximateDurationAtPercentile:1], DBL_MAX);
+}
+
+- (void)testCollectorDeliversToObserver {
+    STPAPIClient *apiClient = [[STPAPIClient alloc] initWithPublishableKey:@"pk_test"];
+    XCTAssertNil([STPRequestMetricsCollector collectorWithAPIClient:apiClient endpoint:@"tokens" HTTPMethod:@"POST"]);
+
+    STPRequestMetricsAggregator *aggregator = [STPRequestMetricsAggregator new];
+    apiClient.metricsObserver = aggregator;
+    STPRequestMetricsCollector *collector = [STPRequestMetricsCollector collectorWithAPIClient:apiClient endpoint:@"tokens" HTTPMethod:@"POST"];
+    [collector recordFormEncodeDuration:0.001];
+    [collector recordResponse:nil error:nil];
+    [collector recordCompletionStarted];
+    [collector finish];
+
+    STPRequestMetrics *metrics = [aggregator recentMetricsForEndpoint:@"tokens"].firstObject;
+    XCTAssertNotNil(metrics);
+    XCTAssertEqualObjects(metrics.HTTPMethod, @"POST");
+    XCTAssertEqualWithAccuracy(metrics.formEncodeDuration, 0.001, 0.00001);
+    XCTAssertGreaterThanOrEqual(metrics.totalDuration, metrics.mainThreadDispatchDelay);
+}
+
+@end
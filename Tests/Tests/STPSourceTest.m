@@ -7,6 +7,7 @@
 //
 
 @import XCTest;
+#import <malloc/malloc.h>
 
 #import "STPSource.h"
 #import "STPSource+Private.h"
@@ -455,6 +456,63 @@
     XCTAssertEqualObjects(source.allResponseFields, [response stp_dictionaryByRemovingNulls]);
 }
 
+#pragma mark - Decoding Many Sources
+
+- (size_t)allocatedBytes {
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+    return statistics.size_in_use;
+}
+
+- (NSArray<NSData *> *)cardSourceResponsesWithCount:(NSUInteger)sourceCount {
+    NSMutableArray<NSData *> *responses = [NSMutableArray array];
+    for (NSUInteger i = 0; i < sourceCount; i++) {
+        NSMutableDictionary *json = [[STPTestUtils jsonNamed:STPTestJSONSourceCard] mutableCopy];
+        json[@"id"] = [NSString stringWithFormat:@"src_%lu", (unsigned long)i];
+        [responses addObject:[NSJSONSerialization dataWithJSONObject:json options:0 error:nil]];
+    }
+    return responses;
+}
+
+/**
+ Decodes `responses` into `sources`, and returns the bytes that are still
+ allocated afterwards. Like STPAPIRequest, only the decoded objects are kept.
+ */
+- (size_t)decodeResponses:(NSArray<NSData *> *)responses intoSources:(NSMutableArray<STPSource *> *)sources {
+    size_t startBytes = [self allocatedBytes];
+    @autoreleasepool {
+        for (NSData *response in responses) {
+            NSDictionary *json = [NSJSONSerialization JSONObjectWithData:response options:0 error:nil];
+            [sources addObject:[STPSource decodedObjectFromAPIResponse:json]];
+        }
+    }
+    return [self allocatedBytes] - startBytes;
+}
+
+- (void)testDecodingManySourcesSharesStrings {
+    NSUInteger sourceCount = 500;
+    NSArray<NSData *> *responses = [self cardSourceResponsesWithCount:sourceCount];
+
+    NSMutableArray<STPSource *> *plainSources = [NSMutableArray array];
+    [NSDictionary stp_setInterningEnabled:NO];
+    size_t plainBytes = [self decodeResponses:responses intoSources:plainSources];
+    [NSDictionary stp_setInterningEnabled:YES];
+
+    NSMutableArray<STPSource *> *sources = [NSMutableArray array];
+    size_t internedBytes = [self decodeResponses:responses intoSources:sources];
+
+    XCTAssertEqual(plainSources.count, sourceCount);
+    XCTAssertEqual(sources.count, sourceCount);
+    XCTAssertLessThan(internedBytes, plainBytes);
+
+    STPSource *first = sources.firstObject;
+    for (STPSource *source in sources) {
+        XCTAssertEqual(source.allResponseFields[@"status"], first.allResponseFields[@"status"]);
+        XCTAssertEqual(source.allResponseFields[@"card"][@"three_d_secure"], first.allResponseFields[@"card"][@"three_d_secure"]);
+        XCTAssertEqual(source.cardDetails.country, first.cardDetails.country);
+    }
+}
+
 #pragma mark - STPPaymentMethod Tests
 
 - (NSArray *)possibleAPIResponses {
@@ -0,0 +1,129 @@
+//
+//  STPTraceRecorderTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <OHHTTPStubs/OHHTTPStubs.h>
+#import <Stripe/Stripe.h>
+
+#import "STPFixtures.h"
+#import "STPTestUtils.h"
+#import "STPTrace.h"
+#import "UIImage+Stripe.h"
+
+@interface STPTraceRecorderTest : XCTestCase
+@property (nonatomic) STPTraceRecorder *recorder;
+@end
+
+@implementation STPTraceRecorderTest
+
+- (void)setUp {
+    [super setUp];
+    self.recorder = [STPTraceRecorder new];
+    [Stripe setTracer:self.recorder];
+}
+
+- (void)tearDown {
+    [Stripe setTracer:nil];
+    [OHHTTPStubs removeAllStubs];
+    [super tearDown];
+}
+
+- (NSArray<NSDictionary *> *)traceEventsWithPhase:(NSString *)phase {
+    NSDictionary *trace = [NSJSONSerialization JSONObjectWithData:[self.recorder traceData] options:(NSJSONReadingOptions)0 error:nil];
+    return [trace[@"traceEvents"] filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"ph == %@", phase]];
+}
+
+- (NSArray<NSString *> *)spanNames {
+    return [[self traceEventsWithPhase:@"X"] valueForKey:@"name"];
+}
+
+- (void)testTracingIsOffByDefault {
+    [Stripe setTracer:nil];
+    XCTAssertNil([Stripe tracer]);
+    XCTAssertEqual(stpTraceBegin(), 0);
+}
+
+- (void)testRecordsSpan {
+    NSTimeInterval startTime = stpTraceBegin();
+    XCTAssertGreaterThan(startTime, 0);
+    stpTraceEnd(startTime, @"test_span", @"test");
+    XCTAssertEqual(self.recorder.spanCount, 1U);
+
+    NSDictionary *span = [self traceEventsWithPhase:@"X"].firstObject;
+    XCTAssertEqualObjects(span[@"name"], @"test_span");
+    XCTAssertEqualObjects(span[@"cat"], @"test");
+    XCTAssertEqualWithAccuracy([span[@"ts"] doubleValue], startTime * 1000000, 1);
+    XCTAssertGreaterThanOrEqual([span[@"dur"] longLongValue], 0);
+    XCTAssertEqualObjects(span[@"pid"], @([NSProcessInfo processInfo].processIdentifier));
+
+    NSDictionary *threadName = [self traceEventsWithPhase:@"M"].firstObject;
+    XCTAssertEqualObjects(threadName[@"tid"], span[@"tid"]);
+    XCTAssertEqualObjects(threadName[@"args"][@"name"], @"main");
+}
+
+- (void)testSpanStartedWhileTracingWasOffIsDropped {
+    [Stripe setTracer:nil];
+    NSTimeInterval startTime = stpTraceBegin();
+    [Stripe setTracer:self.recorder];
+    stpTraceEnd(startTime, @"test_span", @"test");
+    XCTAssertEqual(self.recorder.spanCount, 0U);
+}
+
+- (void)testMaxSpanCount {
+    STPTraceRecorder *recorder = [[STPTraceRecorder alloc] initWithMaxSpanCount:2];
+    for (NSUInteger i = 0; i < 5; i++) {
+        [recorder recordSpanWithName:@"test_span" category:@"test" startTime:1 endTime:2];
+    }
+    XCTAssertEqual(recorder.spanCount, 2U);
+    [recorder reset];
+    XCTAssertEqual(recorder.spanCount, 0U);
+}
+
+- (void)testAPIRequestSpans {
+    [OHHTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest *request) {
+        return [request.URL.host isEqualToString:@"api.stripe.com"];
+    } withStubResponse:^OHHTTPStubsResponse *(__unused NSURLRequest *request) {
+        return [OHHTTPStubsResponse responseWithJSONObject:[STPTestUtils jsonNamed:STPTestJSONSourceCard] statusCode:200 headers:nil];
+    }];
+
+    STPAPIClient *apiClient = [[STPAPIClient alloc] initWithPublishableKey:@"pk_test_123"];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"retrieve"];
+    [apiClient retrieveSourceWithId:@"src_123" clientSecret:@"secret" completion:^(STPSource *source, __unused NSError *error) {
+        XCTAssertNotNil(source);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    NSArray<NSString *> *spanNames = [self spanNames];
+    for (NSString *name in @[@"request_build", @"form_encode", @"network", @"json_parse", @"model_decode", @"main_thread_dispatch"]) {
+        XCTAssertTrue([spanNames containsObject:name], @"Missing %@ span", name);
+    }
+}
+
+- (void)testImageCompressSpan {
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(40, 40), YES, 1);
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+
+    [image stp_jpegDataWithMaxFileSize:1000000];
+    XCTAssertEqualObjects([self spanNames], @[@"image_compress"]);
+}
+
+- (void)testWriteTrace {
+    stpTraceEnd(stpTraceBegin(), @"test_span", @"test");
+    NSURL *url = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:@"trace.json"];
+    NSError *error = nil;
+    XCTAssertTrue([self.recorder writeTraceToURL:url error:&error]);
+    XCTAssertNil(error);
+
+    NSDictionary *trace = [NSJSONSerialization JSONObjectWithData:[NSData dataWithContentsOfURL:url] options:(NSJSONReadingOptions)0 error:nil];
+    XCTAssertEqual([trace[@"traceEvents"] count], 2U);
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+}
+
+@end
@@ -0,0 +1,109 @@
+//
+//  STPURLCallbackHandlerTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "STPURLCallbackHandler.h"
+
+@interface STPTestURLCallbackListener : NSObject <STPURLCallbackListener>
+@property (nonatomic) NSUInteger callbackCount;
+@property (nonatomic) BOOL returnValue;
+@property (nonatomic, copy) void (^callbackBlock)(STPTestURLCallbackListener *listener);
+@end
+
+@implementation STPTestURLCallbackListener
+
+- (BOOL)handleURLCallback:(__unused NSURL *)url {
+    self.callbackCount++;
+    if (self.callbackBlock) {
+        self.callbackBlock(self);
+    }
+    return self.returnValue;
+}
+
+@end
+
+@interface STPURLCallbackHandler (Testing)
+@property (nonatomic) NSMutableDictionary<NSString *, NSArray *> *callbacksByKey;
+@end
+
+@interface STPURLCallbackHandlerTest : XCTestCase
+@property (nonatomic) STPURLCallbackHandler *handler;
+@end
+
+@implementation STPURLCallbackHandlerTest
+
+- (void)setUp {
+    [super setUp];
+    self.handler = [STPURLCallbackHandler new];
+}
+
+- (void)testDispatchesOnlyToMatchingListeners {
+    STPTestURLCallbackListener *listener1 = [STPTestURLCallbackListener new];
+    listener1.returnValue = YES;
+    STPTestURLCallbackListener *listener2 = [STPTestURLCallbackListener new];
+    STPTestURLCallbackListener *listener3 = [STPTestURLCallbackListener new];
+    [self.handler registerListener:listener1 forURL:[NSURL URLWithString:@"foo://return/path?source=src_1"]];
+    [self.handler registerListener:listener2 forURL:[NSURL URLWithString:@"foo://return/path?source=src_2"]];
+    [self.handler registerListener:listener3 forURL:[NSURL URLWithString:@"foo://other/path"]];
+
+    XCTAssertTrue([self.handler handleURLCallback:[NSURL URLWithString:@"foo://return/path?source=src_1&client_secret=secret"]]);
+    XCTAssertEqual(listener1.callbackCount, 1U);
+    XCTAssertEqual(listener2.callbackCount, 0U);
+    XCTAssertEqual(listener3.callbackCount, 0U);
+
+    XCTAssertFalse([self.handler handleURLCallback:[NSURL URLWithString:@"foo://return/otherpath?source=src_1"]]);
+    XCTAssertFalse([self.handler handleURLCallback:[NSURL URLWithString:@"bar://return/path?source=src_1"]]);
+    XCTAssertEqual(listener1.callbackCount, 1U);
+}
+
+- (void)testUnregisterRemovesAllRegistrations {
+    STPTestURLCallbackListener *listener = [STPTestURLCallbackListener new];
+    STPTestURLCallbackListener *otherListener = [STPTestURLCallbackListener new];
+    [self.handler registerListener:listener forURL:[NSURL URLWithString:@"foo://return/a"]];
+    [self.handler registerListener:listener forURL:[NSURL URLWithString:@"foo://return/b"]];
+    [self.handler registerListener:otherListener forURL:[NSURL URLWithString:@"foo://return/a"]];
+
+    [self.handler unregisterListener:listener];
+    [self.handler handleURLCallback:[NSURL URLWithString:@"foo://return/a"]];
+    [self.handler handleURLCallback:[NSURL URLWithString:@"foo://return/b"]];
+    XCTAssertEqual(listener.callbackCount, 0U);
+    XCTAssertEqual(otherListener.callbackCount, 1U);
+    XCTAssertEqual(self.handler.callbacksByKey.count, 1U);
+}
+
+- (void)testListenerCanUnregisterDuringDispatch {
+    STPTestURLCallbackListener *listener1 = [STPTestURLCallbackListener new];
+    STPTestURLCallbackListener *listener2 = [STPTestURLCallbackListener new];
+    STPURLCallbackHandler *handler = self.handler;
+    listener1.callbackBlock = ^(STPTestURLCallbackListener *listener) {
+        [handler unregisterListener:listener];
+    };
+    NSURL *url = [NSURL URLWithString:@"foo://return/path"];
+    [self.handler registerListener:listener1 forURL:url];
+    [self.handler registerListener:listener2 forURL:url];
+
+    [self.handler handleURLCallback:url];
+    [self.handler handleURLCallback:url];
+    XCTAssertEqual(listener1.callbackCount, 1U);
+    XCTAssertEqual(listener2.callbackCount, 2U);
+}
+
+- (void)testDeallocatedListenersArePruned {
+    NSURL *url = [NSURL URLWithString:@"foo://return/path"];
+    @autoreleasepool {
+        STPTestURLCallbackListener *listener = [STPTestURLCallbackListener new];
+        [self.handler registerListener:listener forURL:url];
+        XCTAssertEqual(self.handler.callbacksByKey.count, 1U);
+    }
+
+    XCTAssertFalse([self.handler handleURLCallback:url]);
+    XCTAssertEqual(self.handler.callbacksByKey.count, 0U);
+}
+
+@end
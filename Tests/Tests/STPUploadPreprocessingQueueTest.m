@@ -0,0 +1,150 @@
+//
+//  STPUploadPreprocessingQueueTest.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "STPAPIOperation.h"
+#import "STPUploadPreprocessingQueue.h"
+
+@interface STPUploadPreprocessingQueueTest : XCTestCase
+@end
+
+@implementation STPUploadPreprocessingQueueTest
+
+- (void)testJobsStayWithinBudget {
+    STPUploadPreprocessingQueue *queue = [[STPUploadPreprocessingQueue alloc] initWithMaxConcurrentJobCount:4 byteBudget:100];
+    NSMutableArray<NSNumber *> *results = [NSMutableArray array];
+    __block NSUInteger maxBytesInUse = 0;
+    NSArray<NSNumber *> *costs = @[@60, @30, @50, @20, @100];
+
+    for (NSUInteger i = 0; i < costs.count; i++) {
+        XCTestExpectation *expectation = [self expectationWithDescription:@"job"];
+        [queue addJobWithCost:costs[i].unsignedIntegerValue block:^id{
+            @synchronized (results) {
+                maxBytesInUse = MAX(maxBytesInUse, queue.bytesInUse);
+            }
+            [NSThread sleepForTimeInterval:0.02];
+            return @(i);
+        } completion:^(id result, NSError *error) {
+            XCTAssertTrue([NSThread isMainThread]);
+            XCTAssertNil(error);
+            [results addObject:result];
+            [expectation fulfill];
+        }];
+    }
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    XCTAssertLessThanOrEqual(maxBytesInUse, 100U);
+    XCTAssertEqual(results.count, costs.count);
+    XCTAssertEqual(queue.bytesInUse, 0U);
+}
+
+- (void)testConcurrencyLimit {
+    STPUploadPreprocessingQueue *queue = [[STPUploadPreprocessingQueue alloc] initWithMaxConcurrentJobCount:1 byteBudget:1000];
+    __block NSUInteger runningCount = 0;
+    __block NSUInteger maxRunningCount = 0;
+    NSMutableArray<NSNumber *> *startOrder = [NSMutableArray array];
+
+    for (NSUInteger i = 0; i < 4; i++) {
+        XCTestExpectation *expectation = [self expectationWithDescription:@"job"];
+        [queue addJobWithCost:1 block:^id{
+            @synchronized (startOrder) {
+                runningCount++;
+                maxRunningCount = MAX(maxRunningCount, runningCount);
+                [startOrder addObject:@(i)];
+            }
+            [NSThread sleepForTimeInterval:0.01];
+            @synchronized (startOrder) {
+                runningCount--;
+            }
+            return nil;
+        } completion:^(__unused id result, __unused NSError *error) {
+            [expectation fulfill];
+        }];
+    }
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    XCTAssertEqual(maxRunningCount, 1U);
+    NSArray *expectedOrder = @[@0, @1, @2, @3];
+    XCTAssertEqualObjects(startOrder, expectedOrder);
+}
+
+- (void)testJobLargerThanBudgetRunsAlone {
+    STPUploadPreprocessingQueue *queue = [[STPUploadPreprocessingQueue alloc] initWithMaxConcurrentJobCount:2 byteBudget:100];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"job"];
+    [queue addJobWithCost:500 block:^id{
+        XCTAssertEqual(queue.bytesInUse, 500U);
+        return @"done";
+    } completion:^(id result, NSError *error) {
+        XCTAssertEqualObjects(result, @"done");
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+- (void)testCancelPendingJob {
+    STPUploadPreprocessingQueue *queue = [[STPUploadPreprocessingQueue alloc] initWithMaxConcurrentJobCount:1 byteBudget:100];
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    XCTestExpectation *firstExpectation = [self expectationWithDescription:@"first"];
+    XCTestExpectation *secondExpectation = [self expectationWithDescription:@"second"];
+
+    [queue addJobWithCost:10 block:^id{
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+        return @1;
+    } completion:^(id result, __unused NSError *error) {
+        XCTAssertEqualObjects(result, @1);
+        [firstExpectation fulfill];
+    }];
+    STPAPIOperation *operation = [queue addJobWithCost:10 block:^id{
+        XCTFail(@"A cancelled job shouldn't run");
+        return nil;
+    } completion:^(id result, NSError *error) {
+        XCTAssertNil(result);
+        XCTAssertEqualObjects(error.domain, NSURLErrorDomain);
+        XCTAssertEqual(error.code, NSURLErrorCancelled);
+        [secondExpectation fulfill];
+    }];
+
+    [operation cancel];
+    dispatch_semaphore_signal(semaphore);
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertTrue(operation.isFinished);
+}
+
+- (void)testCancelRunningJob {
+    STPUploadPreprocessingQueue *queue = [[STPUploadPreprocessingQueue alloc] initWithMaxConcurrentJobCount:1 byteBudget:100];
+    dispatch_semaphore_t started = dispatch_semaphore_create(0);
+    dispatch_semaphore_t finish = dispatch_semaphore_create(0);
+    XCTestExpectation *expectation = [self expectationWithDescription:@"job"];
+
+    STPAPIOperation *operation = [queue addJobWithCost:10 block:^id{
+        dispatch_semaphore_signal(started);
+        dispatch_semaphore_wait(finish, DISPATCH_TIME_FOREVER);
+        return @1;
+    } completion:^(id result, NSError *error) {
+        XCTAssertNil(result);
+        XCTAssertEqual(error.code, NSURLErrorCancelled);
+        [expectation fulfill];
+    }];
+
+    dispatch_semaphore_wait(started, DISPATCH_TIME_FOREVER);
+    [operation cancel];
+    dispatch_semaphore_signal(finish);
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(queue.bytesInUse, 0U);
+}
+
+- (void)testEstimatedCostOfEncodingImage {
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(100, 50), YES, 2);
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    XCTAssertEqual([STPUploadPreprocessingQueue estimatedCostOfEncodingImage:image], 200U * 100U * 4U * 2U);
+}
+
+@end
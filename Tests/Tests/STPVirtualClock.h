@@ -0,0 +1,35 @@
+//
+//  STPVirtualClock.h
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "STPClock.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A clock whose time only moves when a test calls `advanceBy:`. Install it
+ with `+[STPClock setSharedClock:]`, and remove it in `tearDown`.
+ */
+@interface STPVirtualClock : STPClock
+
+- (instancetype)initWithDate:(NSDate *)date;
+
+/**
+ Moves time forward, firing the timers that come due along the way, in order.
+ */
+- (void)advanceBy:(NSTimeInterval)interval;
+
+/**
+ The number of timers waiting for time to move forward.
+ */
+@property (nonatomic, readonly) NSUInteger scheduledTimerCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
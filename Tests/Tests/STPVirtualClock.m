@@ -0,0 +1,92 @@
+//
+//  STPVirtualClock.m
+//  StripeiOS Tests
+//
+//  Created by Stripe on 10/19/26.
+//  Copyright © 2026 Stripe, Inc. All rights reserved.
+//
+
+#import "STPVirtualClock.h"
+
+// Monotonic time starts above 0, like the system uptime does
+static const NSTimeInterval InitialMonotonicTime = 1000;
+
+@interface STPVirtualClock ()
+
+@property (nonatomic) NSDate *startDate;
+@property (nonatomic) NSTimeInterval elapsedTime;
+@property (nonatomic) NSMutableArray<NSTimer *> *timers;
+@property (nonatomic) NSMutableArray<NSNumber *> *timerFireTimes;
+
+@end
+
+@implementation STPVirtualClock
+
+- (instancetype)init {
+    return [self initWithDate:[NSDate date]];
+}
+
+- (instancetype)initWithDate:(NSDate *)date {
+    self = [super init];
+    if (self) {
+        _startDate = date;
+        _timers = [NSMutableArray array];
+        _timerFireTimes = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (NSDate *)currentDate {
+    return [self.startDate dateByAddingTimeInterval:self.elapsedTime];
+}
+
+- (NSTimeInterval)monotonicTime {
+    return InitialMonotonicTime + self.elapsedTime;
+}
+
+- (NSTimer *)scheduledTimerWithTimeInterval:(NSTimeInterval)interval
+                                     target:(id)target
+                                   selector:(SEL)selector {
+    // Not added to a run loop; advanceBy: fires it
+    NSTimer *timer = [NSTimer timerWithTimeInterval:interval target:target selector:selector userInfo:nil repeats:NO];
+    [self.timers addObject:timer];
+    [self.timerFireTimes addObject:@(self.elapsedTime + MAX(interval, 0))];
+    return timer;
+}
+
+- (NSUInteger)scheduledTimerCount {
+    NSUInteger count = 0;
+    for (NSTimer *timer in self.timers) {
+        if (timer.isValid) {
+            count++;
+        }
+    }
+    return count;
+}
+
+- (void)advanceBy:(NSTimeInterval)interval {
+    NSTimeInterval endTime = self.elapsedTime + interval;
+    while (YES) {
+        NSUInteger nextIndex = NSNotFound;
+        for (NSUInteger i = 0; i < self.timers.count; i++) {
+            if (self.timerFireTimes[i].doubleValue <= endTime
+                && (nextIndex == NSNotFound || self.timerFireTimes[i].doubleValue < self.timerFireTimes[nextIndex].doubleValue)) {
+                nextIndex = i;
+            }
+        }
+        if (nextIndex == NSNotFound) {
+            break;
+        }
+        NSTimer *timer = self.timers[nextIndex];
+        self.elapsedTime = MAX(self.elapsedTime, self.timerFireTimes[nextIndex].doubleValue);
+        [self.timers removeObjectAtIndex:nextIndex];
+        [self.timerFireTimes removeObjectAtIndex:nextIndex];
+        if (timer.isValid) {
+            [timer fire];
+            [timer invalidate];
+        }
+    }
+    self.elapsedTime = endTime;
+}
+
+@end
@@ -9,7 +9,7 @@ end
 
 require 'xcodeproj'
 
-contents_of_resources_dir = Dir.glob("Stripe/Resources/Images/*.png").map { |h| File.basename(h) }.uniq.sort
+contents_of_resources_dir = Dir.glob(["Stripe/Resources/Images/*.png", "Stripe/Resources/*.bin"]).map { |h| File.basename(h) }.uniq.sort
 targets = ['StripeiOSResources', 'StripeiOS']
 targets.each do |target|
 
@@ -23,7 +23,7 @@ targets.each do |target|
 
   if contents_of_resources_dir != resources
     likely_culprits = ((contents_of_resources_dir - resources) + (resources - contents_of_resources_dir)).uniq
-    abort("The contents of Stripe/Resources/Images do not match the contents of the #{target} target. Likely culprits: #{likely_culprits}.")
+    abort("The contents of Stripe/Resources/Images and Stripe/Resources/*.bin do not match the contents of the #{target} target. Likely culprits: #{likely_culprits}.")
   end
 
 end
@@ -0,0 +1,96 @@
+#!/usr/bin/env ruby
+
+# Generates Stripe/Resources/stp_phone_metadata.bin, which STPPhoneNumberValidator
+# memory-maps to validate and format phone numbers. Edit the table below and
+# rerun this script to change it.
+#
+# Numbers are described as dialed within the country, including any trunk
+# prefix (e.g. the leading 0 in the UK).
+#
+#   calling_code:    the country calling code, dialed after + or 00
+#   national_prefix: the trunk prefix that's dropped after the calling code,
+#                    e.g. 0 for +44 7700 900123, which is 07700 900123 in the UK
+#   lengths: the allowed number of digits
+#   leading: the digits a number may start with
+#   formats: [leading digits, template] pairs. The first format whose leading
+#            digits match the number is used; X matches any digit. In a
+#            template, X is a digit and anything else is inserted as typed.
+#            Digits beyond the end of the template are appended as is.
+#
+# File format (all integers little-endian):
+#
+#   header:  "STPN", uint8 version, uint8 reserved, uint16 country count
+#   index:   per country, sorted by code: char[2] code, uint32 record offset
+#   record:  uint8 min length, uint8 max length, uint16 leading digit mask
+#            (bit n set if a number may start with n),
+#            uint8 length + calling code, uint8 length + national prefix,
+#            uint8 format count, then per format: uint8 length + leading
+#            digits, uint8 length + template
+
+METADATA = {
+  'AT' => { calling_code: '43', national_prefix: '0', lengths: 4..13, leading: '0', formats: [['0', 'XXXX XXXXXXXXX']] },
+  'AU' => { calling_code: '61', national_prefix: '0', lengths: 10..10, leading: '0', formats: [['04', 'XXXX XXX XXX'], ['', 'XX XXXX XXXX']] },
+  'BE' => { calling_code: '32', national_prefix: '0', lengths: 9..10, leading: '0', formats: [['04', 'XXXX XX XX XX'], ['', 'XX XXX XX XX']] },
+  'BR' => { calling_code: '55', national_prefix: '', lengths: 10..11, leading: '123456789', formats: [['XX9', '(XX) XXXXX-XXXX'], ['', '(XX) XXXX-XXXX']] },
+  'CA' => { calling_code: '1', national_prefix: '', lengths: 10..10, leading: '23456789', formats: [['', '(XXX) XXX-XXXX']] },
+  'CH' => { calling_code: '41', national_prefix: '0', lengths: 10..10, leading: '0', formats: [['', 'XXX XXX XX XX']] },
+  'DE' => { calling_code: '49', national_prefix: '0', lengths: 6..12, leading: '0', formats: [['01', 'XXXX XXXXXXXX'], ['', 'XXXX XXXXXXXX']] },
+  'DK' => { calling_code: '45', national_prefix: '', lengths: 8..8, leading: '23456789', formats: [['', 'XX XX XX XX']] },
+  'ES' => { calling_code: '34', national_prefix: '', lengths: 9..9, leading: '6789', formats: [['6', 'XXX XXX XXX'], ['7', 'XXX XXX XXX'], ['', 'XXX XX XX XX']] },
+  'FI' => { calling_code: '358', national_prefix: '0', lengths: 5..12, leading: '0', formats: [['', 'XXX XXX XXXXXX']] },
+  'FR' => { calling_code: '33', national_prefix: '0', lengths: 10..10, leading: '0', formats: [['', 'XX XX XX XX XX']] },
+  'GB' => { calling_code: '44', national_prefix: '0', lengths: 10..11, leading: '0', formats: [['02', 'XXX XXXX XXXX'], ['', 'XXXXX XXXXXX']] },
+  'HK' => { calling_code: '852', national_prefix: '', lengths: 8..8, leading: '235679', formats: [['', 'XXXX XXXX']] },
+  'IE' => { calling_code: '353', national_prefix: '0', lengths: 9..10, leading: '0', formats: [['08', 'XXX XXX XXXX'], ['', 'XX XXX XXXX']] },
+  'IN' => { calling_code: '91', national_prefix: '0', lengths: 10..11, leading: '06789', formats: [['0', 'XXXXX XXXXXX'], ['', 'XXXXX XXXXX']] },
+  'IT' => { calling_code: '39', national_prefix: '', lengths: 6..11, leading: '03', formats: [['3', 'XXX XXX XXXX'], ['', 'XX XXXX XXXXX']] },
+  'JP' => { calling_code: '81', national_prefix: '0', lengths: 10..11, leading: '0', formats: [['0X0', 'XXX-XXXX-XXXX'], ['', 'XX-XXXX-XXXX']] },
+  'MX' => { calling_code: '52', national_prefix: '', lengths: 10..10, leading: '123456789', formats: [['', 'XX XXXX XXXX']] },
+  'NL' => { calling_code: '31', national_prefix: '0', lengths: 10..10, leading: '0', formats: [['06', 'XX XXXXXXXX'], ['', 'XXX XXX XXXX']] },
+  'NO' => { calling_code: '47', national_prefix: '', lengths: 8..8, leading: '23456789', formats: [['4', 'XXX XX XXX'], ['9', 'XXX XX XXX'], ['', 'XX XX XX XX']] },
+  'NZ' => { calling_code: '64', national_prefix: '0', lengths: 8..10, leading: '0', formats: [['02', 'XXX XXX XXXX'], ['', 'XX XXX XXXX']] },
+  'SE' => { calling_code: '46', national_prefix: '0', lengths: 7..10, leading: '0', formats: [['07', 'XXX-XXX XX XX'], ['', 'XX-XXX XX XXX']] },
+  'SG' => { calling_code: '65', national_prefix: '', lengths: 8..8, leading: '3689', formats: [['', 'XXXX XXXX']] },
+  'US' => { calling_code: '1', national_prefix: '', lengths: 10..10, leading: '23456789', formats: [['', '(XXX) XXX-XXXX']] },
+}.freeze
+
+VERSION = 2
+
+def pascal_string(string)
+  abort("#{string} is too long") if string.bytesize > 255
+  [string.bytesize].pack('C') + string.b
+end
+
+codes = METADATA.keys.sort
+header_size = 8
+index_size = codes.length * 6
+
+records = ''.b
+index = ''.b
+codes.each do |code|
+  entry = METADATA[code]
+  formats = entry[:formats]
+  formats.each do |(leading_digits, template)|
+    slots = template.count('X')
+    if slots < entry[:lengths].min
+      abort("#{code}: template '#{template}' has fewer digits than the minimum length")
+    end
+    abort("#{code}: bad leading digits '#{leading_digits}'") unless leading_digits =~ /\A[0-9X]*\z/
+  end
+  abort("#{code}: bad calling code") unless entry[:calling_code] =~ /\A[1-9][0-9]{0,2}\z/
+  abort("#{code}: bad national prefix") unless entry[:national_prefix] =~ /\A[0-9]*\z/
+  mask = entry[:leading].chars.map { |d| 1 << d.to_i }.reduce(0, :|)
+
+  index << code.b << [header_size + index_size + records.bytesize].pack('V')
+  records << [entry[:lengths].min, entry[:lengths].max, mask].pack('CCv')
+  records << pascal_string(entry[:calling_code]) << pascal_string(entry[:national_prefix])
+  records << [formats.length].pack('C')
+  formats.each do |(leading_digits, template)|
+    records << pascal_string(leading_digits) << pascal_string(template)
+  end
+end
+
+data = 'STPN'.b + [VERSION, 0, codes.length].pack('CCv') + index + records
+path = File.expand_path('../Stripe/Resources/stp_phone_metadata.bin', __dir__)
+File.binwrite(path, data)
+puts "Wrote #{codes.length} countries (#{data.bytesize} bytes) to #{path}"